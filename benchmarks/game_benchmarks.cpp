@@ -0,0 +1,483 @@
+/**
+ * @brief 核心内核微基准（game_benchmarks 目标，cmake -DBUILD_BENCHMARKS=ON）
+ *
+ * 覆盖碰撞掩码生成、像素级碰撞、关卡配置解析、配置查询、图片加载和噩梦遮罩生成。
+ * 每项重复执行直到累计时间超过 --min-time-ms，报告每次操作的平均耗时；
+ * 默认使用 offscreen 平台，不需要图形会话。--json <文件> 输出与 Google Benchmark 相同结构的 JSON，
+ * 供 perf_check 与基线比较。
+ *
+ * 另有三类场景测量（名称以 scenario/ 开头，单位毫秒）：启动到主窗口显示、
+ * 各关房间切换、各关 Boss 战逐帧推进（额外输出 ticks_per_sec）。
+ *
+ * 用法：game_benchmarks [--json result.json] [--filter collision] [--min-time-ms 200]
+ */
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGraphicsPixmapItem>
+#include <QGraphicsScene>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QSysInfo>
+#include <functional>
+#include "constants.h"
+#include "core/configmanager.h"
+#include "core/gameclock.h"
+#include "core/gamewindow.h"
+#include "core/logging.h"
+#include "core/objectcensus.h"
+#include "core/resourcefactory.h"
+#include "core/spritecache.h"
+#include "entities/boss.h"
+#include "entities/entity.h"
+#include "entities/level_1/nightmareboss.h"
+#include "entities/player.h"
+#include "items/itemeffectconfig.h"
+#include "world/bulletpattern.h"
+#include "world/factory/bossfactory.h"
+#include "world/level.h"
+#include "world/levelconfig.h"
+#include "world/projectilepool.h"
+
+// 只用于测量的最小实体（Entity::move 为纯虚函数）
+class BenchEntity : public Entity {
+public:
+    explicit BenchEntity(const QPixmap &pic) { setPixmap(pic); }
+
+    void move() override {}
+};
+
+namespace {
+
+    // 防止编译器把结果未使用的操作优化掉
+    volatile int g_sink = 0;
+
+    struct Benchmark {
+        QString name;
+        std::function<void()> op;
+    };
+
+    struct Result {
+        QString name;
+        qint64 iterations = 0;
+        double realTime = 0.0;  // 每次操作的耗时，单位见 timeUnit
+        QString timeUnit = "ns";
+        QJsonObject counters;   // 场景的附加指标（如 ticks_per_sec）
+    };
+
+    Result measure(const Benchmark &benchmark, int minTimeMs) {
+        benchmark.op();  // 预热：填充惰性缓存、加载图片
+
+        Result result;
+        result.name = benchmark.name;
+        qint64 batch = 1;
+        qint64 totalNs = 0;
+        QElapsedTimer timer;
+        while (totalNs < minTimeMs * 1000000LL) {
+            timer.start();
+            for (qint64 i = 0; i < batch; ++i) {
+                benchmark.op();
+            }
+            totalNs += timer.nsecsElapsed();
+            result.iterations += batch;
+            if (batch < (1 << 20))
+                batch *= 2;
+        }
+        result.realTime = static_cast<double>(totalNs) / result.iterations;
+        return result;
+    }
+
+    QString formatTime(double ns) {
+        if (ns >= 1.0e6)
+            return QString("%1 ms").arg(ns / 1.0e6, 0, 'f', 3);
+        if (ns >= 1.0e3)
+            return QString("%1 us").arg(ns / 1.0e3, 0, 'f', 2);
+        return QString("%1 ns").arg(ns, 0, 'f', 1);
+    }
+
+    // 真实精灵：按 config.json 的尺寸加载（与游戏中一致）
+    struct Sprite {
+        QString name;
+        QPixmap pixmap;
+    };
+
+    QVector<Sprite> loadSprites() {
+        ConfigManager &config = ConfigManager::instance();
+        QVector<Sprite> sprites;
+        sprites.append({"player", ResourceFactory::createPlayerImage(config.getSize("player"))});
+        sprites.append({"bullet", ResourceFactory::createBulletImage(config.getBulletSize("player"))});
+        for (const QString &type : {QString("clock_normal"), QString("pillow")}) {
+            sprites.append({type, ResourceFactory::createEnemyImage(config.getEntitySize("enemies", type), 1, type)});
+        }
+        sprites.append({"xuke", ResourceFactory::createEnemyImage(config.getEntitySize("enemies", "xuke"), 3, "xuke")});
+        sprites.append({"nightmare", ResourceFactory::createBossImage(config.getEntitySize("bosses", "nightmare"), 1, "nightmare")});
+        sprites.append({"washmachine", ResourceFactory::createBossImage(config.getEntitySize("bosses", "washmachine"), 2, "washmachine")});
+        sprites.append({"teacher", ResourceFactory::createBossImage(config.getEntitySize("bosses", "teacher"), 3, "teacher")});
+        return sprites;
+    }
+
+    // 让 b 的图片中心与 a 的图片中心重合（两者都不在场景中，场景坐标即自身坐标）
+    void centerOn(Entity &a, QGraphicsPixmapItem &b) {
+        const QRectF ra(a.pos(), a.pixmap().size());
+        b.setPos(ra.center() - QPointF(b.pixmap().width() / 2.0, b.pixmap().height() / 2.0));
+    }
+
+    // ---------- 场景测量 ----------
+    // 与 StressBenchmark 相同的驱动方式：时钟不启动，逐帧推进游戏域、处理延迟删除、离屏渲染
+
+    constexpr int kFrameMs = 16;
+    constexpr int kBossFightFrames = 600;  // 约 10 秒游戏时间
+    constexpr int kBossHealth = 1000000;   // 测量期间 Boss 不会进入死亡流程
+    constexpr int kRoomTransitions = 30;
+
+    struct SceneFixture {
+        QGraphicsScene *scene = nullptr;
+        Player *player = nullptr;
+        QImage frame;
+
+        SceneFixture() : scene(new QGraphicsScene()), frame(scene_bound_x, scene_bound_y, QImage::Format_ARGB32_Premultiplied) {
+            scene->setSceneRect(0, 0, scene_bound_x, scene_bound_y);
+            const int playerSize = ConfigManager::instance().getSize("player");
+            player = new Player(ResourceFactory::createPlayerImage(playerSize), 1.0);
+            player->setPermanentInvincible(true);
+            player->setPos(scene_bound_x / 2.0 - playerSize / 2.0, scene_bound_y / 2.0 - playerSize / 2.0);
+            player->preloadCollisionMask();
+            scene->addItem(player);
+            // 前一个场景中的对话可能暂停了游戏域
+            GameClock::instance().setPaused(ClockDomain::Gameplay, false);
+        }
+
+        ~SceneFixture() {
+            // 场景删除时一并删除其中的实体，再释放对象池中空闲的子弹
+            delete scene;
+            BulletPatternEngine::instance().clear();
+            ProjectilePool::instance().clear();
+        }
+
+        void advanceFrame() {
+            GameClock::instance().advanceGameplay(kFrameMs);
+            QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+            render();
+        }
+
+        void render() {
+            QPainter painter(&frame);
+            scene->render(&painter);
+        }
+    };
+
+    Result bossFight(int levelNumber, const QString &bossType) {
+        Result result;
+        result.name = QString("scenario/boss_fight_%1").arg(bossType);
+        result.timeUnit = "ms";
+
+        SceneFixture fixture;
+        const int size = ConfigManager::instance().getEntitySize("bosses", bossType);
+        Boss *boss = BossFactory::instance().createBoss(levelNumber, ResourceFactory::createBossImage(size, levelNumber, bossType),
+                                                        1.0, fixture.scene);
+        if (!boss) {
+            qWarning() << "无法创建 Boss:" << bossType;
+            return result;
+        }
+        boss->setHealth(kBossHealth);
+        boss->setPos(150, 150);
+        boss->setPlayer(fixture.player);
+        boss->preloadCollisionMask();
+        fixture.scene->addItem(boss);
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < kBossFightFrames; ++i) {
+            fixture.advanceFrame();
+        }
+        const qint64 ns = timer.nsecsElapsed();
+
+        result.iterations = kBossFightFrames;
+        result.realTime = ns / 1.0e6 / kBossFightFrames;
+        result.counters["ticks_per_sec"] = ns > 0 ? kBossFightFrames * 1.0e9 / ns : 0.0;
+        return result;
+    }
+
+    // 房间切换：开发者模式初始化关卡（非 Boss 房间全部标记为已访问），再在这些房间之间反复 loadRoom
+    Result roomTransition(int levelNumber) {
+        Result result;
+        result.name = QString("scenario/room_transition_level%1").arg(levelNumber);
+        result.timeUnit = "ms";
+
+        LevelConfig config;
+        if (!config.loadFromFile(levelNumber))
+            return result;
+        QVector<int> rooms;
+        for (int i = 0; i < config.getRoomCount(); ++i) {
+            if (!config.getRoom(i).hasBoss)
+                rooms.append(i);
+        }
+        if (rooms.isEmpty())
+            return result;
+
+        SceneFixture fixture;
+        auto *level = new Level(fixture.player, fixture.scene);
+        level->setSkipToBoss(true);
+        level->init(levelNumber);
+        fixture.advanceFrame();
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < kRoomTransitions; ++i) {
+            level->loadRoom(rooms[i % rooms.size()]);
+            QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+            fixture.render();
+        }
+        const qint64 ns = timer.nsecsElapsed();
+        delete level;
+
+        result.iterations = kRoomTransitions;
+        result.realTime = ns / 1.0e6 / kRoomTransitions;
+        return result;
+    }
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    QElapsedTimer startup;
+    startup.start();
+
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption jsonOption("json", "结果 JSON 的输出路径", "file");
+    QCommandLineOption filterOption("filter", "只运行名称包含该字符串的基准", "text");
+    QCommandLineOption minTimeOption("min-time-ms", "每项的最短累计运行时间（毫秒，默认 200）", "ms", "200");
+    QCommandLineOption censusOption("census", "统计全部基准结束后仍存活的对象（钩子会计入测量，只用于查泄漏）");
+    parser.addOption(jsonOption);
+    parser.addOption(filterOption);
+    parser.addOption(minTimeOption);
+    parser.addOption(censusOption);
+    parser.process(app);
+    if (parser.isSet(censusOption)) {
+        ObjectCensus::instance().enable();
+    }
+
+    // 资源路径相对于项目根目录
+    if (!QFile::exists("assets/config.json")) {
+        QDir::setCurrent(GAME_SOURCE_DIR);
+    }
+    Logging::initializeLogging(false);
+    if (!ConfigManager::instance().loadConfig("assets/config.json")) {
+        qCritical() << "无法加载配置文件";
+        return 1;
+    }
+    ItemEffectConfig::instance().loadConfig("assets/item_effects.json");
+
+    const QString filter = parser.value(filterOption);
+    auto selected = [&filter](const QString &name) { return filter.isEmpty() || name.contains(filter); };
+    QVector<Result> results;
+
+    // 启动：进程入口 → 配置加载 → 主窗口首次显示（须在其他测量之前，精灵等缓存还是冷的）
+    if (selected("scenario/startup")) {
+        GameWindow window;
+        window.show();
+        QCoreApplication::processEvents();
+
+        Result result;
+        result.name = "scenario/startup";
+        result.iterations = 1;
+        result.realTime = startup.nsecsElapsed() / 1.0e6;
+        result.timeUnit = "ms";
+        results.append(result);
+    }
+
+    QVector<Benchmark> benchmarks;
+    QVector<Sprite> sprites;
+    try {
+        sprites = loadSprites();
+    } catch (const QString &e) {
+        qCritical() << "加载精灵失败:" << e;
+        return 1;
+    }
+
+    // ---------- Entity::generateCollisionMask ----------
+    for (const Sprite &sprite : sprites) {
+        auto entity = std::make_shared<BenchEntity>(sprite.pixmap);
+        benchmarks.append({QString("collision_mask/%1_%2px").arg(sprite.name).arg(sprite.pixmap.width()),
+                           [entity]() {
+                               entity->generateCollisionMask();
+                               g_sink = g_sink + entity->getCollisionMask().width();
+                           }});
+    }
+
+    // ---------- Entity::pixelCollision ----------
+    auto spriteNamed = [&sprites](const QString &name) {
+        for (const Sprite &sprite : sprites) {
+            if (sprite.name == name)
+                return sprite.pixmap;
+        }
+        return QPixmap();
+    };
+
+    for (const QString &boss : {QString("nightmare"), QString("washmachine"), QString("teacher")}) {
+        auto bullet = std::make_shared<BenchEntity>(spriteNamed("bullet"));
+        auto target = std::make_shared<BenchEntity>(spriteNamed(boss));
+        target->setPos(200, 200);
+        centerOn(*target, *bullet);
+        bullet->preloadCollisionMask();
+        target->preloadCollisionMask();
+        benchmarks.append({QString("pixel_collision/bullet_vs_%1").arg(boss),
+                           [bullet, target]() { g_sink = g_sink + Entity::pixelCollision(bullet.get(), target.get()); }});
+    }
+
+    for (const QString &enemy : {QString("clock_normal"), QString("pillow")}) {
+        auto player = std::make_shared<BenchEntity>(spriteNamed("player"));
+        auto target = std::make_shared<BenchEntity>(spriteNamed(enemy));
+        player->setPos(300, 300);
+        // 半身重叠：玩家右半部分与敌人左半部分相交
+        target->setPos(300 + player->pixmap().width() / 2.0, 300);
+        player->preloadCollisionMask();
+        target->preloadCollisionMask();
+        benchmarks.append({QString("pixel_collision/player_vs_%1").arg(enemy),
+                           [player, target]() { g_sink = g_sink + Entity::pixelCollision(player.get(), target.get()); }});
+    }
+
+    // ---------- Entity::pixelCollisionWithPixmapItem ----------
+    {
+        auto player = std::make_shared<BenchEntity>(spriteNamed("player"));
+        QPixmap paper = ResourceFactory::tryLoadSprite("assets/boss/Teacher/exam_paper.png", 40, 40);
+        if (paper.isNull()) {
+            paper = QPixmap(40, 40);
+            paper.fill(Qt::white);
+        }
+        auto item = std::make_shared<QGraphicsPixmapItem>(paper);
+        player->setPos(300, 300);
+        centerOn(*player, *item);
+        player->preloadCollisionMask();
+        benchmarks.append({"pixel_collision_item/player_vs_exam_paper",
+                           [player, item]() { g_sink = g_sink + Entity::pixelCollisionWithPixmapItem(player.get(), item.get()); }});
+    }
+
+    // ---------- LevelConfig::loadFromFile ----------
+    for (int level = 1; level <= 3; ++level) {
+        benchmarks.append({QString("level_parse/level%1").arg(level), [level]() {
+                               LevelConfig config;
+                               g_sink = g_sink + config.loadFromFile(level);
+                           }});
+    }
+
+    // ---------- ConfigManager::getEnemyInt ----------
+    benchmarks.append({"config/get_enemy_int", []() {
+                           g_sink = g_sink + ConfigManager::instance().getEnemyInt("clock_normal", "health", 0);
+                       }});
+
+    // ---------- ResourceFactory::loadImageScaled ----------
+    // cold：每次先清空精灵缓存，测量解码 + 缩放；warm：命中 SpriteCache 缓存
+    struct AssetClass {
+        QString name;
+        QString path;
+        int width;
+        int height;
+    };
+    ConfigManager &config = ConfigManager::instance();
+    const QVector<AssetClass> assets = {
+            {"player", config.getAssetPath("player"), 60, 60},
+            {"enemy", "assets/enemy/level_1/clock_normal.png", 50, 50},
+            {"boss", "assets/boss/Nightmare/Nightmare.png", 200, 200},
+            {"bullet", config.getAssetPath("bullet"), 50, 50},
+            {"chest", config.getAssetPath("chest"), 60, 60},
+            {"background", config.getAssetPath("startRoom"), 800, 600},
+    };
+    for (const AssetClass &asset : assets) {
+        if (!QFile::exists(asset.path)) {
+            qWarning() << "跳过不存在的资源:" << asset.path;
+            continue;
+        }
+        benchmarks.append({QString("load_image/%1_cold").arg(asset.name), [asset]() {
+                               SpriteCache::instance().clear();
+                               g_sink = g_sink + ResourceFactory::loadImageScaled(asset.path, asset.width, asset.height).width();
+                           }});
+        benchmarks.append({QString("load_image/%1_warm").arg(asset.name), [asset]() {
+                               g_sink = g_sink + ResourceFactory::loadImageScaled(asset.path, asset.width, asset.height).width();
+                           }});
+    }
+
+    // ---------- NightmareBoss::createShadowWithVision ----------
+    benchmarks.append({"nightmare/create_shadow_with_vision", []() {
+                           g_sink = g_sink + NightmareBoss::createShadowWithVision(QPointF(400, 300),
+                                                                                   NightmareBoss::kDefaultVisionRadius).width();
+                       }});
+
+    // ---------- 运行 ----------
+    const int minTimeMs = qMax(1, parser.value(minTimeOption).toInt());
+    for (const Benchmark &benchmark : benchmarks) {
+        if (selected(benchmark.name))
+            results.append(measure(benchmark, minTimeMs));
+    }
+
+    // 场景：房间切换、Boss 战（Boss 由 BossFactory 按关卡创建）
+    try {
+        for (int level = 1; level <= 3; ++level) {
+            const QString name = QString("scenario/room_transition_level%1").arg(level);
+            if (selected(name))
+                results.append(roomTransition(level));
+        }
+        const QPair<int, QString> bosses[] = {{1, "nightmare"}, {2, "washmachine"}, {3, "teacher"}};
+        for (const auto &boss : bosses) {
+            if (selected("scenario/boss_fight_" + boss.second))
+                results.append(bossFight(boss.first, boss.second));
+        }
+    } catch (const QString &e) {
+        qCritical() << "场景测量失败:" << e;
+        return 1;
+    }
+
+    QJsonArray entries;
+    for (const Result &result : results) {
+        const QString time = result.timeUnit == "ns" ? formatTime(result.realTime)
+                                                     : QString("%1 %2").arg(result.realTime, 0, 'f', 3).arg(result.timeUnit);
+        QString line = QString("%1 %2 %3 次").arg(result.name, -52).arg(time, 14).arg(result.iterations);
+        for (auto it = result.counters.begin(); it != result.counters.end(); ++it) {
+            line += QString("  %1=%2").arg(it.key()).arg(it.value().toDouble(), 0, 'f', 1);
+        }
+        qInfo().noquote() << line;
+
+        QJsonObject entry = result.counters;
+        entry["name"] = result.name;
+        entry["iterations"] = result.iterations;
+        entry["real_time"] = result.realTime;
+        entry["time_unit"] = result.timeUnit;
+        entries.append(entry);
+    }
+
+    if (parser.isSet(jsonOption)) {
+        QJsonObject context;
+        context["date"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+        context["host_name"] = QSysInfo::machineHostName();
+        context["qt_version"] = QString(qVersion());
+        context["min_time_ms"] = minTimeMs;
+        // 全部场景结束后仍存活的对象（场景对象应已全部销毁，增长说明泄漏）
+        if (ObjectCensus::instance().isEnabled()) {
+            context["census"] = ObjectCensus::instance().sample().toJson();
+        }
+
+        QJsonObject root;
+        root["context"] = context;
+        root["benchmarks"] = entries;
+
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical() << "无法写入结果文件" << parser.value(jsonOption);
+            return 1;
+        }
+        file.write(QJsonDocument(root).toJson());
+    }
+    return 0;
+}
@@ -0,0 +1,256 @@
+/**
+ * @brief 性能回归检查：把本次基准结果与仓库中的基线比较（perf_check 目标调用）
+ *
+ * 结果文件可以是 game_benchmarks --json 的输出（benchmarks 数组），
+ * 也可以是 game_final --benchmark-output 的压力测试结果（单个对象，名称取 "<scenario>/<bullets>"）。
+ * 基线文件列出要检查的指标：结果名、字段、单位、方向（越低越好或越高越好）和容差百分比。
+ * 超出容差的变差记为回归，超出容差的变好记为改进；存在回归时返回 1。
+ * 结果中缺失的指标和尚未记录基线（baseline 为 null）的指标同样返回 1，
+ * 否则空结果或空基线都会让检查"通过"；--allow-missing 只报告不判定（新增指标、尚未记录基线时使用）。
+ *
+ * 用法：perf_compare --baseline benchmarks/perf_baseline.json kernels.json bullet_hell.json
+ *       perf_compare --baseline benchmarks/perf_baseline.json --update kernels.json bullet_hell.json
+ *       perf_compare --baseline benchmarks/perf_baseline.json --allow-missing kernels.json
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtMath>
+
+namespace {
+
+    // 名称 → 结果对象（字段名 → 值）
+    using ResultTable = QHash<QString, QJsonObject>;
+
+    bool readJson(const QString &path, QJsonObject &root) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical().noquote() << "无法打开" << path;
+            return false;
+        }
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+        if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+            qCritical().noquote() << "JSON 解析失败" << path << error.errorString();
+            return false;
+        }
+        root = doc.object();
+        return true;
+    }
+
+    bool loadResults(const QString &path, ResultTable &table) {
+        QJsonObject root;
+        if (!readJson(path, root))
+            return false;
+
+        if (root.contains("benchmarks")) {
+            for (const QJsonValue &value : root.value("benchmarks").toArray()) {
+                const QJsonObject entry = value.toObject();
+                table.insert(entry.value("name").toString(), entry);
+            }
+        } else if (root.contains("scenario")) {
+            // 压力测试结果：同一场景按子弹规模区分
+            const QString name = QString("%1/%2").arg(root.value("scenario").toString()).arg(root.value("bullets").toInt());
+            table.insert(name, root);
+        } else {
+            qCritical().noquote() << "无法识别的结果文件" << path;
+            return false;
+        }
+        return true;
+    }
+
+    // 时间单位换算为纳秒的倍数，非时间单位返回 0
+    double nsPerUnit(const QString &unit) {
+        if (unit == "ns")
+            return 1.0;
+        if (unit == "us")
+            return 1.0e3;
+        if (unit == "ms")
+            return 1.0e6;
+        if (unit == "s")
+            return 1.0e9;
+        return 0.0;
+    }
+
+    /**
+     * @brief 按指标定义从结果中取值，real_time 按 time_unit 换算到指标单位
+     * @return 结果中没有该指标时返回 false
+     */
+    bool metricValue(const QJsonObject &metric, const ResultTable &table, double &value) {
+        const auto it = table.constFind(metric.value("benchmark").toString());
+        if (it == table.constEnd())
+            return false;
+
+        const QString field = metric.value("field").toString("real_time");
+        if (!it->contains(field))
+            return false;
+        value = it->value(field).toDouble();
+
+        if (field == "real_time") {
+            const double from = nsPerUnit(it->value("time_unit").toString("ns"));
+            const double to = nsPerUnit(metric.value("unit").toString());
+            if (from > 0.0 && to > 0.0)
+                value = value * from / to;
+        }
+        return true;
+    }
+
+    QString formatValue(double value) {
+        if (qAbs(value) >= 1000.0)
+            return QString::number(value, 'f', 0);
+        if (qAbs(value) >= 10.0)
+            return QString::number(value, 'f', 1);
+        return QString::number(value, 'f', 3);
+    }
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.setApplicationDescription("把基准结果与基线比较，存在回归时返回非零");
+    QCommandLineOption baselineOption("baseline", "基线文件", "file");
+    QCommandLineOption updateOption("update", "用本次结果更新基线中的数值（保留指标定义和容差）");
+    QCommandLineOption allowMissingOption("allow-missing", "缺失的指标和未记录的基线只报告，不算失败");
+    parser.addOption(baselineOption);
+    parser.addOption(updateOption);
+    parser.addOption(allowMissingOption);
+    parser.addPositionalArgument("results", "结果 JSON 文件（game_benchmarks --json 或 --benchmark-output）", "results...");
+    parser.process(app);
+
+    if (!parser.isSet(baselineOption) || parser.positionalArguments().isEmpty()) {
+        parser.showHelp(2);
+    }
+
+    ResultTable table;
+    for (const QString &path : parser.positionalArguments()) {
+        if (!loadResults(path, table))
+            return 2;
+    }
+
+    const QString baselinePath = parser.value(baselineOption);
+    QJsonObject baseline;
+    if (!readJson(baselinePath, baseline))
+        return 2;
+
+    const double defaultTolerance = baseline.value("default_tolerance_pct").toDouble(10.0);
+    QJsonArray metrics = baseline.value("metrics").toArray();
+    if (metrics.isEmpty()) {
+        qCritical().noquote() << "基线文件中没有指标" << baselinePath;
+        return 2;
+    }
+
+    // --update：只写回数值，指标列表与容差由人工维护
+    if (parser.isSet(updateOption)) {
+        int updated = 0;
+        for (int i = 0; i < metrics.size(); ++i) {
+            QJsonObject metric = metrics[i].toObject();
+            double value = 0.0;
+            if (metricValue(metric, table, value)) {
+                metric["baseline"] = value;
+                metrics[i] = metric;
+                ++updated;
+            } else {
+                qWarning().noquote() << "结果中没有" << metric.value("benchmark").toString() << "，保留原基线";
+            }
+        }
+        baseline["metrics"] = metrics;
+
+        QFile file(baselinePath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical().noquote() << "无法写入" << baselinePath;
+            return 2;
+        }
+        file.write(QJsonDocument(baseline).toJson());
+        qInfo().noquote() << QString("已更新 %1/%2 项基线：%3").arg(updated).arg(metrics.size()).arg(baselinePath);
+        return 0;
+    }
+
+    int regressions = 0;
+    int improvements = 0;
+    int missing = 0;
+    int unset = 0;
+    qInfo().noquote() << QString("%1 %2 %3 %4 %5  %6")
+                                 .arg("指标", -44)
+                                 .arg("基线", 12)
+                                 .arg("本次", 12)
+                                 .arg("变化", 9)
+                                 .arg("容差", 7)
+                                 .arg("结果");
+    for (const QJsonValue &entry : metrics) {
+        const QJsonObject metric = entry.toObject();
+        const QString label = QString("%1 (%2)").arg(metric.value("name").toString(metric.value("benchmark").toString()),
+                                                     metric.value("unit").toString());
+        const double tolerance = metric.value("tolerance_pct").toDouble(defaultTolerance);
+        const QString toleranceText = QString("±%1%").arg(tolerance, 0, 'f', 0);
+
+        double current = 0.0;
+        if (!metricValue(metric, table, current)) {
+            ++missing;
+            qInfo().noquote() << QString("%1 %2 %3 %4 %5  缺失").arg(label, -44).arg("-", 12).arg("-", 12).arg("-", 9).arg(toleranceText, 7);
+            continue;
+        }
+
+        const QJsonValue base = metric.value("baseline");
+        if (!base.isDouble() || base.toDouble() == 0.0) {
+            ++unset;
+            qInfo().noquote() << QString("%1 %2 %3 %4 %5  无基线")
+                                         .arg(label, -44)
+                                         .arg("-", 12)
+                                         .arg(formatValue(current), 12)
+                                         .arg("-", 9)
+                                         .arg(toleranceText, 7);
+            continue;
+        }
+
+        // 变化百分比统一换算成"变差为正"
+        const double reference = base.toDouble();
+        const double changePct = (current - reference) / reference * 100.0;
+        const bool higherIsBetter = metric.value("better").toString("lower") == "higher";
+        const double worsePct = higherIsBetter ? -changePct : changePct;
+
+        QString verdict = "持平";
+        if (worsePct > tolerance) {
+            verdict = "回归";
+            ++regressions;
+        } else if (worsePct < -tolerance) {
+            verdict = "改进";
+            ++improvements;
+        }
+        qInfo().noquote() << QString("%1 %2 %3 %4 %5  %6")
+                                     .arg(label, -44)
+                                     .arg(formatValue(reference), 12)
+                                     .arg(formatValue(current), 12)
+                                     .arg(QString("%1%2%").arg(changePct >= 0 ? "+" : "").arg(changePct, 0, 'f', 1), 9)
+                                     .arg(toleranceText, 7)
+                                     .arg(verdict);
+    }
+
+    qInfo().noquote() << QString("回归 %1，改进 %2，缺失 %3，无基线 %4，共 %5 项")
+                                 .arg(regressions)
+                                 .arg(improvements)
+                                 .arg(missing)
+                                 .arg(unset)
+                                 .arg(metrics.size());
+
+    if (regressions > 0)
+        return 1;
+    if ((missing > 0 || unset > 0) && !parser.isSet(allowMissingOption)) {
+        qCritical().noquote() << "存在缺失的指标或未记录的基线：在参考机器上运行 perf_baseline 目标记录基线，"
+                                 "或加 --allow-missing 只报告";
+        return 1;
+    }
+    if (missing > 0 || unset > 0) {
+        qWarning().noquote() << QString("警告：%1 项指标缺失、%2 项基线未记录，未参与回归判定（--allow-missing）")
+                                        .arg(missing)
+                                        .arg(unset);
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "core/allocationcounter.h"
+
+#ifdef GAME_COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+    std::atomic<quint64> g_allocations{0};
+
+    void *countedAlloc(std::size_t size) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+}  // namespace
+
+namespace AllocationCounter {
+
+    quint64 count() {
+        return g_allocations.load(std::memory_order_relaxed);
+    }
+
+    bool isEnabled() {
+        return true;
+    }
+
+}  // namespace AllocationCounter
+
+// 数组和 nothrow 版本按标准默认实现转发到这里
+void *operator new(std::size_t size) {
+    if (void *p = countedAlloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#else
+
+namespace AllocationCounter {
+
+    quint64 count() {
+        return 0;
+    }
+
+    bool isEnabled() {
+        return false;
+    }
+
+}  // namespace AllocationCounter
+
+#endif  // GAME_COUNT_ALLOCATIONS
@@ -0,0 +1,19 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+namespace AllocationCounter {
+
+// 进程启动以来全局 operator new 的调用次数（替换了全局 operator new/delete，计数为 relaxed 原子操作）
+// 注意：Qt 容器内部直接使用 malloc，不计入此数，度量的是 QObject、图元等对象的分配
+// 只有定义了 GAME_COUNT_ALLOCATIONS 的构建（cmake -DGAME_COUNT_ALLOCATIONS=ON）才替换 operator new，
+// 发行版不付出每次分配的原子操作开销，此时始终返回 0
+    quint64 count();
+
+// 当前构建是否统计分配次数
+    bool isEnabled();
+
+}  // namespace AllocationCounter
+
+#endif // ALLOCATIONCOUNTER_H
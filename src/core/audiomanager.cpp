@@ -1,6 +1,7 @@
 #include "audiomanager.h"
 #include <QDebug>
 #include <QDir>
+#include "logging.h"
 
 AudioManager &AudioManager::instance() {
     static AudioManager instance;
@@ -34,7 +35,7 @@ AudioManager::~AudioManager() {
 
 void AudioManager::preloadSound(const QString &soundName, const QString &filePath) {
     if (m_soundPools.contains(soundName)) {
-        qDebug() << "Sound already preloaded:" << soundName;
+        qCDebug(lcAudio) << "Sound already preloaded:" << soundName;
         return;
     }
 
@@ -59,7 +60,7 @@ void AudioManager::preloadSound(const QString &soundName, const QString &filePat
     }
 
     m_soundPools[soundName] = pool;
-    qDebug() << "Preloaded sound pool:" << soundName << "with" << POOL_SIZE << "instances";
+    qCDebug(lcAudio) << "Preloaded sound pool:" << soundName << "with" << POOL_SIZE << "instances";
 }
 
 void AudioManager::playSound(const QString &soundName) {
@@ -90,7 +91,7 @@ void AudioManager::playMusic(const QString &musicFile) {
 
 
     m_musicPlayer->play();
-    qDebug() << "Playing music:" << musicFile;
+    qCDebug(lcAudio) << "Playing music:" << musicFile;
 }
 
 void AudioManager::stopMusic() {
@@ -119,7 +120,7 @@ bool AudioManager::isMusicPlaying() const {
 void AudioManager::onMediaStatusChanged(QMediaPlayer::MediaStatus status) {
     if (status == QMediaPlayer::EndOfMedia) {
         // 手动实现循环播放
-        qDebug() << "Music playback finished, looping...";
+        qCDebug(lcAudio) << "Music playback finished, looping...";
         m_musicPlayer->setPosition(0);
         m_musicPlayer->play();
     }
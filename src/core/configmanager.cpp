@@ -4,6 +4,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
+#include "logging.h"
 
 ConfigManager& ConfigManager::instance() {
     static ConfigManager instance;
@@ -35,7 +36,7 @@ bool ConfigManager::loadConfig(const QString& configPath) {
 
     configObject = configDoc.object();
     loaded = true;
-    qDebug() << "配置文件加载成功:" << configPath;
+    qCDebug(lcAssets) << "配置文件加载成功:" << configPath;
     return true;
 }
 
@@ -76,7 +77,7 @@ bool ConfigManager::saveConfig(const QString& configPath) {
     configFile.write(configDoc.toJson(QJsonDocument::Indented));
     configFile.close();
 
-    qDebug() << "配置文件保存成功:" << configPath;
+    qCDebug(lcAssets) << "配置文件保存成功:" << configPath;
     return true;
 }
 
@@ -349,6 +350,16 @@ QString ConfigManager::getBossString(const QString& bossType, const QString& key
     return defaultValue;
 }
 
+QJsonObject ConfigManager::getBossPattern(const QString& bossType, const QString& name) const {
+    if (!loaded) {
+        qWarning() << "配置文件未加载";
+        return QJsonObject();
+    }
+
+    QJsonObject bossConfig = configObject.value("bosses").toObject().value(bossType).toObject();
+    return bossConfig.value("patterns").toObject().value(name).toObject();
+}
+
 bool ConfigManager::getLoggingDebug(bool defaultValue) const {
     if (!loaded) {
         qWarning() << "配置文件未加载";
@@ -358,6 +369,14 @@ bool ConfigManager::getLoggingDebug(bool defaultValue) const {
     return loggingObj.value("debug").toBool(defaultValue);
 }
 
+QJsonObject ConfigManager::getLoggingCategories() const {
+    if (!loaded) {
+        qWarning() << "配置文件未加载";
+        return QJsonObject();
+    }
+    return configObject.value("logging").toObject().value("categories").toObject();
+}
+
 bool ConfigManager::isGameCompleted() const {
     if (!loaded) {
         return false;
@@ -375,5 +394,5 @@ void ConfigManager::setGameCompleted(bool completed) {
     progressObj["game_completed"] = completed;
     configObject["progress"] = progressObj;
     saveConfig();
-    qDebug() << "游戏通关状态已保存:" << completed;
+    qCDebug(lcAssets) << "游戏通关状态已保存:" << completed;
 }
\ No newline at end of file
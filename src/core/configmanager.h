@@ -85,6 +85,12 @@ class ConfigManager {
      */
     [[nodiscard]] bool getLoggingDebug(bool defaultValue = false) const;
 
+    /**
+     * @brief 获取 logging.categories 配置（分类名 → 是否输出 debug，如 {"boss": true}）
+     * @return 未配置时返回空对象
+     */
+    [[nodiscard]] QJsonObject getLoggingCategories() const;
+
     // ============== 玩家配置 ==============
     /**
      * @brief 获取玩家配置的整数值
@@ -152,6 +158,14 @@ class ConfigManager {
      */
     [[nodiscard]] QString getBossString(const QString& bossType, const QString& key, const QString& defaultValue = "") const;
 
+    /**
+     * @brief 获取Boss的弹幕描述（bosses.<bossType>.patterns.<name>）
+     * @param bossType Boss类型
+     * @param name 弹幕名称，如 normal_barrage, spread_gas
+     * @return 弹幕描述对象，不存在时返回空对象
+     */
+    [[nodiscard]] QJsonObject getBossPattern(const QString& bossType, const QString& name) const;
+
     // ============== 游戏进度配置 ==============
     /**
      * @brief 检查游戏是否已通关
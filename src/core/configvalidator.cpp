@@ -1,5 +1,6 @@
 #include "configvalidator.h"
 #include "configmanager.h"
+#include "logging.h"
 
 // 静态成员初始化
 QStringList ConfigValidator::s_errors;
@@ -18,7 +19,7 @@ void ConfigValidator::logWarning(const QString& msg) {
 
 void ConfigValidator::logSuccess(const QString& msg) {
     s_successes.append(msg);
-    qDebug() << "[CONFIG OK]" << msg;
+    qCDebug(lcAssets) << "[CONFIG OK]" << msg;
 }
 
 void ConfigValidator::clearLogs() {
@@ -29,20 +30,20 @@ void ConfigValidator::clearLogs() {
 
 bool ConfigValidator::validateAllConfigs() {
     clearLogs();
-    qDebug() << "========== 开始配置验证 ==========";
+    qCDebug(lcAssets) << "========== 开始配置验证 ==========";
 
     bool playerOk = validatePlayerConfig();
     bool enemiesOk = validateEnemyConfigs();
     bool bossesOk = validateBossConfigs();
 
-    qDebug() << "========== 配置验证完成 ==========";
-    qDebug() << "成功:" << s_successes.count() << "警告:" << s_warnings.count() << "错误:" << s_errors.count();
+    qCDebug(lcAssets) << "========== 配置验证完成 ==========";
+    qCDebug(lcAssets) << "成功:" << s_successes.count() << "警告:" << s_warnings.count() << "错误:" << s_errors.count();
 
     return playerOk && enemiesOk && bossesOk;
 }
 
 bool ConfigValidator::validatePlayerConfig() {
-    qDebug() << "--- 验证玩家配置 ---";
+    qCDebug(lcAssets) << "--- 验证玩家配置 ---";
     ConfigManager& config = ConfigManager::instance();
     bool allOk = true;
 
@@ -100,7 +101,7 @@ bool ConfigValidator::validatePlayerConfig() {
 }
 
 bool ConfigValidator::validateEnemyConfigs() {
-    qDebug() << "--- 验证敌人配置 ---";
+    qCDebug(lcAssets) << "--- 验证敌人配置 ---";
     ConfigManager& config = ConfigManager::instance();
     bool allOk = true;
 
@@ -117,7 +118,7 @@ bool ConfigValidator::validateEnemyConfigs() {
     QStringList requiredDoubleKeys = {"speed"};
 
     for (const QString& enemyType : enemyTypes) {
-        qDebug() << "  检查敌人:" << enemyType;
+        qCDebug(lcAssets) << "  检查敌人:" << enemyType;
 
         // 检查必须的整数配置
         for (const QString& key : requiredIntKeys) {
@@ -206,7 +207,7 @@ bool ConfigValidator::validateEnemyConfigs() {
 }
 
 bool ConfigValidator::validateBossConfigs() {
-    qDebug() << "--- 验证Boss配置 ---";
+    qCDebug(lcAssets) << "--- 验证Boss配置 ---";
     ConfigManager& config = ConfigManager::instance();
     bool allOk = true;
 
@@ -226,10 +227,10 @@ bool ConfigValidator::validateBossConfigs() {
     QStringList phase1RequiredIntKeys = {"health", "attack_cooldown"};
 
     for (const BossInfo& boss : bosses) {
-        qDebug() << "  检查Boss:" << boss.type;
+        qCDebug(lcAssets) << "  检查Boss:" << boss.type;
 
         for (const QString& phase : boss.phases) {
-            qDebug() << "    阶段:" << phase;
+            qCDebug(lcAssets) << "    阶段:" << phase;
 
             // 检查contact_damage
             for (const QString& key : requiredIntKeys) {
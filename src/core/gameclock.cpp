@@ -0,0 +1,192 @@
+#include "gameclock.h"
+#include <QDebug>
+#include "gametimer.h"
+
+GameClock &GameClock::instance() {
+    static GameClock instance;
+    return instance;
+}
+
+GameClock::GameClock(QObject *parent) : QObject(parent) {
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &GameClock::onTimeout);
+}
+
+void GameClock::start() {
+    if (m_timer.isActive())
+        return;
+    m_elapsed.start();
+    m_rateWindow.start();
+    m_simTicksInWindow = 0;
+    m_timer.start(kTickIntervalMs);
+}
+
+void GameClock::stop() {
+    m_timer.stop();
+}
+
+void GameClock::setPaused(ClockDomain domain, bool paused) {
+    DomainState &d = state(domain);
+    if (d.paused == paused)
+        return;
+    d.paused = paused;
+    // 丢弃暂停前不足1ms的余量，恢复后从整毫秒继续
+    d.carryMs = 0.0;
+}
+
+void GameClock::setTimeScale(ClockDomain domain, double scale) {
+    state(domain).timeScale = qMax(0.0, scale);
+}
+
+void GameClock::setFastForward(int factor) {
+    if (factor != kFastForwardUnbounded && factor < 1) {
+        qWarning() << "GameClock: 无效的快进倍率" << factor;
+        return;
+    }
+    if (factor == m_fastForward)
+        return;
+
+    m_fastForward = factor;
+    if (factor == kFastForwardUnbounded) {
+        qInfo() << "GameClock: 快进已开启（不限倍率）";
+    } else if (factor > 1) {
+        qInfo() << "GameClock: 快进已开启" << factor << "x";
+    } else {
+        qInfo() << "GameClock: 快进已关闭";
+    }
+    emit fastForwardChanged(factor);
+}
+
+void GameClock::onTimeout() {
+    int dtMs = static_cast<int>(m_elapsed.restart());
+    if (dtMs > kMaxTickMs)
+        dtMs = kMaxTickMs;
+
+    // 界面与对话始终按实际时间推进；快进只作用于游戏域
+    for (int i = 0; i < static_cast<int>(ClockDomain::DomainCount); ++i) {
+        auto domain = static_cast<ClockDomain>(i);
+        if (domain == ClockDomain::Gameplay && isFastForwarding()) {
+            advanceFastForward();
+        } else {
+            advanceDomain(domain, dtMs);
+        }
+    }
+
+    measureSimRate();
+}
+
+void GameClock::advanceFastForward() {
+    // 固定步长而非实际间隔，结果与机器快慢无关
+    if (m_fastForward == kFastForwardUnbounded) {
+        // 游戏域不能推进（暂停、时间缩放为 0）时立即退出，不空转整个预算
+        QElapsedTimer budget;
+        budget.start();
+        do {
+            if (!advanceDomain(ClockDomain::Gameplay, kTickIntervalMs))
+                break;
+        } while (budget.elapsed() < kUnboundedBudgetMs);
+        return;
+    }
+
+    for (int i = 0; i < m_fastForward; ++i) {
+        if (!advanceDomain(ClockDomain::Gameplay, kTickIntervalMs))
+            break;
+    }
+}
+
+void GameClock::advanceGameplay(int dtMs) {
+    advanceDomain(ClockDomain::Gameplay, dtMs);
+}
+
+int GameClock::activeTimerCount() const {
+    int count = 0;
+    for (const DomainState &domain : m_domains) {
+        count += domain.timers.size() - domain.holes;
+    }
+    return count;
+}
+
+void GameClock::measureSimRate() {
+    const qint64 windowMs = m_rateWindow.elapsed();
+    if (windowMs < 1000)
+        return;
+
+    m_simTicksPerSecond = m_simTicksInWindow * 1000.0 / windowMs;
+    m_simTicksInWindow = 0;
+    m_rateWindow.restart();
+    emit simRateMeasured(m_simTicksPerSecond);
+
+    if (isFastForwarding()) {
+        qInfo().noquote() << QString("GameClock: 模拟速率 %1 tick/s（约 %2 倍实时）")
+                                     .arg(m_simTicksPerSecond, 0, 'f', 1)
+                                     .arg(m_simTicksPerSecond * kTickIntervalMs / 1000.0, 0, 'f', 1);
+    }
+}
+
+bool GameClock::advanceDomain(ClockDomain domain, int realDtMs) {
+    DomainState &d = state(domain);
+    // advancing 防止回调中开启嵌套事件循环时重入
+    if (d.paused || d.advancing || d.timeScale <= 0.0)
+        return false;
+
+    double scaled = realDtMs * d.timeScale + d.carryMs;
+    int dtMs = static_cast<int>(scaled);
+    d.carryMs = scaled - dtMs;
+    if (dtMs <= 0)
+        return true;  // 慢动作下不足 1ms 的余量已累积，下一次继续
+
+    d.nowMs += dtMs;
+    if (domain == ClockDomain::Gameplay) {
+        ++m_simTicksInWindow;
+    }
+
+    // 只推进本次节拍开始前已运行的定时器，回调中新启动的定时器从下一拍开始计时
+    d.advancing = true;
+    const int count = d.timers.size();
+    for (int i = 0; i < count && !d.paused; ++i) {
+        if (GameTimer *timer = d.timers[i]) {
+            timer->advance(dtMs);
+        }
+    }
+    d.advancing = false;
+
+    if (d.holes > 0) {
+        compact(d);
+    }
+
+    if (domain == ClockDomain::Gameplay) {
+        emit tick(dtMs);
+    }
+    emit advanced(domain, dtMs);
+    return true;
+}
+
+void GameClock::attachTimer(GameTimer *timer) {
+    DomainState &d = state(timer->domain());
+    timer->m_slot = d.timers.size();
+    d.timers.append(timer);
+}
+
+void GameClock::detachTimer(GameTimer *timer) {
+    DomainState &d = state(timer->domain());
+    d.timers[timer->m_slot] = nullptr;
+    timer->m_slot = -1;
+    ++d.holes;
+
+    // 推进过程中只置空，结束后统一压缩
+    if (!d.advancing && d.holes * 2 > d.timers.size()) {
+        compact(d);
+    }
+}
+
+void GameClock::compact(DomainState &domain) {
+    int write = 0;
+    for (GameTimer *timer : domain.timers) {
+        if (timer) {
+            timer->m_slot = write;
+            domain.timers[write++] = timer;
+        }
+    }
+    domain.timers.resize(write);
+    domain.holes = 0;
+}
@@ -0,0 +1,169 @@
+#ifndef GAMECLOCK_H
+#define GAMECLOCK_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <array>
+
+class GameTimer;
+
+/**
+ * @brief 时间域 - 每个域独立暂停与缩放
+ *
+ * Gameplay：敌人、子弹、玩家、掉落物、特效等一切游戏逻辑；
+ * UI：HUD 等界面元素，暂停菜单下仍然运行；
+ * Dialog：剧情对话相关的计时，打开暂停菜单时一并暂停。
+ */
+enum class ClockDomain {
+    Gameplay,
+    UI,
+    Dialog,
+    DomainCount
+};
+
+/**
+ * @brief 游戏时钟 - 全局统一的逻辑节拍
+ *
+ * 以固定间隔推进各时间域，替代各对象为短时效果各自创建的 QTimer/singleShot。
+ * 每个域有自己的模拟时间 now()、暂停状态和时间缩放：
+ * 暂停某个域只是停止推进它的时间，域内的 GameTimer 和 tick 订阅者全部静止，
+ * 恢复时从暂停处继续，不需要逐个对象停止/重启定时器。
+ * tick(dtMs) 为游戏域（已缩放）的节拍，dtMs 有上限，避免卡顿后一次推进过多。
+ *
+ * 开发者快进：每次计时器触发时让游戏域以固定步长连续推进多个节拍，
+ * 用于在几分钟内跑完需要数小时的浸泡测试，同时统计每秒能推进的节拍数。
+ */
+class GameClock : public QObject {
+    Q_OBJECT
+
+public:
+    static GameClock &instance();
+
+    static constexpr int kTickIntervalMs = 16;        // 约60Hz
+    static constexpr int kMaxTickMs = 100;            // 单次节拍最多推进的时间（缩放前）
+    static constexpr int kFastForwardUnbounded = -1;  // 快进倍率：不限，尽可能多地推进
+    static constexpr int kUnboundedBudgetMs = 12;     // 不限倍率时每次触发可占用的实际时间
+
+    void start();
+
+    void stop();
+
+    [[nodiscard]] bool isRunning() const { return m_timer.isActive(); }
+
+    /**
+     * @brief 暂停/恢复一个时间域，O(1)
+     */
+    void setPaused(ClockDomain domain, bool paused);
+
+    [[nodiscard]] bool isPaused(ClockDomain domain) const { return state(domain).paused; }
+
+    /**
+     * @brief 设置时间域的时间缩放（<1 慢动作，>1 快进，0 等同暂停）
+     */
+    void setTimeScale(ClockDomain domain, double scale);
+
+    [[nodiscard]] double timeScale(ClockDomain domain) const { return state(domain).timeScale; }
+
+    /**
+     * @brief 时间域的模拟时间（毫秒），暂停期间不增长
+     *
+     * 冷却、攻击间隔等需要"当前时间"的逻辑应读取它，而不是系统时间。
+     */
+    [[nodiscard]] qint64 now(ClockDomain domain = ClockDomain::Gameplay) const { return state(domain).nowMs; }
+
+    /**
+     * @brief 设置开发者快进倍率
+     * @param factor 1 为正常速度；2/4/8 等表示每次触发推进的固定节拍数；
+     *               kFastForwardUnbounded 表示在时间预算内尽可能多地推进
+     */
+    void setFastForward(int factor);
+
+    [[nodiscard]] int fastForward() const { return m_fastForward; }
+
+    [[nodiscard]] bool isFastForwarding() const { return m_fastForward != 1; }
+
+    /**
+     * @brief 最近一秒内游戏域实际推进的节拍数（模拟余量的直接度量）
+     */
+    [[nodiscard]] double simTicksPerSecond() const { return m_simTicksPerSecond; }
+
+    /**
+     * @brief 所有时间域中正在运行的 GameTimer 数量
+     */
+    [[nodiscard]] int activeTimerCount() const;
+
+    /**
+     * @brief 手动推进游戏域一个节拍（压力测试在时钟停止后逐帧驱动，不经过 QTimer）
+     */
+    void advanceGameplay(int dtMs);
+
+signals:
+
+    /**
+     * @brief 游戏域节拍（已缩放、暂停时不发出）
+     */
+    void tick(int dtMs);
+
+    /**
+     * @brief 任意时间域推进后发出
+     */
+    void advanced(ClockDomain domain, int dtMs);
+
+    void fastForwardChanged(int factor);
+
+    /**
+     * @brief 每秒发出一次游戏域的节拍速率
+     */
+    void simRateMeasured(double ticksPerSecond);
+
+private slots:
+
+    void onTimeout();
+
+private:
+    friend class GameTimer;
+
+    explicit GameClock(QObject *parent = nullptr);
+
+    struct DomainState {
+        bool paused = false;
+        double timeScale = 1.0;
+        double carryMs = 0.0;      // 缩放后不足1ms的余量，累积到下一次节拍
+        qint64 nowMs = 0;
+        QVector<GameTimer *> timers;  // 运行中的定时器，停止时置空、推进结束后压缩
+        int holes = 0;
+        bool advancing = false;
+    };
+
+    DomainState &state(ClockDomain domain) { return m_domains[static_cast<int>(domain)]; }
+
+    [[nodiscard]] const DomainState &state(ClockDomain domain) const {
+        return m_domains[static_cast<int>(domain)];
+    }
+
+    // 按缩放推进一个域并驱动其中的定时器；域暂停、时间缩放为 0 或正在推进（重入）时返回 false
+    bool advanceDomain(ClockDomain domain, int realDtMs);
+
+    // 快进时以固定步长连续推进游戏域
+    void advanceFastForward();
+
+    void measureSimRate();
+
+    void attachTimer(GameTimer *timer);
+
+    void detachTimer(GameTimer *timer);
+
+    static void compact(DomainState &domain);
+
+    QTimer m_timer;
+    QElapsedTimer m_elapsed;
+    QElapsedTimer m_rateWindow;  // 节拍速率统计窗口
+    int m_fastForward = 1;
+    int m_simTicksInWindow = 0;
+    double m_simTicksPerSecond = 0.0;
+    std::array<DomainState, static_cast<int>(ClockDomain::DomainCount)> m_domains;
+};
+
+#endif // GAMECLOCK_H
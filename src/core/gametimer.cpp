@@ -0,0 +1,68 @@
+#include "gametimer.h"
+#include <QPointer>
+
+quint64 GameTimer::s_fires = 0;
+
+GameTimer::GameTimer(QObject *parent, ClockDomain domain) : QObject(parent), m_domain(domain) {
+}
+
+GameTimer::~GameTimer() {
+    stop();
+}
+
+void GameTimer::start(int msec) {
+    setInterval(msec);
+    start();
+}
+
+void GameTimer::start() {
+    // 与 QTimer 一致：运行中再次 start 会从头开始计时
+    m_remaining = m_interval;
+    if (!isActive()) {
+        GameClock::instance().attachTimer(this);
+    }
+}
+
+void GameTimer::stop() {
+    if (isActive()) {
+        GameClock::instance().detachTimer(this);
+    }
+}
+
+int GameTimer::remainingTime() const {
+    return isActive() ? qMax(0, m_remaining) : -1;
+}
+
+void GameTimer::advance(int dtMs) {
+    // 间隔为0时每个节拍触发一次
+    if (m_interval == 0) {
+        if (m_singleShot)
+            stop();
+        ++s_fires;
+        emit timeout();
+        return;
+    }
+
+    m_remaining -= dtMs;
+    QPointer<GameTimer> guard(this);
+    int fires = 0;
+    while (isActive() && m_remaining <= 0 && fires < kMaxFiresPerTick) {
+        ++fires;
+        if (m_singleShot) {
+            stop();
+            ++s_fires;
+            emit timeout();
+            return;
+        }
+        m_remaining += m_interval;
+        ++s_fires;
+        emit timeout();
+        if (!guard)
+            return;  // 回调中删除了定时器或其父对象
+    }
+
+    // 补发达到上限时丢弃积压，避免越积越多
+    if (isActive() && m_remaining <= 0) {
+        m_remaining = m_interval;
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef GAMETIMER_H
+#define GAMETIMER_H
+
+#include <QObject>
+#include "gameclock.h"
+
+/**
+ * @brief 由 GameClock 驱动的定时器，接口与 QTimer 的常用部分一致
+ *
+ * 计时读取所属时间域的模拟时间，因此时间域暂停时自动静止、恢复后继续剩余时间，
+ * 时间缩放也同样作用于它。游戏对象用它代替 QTimer，不再需要各自实现暂停/恢复。
+ * 一次节拍跨过多个周期时会补发多次 timeout（快进时保持移动速度等不变）。
+ */
+class GameTimer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GameTimer(QObject *parent = nullptr, ClockDomain domain = ClockDomain::Gameplay);
+
+    ~GameTimer() override;
+
+    static constexpr int kMaxFiresPerTick = 64;  // 单次节拍最多补发的次数
+
+    void start(int msec);
+
+    void start();
+
+    void stop();
+
+    [[nodiscard]] bool isActive() const { return m_slot >= 0; }
+
+    void setInterval(int msec) { m_interval = qMax(0, msec); }
+
+    [[nodiscard]] int interval() const { return m_interval; }
+
+    void setSingleShot(bool singleShot) { m_singleShot = singleShot; }
+
+    [[nodiscard]] bool isSingleShot() const { return m_singleShot; }
+
+    /**
+     * @brief 距下一次触发的模拟时间，未运行时返回 -1（与 QTimer 一致）
+     */
+    [[nodiscard]] int remainingTime() const;
+
+    [[nodiscard]] ClockDomain domain() const { return m_domain; }
+
+    /**
+     * @brief 进程内所有 GameTimer 累计触发次数（对象普查计算触发速率）
+     */
+    [[nodiscard]] static quint64 totalFires() { return s_fires; }
+
+signals:
+
+    void timeout();
+
+private:
+    friend class GameClock;
+
+    // 由 GameClock 调用，推进 dtMs 模拟时间
+    void advance(int dtMs);
+
+    ClockDomain m_domain;
+    int m_interval = 0;
+    int m_remaining = 0;
+    int m_slot = -1;  // 在所属域运行列表中的位置，-1 表示未运行
+    bool m_singleShot = false;
+
+    static quint64 s_fires;  // 只在主线程推进，无需原子操作
+};
+
+#endif // GAMETIMER_H
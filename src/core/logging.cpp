@@ -1,61 +1,290 @@
 #include "core/logging.h"
+#include <QByteArray>
 #include <QDateTime>
 #include <QDebug>
-#include <QMutex>
-#include <QMutexLocker>
+#include <QMap>
 #include <QtGlobal>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// 分类默认只输出 info 及以上，debug 由 Logging::setDebugEnabled / setCategoryDebugEnabled 在运行时打开
+Q_LOGGING_CATEGORY(lcAi, "game.ai", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcCollision, "game.collision", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcRoom, "game.room", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcBoss, "game.boss", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcAudio, "game.audio", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcAssets, "game.assets", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcPlayer, "game.player", QtInfoMsg)
 
 namespace {
 
     static std::atomic_bool g_debug_enabled{false};
-    static QMutex g_print_mutex;
+    static QMap<QString, bool> g_category_overrides;  // 分类名（不含 game. 前缀）→ 是否输出 debug
+    // 后台写线程运行期间为 true；未初始化或已停止时消息同步写出（程序退出阶段的析构函数日志）
+    static std::atomic_bool g_async_active{false};
+    // 已读到 g_async_active == true、尚未写完的生产者数；停止时等它归零，之后不会再有记录进入缓冲
+    static std::atomic_int g_inflight{0};
+    static std::atomic<quint64> g_dropped{0};
 
-    void defaultMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
-        // 如果是 debug 消息并且当前关闭，则丢弃
-        if (type == QtDebugMsg && !g_debug_enabled.load()) {
-            return;
-        }
-        QByteArray localMsg = msg.toLocal8Bit();
-        const char *file = context.file ? context.file : "";
-        const char *function = context.function ? context.function : "";
-
-        // 标记时间 & 类型
-        const char *typeStr = "DEBUG";
+    const char *typeName(QtMsgType type) {
         switch (type) {
             case QtDebugMsg:
-                typeStr = "DEBUG";
-                break;
+                return "DEBUG";
             case QtInfoMsg:
-                typeStr = "INFO";
-                break;
+                return "INFO";
             case QtWarningMsg:
-                typeStr = "WARNING";
-                break;
+                return "WARNING";
             case QtCriticalMsg:
-                typeStr = "CRITICAL";
-                break;
+                return "CRITICAL";
             case QtFatalMsg:
-                typeStr = "FATAL";
-                break;
+                return "FATAL";
             default:
-                typeStr = "LOG";
-                break;
+                return "LOG";
         }
+    }
+
+    /**
+     * @brief 异步日志写出器：有界无锁多生产者单消费者环形缓冲 + 后台写线程
+     *
+     * 调用线程只把消息格式化进固定大小的槽位（时间戳只记录毫秒数，由写线程格式化），
+     * 不做 IO；缓冲满时丢弃并计数。写线程空闲时阻塞在条件变量上（不轮询），
+     * 一批中的第一条记录唤醒它，它再等待 kFlushIntervalMs 攒批（警告以上的消息或停止请求立即结束等待），
+     * 然后取出全部记录，拼接后一次 fwrite + fflush，并在有丢弃时补一行提示。
+     * 生产者只在一批的第一条记录和警告以上的消息上短暂获取唤醒锁，避免丢失唤醒。
+     * 槽位序号的用法同 Vyukov 有界队列：序号等于写入位置时可写，等于写入位置 + 1 时可读。
+     */
+    class AsyncLogWriter {
+    public:
+        static constexpr std::size_t kCapacity = 1024;  // 槽位数（2 的幂）
+        static constexpr int kRecordBytes = 1000;       // 单条记录上限，超出部分截断
+        static constexpr int kFlushIntervalMs = 20;
+
+        AsyncLogWriter() : m_slots(new Slot[kCapacity]) {
+            for (std::size_t i = 0; i < kCapacity; ++i) {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            m_batch.reserve(64 * 1024);
+            m_running = true;
+            m_thread = std::thread([this]() { writerLoop(); });
+            g_async_active.store(true);
+        }
+
+        ~AsyncLogWriter() { stop(); }
+
+        /**
+         * @brief 写入一条记录（任意线程调用，不阻塞）
+         * @return 缓冲已满时返回 false
+         */
+        bool push(QtMsgType type, const QMessageLogContext &context, const QByteArray &msg) {
+            std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+            Slot *slot = nullptr;
+            for (;;) {
+                slot = &m_slots[pos & (kCapacity - 1)];
+                const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->timeMs = QDateTime::currentMSecsSinceEpoch();
+            const int written = qsnprintf(slot->text, kRecordBytes, "%s (%s:%u, %s)\n%s\n", typeName(type),
+                                          context.file ? context.file : "", context.line,
+                                          context.function ? context.function : "", msg.constData());
+            slot->length = qBound(0, written, kRecordBytes - 1);
+            if (written >= kRecordBytes) {
+                slot->text[kRecordBytes - 2] = '\n';  // 截断的记录仍以换行结束
+            }
+            slot->sequence.store(pos + 1, std::memory_order_release);
+
+            // 先发布槽位再置 pending：写线程清除 pending 之后的 drain 一定能看到这条记录
+            const bool urgent = type == QtWarningMsg || type == QtCriticalMsg;
+            if (urgent) {
+                m_urgent.store(true, std::memory_order_release);
+            }
+            if (!m_pending.exchange(true, std::memory_order_acq_rel) || urgent) {
+                wake();
+            }
+            return true;
+        }
+
+        /**
+         * @brief 停止写线程（写出缓冲中剩余的记录），之后的消息同步写出
+         */
+        void stop() {
+            if (!m_thread.joinable())
+                return;
+            g_async_active.store(false);
+            // 等待已决定异步写出的生产者完成 push，之后缓冲不再增长
+            while (g_inflight.load() > 0) {
+                std::this_thread::yield();
+            }
+            m_running = false;
+            wake();
+            m_thread.join();
+            drain();  // 写线程最后一次 drain 之后才写入的记录（写线程已退出，可在本线程读取）
+        }
+
+    private:
+        struct Slot {
+            std::atomic<std::size_t> sequence{0};
+            qint64 timeMs = 0;
+            int length = 0;
+            char text[kRecordBytes];
+        };
+
+        // 经过唤醒锁再通知：写线程检查条件与进入等待之间不会漏掉这次唤醒
+        void wake() {
+            { std::lock_guard<std::mutex> lock(m_wakeMutex); }
+            m_wake.notify_one();
+        }
+
+        void writerLoop() {
+            while (m_running) {
+                {
+                    std::unique_lock<std::mutex> lock(m_wakeMutex);
+                    // 除 pending 外再检查缓冲：生产者看到 pending 仍为 true 时不会唤醒，
+                    // 而这条记录可能在上一轮 drain 之后才发布
+                    m_wake.wait(lock, [this]() {
+                        return m_pending.load(std::memory_order_acquire) || hasReadyRecord() || !m_running;
+                    });
+                    if (m_running && !m_urgent.load(std::memory_order_acquire)) {
+                        m_wake.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs),
+                                        [this]() { return m_urgent.load(std::memory_order_acquire) || !m_running; });
+                    }
+                    m_urgent.store(false, std::memory_order_relaxed);
+                }
+                // 先清除再取出：exchange 与生产者置 pending 的 exchange 同步，清除之前发布的记录一定可见；
+                // 之后到达的记录会重新置 pending（或由上面的缓冲检查发现），进入下一轮
+                m_pending.exchange(false, std::memory_order_acq_rel);
+                drain();
+            }
+            drain();  // 停止前写出剩余记录（stop() 已先切换为同步写出）
+        }
+
+        // 缓冲头部是否有已发布、尚未取出的记录（只在写线程调用）
+        bool hasReadyRecord() const {
+            const Slot &slot = m_slots[m_dequeuePos & (kCapacity - 1)];
+            return slot.sequence.load(std::memory_order_acquire) == m_dequeuePos + 1;
+        }
+
+        void drain() {
+            m_batch.clear();
+            for (;;) {
+                Slot &slot = m_slots[m_dequeuePos & (kCapacity - 1)];
+                const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+                if (seq != m_dequeuePos + 1)
+                    break;
+
+                appendTimestamp(slot.timeMs);
+                m_batch.append(slot.text, slot.length);
+                slot.sequence.store(m_dequeuePos + kCapacity, std::memory_order_release);
+                ++m_dequeuePos;
+            }
 
-        QMutexLocker locker(&g_print_mutex);
-        fprintf(stderr, "%s %s (%s:%u, %s)\n",
+            const quint64 dropped = g_dropped.load(std::memory_order_relaxed);
+            if (dropped != m_reportedDropped) {
+                appendTimestamp(QDateTime::currentMSecsSinceEpoch());
+                m_batch.append("WARNING (logging)\n日志缓冲区已满，丢弃 ");
+                m_batch.append(QByteArray::number(dropped - m_reportedDropped));
+                m_batch.append(" 条消息\n");
+                m_reportedDropped = dropped;
+            }
+
+            if (!m_batch.isEmpty()) {
+                fwrite(m_batch.constData(), 1, static_cast<std::size_t>(m_batch.size()), stderr);
+                fflush(stderr);
+            }
+        }
+
+        // 同一秒内的记录复用已格式化的时间字符串
+        void appendTimestamp(qint64 timeMs) {
+            const qint64 second = timeMs / 1000;
+            if (second != m_cachedSecond) {
+                m_cachedSecond = second;
+                m_cachedTime = QDateTime::fromMSecsSinceEpoch(second * 1000).toString(Qt::ISODate).toUtf8();
+                m_cachedTime.append(' ');
+            }
+            m_batch.append(m_cachedTime);
+        }
+
+        std::unique_ptr<Slot[]> m_slots;
+        std::atomic<std::size_t> m_enqueuePos{0};
+        std::size_t m_dequeuePos = 0;  // 只由写线程访问
+
+        std::thread m_thread;
+        std::atomic_bool m_running{false};
+        std::atomic_bool m_pending{false};  // 缓冲中有写线程尚未取出的记录
+        std::atomic_bool m_urgent{false};   // 有警告以上的消息，立即写出
+        std::mutex m_wakeMutex;             // 只用于写线程的条件等待与唤醒
+        std::condition_variable m_wake;
+
+        QByteArray m_batch;
+        QByteArray m_cachedTime;
+        qint64 m_cachedSecond = -1;
+        quint64 m_reportedDropped = 0;
+    };
+
+    AsyncLogWriter &asyncWriter() {
+        static AsyncLogWriter writer;
+        return writer;
+    }
+
+    // 同步写出：写线程未运行时，以及致命错误前
+    void writeSynchronously(QtMsgType type, const QMessageLogContext &context, const QByteArray &msg) {
+        fprintf(stderr, "%s %s (%s:%u, %s)\n%s\n",
                 QDateTime::currentDateTime().toString(Qt::ISODate).toUtf8().constData(),
-                typeStr,
-                file,
+                typeName(type),
+                context.file ? context.file : "",
                 context.line,
-                function);
-        fprintf(stderr, "%s\n", localMsg.constData());
+                context.function ? context.function : "",
+                msg.constData());
         fflush(stderr);
+    }
+
+    // 开关以过滤规则的形式交给 QLoggingCategory：关闭的 debug 在格式化参数之前就被跳过，
+    // 不会到达消息处理程序（后写的规则优先；QT_LOGGING_RULES 环境变量仍可覆盖）
+    void applyFilterRules() {
+        const QString enabled = g_debug_enabled.load() ? "true" : "false";
+        QString rules = QString("default.debug=%1\ngame.*.debug=%1\n").arg(enabled);
+        for (auto it = g_category_overrides.cbegin(); it != g_category_overrides.cend(); ++it) {
+            rules += QString("game.%1.debug=%2\n").arg(it.key(), it.value() ? "true" : "false");
+        }
+        QLoggingCategory::setFilterRules(rules);
+    }
+
+    void defaultMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+        const QByteArray localMsg = msg.toLocal8Bit();
 
         if (type == QtFatalMsg) {
+            // 先写出缓冲中的记录，保证致命错误是最后一条
+            if (g_async_active.load()) {
+                asyncWriter().stop();
+            }
+            writeSynchronously(type, context, localMsg);
             abort();
         }
+
+        // 先登记再检查：stop() 关闭开关后会等待已登记的生产者写完
+        g_inflight.fetch_add(1);
+        if (!g_async_active.load()) {
+            g_inflight.fetch_sub(1);
+            writeSynchronously(type, context, localMsg);
+            return;
+        }
+        if (!asyncWriter().push(type, context, localMsg)) {
+            g_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        g_inflight.fetch_sub(1);
     }
 
 }  // anonymous namespace
@@ -64,16 +293,28 @@ namespace Logging {
 
     void initializeLogging(bool debugEnabled) {
         g_debug_enabled.store(debugEnabled);
-        // 安装自定义消息处理程序
+        applyFilterRules();
+        // 启动后台写线程，安装自定义消息处理程序
+        asyncWriter();
         qInstallMessageHandler(defaultMessageHandler);
     }
 
     void setDebugEnabled(bool enabled) {
         g_debug_enabled.store(enabled);
+        applyFilterRules();
+    }
+
+    void setCategoryDebugEnabled(const QString &name, bool enabled) {
+        g_category_overrides.insert(name, enabled);
+        applyFilterRules();
     }
 
     bool isDebugEnabled() {
         return g_debug_enabled.load();
     }
 
+    quint64 droppedMessageCount() {
+        return g_dropped.load();
+    }
+
 }  // namespace Logging
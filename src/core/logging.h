@@ -1,17 +1,34 @@
 #pragma once
 
 #include <QLoggingCategory>
+#include <QString>
 #include <atomic>
 
+// 日志分类：热路径使用 qCDebug(lcAi) 等，分类关闭时只判断一次开关，不会格式化参数。
+// 编译期最低级别由 CMake 的 GAME_LOG_MIN_LEVEL 决定（QT_NO_DEBUG_OUTPUT / QT_NO_INFO_OUTPUT 直接去掉调用）。
+Q_DECLARE_LOGGING_CATEGORY(lcAi)         // game.ai：敌人 AI、受伤与死亡
+Q_DECLARE_LOGGING_CATEGORY(lcCollision)  // game.collision：子弹、玩家受击、陷阱与拾取
+Q_DECLARE_LOGGING_CATEGORY(lcRoom)       // game.room：关卡、房间切换、门、宝箱与对话流程
+Q_DECLARE_LOGGING_CATEGORY(lcBoss)       // game.boss：Boss 技能、阶段与战斗流程
+Q_DECLARE_LOGGING_CATEGORY(lcAudio)      // game.audio：音效与音乐
+Q_DECLARE_LOGGING_CATEGORY(lcAssets)     // game.assets：配置与资源加载
+Q_DECLARE_LOGGING_CATEGORY(lcPlayer)     // game.player：玩家状态（护盾、无敌、黑心复活、属性变化）
+
 namespace Logging {
 
 // 初始化并安装消息处理程序。默认 debugEnabled=false（即关闭 qDebug）。
     void initializeLogging(bool debugEnabled = false);
 
-// 打开或关闭 debug 输出（控制 qDebug、qInfo 等类型为 debug 的输出）
+// 打开或关闭 debug 输出（未分类的 qDebug 和所有未单独设置的分类）
     void setDebugEnabled(bool enabled);
 
 // 查询当前 debug 是否开启
     bool isDebugEnabled();
 
+// 单独打开或关闭某个分类的 debug 输出（name 为 ai、collision、room、boss、audio、assets、player），优先于 setDebugEnabled
+    void setCategoryDebugEnabled(const QString &name, bool enabled);
+
+// 异步缓冲已满而丢弃的消息总数（消息由后台线程批量写出，调用线程不阻塞）
+    quint64 droppedMessageCount();
+
 }  // namespace Logging
@@ -0,0 +1,352 @@
+#include "objectcensus.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QEvent>
+#include <QMutexLocker>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+#include <algorithm>
+#include "gameclock.h"
+#include "gametimer.h"
+
+// Qt 的调试钩子表（定义见 Qt 私有头 qhooks_p.h，GammaRay 等工具使用同一接口）
+QT_BEGIN_NAMESPACE
+extern Q_DECL_IMPORT quintptr qtHookData[];
+QT_END_NAMESPACE
+
+namespace {
+    // 与 qhooks_p.h 中 QHooks::HookIndex 一致
+    constexpr int kHookAddQObject = 3;
+    constexpr int kHookRemoveQObject = 4;
+
+    using ObjectHook = void (*)(QObject *);
+
+    // 启用前已安装的钩子（其他调试工具），转发给它们
+    ObjectHook g_previousAdd = nullptr;
+    ObjectHook g_previousRemove = nullptr;
+
+    const char *const kOtherThreads = "(其他线程)";
+    const char *const kPooled = "(对象池)";
+
+    /**
+     * 具名常驻类：房间清空后合理地多于基线的对象，及各自容许的增长量。
+     * 它们的子对象（如掉落物、宝箱自己的 GameTimer）同样不参与定时器的精确比较。
+     */
+    struct RetainedClass {
+        const char *name;
+        int slack;
+    };
+
+    const RetainedClass kRetainedClasses[] = {
+            {"DroppedItem", 16},       // 房间中保存的掉落物
+            {"NormalChest", 4},        // 房间奖励宝箱
+            {"LockedChest", 4},
+            {"BossChest", 4},
+            {"Door", 4},               // 每个房间重新生成，数量随出口数变化
+            {"QGraphicsTextItem", 8},  // 清空提示等文字（按真实时间消失，快进时会多留一会）
+            {"EffectSystem", 1},       // 每个场景一个，首次使用时创建
+            {"FloatingTextLayer", 1},
+            {"QSoundEffect", 32},      // AudioManager 按音效缓存
+    };
+
+    // 常驻类的容许增长量，不是常驻类时返回 -1
+    int retainedSlack(const QString &className) {
+        for (const RetainedClass &retained : kRetainedClasses) {
+            if (className == QLatin1String(retained.name))
+                return retained.slack;
+        }
+        return -1;
+    }
+}
+
+// ==================== CensusSnapshot ====================
+
+QStringList CensusSnapshot::topClassNames(int limit) const {
+    QStringList names = byClass.keys();
+    std::stable_sort(names.begin(), names.end(),
+                     [this](const QString &a, const QString &b) { return byClass.value(a) > byClass.value(b); });
+    return names.mid(0, limit);
+}
+
+QJsonObject CensusSnapshot::toJson(int topClasses) const {
+    QJsonObject classes;
+    for (const QString &name : topClassNames(topClasses)) {
+        classes[name] = byClass.value(name);
+    }
+
+    QJsonObject result;
+    result["live_qobjects"] = liveObjects;
+    result["live_timers"] = liveTimers;
+    result["active_game_timers"] = activeGameTimers;
+    result["timer_wakeups_per_sec"] = timerWakeupsPerSec;
+    result["game_timer_fires_per_sec"] = gameTimerFiresPerSec;
+    result["by_class"] = classes;
+    result["tracked_timers"] = trackedTimers;
+    result["tracked_active_game_timers"] = trackedActiveGameTimers;
+
+    QJsonObject retained;
+    for (auto it = retainedByClass.cbegin(); it != retainedByClass.cend(); ++it) {
+        retained[it.key()] = it.value();
+    }
+    result["retained_by_class"] = retained;
+    return result;
+}
+
+QString CensusSnapshot::summary(int topClasses) const {
+    int retained = 0;
+    for (int count : retainedByClass) {
+        retained += count;
+    }
+    QString text = QString("QObject %1  定时器 %2（GameTimer 运行 %3）\n唤醒 %4/s  GameTimer 触发 %5/s\n"
+                           "常驻 %6  比较用定时器 %7（运行 %8）")
+                           .arg(liveObjects)
+                           .arg(liveTimers)
+                           .arg(activeGameTimers)
+                           .arg(timerWakeupsPerSec, 0, 'f', 0)
+                           .arg(gameTimerFiresPerSec, 0, 'f', 0)
+                           .arg(retained)
+                           .arg(trackedTimers)
+                           .arg(trackedActiveGameTimers);
+    for (const QString &name : topClassNames(topClasses)) {
+        text += QString("\n%1 %2").arg(name, -24).arg(byClass.value(name));
+    }
+    return text;
+}
+
+// ==================== ObjectCensus ====================
+
+ObjectCensus &ObjectCensus::instance() {
+    static ObjectCensus instance;
+    return instance;
+}
+
+ObjectCensus::~ObjectCensus() {
+    // 程序退出时恢复原钩子，之后销毁的对象不再访问已析构的登记表
+    if (m_enabled) {
+        qtHookData[kHookAddQObject] = reinterpret_cast<quintptr>(g_previousAdd);
+        qtHookData[kHookRemoveQObject] = reinterpret_cast<quintptr>(g_previousRemove);
+    }
+}
+
+void ObjectCensus::enable() {
+    if (m_enabled)
+        return;
+    if (!QCoreApplication::instance()) {
+        qWarning() << "ObjectCensus: 需要在 QApplication 创建之后启用";
+        return;
+    }
+
+    m_mainThread = QThread::currentThreadId();
+    g_previousAdd = reinterpret_cast<ObjectHook>(qtHookData[kHookAddQObject]);
+    g_previousRemove = reinterpret_cast<ObjectHook>(qtHookData[kHookRemoveQObject]);
+    qtHookData[kHookAddQObject] = reinterpret_cast<quintptr>(&ObjectCensus::onAddObject);
+    qtHookData[kHookRemoveQObject] = reinterpret_cast<quintptr>(&ObjectCensus::onRemoveObject);
+
+    QCoreApplication::instance()->installEventFilter(this);
+    m_enabled = true;
+    m_lastTimerEvents = 0;
+    m_lastGameTimerFires = GameTimer::totalFires();
+    m_sampleClock.start();
+}
+
+void ObjectCensus::onAddObject(QObject *object) {
+    ObjectCensus &census = instance();
+    {
+        QMutexLocker locker(&census.m_mutex);
+        census.m_live.insert(object, QThread::currentThreadId() == census.m_mainThread);
+    }
+    if (g_previousAdd)
+        g_previousAdd(object);
+}
+
+void ObjectCensus::onRemoveObject(QObject *object) {
+    ObjectCensus &census = instance();
+    {
+        QMutexLocker locker(&census.m_mutex);
+        census.m_live.remove(object);
+        census.m_pooled.remove(object);
+    }
+    if (g_previousRemove)
+        g_previousRemove(object);
+}
+
+void ObjectCensus::setRetained(QObject *object, bool retained) {
+    if (!m_enabled || !object)
+        return;
+    QMutexLocker locker(&m_mutex);
+    if (retained) {
+        m_pooled.insert(object);
+    } else {
+        m_pooled.remove(object);
+    }
+}
+
+bool ObjectCensus::eventFilter(QObject *watched, QEvent *event) {
+    if (event->type() == QEvent::Timer) {
+        m_timerEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+CensusSnapshot ObjectCensus::sample() {
+    CensusSnapshot snapshot;
+    if (!m_enabled)
+        return snapshot;
+
+    // 元对象 → 类别信息（类名、是否定时器、是否常驻类），每个类只解析一次；按值返回，插入不会使其失效
+    struct ClassInfo {
+        QString name;
+        bool timer = false;
+        bool gameTimer = false;
+        bool retained = false;
+    };
+    QHash<const QMetaObject *, ClassInfo> classes;
+    auto classOf = [&classes](const QObject *object) -> ClassInfo {
+        const QMetaObject *meta = object->metaObject();
+        auto it = classes.find(meta);
+        if (it == classes.end()) {
+            ClassInfo info;
+            info.name = QString::fromLatin1(meta->className());
+            info.gameTimer = meta->inherits(&GameTimer::staticMetaObject);
+            info.timer = info.gameTimer || meta->inherits(&QTimer::staticMetaObject);
+            info.retained = retainedSlack(info.name) >= 0;
+            it = classes.insert(meta, info);
+        }
+        return it.value();
+    };
+
+    // 对象是否属于常驻对象（自身或某个祖先是对象池中的空闲对象或常驻类），沿途结果缓存
+    QHash<QObject *, bool> inRetained;
+    QVector<QObject *> path;
+    auto isInRetained = [&](QObject *object) {
+        path.clear();
+        bool result = false;
+        for (QObject *o = object; o; o = o->parent()) {
+            auto it = inRetained.constFind(o);
+            if (it != inRetained.constEnd()) {
+                result = it.value();
+                break;
+            }
+            path.append(o);
+            if (m_pooled.contains(o) || classOf(o).retained) {
+                result = true;
+                break;
+            }
+        }
+        for (QObject *o : path) {
+            inRetained.insert(o, result);
+        }
+        return result;
+    };
+
+    int otherThreads = 0;
+    int retainedActiveGameTimers = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        snapshot.liveObjects = m_live.size();
+        for (auto it = m_live.cbegin(); it != m_live.cend(); ++it) {
+            // 只在主线程（即当前线程）创建的对象上调用虚函数，其他线程的对象可能正在析构
+            if (!it.value()) {
+                ++otherThreads;
+                continue;
+            }
+
+            QObject *object = it.key();
+            const ClassInfo info = classOf(object);
+            ++snapshot.byClass[info.name];
+            if (info.timer)
+                ++snapshot.liveTimers;
+
+            if (m_pooled.contains(object)) {
+                ++snapshot.retainedByClass[kPooled];
+            } else if (info.retained) {
+                ++snapshot.retainedByClass[info.name];
+            }
+
+            if (isInRetained(object)) {
+                if (info.gameTimer && static_cast<GameTimer *>(object)->isActive())
+                    ++retainedActiveGameTimers;
+                continue;
+            }
+            ++snapshot.trackedByClass[info.name];
+            if (info.timer)
+                ++snapshot.trackedTimers;
+        }
+    }
+    if (otherThreads > 0) {
+        snapshot.byClass[kOtherThreads] = otherThreads;
+    }
+    snapshot.activeGameTimers = GameClock::instance().activeTimerCount();
+    snapshot.trackedActiveGameTimers = snapshot.activeGameTimers - retainedActiveGameTimers;
+
+    const qint64 elapsedMs = m_sampleClock.restart();
+    const quint64 timerEvents = m_timerEvents.load(std::memory_order_relaxed);
+    const quint64 fires = GameTimer::totalFires();
+    if (elapsedMs > 0) {
+        snapshot.timerWakeupsPerSec = (timerEvents - m_lastTimerEvents) * 1000.0 / elapsedMs;
+        snapshot.gameTimerFiresPerSec = (fires - m_lastGameTimerFires) * 1000.0 / elapsedMs;
+    }
+    m_lastTimerEvents = timerEvents;
+    m_lastGameTimerFires = fires;
+    return snapshot;
+}
+
+QStringList ObjectCensus::checkpoint(const QString &label) {
+    QStringList grown;
+    if (!m_enabled)
+        return grown;
+
+    const CensusSnapshot now = sample();
+    if (!m_hasBaseline) {
+        m_baseline = now;
+        m_hasBaseline = true;
+        qInfo().noquote() << QString("ObjectCensus: %1 记录基线，QObject %2，定时器 %3（运行中的 GameTimer %4）")
+                                     .arg(label)
+                                     .arg(now.liveObjects)
+                                     .arg(now.trackedTimers)
+                                     .arg(now.trackedActiveGameTimers);
+        return grown;
+    }
+
+    // 定时器必须精确回到基线：每个房间多留一个定时器正是要查的泄漏
+    if (now.trackedTimers > m_baseline.trackedTimers) {
+        grown << QString("定时器 %1→%2").arg(m_baseline.trackedTimers).arg(now.trackedTimers);
+    }
+    if (now.trackedActiveGameTimers > m_baseline.trackedActiveGameTimers) {
+        grown << QString("运行中的 GameTimer %1→%2").arg(m_baseline.trackedActiveGameTimers).arg(now.trackedActiveGameTimers);
+    }
+
+    // 其他类逐类精确比较；常驻类按各自的容许量，对象池中的空闲对象有上限，不比较
+    for (auto it = now.trackedByClass.cbegin(); it != now.trackedByClass.cend(); ++it) {
+        const int before = m_baseline.trackedByClass.value(it.key());
+        if (it.value() > before) {
+            grown << QString("%1 %2→%3").arg(it.key()).arg(before).arg(it.value());
+        }
+    }
+    for (auto it = now.retainedByClass.cbegin(); it != now.retainedByClass.cend(); ++it) {
+        if (it.key() == QLatin1String(kPooled))
+            continue;
+        const int before = m_baseline.retainedByClass.value(it.key());
+        if (it.value() - before > retainedSlack(it.key())) {
+            grown << QString("%1 %2→%3（容许 +%4）").arg(it.key()).arg(before).arg(it.value()).arg(retainedSlack(it.key()));
+        }
+    }
+
+    if (grown.isEmpty()) {
+        qInfo().noquote() << QString("ObjectCensus: %1 已回到基线，QObject %2（基线 %3），定时器 %4（基线 %5）")
+                                     .arg(label)
+                                     .arg(now.liveObjects)
+                                     .arg(m_baseline.liveObjects)
+                                     .arg(now.trackedTimers)
+                                     .arg(m_baseline.trackedTimers);
+        return grown;
+    }
+
+    const QString message = QString("ObjectCensus: %1 对象数未回到基线：%2").arg(label, grown.join("，"));
+    if (m_assertOnLeak) {
+        qFatal("%s", message.toLocal8Bit().constData());
+    }
+    qWarning().noquote() << message;
+    return grown;
+}
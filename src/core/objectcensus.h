@@ -0,0 +1,129 @@
+#ifndef OBJECTCENSUS_H
+#define OBJECTCENSUS_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+
+/**
+ * @brief 一次对象普查的结果
+ */
+struct CensusSnapshot {
+    int liveObjects = 0;              // 存活的 QObject（自启用普查起创建的）
+    int liveTimers = 0;               // 其中 QTimer 与 GameTimer 实例数
+    int activeGameTimers = 0;         // GameClock 中正在运行的 GameTimer
+    double timerWakeupsPerSec = 0.0;  // 主线程每秒收到的 QTimerEvent（系统定时器唤醒）
+    double gameTimerFiresPerSec = 0.0;
+    QMap<QString, int> byClass;  // 类名 → 存活数量（其他线程创建的对象归入一项）
+
+    // 以下不含常驻对象（对象池中的空闲对象、具名常驻类）及其子对象，检查点据此与基线比较
+    int trackedTimers = 0;
+    int trackedActiveGameTimers = 0;
+    QMap<QString, int> trackedByClass;
+    QMap<QString, int> retainedByClass;  // 常驻对象按类计数（只计根对象，对象池中的归入一项）
+
+    /**
+     * @brief 导出为 JSON（by_class 只保留数量最多的 topClasses 个类）
+     */
+    [[nodiscard]] QJsonObject toJson(int topClasses = 20) const;
+
+    /**
+     * @brief 调试浮层用的多行文本
+     */
+    [[nodiscard]] QString summary(int topClasses = 8) const;
+
+    // 按数量从多到少排列的类名
+    [[nodiscard]] QStringList topClassNames(int limit) const;
+};
+
+/**
+ * @brief QObject / 定时器普查 - 统计存活对象、定时器和定时器唤醒次数
+ *
+ * 启用后通过 Qt 的对象钩子（qtHookData，调试工具使用的同一接口）登记每个 QObject 的创建与销毁，
+ * 只记录指针，统计时才按 metaObject() 分类（创建时子类构造函数尚未运行，类名不可用）。
+ * 主线程的 QTimerEvent 由应用级事件过滤器计数，GameTimer 触发次数来自 GameTimer::totalFires()。
+ *
+ * 浸泡测试：每关进入首个房间、生成敌人之前记录基线，之后每次清空房间调用 checkpoint() 与基线比较。
+ * 定时器数量（实例数和运行中的 GameTimer）必须精确回到基线；其他类逐类比较，只有具名常驻类
+ * （保存的掉落物、宝箱、门等，见 objectcensus.cpp）允许有限的增长。对象池中的空闲对象由对象池
+ * 通过 setRetained() 标记，不参与比较。超出时输出警告（setAssertOnLeak 时直接终止）。
+ * 未启用时不安装任何钩子，没有开销；基准测试中只在显式 --census 时启用，避免钩子计入测量。
+ */
+class ObjectCensus : public QObject {
+    Q_OBJECT
+
+public:
+    static ObjectCensus &instance();
+
+    /**
+     * @brief 安装对象钩子和事件过滤器（需在 QApplication 创建之后调用，之前创建的对象不计入）
+     */
+    void enable();
+
+    [[nodiscard]] bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief 统计当前存活对象，唤醒速率按距上次 sample() 的时间计算
+     */
+    CensusSnapshot sample();
+
+    /**
+     * @brief 房间清空检查点：没有基线时记录基线，之后与基线比较
+     * @return 超出基线的类别说明，为空表示已回到基线
+     */
+    QStringList checkpoint(const QString &label);
+
+    /**
+     * @brief 丢弃基线（进入新关卡时调用，各关的常驻对象不同）
+     */
+    void resetBaseline() { m_hasBaseline = false; }
+
+    [[nodiscard]] bool hasBaseline() const { return m_hasBaseline; }
+
+    void setAssertOnLeak(bool assertOnLeak) { m_assertOnLeak = assertOnLeak; }
+
+    /**
+     * @brief 标记对象池中的空闲对象（放回时 true，取出时 false），它及其子对象不参与检查点比较
+     */
+    void setRetained(QObject *object, bool retained);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    ObjectCensus() = default;
+
+    ~ObjectCensus() override;
+
+    ObjectCensus(const ObjectCensus &) = delete;
+
+    ObjectCensus &operator=(const ObjectCensus &) = delete;
+
+    static void onAddObject(QObject *object);
+
+    static void onRemoveObject(QObject *object);
+
+    QMutex m_mutex;                  // 保护 m_live 和 m_pooled（其他线程也会创建和销毁对象）
+    QHash<QObject *, bool> m_live;   // 对象 → 是否在主线程创建
+    QSet<QObject *> m_pooled;        // 对象池中的空闲对象
+    Qt::HANDLE m_mainThread = nullptr;
+    bool m_enabled = false;
+
+    std::atomic<quint64> m_timerEvents{0};
+    quint64 m_lastTimerEvents = 0;
+    quint64 m_lastGameTimerFires = 0;
+    QElapsedTimer m_sampleClock;
+
+    bool m_hasBaseline = false;
+    bool m_assertOnLeak = false;
+    CensusSnapshot m_baseline;
+};
+
+#endif // OBJECTCENSUS_H
@@ -8,6 +8,7 @@
 #include <QPixmap>
 #include <QString>
 #include "configmanager.h"
+#include "spritecache.h"
 
 /**
  * @brief 资源工厂类 - 封装各种图形资源的创建和加载
@@ -39,20 +40,49 @@ public:
 
     /**
      * @brief 从文件加载图片并缩放到指定尺寸
+     * 结果会缓存进 SpriteCache，同一路径和尺寸的图片只解码、缩放一次
      * @param filePath 图片文件路径
-     * @param width 目标宽度
-     * @param height 目标高度
+     * @param width 目标宽度（<=0 表示保持原始尺寸）
+     * @param height 目标高度（<=0 表示保持原始尺寸）
+     * @param mode 缩放时的宽高比模式
      * @return 缩放后的QPixmap
      * @throws QString 加载失败时抛出错误信息
      */
-    static QPixmap loadImageScaled(const QString &filePath, int width, int height) {
+    static QPixmap loadImageScaled(const QString &filePath, int width, int height,
+                                   Qt::AspectRatioMode mode = Qt::KeepAspectRatio) {
+        const QString key = SpriteCache::makeKey(filePath, width, height, mode);
+        QPixmap cached = SpriteCache::instance().sprite(key);
+        if (!cached.isNull()) {
+            return cached;
+        }
+
         QPixmap pixmap = loadImage(filePath);
-        if (pixmap.width() != width || pixmap.height() != height) {
-            return pixmap.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        if (width > 0 && height > 0 && (pixmap.width() != width || pixmap.height() != height)) {
+            pixmap = pixmap.scaled(width, height, mode, Qt::SmoothTransformation);
         }
+        SpriteCache::instance().add(key, pixmap);
         return pixmap;
     }
 
+    /**
+     * @brief 加载精灵图片（经过精灵缓存），失败时返回空QPixmap而不抛出错误
+     * 用于调用方自带占位图回退逻辑的场合
+     * @param filePath 图片文件路径
+     * @param width 目标宽度（<=0 表示保持原始尺寸）
+     * @param height 目标高度（<=0 表示保持原始尺寸）
+     */
+    static QPixmap tryLoadSprite(const QString &filePath, int width = 0, int height = 0,
+                                 Qt::AspectRatioMode mode = Qt::KeepAspectRatio) {
+        if (!QFile::exists(filePath)) {
+            return QPixmap();
+        }
+        try {
+            return loadImageScaled(filePath, width, height, mode);
+        } catch (const QString &) {
+            return QPixmap();
+        }
+    }
+
     /**
      * @brief 加载玩家图像
      * @throws QString 加载失败时抛出错误信息
@@ -142,13 +172,20 @@ public:
             imagePath = ConfigManager::instance().getAssetPath("enemy");
         }
 
+        const QString key = SpriteCache::makeKey(imagePath, maxSize, maxSize) + "#hr";
+        QPixmap cached = SpriteCache::instance().sprite(key);
+        if (!cached.isNull()) {
+            return cached;
+        }
+
         QPixmap pixmap = loadImage(imagePath);
 
         // 如果指定了maxSize且图片超过该尺寸，则缩小到maxSize（保持高质量）
         if (maxSize > 0 && (pixmap.width() > maxSize || pixmap.height() > maxSize)) {
-            return pixmap.scaled(maxSize, maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            pixmap = pixmap.scaled(maxSize, maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
         }
 
+        SpriteCache::instance().add(key, pixmap);
         return pixmap;
     }
 
@@ -0,0 +1,78 @@
+#include "spritecache.h"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include "configmanager.h"
+#include "logging.h"
+#include "resourcefactory.h"
+
+SpriteCache &SpriteCache::instance() {
+    static SpriteCache instance;
+    return instance;
+}
+
+QString SpriteCache::makeKey(const QString &path, int width, int height, Qt::AspectRatioMode mode) {
+    QString key = QString("%1@%2x%3").arg(path).arg(qMax(0, width)).arg(qMax(0, height));
+    if (mode == Qt::IgnoreAspectRatio) {
+        key += '!';
+    }
+    return key;
+}
+
+void SpriteCache::clear() {
+    m_sprites.clear();
+    m_levelNumber = -1;
+}
+
+void SpriteCache::buildForLevel(int levelNumber) {
+    if (levelNumber == m_levelNumber && !m_sprites.isEmpty())
+        return;
+
+    clear();
+    m_levelNumber = levelNumber;
+
+    // 以下调用会把图片载入缓存（ResourceFactory 在未命中时自动加入）
+    ConfigManager &config = ConfigManager::instance();
+
+    // 玩家子弹
+    int bulletSize = config.getBulletSize("player");
+    if (bulletSize <= 0)
+        bulletSize = 20;
+    ResourceFactory::tryLoadSprite(config.getAssetPath("bullet"), bulletSize, bulletSize);
+    ResourceFactory::tryLoadSprite("assets/items/bullet_frost.png", 20, 20);
+
+    // 宝箱
+    ResourceFactory::tryLoadSprite("assets/chest/chest.png", 50, 50);
+    ResourceFactory::tryLoadSprite("assets/chest/chest_up.png", 50, 50);
+    ResourceFactory::tryLoadSprite("assets/chest/chest_boss.png", 50, 50);
+
+    // 爆炸帧（保持原始尺寸）
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            ResourceFactory::tryLoadSprite(QString("assets/explosion/cell_%1_%2.png").arg(i).arg(j));
+        }
+    }
+
+    // 本关卡的普通敌人（与 RoomManager::spawnEnemiesInRoom 使用相同的尺寸）
+    QDir enemyDir(QString("assets/enemy/level_%1").arg(levelNumber));
+    const QStringList enemyFiles = enemyDir.entryList(QStringList() << "*.png", QDir::Files);
+    for (const QString &fileName : enemyFiles) {
+        QString enemyType = QFileInfo(fileName).completeBaseName();
+        int enemySize = config.getEntitySize("enemies", enemyType);
+        if (enemySize <= 0)
+            enemySize = 40;
+        ResourceFactory::tryLoadSprite(enemyDir.filePath(fileName), enemySize, enemySize);
+    }
+
+    qCDebug(lcAssets) << "关卡" << levelNumber << "精灵缓存预热完成，精灵数:" << m_sprites.size();
+}
+
+void SpriteCache::add(const QString &key, const QPixmap &pixmap) {
+    if (pixmap.isNull() || m_sprites.contains(key))
+        return;
+    m_sprites.insert(key, pixmap);
+}
+
+QPixmap SpriteCache::sprite(const QString &key) const {
+    return m_sprites.value(key);
+}
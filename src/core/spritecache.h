@@ -0,0 +1,61 @@
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+#include <QHash>
+#include <QPixmap>
+#include <QString>
+
+/**
+ * @brief 运行时精灵缓存 - 关卡加载时预热本关卡用到的精灵
+ *
+ * 精灵以 (路径, 目标尺寸) 为键，每个键只解码和缩放一次，之后所有使用者共享同一份像素数据（隐式共享）。
+ * ResourceFactory 优先从这里取图，重复生成同一种敌人/子弹/宝箱时不再解码和缩放原图。
+ * 不把精灵再拼进大图：场景图元各自持有 QPixmap，拼图只会让每个精灵多存一份。
+ */
+class SpriteCache {
+public:
+    static SpriteCache &instance();
+
+    /**
+     * @brief 为指定关卡预热精灵缓存（切换关卡时清空旧缓存）
+     */
+    void buildForLevel(int levelNumber);
+
+    /**
+     * @brief 清空精灵缓存
+     */
+    void clear();
+
+    /**
+     * @brief 加入一个精灵，已存在时保留原有的
+     */
+    void add(const QString &key, const QPixmap &pixmap);
+
+    /**
+     * @brief 获取精灵QPixmap（隐式共享，所有使用者共用同一份像素数据）
+     * @return 未缓存时返回空QPixmap
+     */
+    [[nodiscard]] QPixmap sprite(const QString &key) const;
+
+    [[nodiscard]] int spriteCount() const { return m_sprites.size(); }
+
+    /**
+     * @brief 生成精灵键
+     * @param width 目标宽度，<=0 表示保持原始尺寸
+     * @param height 目标高度，<=0 表示保持原始尺寸
+     */
+    static QString makeKey(const QString &path, int width = 0, int height = 0,
+                           Qt::AspectRatioMode mode = Qt::KeepAspectRatio);
+
+private:
+    SpriteCache() = default;
+
+    SpriteCache(const SpriteCache &) = delete;
+
+    SpriteCache &operator=(const SpriteCache &) = delete;
+
+    QHash<QString, QPixmap> m_sprites;
+    int m_levelNumber = -1;
+};
+
+#endif // SPRITECACHE_H
@@ -0,0 +1,105 @@
+#include "spritevariantcache.h"
+#include <QPainter>
+#include <QTransform>
+
+namespace {
+const QColor kFlashTint(255, 0, 0, 180);  // 受击闪烁颜色
+const int kCacheLimitKB = 32 * 1024;      // 每种变体最多缓存32MB
+const double kMipScales[SpriteVariantCache::kMipLevelCount] = {1.0, 0.75, 0.5};
+}  // namespace
+
+SpriteVariantCache &SpriteVariantCache::instance() {
+    static SpriteVariantCache instance;
+    return instance;
+}
+
+SpriteVariantCache::SpriteVariantCache() {
+    m_flashVariants.setMaxCost(kCacheLimitKB);
+    m_mirrored.setMaxCost(kCacheLimitKB);
+    m_scaled.setMaxCost(kCacheLimitKB);
+}
+
+int SpriteVariantCache::costOf(const QPixmap &pixmap) {
+    return qMax(1, pixmap.width() * pixmap.height() * 4 / 1024);
+}
+
+QPixmap SpriteVariantCache::flashVariant(const QPixmap &source) {
+    if (source.isNull())
+        return source;
+
+    const qint64 key = source.cacheKey();
+    if (QPixmap *cached = m_flashVariants.object(key))
+        return *cached;
+
+    QPixmap flashPixmap = source;
+    QPainter painter(&flashPixmap);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+    painter.fillRect(flashPixmap.rect(), kFlashTint);
+    painter.end();
+
+    m_flashVariants.insert(key, new QPixmap(flashPixmap), costOf(flashPixmap));
+    return flashPixmap;
+}
+
+QPixmap SpriteVariantCache::mirrored(const QPixmap &source) {
+    if (source.isNull())
+        return source;
+
+    const qint64 key = source.cacheKey();
+    if (QPixmap *cached = m_mirrored.object(key))
+        return *cached;
+
+    QPixmap flipped = source.transformed(QTransform().scale(-1, 1));
+
+    // 双向登记：再次镜像时直接得到原图，保证 cacheKey 稳定
+    m_mirrored.insert(key, new QPixmap(flipped), costOf(flipped));
+    m_mirrored.insert(flipped.cacheKey(), new QPixmap(source), costOf(source));
+    return flipped;
+}
+
+double SpriteVariantCache::mipScale(int level) {
+    return kMipScales[qBound(0, level, kMipLevelCount - 1)];
+}
+
+QPixmap SpriteVariantCache::scaledVariant(const QPixmap &source, double factor) {
+    if (source.isNull() || qFuzzyCompare(factor, 1.0))
+        return source;
+
+    const QPair<qint64, int> key(source.cacheKey(), qRound(factor * 1000.0));
+    if (QPixmap *cached = m_scaled.object(key))
+        return *cached;
+
+    int width = qMax(1, qRound(source.width() * factor));
+    int height = qMax(1, qRound(source.height() * factor));
+    QPixmap scaled = source.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    m_scaled.insert(key, new QPixmap(scaled), costOf(scaled));
+    return scaled;
+}
+
+QPixmap SpriteVariantCache::mipLevel(const QPixmap &source, int level) {
+    return scaledVariant(source, mipScale(level));
+}
+
+SpriteVariantCache::MipSelection SpriteVariantCache::selectMip(const QPixmap &source, double displayScale) {
+    // 选择不小于目标比例的最小一级：只做缩小方向的残余缩放，避免放大模糊
+    int level = 0;
+    for (int i = kMipLevelCount - 1; i > 0; --i) {
+        if (displayScale <= kMipScales[i]) {
+            level = i;
+            break;
+        }
+    }
+
+    MipSelection selection;
+    selection.level = level;
+    selection.pixmap = mipLevel(source, level);
+    selection.residualScale = displayScale / kMipScales[level];
+    return selection;
+}
+
+void SpriteVariantCache::clear() {
+    m_flashVariants.clear();
+    m_mirrored.clear();
+    m_scaled.clear();
+}
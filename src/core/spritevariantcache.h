@@ -0,0 +1,77 @@
+#ifndef SPRITEVARIANTCACHE_H
+#define SPRITEVARIANTCACHE_H
+
+#include <QCache>
+#include <QColor>
+#include <QPair>
+#include <QPixmap>
+
+/**
+ * @brief 精灵变体缓存 - 受击闪烁色、水平镜像等派生图片只生成一次
+ *
+ * 以源图片的 QPixmap::cacheKey() 为键。镜像会双向登记（镜像的镜像返回原图本身），
+ * 因此实体来回转向时图片的 cacheKey 保持稳定，两个朝向的闪烁图也都只生成一次。
+ *
+ * 对运行时持续缩放的精灵还提供一条小的 mip 链（1x / 0.75x / 0.5x），
+ * 渲染时选用不小于目标比例的最近一级，剩余的缩放量很小，低质量采样也足够清晰。
+ */
+class SpriteVariantCache {
+public:
+    static SpriteVariantCache &instance();
+
+    static constexpr int kMipLevelCount = 3;
+
+    /**
+     * @brief mip 选择结果
+     */
+    struct MipSelection {
+        QPixmap pixmap;             // 选中的 mip 图片
+        int level = 0;              // mip 级别（0 = 原图）
+        double residualScale = 1.0; // 仍需通过 setScale 施加的缩放
+    };
+
+    /**
+     * @brief 获取 mip 链中指定级别的图片（0 = 原图，1 = 0.75x，2 = 0.5x）
+     */
+    QPixmap mipLevel(const QPixmap &source, int level);
+
+    /**
+     * @brief 根据目标显示比例选择最合适的 mip 级别
+     * @param displayScale 相对原图的显示比例
+     */
+    MipSelection selectMip(const QPixmap &source, double displayScale);
+
+    /**
+     * @brief 获取按固定倍数缩放后的图片（例如大招放大的子弹）
+     */
+    QPixmap scaledVariant(const QPixmap &source, double factor);
+
+    static double mipScale(int level);
+
+    /**
+     * @brief 获取受击闪烁用的红色图片
+     */
+    QPixmap flashVariant(const QPixmap &source);
+
+    /**
+     * @brief 获取水平镜像图片
+     */
+    QPixmap mirrored(const QPixmap &source);
+
+    void clear();
+
+private:
+    SpriteVariantCache();
+
+    SpriteVariantCache(const SpriteVariantCache &) = delete;
+
+    SpriteVariantCache &operator=(const SpriteVariantCache &) = delete;
+
+    static int costOf(const QPixmap &pixmap);  // 以KB计的缓存开销
+
+    QCache<qint64, QPixmap> m_flashVariants;
+    QCache<qint64, QPixmap> m_mirrored;
+    QCache<QPair<qint64, int>, QPixmap> m_scaled;  // 键：(源图, 缩放千分比)，mip 链也存于此
+};
+
+#endif // SPRITEVARIANTCACHE_H
@@ -0,0 +1,204 @@
+#include "timerwheel.h"
+#include <algorithm>
+
+TimerWheel &TimerWheel::instance() {
+    static TimerWheel instance;
+    return instance;
+}
+
+TimerWheel::TimerWheel() {
+    m_level0.fill(-1);
+    m_level1.fill(-1);
+    m_level2.fill(-1);
+}
+
+TimerHandle TimerWheel::scheduleCallback(QObject *owner, int delayMs, std::function<void()> callback) {
+    if (!callback)
+        return {};
+
+    if (!m_tickConnection) {
+        m_tickConnection = QObject::connect(&GameClock::instance(), &GameClock::tick, &GameClock::instance(),
+                                            [](int dtMs) { TimerWheel::instance().advance(dtMs); });
+    }
+
+    int index = allocate();
+    Node &node = m_nodes[index];
+    node.callback = std::move(callback);
+    node.owner = owner;
+    node.hasOwner = owner != nullptr;
+    node.sequence = m_nextSequence++;
+
+    // 向上取整到节拍，且至少在下一拍执行（与 singleShot 一样不会在调用栈内同步执行）
+    const qint64 dueMs = m_nowMs + qMax(0, delayMs);
+    node.dueTick = qMax(m_currentTick + 1, (dueMs + kSlotMs - 1) / kSlotMs);
+    insert(index);
+
+    return {index, node.generation};
+}
+
+bool TimerWheel::cancel(TimerHandle &handle) {
+    const bool pending = isPending(handle);
+    if (pending) {
+        unlink(handle.index);
+        release(handle.index);
+    }
+    handle = TimerHandle();
+    return pending;
+}
+
+bool TimerWheel::isPending(const TimerHandle &handle) const {
+    if (handle.index < 0 || handle.index >= m_nodes.size())
+        return false;
+    const Node &node = m_nodes[handle.index];
+    return node.inUse && node.generation == handle.generation;
+}
+
+void TimerWheel::clear() {
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        if (m_nodes[i].inUse) {
+            unlink(i);
+            release(i);
+        }
+    }
+    m_firing.clear();
+}
+
+int TimerWheel::allocate() {
+    int index;
+    if (!m_freeList.isEmpty()) {
+        index = m_freeList.takeLast();
+    } else {
+        index = m_nodes.size();
+        m_nodes.append(Node());
+    }
+    m_nodes[index].inUse = true;
+    ++m_pendingCount;
+    return index;
+}
+
+void TimerWheel::release(int index) {
+    Node &node = m_nodes[index];
+    node.callback = nullptr;
+    node.owner = nullptr;
+    node.hasOwner = false;
+    node.inUse = false;
+    ++node.generation;  // 使旧句柄失效
+    m_freeList.append(index);
+    --m_pendingCount;
+}
+
+void TimerWheel::insert(int index) {
+    Node &node = m_nodes[index];
+    qint64 delta = node.dueTick - m_currentTick;
+
+    int *bucket;
+    if (delta < kLevel0Size) {
+        bucket = &m_level0[node.dueTick & (kLevel0Size - 1)];
+    } else if (delta < kLevel1Limit) {
+        bucket = &m_level1[(node.dueTick >> kLevel0Bits) & (kLevelSize - 1)];
+    } else {
+        if (delta >= kLevel2Limit) {
+            node.dueTick = m_currentTick + kLevel2Limit - 1;
+        }
+        bucket = &m_level2[(node.dueTick >> (kLevel0Bits + kLevelBits)) & (kLevelSize - 1)];
+    }
+
+    node.bucket = bucket;
+    node.prev = -1;
+    node.next = *bucket;
+    if (*bucket >= 0) {
+        m_nodes[*bucket].prev = index;
+    }
+    *bucket = index;
+}
+
+void TimerWheel::unlink(int index) {
+    Node &node = m_nodes[index];
+    if (!node.bucket)
+        return;
+
+    if (node.prev >= 0) {
+        m_nodes[node.prev].next = node.next;
+    } else {
+        *node.bucket = node.next;
+    }
+    if (node.next >= 0) {
+        m_nodes[node.next].prev = node.prev;
+    }
+    node.prev = -1;
+    node.next = -1;
+    node.bucket = nullptr;
+}
+
+void TimerWheel::cascade(int *bucket) {
+    int index = *bucket;
+    *bucket = -1;
+    while (index >= 0) {
+        int next = m_nodes[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+void TimerWheel::advance(int dtMs) {
+    m_nowMs += dtMs;
+    const qint64 targetTick = m_nowMs / kSlotMs;
+    while (m_currentTick < targetTick) {
+        processTick(m_currentTick + 1);
+    }
+}
+
+void TimerWheel::processTick(qint64 tick) {
+    m_currentTick = tick;
+
+    // 第0层转完一圈时，先把上层对应格子的节点分配下来
+    if ((tick & (kLevel0Size - 1)) == 0) {
+        const qint64 level1Index = tick >> kLevel0Bits;
+        if ((level1Index & (kLevelSize - 1)) == 0) {
+            cascade(&m_level2[(tick >> (kLevel0Bits + kLevelBits)) & (kLevelSize - 1)]);
+        }
+        cascade(&m_level1[level1Index & (kLevelSize - 1)]);
+    }
+
+    int &bucket = m_level0[tick & (kLevel0Size - 1)];
+    if (bucket < 0)
+        return;
+
+    // 先摘下整格，回调中新调度的节点不会在本拍执行；
+    // 取出复用缓冲，回调中开启嵌套事件循环重入时也不会互相覆盖
+    QVector<QPair<int, quint32>> firing;
+    firing.swap(m_firing);
+    firing.clear();
+    for (int index = bucket; index >= 0; index = m_nodes[index].next) {
+        firing.append({index, m_nodes[index].generation});
+    }
+    for (const auto &entry : firing) {
+        Node &node = m_nodes[entry.first];
+        node.bucket = nullptr;
+        node.prev = -1;
+        node.next = -1;
+    }
+    bucket = -1;
+
+    // 格子链表按插入逆序排列，上层分配下来的节点又在其后插入；按调度序号恢复先进先出
+    if (firing.size() > 1) {
+        std::sort(firing.begin(), firing.end(), [this](const QPair<int, quint32> &a, const QPair<int, quint32> &b) {
+            return m_nodes[a.first].sequence < m_nodes[b.first].sequence;
+        });
+    }
+
+    for (const auto &entry : firing) {
+        Node &node = m_nodes[entry.first];
+        if (!node.inUse || node.generation != entry.second)
+            continue;  // 已被前面的回调取消
+
+        std::function<void()> callback = std::move(node.callback);
+        const bool ownerAlive = !node.hasOwner || node.owner;
+        release(entry.first);
+
+        if (ownerAlive) {
+            callback();
+        }
+    }
+    m_firing.swap(firing);
+}
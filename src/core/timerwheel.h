@@ -0,0 +1,128 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <array>
+#include <functional>
+#include <type_traits>
+#include "gameclock.h"
+
+/**
+ * @brief 延迟回调句柄，可用于取消；过期或取消后自动失效
+ */
+struct TimerHandle {
+    int index = -1;
+    quint32 generation = 0;
+
+    [[nodiscard]] bool isNull() const { return index < 0; }
+};
+
+/**
+ * @brief 分层时间轮 - 运行在游戏时间域上的延迟回调
+ *
+ * 替代游戏逻辑中的 QTimer::singleShot：不创建 Qt 定时器对象，
+ * 节点从对象池分配，调度与取消都是 O(1)。
+ * 由 GameClock::tick 推进，因此暂停、慢动作和快进对延迟回调同样生效。
+ * 回调可绑定一个所有者对象，所有者销毁后回调不会执行（与 singleShot 的上下文对象一致）。
+ * 同一节拍到期的回调按调度顺序执行（与依次调用的 singleShot 一致）。
+ *
+ * 三层时间轮，精度为一个时钟节拍（16ms）：
+ * 第0层 256 格（约4秒），第1层 64 格（约4.4分钟），第2层 64 格（约4.7小时），
+ * 更远的延迟按最大值处理。
+ */
+class TimerWheel {
+public:
+    static TimerWheel &instance();
+
+    static constexpr int kSlotMs = GameClock::kTickIntervalMs;
+
+    /**
+     * @brief 在 delayMs 毫秒（游戏时间）后执行回调
+     * @param owner 所有者对象，为空时回调不绑定生命周期
+     * @param callback 可调用对象，或 owner 类的无参成员函数指针
+     */
+    template<typename Owner, typename Callback>
+    TimerHandle schedule(Owner *owner, int delayMs, Callback &&callback) {
+        if constexpr (std::is_member_function_pointer_v<std::decay_t<Callback>>) {
+            return scheduleCallback(owner, delayMs, [owner, callback]() { (owner->*callback)(); });
+        } else {
+            return scheduleCallback(owner, delayMs, std::function<void()>(std::forward<Callback>(callback)));
+        }
+    }
+
+    /**
+     * @brief 取消尚未执行的回调，并将句柄置空
+     * @return 回调仍在等待中并被取消时返回 true
+     */
+    bool cancel(TimerHandle &handle);
+
+    [[nodiscard]] bool isPending(const TimerHandle &handle) const;
+
+    [[nodiscard]] int pendingCount() const { return m_pendingCount; }
+
+    /**
+     * @brief 丢弃所有等待中的回调（重新开始游戏时调用）
+     */
+    void clear();
+
+private:
+    TimerWheel();
+
+    TimerWheel(const TimerWheel &) = delete;
+
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    static constexpr int kLevel0Bits = 8;
+    static constexpr int kLevelBits = 6;
+    static constexpr int kLevel0Size = 1 << kLevel0Bits;
+    static constexpr int kLevelSize = 1 << kLevelBits;
+    static constexpr qint64 kLevel1Limit = qint64(1) << (kLevel0Bits + kLevelBits);      // 第1层可容纳的最大延迟（节拍）
+    static constexpr qint64 kLevel2Limit = qint64(1) << (kLevel0Bits + kLevelBits * 2);  // 第2层可容纳的最大延迟（节拍）
+
+    struct Node {
+        std::function<void()> callback;
+        QPointer<QObject> owner;
+        bool hasOwner = false;
+        qint64 dueTick = 0;
+        quint64 sequence = 0;  // 调度序号，同一节拍到期的回调按它排序
+        quint32 generation = 0;
+        int prev = -1;
+        int next = -1;
+        int *bucket = nullptr;  // 所在格子的链表头，不在格子中时为 nullptr
+        bool inUse = false;
+    };
+
+    TimerHandle scheduleCallback(QObject *owner, int delayMs, std::function<void()> callback);
+
+    int allocate();
+
+    void release(int index);
+
+    void insert(int index);
+
+    void unlink(int index);
+
+    // 把上层一格中的节点重新分配到下层
+    void cascade(int *bucket);
+
+    void advance(int dtMs);
+
+    void processTick(qint64 tick);
+
+    QVector<Node> m_nodes;
+    QVector<int> m_freeList;
+    // 每格为双向链表头（节点下标），-1 表示空
+    std::array<int, kLevel0Size> m_level0{};
+    std::array<int, kLevelSize> m_level1{};
+    std::array<int, kLevelSize> m_level2{};
+    qint64 m_nowMs = 0;        // 已推进到的游戏时间
+    qint64 m_currentTick = 0;  // 已处理到的节拍
+    int m_pendingCount = 0;
+    quint64 m_nextSequence = 0;
+    QVector<QPair<int, quint32>> m_firing;  // 本拍到期的节点（复用缓冲）
+    QMetaObject::Connection m_tickConnection;
+};
+
+#endif // TIMERWHEEL_H
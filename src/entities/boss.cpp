@@ -1,4 +1,5 @@
 #include "boss.h"
+#include "../core/logging.h"
 
 Boss::Boss(const QPixmap& pic, double scale)
     : Enemy(pic, scale) {
@@ -17,7 +18,7 @@ Boss::Boss(const QPixmap& pic, double scale)
 }
 
 Boss::~Boss() {
-    // qDebug() <<"Boss被击败！";
+    // qCDebug(lcBoss) <<"Boss被击败！";
 }
 
 // 重写边界框以包含血条区域
@@ -1,11 +1,15 @@
 #include "enemy.h"
-#include <QDateTime>
 #include <QDebug>
 #include <QPainter>
 #include <QRandomGenerator>
 #include <QtMath>
 #include "../core/audiomanager.h"
-#include "../ui/explosion.h"
+#include "../core/logging.h"
+#include "../ui/effectsystem.h"
+#include "../world/aisystem.h"
+#include "../world/crowdsystem.h"
+#include "../world/enemypool.h"
+#include "../world/flowfield.h"
 #include "player.h"
 
 Enemy::Enemy(const QPixmap& pic, double scale)
@@ -33,11 +37,23 @@ Enemy::Enemy(const QPixmap& pic, double scale)
       m_preferredDistance(150.0),
       m_diagonalDirection(1),
       m_isSummoned(false),
-      m_isPaused(false) {
+      m_isPaused(false),
+      m_aiEnabled(false),
+      m_aiSlot(-1),
+      m_aiElapsedMs(AISystem::kStepMs),
+      m_toPlayerX(0.0),
+      m_toPlayerY(0.0),
+      m_playerDistSq(0.0),
+      m_playerDist(0.0),
+      m_crowdSlot(-1),
+      m_separationX(0.0),
+      m_separationY(0.0) {
     // 设置图像
     setPixmap(pic.scaled(pic.width() * scale, pic.height() * scale,
                          Qt::KeepAspectRatio, Qt::SmoothTransformation));
 
+    registerKind(EntityKind::Enemy);
+
     // 设置基础属性
     speed = 2.0;
     hurt = contactDamage;
@@ -57,28 +73,24 @@ Enemy::Enemy(const QPixmap& pic, double scale)
     // 初始化随机漫游点
     wanderTarget = getRandomWanderPoint();
 
-    // AI更新定时器
-    aiTimer = new QTimer(this);
-    connect(aiTimer, &QTimer::timeout, this, &Enemy::updateAI);
-    aiTimer->start(100);
+    // AI 由 AISystem 统一批量更新（每100ms一步，远处敌人降频）
+    setAIEnabled(true);
+    CrowdSystem::instance().ensureTicking();
 
     // 移动定时器 (每20ms移动一次)
-    moveTimer = new QTimer(this);
-    connect(moveTimer, &QTimer::timeout, this, &Enemy::move);
+    moveTimer = new GameTimer(this);
+    connect(moveTimer, &GameTimer::timeout, this, &Enemy::move);
     moveTimer->start(20);
 
     // 攻击检测定时器
-    attackTimer = new QTimer(this);
-    connect(attackTimer, &QTimer::timeout, this, &Enemy::tryAttack);
+    attackTimer = new GameTimer(this);
+    connect(attackTimer, &GameTimer::timeout, this, &Enemy::tryAttack);
     attackTimer->start(100);
 }
 
 Enemy::~Enemy() {
-    if (aiTimer) {
-        aiTimer->stop();
-        delete aiTimer;
-        aiTimer = nullptr;
-    }
+    AISystem::instance().remove(this);
+    CrowdSystem::instance().forget(this);
     if (moveTimer) {
         moveTimer->stop();
         delete moveTimer;
@@ -98,53 +110,55 @@ void Enemy::getEffects() {
         return;
 
     int type = QRandomGenerator::global()->bounded(4);
-    StatusEffect* effect = nullptr;
 
+    // 50% 概率应用效果
+    if (QRandomGenerator::global()->bounded(2) != 0)
+        return;
+
+    EffectManager& effects = EffectManager::instance();
     switch (type) {
         case 0: {
-            // 防止中毒效果在delete后施加
+            // 中毒时长不超过玩家当前血量
             int duration = (3 > player->getCurrentHealth() * 2 ? (int)player->getCurrentHealth() : 3);
-            effect = new PoisonEffect(player, duration, 1);
+            effects.apply(player, StatusEffectType::Poison, 1, duration);
             break;
         }
         case 1:
-            effect = new SpeedEffect(5, 0.5);
+            effects.apply(player, StatusEffectType::Speed, 0.5, 5);
             break;
         case 2:
-            effect = new DamageEffect(5, 0.5);
+            effects.apply(player, StatusEffectType::Damage, 0.5, 5);
             break;
         case 3:
-            effect = new shootSpeedEffect(5, 0.5);
+            effects.apply(player, StatusEffectType::ShootSpeed, 0.5, 5);
             break;
     }
+}
 
-    // 50% 概率应用效果
-    if (QRandomGenerator::global()->bounded(2) == 0) {
-        if (effect) {
-            effect->applyTo(player);
-            // effect会在expire()中调用deleteLater()自我销毁
-        }
+void Enemy::setAIEnabled(bool enabled) {
+    m_aiEnabled = enabled;
+    if (enabled) {
+        AISystem::instance().add(this);
     } else {
-        // 如果未选中应用，需要手动删除创建的对象
-        if (effect) {
-            delete effect;
-        }
+        AISystem::instance().remove(this);
     }
 }
 
-void Enemy::updateAI() {
-    if (!scene())
-        return;
+void Enemy::setPlayerVector(double dx, double dy, double distSq) {
+    m_toPlayerX = dx;
+    m_toPlayerY = dy;
+    m_playerDistSq = distSq;
+    m_playerDist = qSqrt(distSq);
+}
 
-    // 暂停状态下不更新AI
-    if (m_isPaused)
-        return;
+bool Enemy::updateAIState(int elapsedMs) {
+    m_aiElapsedMs = elapsedMs;
 
     // 如果玩家不存在或已死亡，只执行漫游
     if (!player) {
         currentState = WANDER;
         wander();
-        return;
+        return false;
     }
 
     updateState();
@@ -153,21 +167,18 @@ void Enemy::updateAI() {
         case IDLE:
             xdir = 0;
             ydir = 0;
-            break;
+            return false;
 
         case WANDER:
             wander();
-            break;
+            return false;
 
         case CHASE:
-            executeMovement();  // 使用配置的移动模式
-            break;
-
         case ATTACK:
-            // 攻击状态下继续使用配置的移动模式
-            executeMovement();
-            break;
+            // 追击和攻击状态使用配置的移动模式，由 AISystem 按模式分组执行
+            return true;
     }
+    return false;
 }
 
 void Enemy::updateState() {
@@ -176,12 +187,10 @@ void Enemy::updateState() {
         return;
     }
 
-    double dist = distanceToPlayer();
-
-    // 状态转换逻辑
-    if (dist <= attackRange) {
+    // 状态转换逻辑（比较距离平方，无需开方）
+    if (m_playerDistSq <= attackRange * attackRange) {
         currentState = ATTACK;
-    } else if (canSeePlayer() && dist <= visionRange) {
+    } else if (m_playerDistSq <= visionRange * visionRange) {
         currentState = CHASE;
     } else {
         currentState = WANDER;
@@ -209,21 +218,29 @@ double Enemy::distanceToPlayer() {
     return qSqrt(dx * dx + dy * dy);
 }
 
+bool Enemy::chaseDirection(double& dirX, double& dirY) const {
+    // 流场只在房间登记了障碍时生效，且在玩家所在格附近返回 false，其余情况用精确的玩家方向
+    if (FlowField::instance().direction(pos(), dirX, dirY))
+        return true;
+
+    if (m_playerDist <= 0.1)
+        return false;
+    dirX = m_toPlayerX / m_playerDist;
+    dirY = m_toPlayerY / m_playerDist;
+    return true;
+}
+
 void Enemy::moveTowardsPlayer() {
     if (!player)
         return;
 
-    QPointF enemyPos = pos();
-    QPointF playerPos = player->pos();
-
-    double dx = playerPos.x() - enemyPos.x();
-    double dy = playerPos.y() - enemyPos.y();
-    double dist = qSqrt(dx * dx + dy * dy);
+    double dx = m_toPlayerX;
+    double dy = m_toPlayerY;
+    double dirX, dirY;
 
-    if (dist > 0.1) {
-        // 归一化方向向量
-        xdir = static_cast<int>(qRound((dx / dist) * 10));
-        ydir = static_cast<int>(qRound((dy / dist) * 10));
+    if (chaseDirection(dirX, dirY)) {
+        xdir = static_cast<int>(qRound(dirX * 10));
+        ydir = static_cast<int>(qRound(dirY * 10));
 
         // 更新朝向
         if (qAbs(dx) > qAbs(dy)) {
@@ -245,9 +262,9 @@ void Enemy::wander() {
     // 到达漫游点或需要新目标
     if (dist < 20 || wanderCooldown <= 0) {
         wanderTarget = getRandomWanderPoint();
-        wanderCooldown = 60;  // 约3秒后重新选择目标
+        wanderCooldown = 6000;  // 约6秒后重新选择目标
     } else {
-        wanderCooldown--;
+        wanderCooldown -= m_aiElapsedMs;
 
         // 朝向漫游点移动（速度较慢）
         if (dist > 0.1) {
@@ -275,7 +292,7 @@ void Enemy::tryAttack() {
     if (currentState != ATTACK || !player)
         return;
 
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+    qint64 currentTime = GameClock::instance().now();
 
     // 检查冷却时间
     if (currentTime - lastAttackTime < attackCooldown)
@@ -308,9 +325,9 @@ void Enemy::move() {
     if (m_isPaused)
         return;
 
-    // 计算新位置
-    double newX = x() + xdir * speed / 10.0;
-    double newY = y() + ydir * speed / 10.0;
+    // 计算新位置（叠加群体分离的推开量，避免叠成一团）
+    double newX = x() + xdir * speed / 10.0 + m_separationX;
+    double newY = y() + ydir * speed / 10.0 + m_separationY;
 
     // 边界检测
     QRectF pixmapRect = pixmap().rect();
@@ -331,10 +348,8 @@ void Enemy::takeDamage(int damage) {
     int realDamage = qMax(1, damage);  // 每次至少1点伤害
     health -= realDamage;
     if (health <= 0) {
-        // 立即停止所有定时器，防止死亡后仍在运行AI
-        if (aiTimer) {
-            aiTimer->stop();
-        }
+        // 立即停止AI和所有定时器，防止死亡后仍在运行AI
+        setAIEnabled(false);
         if (moveTimer) {
             moveTimer->stop();
         }
@@ -344,27 +359,50 @@ void Enemy::takeDamage(int damage) {
 
         // 播放死亡音效
         AudioManager::instance().playSound("enemy_death");
-        qDebug() << "敌人死亡音效已触发";
+        qCDebug(lcAi) << "敌人死亡音效已触发";
 
         // 创建爆炸动画
-        Explosion* explosion = new Explosion();
-        explosion->setPos(this->pos());  // 在敌人位置创建爆炸
-        if (scene()) {
-            scene()->addItem(explosion);
-            explosion->startAnimation();
-            qDebug() << "创建爆炸动画在位置:" << this->pos();
-        }
+        EffectSystem::spawnExplosion(scene(), this->pos());  // 在敌人位置创建爆炸
 
-        qDebug() << "Enemy::takeDamage - 敌人死亡，发出dying信号";
+        qCDebug(lcAi) << "Enemy::takeDamage - 敌人死亡，发出dying信号";
         emit dying(this);  // 在删除之前发出信号
 
-        if (scene()) {
-            scene()->removeItem(this);
-        }
+        retire();
+    }
+}
+
+void Enemy::reset() {
+    cancelFlash();
 
-        // 立即删除，不再延迟
-        deleteLater();
+    currentState = WANDER;
+    health = maxHealth;
+    lastAttackTime = 0;
+    wanderCooldown = 0;
+    wanderTarget = getRandomWanderPoint();
+    m_zigzagPhase = 0.0;
+    m_isDashing = false;
+    m_dashChargeCounter = 0;
+    m_dashDuration = 0;
+    m_isSummoned = false;
+    firstBonus = true;
+
+    xdir = 0;
+    ydir = 0;
+    damageScale = 1.0;
+    invincible = false;
+
+    onReset();
+    resumeTimers();
+}
+
+void Enemy::retire() {
+    if (EnemyPool::instance().release(this))
+        return;
+
+    if (scene()) {
+        scene()->removeItem(this);
     }
+    deleteLater();
 }
 
 // ============== 不同移动模式 ==============
@@ -399,18 +437,12 @@ void Enemy::moveZigzag() {
     if (!player)
         return;
 
-    QPointF enemyPos = pos();
-    QPointF playerPos = player->pos();
-
-    double dx = playerPos.x() - enemyPos.x();
-    double dy = playerPos.y() - enemyPos.y();
-    double dist = qSqrt(dx * dx + dy * dy);
-
-    if (dist > 0.1) {
-        // 归一化主方向
-        double dirX = dx / dist;
-        double dirY = dy / dist;
+    double dx = m_toPlayerX;
+    double dy = m_toPlayerY;
+    double dirX, dirY;
 
+    // 主方向取自流场
+    if (chaseDirection(dirX, dirY)) {
         // 计算垂直于主方向的侧向量
         double perpX = -dirY;
         double perpY = dirX;
@@ -451,11 +483,10 @@ void Enemy::moveCircle() {
         return;
 
     QPointF enemyPos = pos();
-    QPointF playerPos = player->pos();
-
-    double dx = playerPos.x() - enemyPos.x();
-    double dy = playerPos.y() - enemyPos.y();
-    double dist = qSqrt(dx * dx + dy * dy);
+    double dx = m_toPlayerX;
+    double dy = m_toPlayerY;
+    double dist = m_playerDist;
+    QPointF playerPos = enemyPos + QPointF(dx, dy);
 
     // 逐渐增加角度，实现绕圈效果
     m_circleAngle += 0.05;
@@ -492,21 +523,19 @@ void Enemy::moveDash() {
         return;
 
     QPointF enemyPos = pos();
-    QPointF playerPos = player->pos();
-
-    double dx = playerPos.x() - enemyPos.x();
-    double dy = playerPos.y() - enemyPos.y();
-    double dist = qSqrt(dx * dx + dy * dy);
+    double dx = m_toPlayerX;
+    double dy = m_toPlayerY;
+    QPointF playerPos = enemyPos + QPointF(dx, dy);
 
     if (!m_isDashing) {
         // 蓄力阶段
-        m_dashChargeCounter += 100;  // AI更新间隔约100ms
+        m_dashChargeCounter += m_aiElapsedMs;  // 距上次AI更新经过的时间
 
-        // 蓄力时缓慢追踪玩家（而不是完全停止）
-        if (dist > 0.1) {
-            // 蓄力时以较低速度追踪
-            xdir = static_cast<int>(qRound((dx / dist) * 3));
-            ydir = static_cast<int>(qRound((dy / dist) * 3));
+        // 蓄力时沿流场以较低速度追踪玩家（而不是完全停止）
+        double dirX, dirY;
+        if (chaseDirection(dirX, dirY)) {
+            xdir = static_cast<int>(qRound(dirX * 3));
+            ydir = static_cast<int>(qRound(dirY * 3));
         }
 
         if (m_dashChargeCounter >= m_dashChargeMs) {
@@ -541,9 +570,10 @@ void Enemy::moveDash() {
             m_isDashing = false;
             m_dashChargeCounter = 0;
             // 不要立即停止，继续缓慢追踪
-            if (dist > 0.1) {
-                xdir = static_cast<int>(qRound((dx / dist) * 3));
-                ydir = static_cast<int>(qRound((dy / dist) * 3));
+            double dirX, dirY;
+            if (chaseDirection(dirX, dirY)) {
+                xdir = static_cast<int>(qRound(dirX * 3));
+                ydir = static_cast<int>(qRound(dirY * 3));
             }
         }
     }
@@ -566,12 +596,9 @@ void Enemy::moveKeepDistance() {
     if (!player)
         return;
 
-    QPointF enemyPos = pos();
-    QPointF playerPos = player->pos();
-
-    double dx = playerPos.x() - enemyPos.x();
-    double dy = playerPos.y() - enemyPos.y();
-    double dist = qSqrt(dx * dx + dy * dy);
+    double dx = m_toPlayerX;
+    double dy = m_toPlayerY;
+    double dist = m_playerDist;
 
     if (dist < 0.1) {
         xdir = 0;
@@ -620,12 +647,9 @@ void Enemy::moveDiagonal() {
     if (!player)
         return;
 
-    QPointF enemyPos = pos();
-    QPointF playerPos = player->pos();
-
-    double dx = playerPos.x() - enemyPos.x();
-    double dy = playerPos.y() - enemyPos.y();
-    double dist = qSqrt(dx * dx + dy * dy);
+    double dx = m_toPlayerX;
+    double dy = m_toPlayerY;
+    double dist = m_playerDist;
 
     if (dist < 0.1)
         return;
@@ -679,9 +703,7 @@ void Enemy::moveDiagonal() {
 
 void Enemy::pauseTimers() {
     m_isPaused = true;
-    if (aiTimer && aiTimer->isActive()) {
-        aiTimer->stop();
-    }
+    setAIEnabled(false);
     if (moveTimer && moveTimer->isActive()) {
         moveTimer->stop();
     }
@@ -692,13 +714,12 @@ void Enemy::pauseTimers() {
 
 void Enemy::resumeTimers() {
     m_isPaused = false;
-    if (aiTimer) {
-        aiTimer->start(200);
-    }
+    // 重新加入AI更新，按构造时设定的间隔重新启动（移动 20ms、攻击 100ms）
+    setAIEnabled(true);
     if (moveTimer) {
-        moveTimer->start(20);
+        moveTimer->start();
     }
     if (attackTimer) {
-        attackTimer->start(100);
+        attackTimer->start();
     }
 }
@@ -5,6 +5,7 @@
 #include <QTimer>
 #include <QVector>
 #include <QtMath>
+#include "../core/gametimer.h"
 #include "entity.h"
 #include "statuseffect.h"
 
@@ -13,6 +14,9 @@ class Player;
 class Enemy : public Entity {
 Q_OBJECT
 
+    friend class AISystem;
+    friend class CrowdSystem;
+
 public:
     // 敌人状态枚举
     enum State {
@@ -76,6 +80,9 @@ public:
     // 接触玩家时的特殊效果（子类可重写添加惊吓/昏迷等效果）
     virtual void onContactWithPlayer(Player *p) { Q_UNUSED(p); }
 
+    // 玩家子弹是否穿过该敌人（子类可重写，如概率论被其他敌人接触时）
+    virtual bool letsProjectilesPass() const { return false; }
+
     // 移动模式配置
     void setMovementPattern(MovementPattern pattern) { m_movePattern = pattern; }
 
@@ -106,23 +113,40 @@ public:
 
     bool isSummoned() const { return m_isSummoned; }
 
+    // 对象池类型键（为空表示不参与池化，由 EnemyPool 设置）
+    void setPoolKey(const QString &key) { m_poolKey = key; }
+
+    const QString &poolKey() const { return m_poolKey; }
+
+    /**
+     * @brief 从对象池取出时恢复初始状态并重新启动定时器
+     *
+     * 先恢复基类的运行时状态，再调用 onReset() 让子类重新读取配置、恢复自身状态，
+     * 最后通过 resumeTimers() 启动所有定时器。
+     */
+    void reset();
+
+    /**
+     * @brief 死亡后的收尾：池化敌人放回对象池，否则移出场景并 deleteLater
+     *
+     * 调用前应已发出 dying 信号。
+     */
+    void retire();
+
 signals:
 
     void dying(Enemy *enemy); // 敌人即将死亡信号（在deleteLater之前发出）
 
 private slots:
 
-    void updateAI();
-
     void tryAttack();
 
 protected:
     // AI相关 - protected 允许子类访问
     State currentState;
     Player *player;
-    QTimer *aiTimer;
-    QTimer *moveTimer;
-    QTimer *attackTimer;
+    GameTimer *moveTimer;
+    GameTimer *attackTimer;
 
     // 属性 - protected 允许子类访问
     int health;
@@ -136,7 +160,7 @@ protected:
 
     // 漫游相关
     QPointF wanderTarget; // 漫游目标点
-    int wanderCooldown;   // 漫游冷却
+    int wanderCooldown;   // 漫游冷却（毫秒）
 
     // 移动模式相关
     MovementPattern m_movePattern; // 当前移动模式
@@ -154,6 +178,26 @@ protected:
     int m_diagonalDirection;       // 斜向方向 (1 或 -1)，用于斜向移动和保持距离模式
     bool m_isSummoned;             // 是否是被召唤的敌人（不触发bonus）
     bool m_isPaused;               // 是否处于暂停状态
+    QString m_poolKey;             // 对象池类型键
+
+    // AI 批量更新相关（由 AISystem 写入）
+    bool m_aiEnabled;              // 是否参与 AI 更新
+    int m_aiSlot;                  // 在 AISystem 中的下标，-1 表示未加入
+    int m_aiElapsedMs;             // 距上次 AI 更新经过的时间（LOD 降频时大于 100ms）
+    double m_toPlayerX;            // 玩家位置 - 敌人位置
+    double m_toPlayerY;
+    double m_playerDistSq;         // 到玩家距离的平方
+    double m_playerDist;           // 到玩家的距离（按需开方）
+
+    // 群体分离（由 CrowdSystem 每个节拍写入）
+    int m_crowdSlot;               // 在 CrowdSystem 本节拍数组中的下标，-1 表示不在场景中
+    double m_separationX;          // 每个移动步叠加的推开量（像素）
+    double m_separationY;
+
+    // 开启/关闭 AI 更新（替代原来启动/停止 aiTimer）
+    void setAIEnabled(bool enabled);
+
+    bool isAIEnabled() const { return m_aiEnabled; }
 
     // AI方法 - protected 允许子类访问和重写
     void updateState();
@@ -170,7 +214,19 @@ protected:
 
     QPointF getRandomWanderPoint();
 
-    // 移动模式实现方法
+    // 池化子类重写：重新读取配置并恢复自身状态（不要在这里启动定时器）
+    virtual void onReset() {}
+
+    // 由 AISystem 调用：写入本步的玩家相对向量，再更新状态
+    void setPlayerVector(double dx, double dy, double distSq);
+
+    // 返回 true 表示处于追击/攻击状态，需要执行 executeMovement()
+    bool updateAIState(int elapsedMs);
+
+    // 追击方向：房间有障碍时查询共享流场（可绕开障碍），没有障碍、在玩家附近或流场不可用时直接朝向玩家
+    bool chaseDirection(double &dirX, double &dirY) const;
+
+    // 移动模式实现方法（使用 AISystem 写入的玩家相对向量）
     virtual void executeMovement(); // 根据当前模式执行移动（可重写）
     void moveZigzag();              // Z字形移动
     void moveCircle();              // 绕圈移动
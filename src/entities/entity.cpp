@@ -1,7 +1,10 @@
 #include "entity.h"
 #include <QPainter>
-#include <QPointer>
-#include <QTimer>
+#include "../core/gameclock.h"
+#include "../core/spritevariantcache.h"
+#include "../items/statuseffect.h"
+
+QVector<Entity*> Entity::s_flashingEntities;
 
 Entity::Entity(QGraphicsPixmapItem* parent)
     : QGraphicsPixmapItem(parent), isFlashing(false), maskNeedsUpdate(true) {
@@ -11,9 +14,39 @@ Entity::Entity(QGraphicsPixmapItem* parent)
     flippingInProgress = false;
 }
 
+Entity::~Entity() {
+    s_flashingEntities.removeOne(this);
+    EffectManager::instance().forget(this);
+    if (m_kind != EntityKind::KindCount) {
+        EntityRegistry::instance().remove(m_kind, this);
+    }
+}
+
+int Entity::type() const {
+    if (m_kind == EntityKind::KindCount)
+        return QGraphicsPixmapItem::type();
+    return entityItemType(m_kind);
+}
+
+void Entity::registerKind(EntityKind kind) {
+    if (m_kind == kind)
+        return;
+    if (m_kind != EntityKind::KindCount) {
+        EntityRegistry::instance().remove(m_kind, this);
+    }
+    m_kind = kind;
+    EntityRegistry::instance().add(kind, this);
+}
+
 void Entity::setPixmap(const QPixmap& pix) {
-    // 直接使用基类实现；player/enemy 可能直接调用这个接口
-    QGraphicsPixmapItem::setPixmap(pix);
+    if (isFlashing) {
+        // 闪烁期间换图：闪烁结束后恢复为新图，当前显示新图的闪烁版本
+        m_flashOriginal = pix;
+        QGraphicsPixmapItem::setPixmap(SpriteVariantCache::instance().flashVariant(pix));
+    } else {
+        // 直接使用基类实现；player/enemy 可能直接调用这个接口
+        QGraphicsPixmapItem::setPixmap(pix);
+    }
     // 标记碰撞掩码需要更新
     maskNeedsUpdate = true;
 }
@@ -27,7 +60,7 @@ void Entity::setPixmapofDirs(QPixmap& downImg, QPixmap& upImg, QPixmap& leftImg,
 
     // 如果 left 未提供但 right 提供，则自动生成 left（水平翻转）
     if (left.isNull() && !right.isNull()) {
-        left = right.transformed(QTransform().scale(-1, 1));
+        left = SpriteVariantCache::instance().mirrored(right);
     }
 
     // 如果目前没有 pixmap，优先设置为 right（假定资源朝右）
@@ -47,9 +80,7 @@ void Entity::updateFacing() {
         // 需要从“当前图”翻转为左向
         if (!pixmap().isNull()) {
             flippingInProgress = true;
-            QPixmap cur = pixmap();
-            QPixmap flipped = cur.transformed(QTransform().scale(-1, 1));
-            QGraphicsPixmapItem::setPixmap(flipped);
+            flipCurrentPixmap();
             facingRight = false;
             flippingInProgress = false;
         } else {
@@ -58,7 +89,7 @@ void Entity::updateFacing() {
                 QGraphicsPixmapItem::setPixmap(left);
                 facingRight = false;
             } else if (!right.isNull()) {
-                QGraphicsPixmapItem::setPixmap(right.transformed(QTransform().scale(-1, 1)));
+                QGraphicsPixmapItem::setPixmap(SpriteVariantCache::instance().mirrored(right));
                 facingRight = false;
             }
         }
@@ -66,9 +97,7 @@ void Entity::updateFacing() {
         // 需要从“当前图”翻转为右向
         if (!pixmap().isNull()) {
             flippingInProgress = true;
-            QPixmap cur = pixmap();
-            QPixmap flipped = cur.transformed(QTransform().scale(-1, 1));
-            QGraphicsPixmapItem::setPixmap(flipped);
+            flipCurrentPixmap();
             facingRight = true;
             flippingInProgress = false;
         } else {
@@ -77,7 +106,7 @@ void Entity::updateFacing() {
                 QGraphicsPixmapItem::setPixmap(right);
                 facingRight = true;
             } else if (!left.isNull()) {
-                QGraphicsPixmapItem::setPixmap(left.transformed(QTransform().scale(-1, 1)));
+                QGraphicsPixmapItem::setPixmap(SpriteVariantCache::instance().mirrored(left));
                 facingRight = true;
             }
         }
@@ -85,6 +114,16 @@ void Entity::updateFacing() {
     // xdir == 0 不改变面朝（保持当前 facingRight）
 }
 
+void Entity::flipCurrentPixmap() {
+    SpriteVariantCache& cache = SpriteVariantCache::instance();
+    if (isFlashing && !m_flashOriginal.isNull()) {
+        m_flashOriginal = cache.mirrored(m_flashOriginal);
+        QGraphicsPixmapItem::setPixmap(cache.flashVariant(m_flashOriginal));
+    } else {
+        QGraphicsPixmapItem::setPixmap(cache.mirrored(pixmap()));
+    }
+}
+
 void Entity::setPos(qreal x, qreal y) {
     // 在移动之前先更新朝向（这样 player/enemy 不用改）
     updateFacing();
@@ -98,34 +137,48 @@ void Entity::setPos(const QPointF& pos) {
 }
 
 void Entity::flash() {
-    if (isFlashing)
+    if (isFlashing || pixmap().isNull())
         return;
 
+    // 闪烁图由缓存提供（每张图、每个朝向只生成一次），这里只是换一下显示的图片
     isFlashing = true;
+    m_flashOriginal = pixmap();  // 当前图像（可能已翻转）
+    QGraphicsPixmapItem::setPixmap(SpriteVariantCache::instance().flashVariant(m_flashOriginal));
+    m_flashRemainingMs = kFlashDurationMs;
+
+    static bool tickerConnected = false;
+    if (!tickerConnected) {
+        QObject::connect(&GameClock::instance(), &GameClock::tick, &GameClock::instance(), &Entity::advanceFlashes);
+        tickerConnected = true;
+    }
+    s_flashingEntities.append(this);
+}
 
-    QPixmap original = pixmap();  // 当前图像（可能已翻转）
-    QPixmap flashPixmap = original;
-
-    QPainter painter(&flashPixmap);
-    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
-    painter.fillRect(flashPixmap.rect(), QColor(255, 0, 0, 180));
-    painter.end();
-
-    QGraphicsPixmapItem::setPixmap(flashPixmap);
+void Entity::endFlash() {
+    if (isFlashing) {
+        // 恢复到闪烁前的图片（保持当前尺寸）
+        QGraphicsPixmapItem::setPixmap(m_flashOriginal);
+        isFlashing = false;
+    }
+    m_flashOriginal = QPixmap();
+}
 
-    // 使用QPointer保护this指针，防止在定时器触发前对象被删除
-    QPointer<Entity> self = this;
-    QTimer::singleShot(120, this, [self, original]() {
-        if (self && self->isFlashing) {
-            // 恢复到捕获时的图片（保持当前尺寸）
-            self->QGraphicsPixmapItem::setPixmap(original);
-            self->isFlashing = false;
-        } });
+void Entity::advanceFlashes(int dtMs) {
+    for (int i = s_flashingEntities.size() - 1; i >= 0; --i) {
+        Entity* entity = s_flashingEntities[i];
+        entity->m_flashRemainingMs -= dtMs;
+        if (entity->m_flashRemainingMs <= 0) {
+            s_flashingEntities.removeAt(i);
+            entity->endFlash();
+        }
+    }
 }
 
 void Entity::cancelFlash() {
     // 立即取消闪烁状态，不恢复图片（因为图片即将被外部更改）
     isFlashing = false;
+    m_flashOriginal = QPixmap();
+    s_flashingEntities.removeOne(this);
 }
 
 void Entity::takeDamage(int damage) {
@@ -176,11 +229,8 @@ QRectF Entity::pixmapSceneBoundingRect() const {
     if (pix.isNull()) {
         return QRectF();
     }
-    // 考虑scale变换，使用实际显示尺寸
-    qreal s = scale();
-    // 考虑offset偏移（用于中心对齐的图片）
-    QPointF off = offset();
-    return QRectF(scenePos() + off * s, QSizeF(pix.width() * s, pix.height() * s));
+    // 通过场景变换映射，同时考虑scale、offset偏移（用于中心对齐的图片）和变换原点
+    return sceneTransform().mapRect(QRectF(offset(), QSizeF(pix.size())));
 }
 
 bool Entity::pixelCollision(Entity* a, Entity* b) {
@@ -9,6 +9,7 @@
 #include <QTransform>
 #include <QVector>
 #include "constants.h"
+#include "../world/entityregistry.h"
 
 class Entity : public QObject, public QGraphicsPixmapItem {
     Q_OBJECT
@@ -20,7 +21,9 @@ class Entity : public QObject, public QGraphicsPixmapItem {
     double hurt{};
     bool invincible{};
     bool isFlashing;
-    int m_slowStackCount = 0;  // 减速效果叠加层数（寒冰/毒气）
+    QPixmap m_flashOriginal;     // 闪烁前的图片，闪烁结束时恢复
+    int m_flashRemainingMs = 0;  // 闪烁剩余时间，由 GameClock 推进
+    EntityKind m_kind = EntityKind::KindCount;  // 实体种类，KindCount 表示未注册
 
     // 保留四方向图（兼容 player/enemy）
     QPixmap down, up, left, right;
@@ -41,6 +44,15 @@ class Entity : public QObject, public QGraphicsPixmapItem {
 
     explicit Entity(QGraphicsPixmapItem* parent = nullptr);
 
+    ~Entity() override;
+
+    static constexpr int kFlashDurationMs = 120;  // 受击闪烁持续时间
+
+    // 图元类型：已注册种类的实体返回种类标签，用于替代 dynamic_cast
+    [[nodiscard]] int type() const override;
+
+    [[nodiscard]] EntityKind kind() const { return m_kind; }
+
     [[nodiscard]] double getSpeed() const { return speed; };
 
     void setSpeed(double sp) { speed = sp; };
@@ -71,15 +83,6 @@ class Entity : public QObject, public QGraphicsPixmapItem {
 
     bool isInvincible() const { return invincible; }
 
-    // 减速层数管理（用于寒冰子弹和毒气攻击）
-    int getSlowStackCount() const { return m_slowStackCount; }
-    void addSlowStack() { m_slowStackCount++; }
-    void removeSlowStack() {
-        if (m_slowStackCount > 0)
-            m_slowStackCount--;
-    }
-    bool canApplySlowStack(int maxStacks = 2) const { return m_slowStackCount < maxStacks; }
-
     // 重载 setPos，以便在每次位置更新时检查并调整朝向
     void setPos(qreal x, qreal y);
 
@@ -101,8 +104,22 @@ class Entity : public QObject, public QGraphicsPixmapItem {
     static bool pixelCollisionWithPixmapItem(Entity* entity, QGraphicsPixmapItem* item, int alphaThreshold = 50);
 
    protected:
+    // 设置实体种类并注册到 EntityRegistry（在派生类构造函数中调用，析构时自动注销）
+    void registerKind(EntityKind kind);
+
     // 检查 xdir，必要时基于当前 pixmap 做水平镜像从而切换朝向
     void updateFacing();
+
+   private:
+    // 水平翻转当前显示的图片（闪烁中则同时翻转闪烁前的原图）
+    void flipCurrentPixmap();
+
+    void endFlash();
+
+    // 推进所有正在闪烁的实体（连接到 GameClock::tick）
+    static void advanceFlashes(int dtMs);
+
+    static QVector<Entity*> s_flashingEntities;
 };
 
 #endif  // ENTITY_H
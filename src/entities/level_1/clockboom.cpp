@@ -1,29 +1,22 @@
 #include "clockboom.h"
 #include <QDebug>
 #include <QGraphicsScene>
-#include <QPainter>
 #include <QRandomGenerator>
 #include <QtMath>
 #include "../../core/audiomanager.h"
 #include "../../core/configmanager.h"
-#include "../../ui/explosion.h"
+#include "../../core/logging.h"
+#include "../../core/spritevariantcache.h"
+#include "../../ui/effectsystem.h"
 #include "nightmareboss.h"
 #include "../player.h"
 
 ClockBoom::ClockBoom(const QPixmap& normalPic, const QPixmap& redPic, double scale)
     : Enemy(normalPic, scale), m_triggered(false), m_exploded(false), m_normalPixmap(normalPic.scaled(normalPic.width() * scale, normalPic.height() * scale, Qt::KeepAspectRatio, Qt::SmoothTransformation)), m_redPixmap(redPic.scaled(redPic.width() * scale, redPic.height() * scale, Qt::KeepAspectRatio, Qt::SmoothTransformation)), m_isRed(false) {
-    // 从配置文件读取ClockBoom属性
-    ConfigManager& config = ConfigManager::instance();
-    setHealth(config.getEnemyInt("clock_boom", "health", 6));
-    setContactDamage(0);  // 碰撞不造成伤害
-    setVisionRange(0);    // 无视野
-    setAttackRange(0);    // 无攻击范围
-    setSpeed(0);          // 不移动
+    applyConfig();
 
     // 停止所有继承的定时器（因为不需要移动、AI和攻击检测）
-    if (aiTimer) {
-        aiTimer->stop();
-    }
+    setAIEnabled(false);
     if (moveTimer) {
         moveTimer->stop();
     }
@@ -32,25 +25,21 @@ ClockBoom::ClockBoom(const QPixmap& normalPic, const QPixmap& redPic, double sca
     }
 
     // 创建独立的碰撞检测定时器
-    m_collisionTimer = new QTimer(this);
-    connect(m_collisionTimer, &QTimer::timeout, this, &ClockBoom::onCollisionCheck);
+    m_collisionTimer = new GameTimer(this);
+    connect(m_collisionTimer, &GameTimer::timeout, this, &ClockBoom::onCollisionCheck);
     m_collisionTimer->start(50);  // 每50ms检测一次碰撞
 
     // 创建闪烁定时器（倒计时闪烁）
-    m_blinkTimer = new QTimer(this);
-    connect(m_blinkTimer, &QTimer::timeout, this, &ClockBoom::onBlinkTimeout);
+    m_blinkTimer = new GameTimer(this);
+    connect(m_blinkTimer, &GameTimer::timeout, this, &ClockBoom::onBlinkTimeout);
 
     // 创建爆炸定时器
-    m_explodeTimer = new QTimer(this);
+    m_explodeTimer = new GameTimer(this);
     m_explodeTimer->setSingleShot(true);
-    connect(m_explodeTimer, &QTimer::timeout, this, &ClockBoom::onExplodeTimeout);
+    connect(m_explodeTimer, &GameTimer::timeout, this, &ClockBoom::onExplodeTimeout);
 
-    // 预创建红色闪烁效果图（类似Entity的flash效果）
-    m_redPixmap = m_normalPixmap;
-    QPainter painter(&m_redPixmap);
-    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
-    painter.fillRect(m_redPixmap.rect(), QColor(255, 0, 0, 180));
-    painter.end();
+    // 红色闪烁效果图与Entity的flash共用缓存，同种闹钟只生成一次
+    m_redPixmap = SpriteVariantCache::instance().flashVariant(m_normalPixmap);
 
     // 禁用与其他物体的碰撞检测，完全避免基类碰撞机制
     setFlag(QGraphicsItem::ItemIsSelectable, false);
@@ -74,6 +63,27 @@ ClockBoom::~ClockBoom() {
     }
 }
 
+void ClockBoom::applyConfig() {
+    // 从配置文件读取ClockBoom属性
+    ConfigManager& config = ConfigManager::instance();
+    setHealth(config.getEnemyInt("clock_boom", "health", 6));
+    setContactDamage(0);  // 碰撞不造成伤害
+    setVisionRange(0);    // 无视野
+    setAttackRange(0);    // 无攻击范围
+    setSpeed(0);          // 不移动
+}
+
+void ClockBoom::onReset() {
+    applyConfig();
+
+    m_triggered = false;
+    m_exploded = false;
+
+    // 回到普通图片（与原图相同尺寸，碰撞掩码无需重新生成）
+    m_isRed = false;
+    QGraphicsPixmapItem::setPixmap(m_normalPixmap);
+}
+
 void ClockBoom::move() {
     // ClockBoom不移动
 }
@@ -183,21 +193,12 @@ void ClockBoom::explode(bool dealDamage) {
     AudioManager::instance().playSound("enemy_death");
 
     // 创建爆炸动画 - 立即创建以确保显示
-    if (scene()) {
-        auto* explosion = new Explosion();
-        explosion->setPos(this->pos());
-        scene()->addItem(explosion);
-        explosion->startAnimation();
-    }
+    EffectSystem::spawnExplosion(scene(), this->pos());
 
-    // 发出dying信号并删除自己
+    // 发出dying信号并回收/删除自己
     emit dying(this);
 
-    if (scene()) {
-        scene()->removeItem(this);
-    }
-
-    deleteLater();
+    retire();
 }
 
 void ClockBoom::damageNearbyEntities() {
@@ -224,13 +225,14 @@ void ClockBoom::damageNearbyEntities() {
             continue;
 
         // 先尝试转换为Enemy，如果失败再尝试Player
-        if (Enemy* enemy = dynamic_cast<Enemy*>(item)) {
+        if (isEntityKind(item, EntityKind::Enemy)) {
+            Enemy* enemy = static_cast<Enemy*>(item);
             // 跳过其他 ClockBoom（同类不互相伤害）
-            if (dynamic_cast<ClockBoom*>(enemy))
+            if (qobject_cast<ClockBoom*>(enemy))
                 continue;
             targetEnemies.append(enemy);
-        } else if (!targetPlayer) {  // 只需要找到一次玩家
-            targetPlayer = dynamic_cast<Player*>(item);
+        } else if (!targetPlayer && isEntityKind(item, EntityKind::Player)) {  // 只需要找到一次玩家
+            targetPlayer = static_cast<Player*>(item);
         }
     }
 
@@ -256,7 +258,7 @@ void ClockBoom::damageNearbyEntities() {
             // 对NightmareBoss造成50点伤害的特判
             if (dynamic_cast<NightmareBoss*>(enemy)) {
                 enemy->takeDamage(50);
-                qDebug() << "ClockBoom对梦魇Boss造成50点爆炸伤害";
+                qCDebug(lcAi) << "ClockBoom对梦魇Boss造成50点爆炸伤害";
             } else {
                 enemy->takeDamage(6);  // 对普通敌人造成6点伤害
             }
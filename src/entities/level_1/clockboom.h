@@ -2,6 +2,7 @@
 #define CLOCKBOOM_H
 
 #include <QTimer>
+#include "../../core/gametimer.h"
 #include "../enemy.h"
 
 class Player;
@@ -35,16 +36,19 @@ public:
 protected:
     void attackPlayer() override;  // 重写攻击，首次碰撞触发倒计时
 
-private:
-    bool m_triggered;          // 是否已触发倒计时
-    bool m_exploded;           // 是否已爆炸
-    QTimer *m_collisionTimer;  // 碰撞检测定时器
-    QTimer *m_blinkTimer;      // 闪烁定时器
-    QTimer *m_explodeTimer;    // 爆炸定时器
-    QPixmap m_normalPixmap;    // 普通图片
-    QPixmap m_redPixmap;       // 深红色图片
-    bool m_isRed;              // 当前是否显示红色
+    void onReset() override;  // 对象池复用：恢复未触发状态
 
+private:
+    bool m_triggered;             // 是否已触发倒计时
+    bool m_exploded;              // 是否已爆炸
+    GameTimer *m_collisionTimer;  // 碰撞检测定时器
+    GameTimer *m_blinkTimer;      // 闪烁定时器
+    GameTimer *m_explodeTimer;    // 爆炸定时器
+    QPixmap m_normalPixmap;       // 普通图片
+    QPixmap m_redPixmap;          // 深红色图片
+    bool m_isRed;                 // 当前是否显示红色
+
+    void applyConfig();                    // 读取配置属性
     void checkCollisionWithPlayer();       // 检测与玩家的碰撞
     void startCountdown();                 // 开始倒计时
     void toggleBlink();                    // 切换闪烁状态
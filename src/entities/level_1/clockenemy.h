@@ -23,7 +23,10 @@ public:
 protected:
     void attackPlayer() override;
 
+    void onReset() override { applyConfig(); }
+
 private:
+    void applyConfig();      // 读取配置属性（构造和对象池复用时调用）
     void applyScareEffect(); // 惊吓效果
 };
 
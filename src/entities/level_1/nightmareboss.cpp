@@ -7,7 +7,10 @@
 #include <QRandomGenerator>
 #include "../../core/audiomanager.h"
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
 #include "../../core/resourcefactory.h"
+#include "../../core/timerwheel.h"
+#include "../../world/entityregistry.h"
 #include "../player.h"
 
 NightmareBoss::NightmareBoss(const QPixmap& pic, double scale, QGraphicsScene* /*scene*/)
@@ -24,7 +27,7 @@ NightmareBoss::NightmareBoss(const QPixmap& pic, double scale, QGraphicsScene* /
       m_shadowText(nullptr),
       m_shadowTimer(nullptr),
       m_visionUpdateTimer(nullptr),
-      m_visionRadius(120) {
+      m_visionRadius(kDefaultVisionRadius) {
     // 遮罩效果使用QGraphicsItem::scene()方法获取场景
     // 参数scene保留为兼容性参数，但不需要使用
 
@@ -48,7 +51,7 @@ NightmareBoss::NightmareBoss(const QPixmap& pic, double scale, QGraphicsScene* /
     int bossSize = ConfigManager::instance().getSize("boss");
     m_phase2Pixmap = ResourceFactory::createBossImage(bossSize, 1, "nightmare2");
 
-    qDebug() << "Nightmare Boss创建，一阶段模式，使用单段冲刺";
+    qCDebug(lcBoss) << "Nightmare Boss创建，一阶段模式，使用单段冲刺";
 }
 
 NightmareBoss::~NightmareBoss() {
@@ -77,7 +80,7 @@ NightmareBoss::~NightmareBoss() {
         delete m_shadowTimer;
         m_shadowTimer = nullptr;
     }
-    qDebug() << "Nightmare Boss被摧毁";
+    qCDebug(lcBoss) << "Nightmare Boss被摧毁";
 }
 
 void NightmareBoss::takeDamage(int damage) {
@@ -96,7 +99,7 @@ void NightmareBoss::takeDamage(int damage) {
         m_isTransitioning = true;
         health = 1;  // 保持存活，不触发dying信号
 
-        qDebug() << "Nightmare Boss 一阶段死亡，触发亡语！";
+        qCDebug(lcBoss) << "Nightmare Boss 一阶段死亡，触发亡语！";
 
         // 击杀场上所有小怪
         killAllEnemies();
@@ -107,10 +110,10 @@ void NightmareBoss::takeDamage(int damage) {
         showShadowOverlay("游戏还没有结束！", 3000);
 
         // 3秒后进入二阶段
-        QTimer::singleShot(4000, this, &NightmareBoss::enterPhase2);
+        TimerWheel::instance().schedule(this, 4000, &NightmareBoss::enterPhase2);
     } else if (health <= 0 && m_phase == 2) {
         // 二阶段死亡 - 真正死亡
-        qDebug() << "Nightmare Boss 二阶段被击败！";
+        qCDebug(lcBoss) << "Nightmare Boss 二阶段被击败！";
 
         // 停止所有定时器
         if (m_nightmareWrapTimer) {
@@ -119,9 +122,7 @@ void NightmareBoss::takeDamage(int damage) {
         if (m_nightmareDescentTimer) {
             m_nightmareDescentTimer->stop();
         }
-        if (aiTimer) {
-            aiTimer->stop();
-        }
+        setAIEnabled(false);
         if (moveTimer) {
             moveTimer->stop();
         }
@@ -147,7 +148,7 @@ void NightmareBoss::enterPhase2() {
     m_phase = 2;
     m_isTransitioning = false;
 
-    qDebug() << "Nightmare Boss 进入二阶段！";
+    qCDebug(lcBoss) << "Nightmare Boss 进入二阶段！";
 
     // 更换图片（使用预加载的Nightmare2.png）
     setPixmap(m_phase2Pixmap);
@@ -164,44 +165,37 @@ void NightmareBoss::enterPhase2() {
     // 设置二阶段技能
     setupPhase2Skills();
 
-    qDebug() << "二阶段属性强化完成，获得新技能";
+    qCDebug(lcBoss) << "二阶段属性强化完成，获得新技能";
 }
 
 void NightmareBoss::setupPhase2Skills() {
     // 技能1：噩梦缠绕 - 每20秒自动释放
-    m_nightmareWrapTimer = new QTimer(this);
+    m_nightmareWrapTimer = new GameTimer(this);
     m_nightmareWrapTimer->setInterval(20000);  // 20秒
-    connect(m_nightmareWrapTimer, &QTimer::timeout, this, &NightmareBoss::onNightmareWrapTimeout);
+    connect(m_nightmareWrapTimer, &GameTimer::timeout, this, &NightmareBoss::onNightmareWrapTimeout);
     m_nightmareWrapTimer->start();
 
     // 技能2：噩梦降临 - 每60秒自动释放
-    m_nightmareDescentTimer = new QTimer(this);
+    m_nightmareDescentTimer = new GameTimer(this);
     m_nightmareDescentTimer->setInterval(60000);  // 60秒
-    connect(m_nightmareDescentTimer, &QTimer::timeout, this, &NightmareBoss::onNightmareDescentTimeout);
+    connect(m_nightmareDescentTimer, &GameTimer::timeout, this, &NightmareBoss::onNightmareDescentTimeout);
     m_nightmareDescentTimer->start();
 
     // 首次技能1完成后立即释放技能2
     m_firstDescentTriggered = false;
 
-    qDebug() << "二阶段技能已激活：噩梦缠绕（每20秒），噩梦降临（首次技能1后+每60秒）";
+    qCDebug(lcBoss) << "二阶段技能已激活：噩梦缠绕（每20秒），噩梦降临（首次技能1后+每60秒）";
 }
 
 void NightmareBoss::killAllEnemies() {
     if (!scene())
         return;
 
-    // 先收集所有需要击杀的敌人，避免在遍历时修改容器
-    QList<QGraphicsItem*> items = scene()->items();
-    QVector<Enemy*> enemiesToKill;
-
-    for (QGraphicsItem* item : items) {
-        Enemy* enemy = dynamic_cast<Enemy*>(item);
-        if (enemy && enemy != this) {
-            enemiesToKill.append(enemy);
-        }
-    }
+    // 先收集所有需要击杀的敌人（注册表返回快照），避免在遍历时修改容器
+    QVector<Enemy*> enemiesToKill = EntityRegistry::instance().inScene<Enemy>(EntityKind::Enemy, scene());
+    enemiesToKill.removeOne(this);
 
-    qDebug() << "亡语准备击杀" << enemiesToKill.size() << "个小怪";
+    qCDebug(lcBoss) << "亡语准备击杀" << enemiesToKill.size() << "个小怪";
 
     // 逐个击杀敌人 - 通过造成致命伤害让它们自然死亡
     for (Enemy* enemy : enemiesToKill) {
@@ -234,13 +228,13 @@ void NightmareBoss::performNightmareWrap() {
     if (!player || m_phase != 2)
         return;  // 只有二阶段才能释放
 
-    qDebug() << "释放技能1：噩梦缠绕";
+    qCDebug(lcBoss) << "释放技能1：噩梦缠绕";
 
     // 显示遮罩3秒 + 白色文字提示（使用内部方法）
     showShadowOverlay("噩梦缠绕！！\n（你已被剥夺视野）", 3000);
 
     // 3秒后瞬移到玩家身边
-    QTimer::singleShot(3000, this, [this]() {
+    TimerWheel::instance().schedule(this, 3000, [this]() {
         if (player) {
             QPointF playerPos = player->pos();
             // 在玩家周围随机位置（距离80-150像素，保持一定距离）
@@ -263,7 +257,7 @@ void NightmareBoss::performNightmareWrap() {
             xdir = 0;
             ydir = 0;
 
-            qDebug() << "瞬移到玩家附近（距离" << distance << "）:" << teleportX << "," << teleportY << "，dash进程已打断";
+            qCDebug(lcBoss) << "瞬移到玩家附近（距离" << distance << "）:" << teleportX << "," << teleportY << "，dash进程已打断";
 
             // 首次技能1完成后，立即释放技能2
             if (!m_firstDescentTriggered) {
@@ -280,7 +274,7 @@ void NightmareBoss::performNightmareDescent() {
     if (m_phase != 2)
         return;  // 只有二阶段才能释放
 
-    qDebug() << "释放技能2：噩梦降临";
+    qCDebug(lcBoss) << "释放技能2：噩梦降临";
 
     // 梦魇暂停移动
     pauseTimers();
@@ -299,12 +293,12 @@ void NightmareBoss::performNightmareDescent() {
     emit requestSpawnEnemies(enemiesToSpawn);
 
     // 1秒后开始强制冲刺
-    QTimer::singleShot(1000, this, &NightmareBoss::startForceDash);
+    TimerWheel::instance().schedule(this, 1000, &NightmareBoss::startForceDash);
 
     // 2秒后恢复移动（强制冲刺会在此期间执行）
-    QTimer::singleShot(2000, this, [this]() {
+    TimerWheel::instance().schedule(this, 2000, [this]() {
         resumeTimers();
-        qDebug() << "梦魇恢复移动，召唤完成";
+        qCDebug(lcBoss) << "梦魇恢复移动，召唤完成";
     });
 }
 
@@ -316,12 +310,12 @@ void NightmareBoss::startForceDash() {
     m_forceDashing = true;
     m_forceDashTarget = player->pos();  // 锁定玩家当前位置
 
-    qDebug() << "噩梦降临：开始强制冲刺！目标位置:" << m_forceDashTarget;
+    qCDebug(lcBoss) << "噩梦降临：开始强制冲刺！目标位置:" << m_forceDashTarget;
 
     // 创建独立的强制冲刺定时器（不受pauseTimers影响）
     if (!m_forceDashTimer) {
-        m_forceDashTimer = new QTimer(this);
-        connect(m_forceDashTimer, &QTimer::timeout, this, &NightmareBoss::executeForceDash);
+        m_forceDashTimer = new GameTimer(this);
+        connect(m_forceDashTimer, &GameTimer::timeout, this, &NightmareBoss::executeForceDash);
     }
     m_forceDashTimer->start(16);  // 约60fps的更新频率
 }
@@ -346,7 +340,7 @@ void NightmareBoss::executeForceDash() {
         if (m_forceDashTimer) {
             m_forceDashTimer->stop();
         }
-        qDebug() << "噩梦降临强制冲刺完成，到达目标位置";
+        qCDebug(lcBoss) << "噩梦降临强制冲刺完成，到达目标位置";
         return;
     }
 
@@ -412,7 +406,7 @@ void NightmareBoss::resumeTimers() {
 }
 
 // 创建带有玩家视野圆形区域的遮罩（使用shadow.png作为背景）
-QPixmap NightmareBoss::createShadowWithVision(const QPointF& playerPos) {
+QPixmap NightmareBoss::createShadowWithVision(const QPointF& playerPos, int visionRadius) {
     // 创建一个带有alpha通道的结果图片
     QPixmap result(800, 600);
     result.fill(Qt::transparent);  // 先填充透明
@@ -438,7 +432,7 @@ QPixmap NightmareBoss::createShadowWithVision(const QPointF& playerPos) {
     painter.setCompositionMode(QPainter::CompositionMode_Clear);
     painter.setBrush(Qt::SolidPattern);
     painter.setPen(Qt::NoPen);
-    painter.drawEllipse(playerPos, m_visionRadius, m_visionRadius);
+    painter.drawEllipse(playerPos, visionRadius, visionRadius);
 
     painter.end();
 
@@ -454,7 +448,7 @@ void NightmareBoss::showShadowOverlay(const QString& text, int duration) {
 
     // 获取玩家位置并创建带视野的遮罩
     QPointF playerPos = player->pos() + QPointF(30, 30);  // 调整到玩家中心
-    QPixmap shadowPixmap = createShadowWithVision(playerPos);
+    QPixmap shadowPixmap = createShadowWithVision(playerPos, m_visionRadius);
 
     // 创建遮罩
     m_shadowOverlay = new QGraphicsPixmapItem(shadowPixmap);
@@ -477,19 +471,19 @@ void NightmareBoss::showShadowOverlay(const QString& text, int duration) {
 
     // 启动视野更新定时器（跟随玩家位置）
     if (!m_visionUpdateTimer) {
-        m_visionUpdateTimer = new QTimer(this);
-        connect(m_visionUpdateTimer, &QTimer::timeout, this, &NightmareBoss::updateShadowVision);
+        m_visionUpdateTimer = new GameTimer(this);
+        connect(m_visionUpdateTimer, &GameTimer::timeout, this, &NightmareBoss::updateShadowVision);
     }
     m_visionUpdateTimer->start(50);  // 每50ms更新一次视野位置
 
-    qDebug() << "显示遮罩（带玩家视野），文字:" << text << "持续时间:" << duration << "ms";
+    qCDebug(lcBoss) << "显示遮罩（带玩家视野），文字:" << text << "持续时间:" << duration << "ms";
 
     // 如果指定了持续时间，设置定时器自动隐藏
     if (duration > 0) {
         if (!m_shadowTimer) {
-            m_shadowTimer = new QTimer(this);
+            m_shadowTimer = new GameTimer(this);
             m_shadowTimer->setSingleShot(true);
-            connect(m_shadowTimer, &QTimer::timeout, this, &NightmareBoss::hideShadowOverlay);
+            connect(m_shadowTimer, &GameTimer::timeout, this, &NightmareBoss::hideShadowOverlay);
         }
         m_shadowTimer->start(duration);
     }
@@ -502,7 +496,7 @@ void NightmareBoss::updateShadowVision() {
 
     // 获取玩家当前位置并重新生成遮罩
     QPointF playerPos = player->pos() + QPointF(30, 30);  // 调整到玩家中心
-    QPixmap newShadow = createShadowWithVision(playerPos);
+    QPixmap newShadow = createShadowWithVision(playerPos, m_visionRadius);
     m_shadowOverlay->setPixmap(newShadow);
 }
 
@@ -532,5 +526,5 @@ void NightmareBoss::hideShadowOverlay() {
         m_shadowTimer->stop();
     }
 
-    qDebug() << "隐藏遮罩";
+    qCDebug(lcBoss) << "隐藏遮罩";
 }
@@ -5,6 +5,7 @@
 #include <QGraphicsTextItem>
 #include <QPixmap>
 #include <QTimer>
+#include "../../core/gametimer.h"
 #include "../boss.h"
 
 /**
@@ -28,6 +29,15 @@ public:
     void pauseTimers() override;
     void resumeTimers() override;
 
+    static constexpr int kDefaultVisionRadius = 120;
+
+    /**
+     * @brief 创建带玩家视野的全屏遮罩（shadow.png 上挖出以玩家为圆心的透明圆）
+     * @param playerPos 视野圆心（场景坐标）
+     * @param visionRadius 视野半径
+     */
+    static QPixmap createShadowWithVision(const QPointF &playerPos, int visionRadius);
+
 signals:
 
     void phase1DeathTriggered();                                           // 一阶段死亡信号
@@ -40,23 +50,23 @@ private:
     QPixmap m_phase2Pixmap; // 二阶段图片
 
     // 技能1：噩梦缠绕（每20秒）
-    QTimer *m_nightmareWrapTimer;
+    GameTimer *m_nightmareWrapTimer;
 
     // 技能2：噩梦降临（每60秒）
-    QTimer *m_nightmareDescentTimer;
+    GameTimer *m_nightmareDescentTimer;
     bool m_firstDescentTriggered; // 首次技能2是否已触发
 
     // 噩梦降临后的强制冲刺
-    bool m_forceDashing;       // 是否正在强制冲刺
-    QPointF m_forceDashTarget; // 强制冲刺目标位置
-    QTimer *m_forceDashTimer;  // 强制冲刺定时器（独立于moveTimer）
+    bool m_forceDashing;          // 是否正在强制冲刺
+    QPointF m_forceDashTarget;    // 强制冲刺目标位置
+    GameTimer *m_forceDashTimer;  // 强制冲刺定时器（独立于moveTimer）
 
     // 遮罩效果（由NightmareBoss自己管理）
     QGraphicsPixmapItem *m_shadowOverlay;
     QGraphicsTextItem *m_shadowText;
-    QTimer *m_shadowTimer;
-    QTimer *m_visionUpdateTimer; // 视野更新定时器（跟随玩家位置）
-    int m_visionRadius;          // 玩家视野半径
+    GameTimer *m_shadowTimer;
+    GameTimer *m_visionUpdateTimer;  // 视野更新定时器（跟随玩家位置）
+    int m_visionRadius;              // 玩家视野半径
 
     // 私有方法
     void enterPhase2();             // 进入二阶段
@@ -73,7 +83,6 @@ private:
     void hideShadowOverlay();
 
     void updateShadowVision();                                // 更新玩家视野区域
-    QPixmap createShadowWithVision(const QPointF &playerPos); // 创建带视野的遮罩
 
 private slots:
 
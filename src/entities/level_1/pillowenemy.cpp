@@ -1,15 +1,20 @@
 #include "pillowenemy.h"
 #include <QDebug>
-#include <QFont>
 #include <QGraphicsScene>
-#include <QGraphicsTextItem>
 #include <QPointer>
 #include <QTimer>
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
+#include "../../core/timerwheel.h"
+#include "../../ui/floatingtextlayer.h"
 #include "../player.h"
 
 PillowEnemy::PillowEnemy(const QPixmap& pic, double scale)
     : Enemy(pic, scale) {
+    applyConfig();
+}
+
+void PillowEnemy::applyConfig() {
     // 从配置文件读取枕头怪属性
     ConfigManager& config = ConfigManager::instance();
 
@@ -58,47 +63,32 @@ void PillowEnemy::applySleepEffect() {
     if (player->isEffectOnCooldown())
         return;
 
-    qDebug() << "枕头怪物触发昏睡效果！玩家无法移动1.5秒";
+    qCDebug(lcAi) << "枕头怪物触发昏睡效果！玩家无法移动1.5秒";
 
     // 立即设置效果冷却，防止重复触发（将在效果结束后解除）
     player->setEffectCooldown(true);
 
     // 显示"昏睡ZZZ"文字提示
-    QGraphicsTextItem* sleepText = new QGraphicsTextItem("昏睡ZZZ");
-    QFont font;
-    font.setPointSize(16);
-    font.setBold(true);
-    sleepText->setFont(font);
-    sleepText->setDefaultTextColor(QColor(128, 128, 128));  // 灰色
-    sleepText->setPos(player->pos().x(), player->pos().y() - 40);
-    sleepText->setZValue(200);
-    scene()->addItem(sleepText);
+    FloatingTextLayer::showLabel(scene(), "昏睡ZZZ", QColor(128, 128, 128), player, QPointF(0, -40), 1500);  // 灰色
 
     // 禁用玩家移动
     player->setCanMove(false);
 
-    // 使用QPointer保护player指针和sleepText指针，确保即使PillowEnemy被删除也能恢复玩家移动
+    // 使用QPointer保护player指针，确保即使PillowEnemy被删除也能恢复玩家移动
     QPointer<Player> playerPtr = player;
-    QPointer<QGraphicsTextItem> sleepTextPtr = sleepText;
 
-    // 1.5秒后恢复移动并删除文字
+    // 1.5秒后恢复移动（文字由文字层按相同时长移除）
     // 使用player作为上下文对象，确保player销毁时回调不会执行
-    QTimer::singleShot(1500, player, [playerPtr, sleepTextPtr]() {
+    TimerWheel::instance().schedule(player, 1500, [playerPtr]() {
         if (playerPtr) {
             playerPtr->setCanMove(true);
-            qDebug() << "昏睡效果结束，玩家恢复移动，3秒后可再次触发";
+            qCDebug(lcAi) << "昏睡效果结束，玩家恢复移动，3秒后可再次触发";
             // 效果结束后3秒再解除冷却，同样使用player作为上下文
-            QTimer::singleShot(3000, playerPtr.data(), [playerPtr]() {
+            TimerWheel::instance().schedule(playerPtr.data(), 3000, [playerPtr]() {
                 if (playerPtr) {
                     playerPtr->setEffectCooldown(false);
                 }
             });
         }
-        if (sleepTextPtr) {
-            if (sleepTextPtr->scene()) {
-                sleepTextPtr->scene()->removeItem(sleepTextPtr);
-            }
-            delete sleepTextPtr;
-        }
     });
 }
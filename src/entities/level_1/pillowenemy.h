@@ -17,7 +17,10 @@ public:
 protected:
     void attackPlayer() override;
 
+    void onReset() override { applyConfig(); }
+
 private:
+    void applyConfig();      // 读取配置属性（构造和对象池复用时调用）
     void applySleepEffect(); // 100%概率触发昏睡效果
 };
 
@@ -3,6 +3,7 @@
 #include <QGraphicsScene>
 #include <QtMath>
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
 #include "washmachineboss.h"
 
 OrbitingSock::OrbitingSock(const QPixmap& pic, WashMachineBoss* master, double scale)
@@ -12,34 +13,20 @@ OrbitingSock::OrbitingSock(const QPixmap& pic, WashMachineBoss* master, double s
       m_orbitRadius(100.0),
       m_orbitSpeed(0.05),
       m_orbitTimer(nullptr) {
-    // 从配置文件读取轨道袜子属性
-    ConfigManager& config = ConfigManager::instance();
-    setHealth(config.getEnemyInt("orbiting_sock", "health", 15));
-    setContactDamage(config.getEnemyInt("orbiting_sock", "contact_damage", 2));
-    setVisionRange(config.getEnemyDouble("orbiting_sock", "vision_range", 300.0));
-    setAttackRange(config.getEnemyDouble("orbiting_sock", "attack_range", 40.0));
-    setAttackCooldown(config.getEnemyInt("orbiting_sock", "attack_cooldown", 800));
-    setSpeed(0);  // 不需要主动移动，靠轨道运动
-    m_orbitRadius = config.getEnemyDouble("orbiting_sock", "orbit_radius", 100.0);
-    m_orbitSpeed = config.getEnemyDouble("orbiting_sock", "orbit_speed", 0.05);
-
-    // 标记为召唤的敌人，不触发bonus
-    setIsSummoned(true);
+    applyConfig();
 
-    // 停止父类的AI定时器，我们使用自己的轨道定时器
-    if (aiTimer) {
-        aiTimer->stop();
-    }
+    // 停止父类的AI更新，我们使用自己的轨道定时器
+    setAIEnabled(false);
     if (moveTimer) {
         moveTimer->stop();
     }
 
     // 创建轨道更新定时器
-    m_orbitTimer = new QTimer(this);
-    connect(m_orbitTimer, &QTimer::timeout, this, &OrbitingSock::updateOrbit);
+    m_orbitTimer = new GameTimer(this);
+    connect(m_orbitTimer, &GameTimer::timeout, this, &OrbitingSock::updateOrbit);
     m_orbitTimer->start(16);  // 约60fps
 
-    qDebug() << "OrbitingSock created, orbiting around WashMachineBoss";
+    qCDebug(lcAi) << "OrbitingSock created, orbiting around WashMachineBoss";
 }
 
 OrbitingSock::~OrbitingSock() {
@@ -48,7 +35,28 @@ OrbitingSock::~OrbitingSock() {
         delete m_orbitTimer;
         m_orbitTimer = nullptr;
     }
-    qDebug() << "OrbitingSock destroyed";
+    qCDebug(lcAi) << "OrbitingSock destroyed";
+}
+
+void OrbitingSock::applyConfig() {
+    // 从配置文件读取轨道袜子属性
+    ConfigManager& config = ConfigManager::instance();
+    setHealth(config.getEnemyInt("orbiting_sock", "health", 15));
+    setContactDamage(config.getEnemyInt("orbiting_sock", "contact_damage", 2));
+    setVisionRange(config.getEnemyDouble("orbiting_sock", "vision_range", 300.0));
+    setAttackRange(config.getEnemyDouble("orbiting_sock", "attack_range", 40.0));
+    setAttackCooldown(config.getEnemyInt("orbiting_sock", "attack_cooldown", 800));
+    setSpeed(0);  // 不需要主动移动，靠轨道运动
+    m_orbitRadius = config.getEnemyDouble("orbiting_sock", "orbit_radius", 100.0);
+    m_orbitSpeed = config.getEnemyDouble("orbiting_sock", "orbit_speed", 0.05);
+
+    // 标记为召唤的敌人，不触发bonus
+    setIsSummoned(true);
+}
+
+void OrbitingSock::onReset() {
+    applyConfig();
+    m_orbitAngle = 0.0;
 }
 
 void OrbitingSock::updateOrbit() {
@@ -56,11 +64,10 @@ void OrbitingSock::updateOrbit() {
         return;
 
     if (!m_master || !m_master->scene()) {
-        // Boss已死亡或不在场景中，销毁自己
+        // Boss已死亡或不在场景中，回收/销毁自己
         if (scene()) {
             emit dying(this);
-            scene()->removeItem(this);
-            deleteLater();
+            retire();
         }
         return;
     }
@@ -2,6 +2,7 @@
 #define ORBITINGSOCK_H
 
 #include <QTimer>
+#include "../../core/gametimer.h"
 #include "sockenemy.h"
 
 class WashMachineBoss;
@@ -42,12 +43,20 @@ public:
     // 获取主人（洗衣机Boss）
     [[nodiscard]] WashMachineBoss *getMaster() const { return m_master; }
 
+    // 对象池复用时重新绑定主人
+    void setMaster(WashMachineBoss *master) { m_master = master; }
+
+protected:
+    void onReset() override;
+
 private:
+    void applyConfig();  // 读取配置属性（构造和对象池复用时调用）
+
     WashMachineBoss *m_master;  // 洗衣机Boss
     double m_orbitAngle;        // 当前轨道角度（弧度）
     double m_orbitRadius;       // 轨道半径
     double m_orbitSpeed;        // 旋转速度（弧度/帧）
-    QTimer *m_orbitTimer;       // 轨道更新定时器
+    GameTimer *m_orbitTimer;    // 轨道更新定时器
 };
 
 #endif  // ORBITINGSOCK_H
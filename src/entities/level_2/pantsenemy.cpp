@@ -1,11 +1,12 @@
 #include "pantsenemy.h"
-#include <QDateTime>
 #include <QDebug>
 #include <QGraphicsScene>
 #include <QPainter>
 #include <QTransform>
 #include <QtMath>
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
+#include "../../core/timerwheel.h"
 #include "../player.h"
 
 PantsEnemy::PantsEnemy(const QPixmap& pic, double scale)
@@ -38,23 +39,23 @@ PantsEnemy::PantsEnemy(const QPixmap& pic, double scale)
     createRotationFrames();
 
     // 创建技能冷却定时器（20秒）
-    m_spinningCooldownTimer = new QTimer(this);
+    m_spinningCooldownTimer = new GameTimer(this);
     m_spinningCooldownTimer->setInterval(SPINNING_COOLDOWN);
-    connect(m_spinningCooldownTimer, &QTimer::timeout, this, &PantsEnemy::onSpinningTimer);
+    connect(m_spinningCooldownTimer, &GameTimer::timeout, this, &PantsEnemy::onSpinningTimer);
 
     // 创建旋转动画更新定时器
-    m_spinningUpdateTimer = new QTimer(this);
+    m_spinningUpdateTimer = new GameTimer(this);
     m_spinningUpdateTimer->setInterval(SPINNING_UPDATE_INTERVAL);
-    connect(m_spinningUpdateTimer, &QTimer::timeout, this, &PantsEnemy::onSpinningUpdate);
+    connect(m_spinningUpdateTimer, &GameTimer::timeout, this, &PantsEnemy::onSpinningUpdate);
 
     // 创建技能持续时间定时器（5秒，单次触发）
-    m_spinningDurationTimer = new QTimer(this);
+    m_spinningDurationTimer = new GameTimer(this);
     m_spinningDurationTimer->setSingleShot(true);
     m_spinningDurationTimer->setInterval(SPINNING_DURATION);
-    connect(m_spinningDurationTimer, &QTimer::timeout, this, &PantsEnemy::onSpinningEnd);
+    connect(m_spinningDurationTimer, &GameTimer::timeout, this, &PantsEnemy::onSpinningEnd);
 
     // 开局立即释放一次技能
-    QTimer::singleShot(500, this, &PantsEnemy::startSpinning);
+    TimerWheel::instance().schedule(this, 500, &PantsEnemy::startSpinning);
 
     // 启动技能冷却定时器
     m_spinningCooldownTimer->start();
@@ -109,7 +110,7 @@ void PantsEnemy::createRotationFrames() {
         m_rotationFrames.append(croppedPixmap);
     }
 
-    qDebug() << "PantsEnemy: 创建了" << m_rotationFrames.size() << "帧旋转动画";
+    qCDebug(lcAi) << "PantsEnemy: 创建了" << m_rotationFrames.size() << "帧旋转动画";
 }
 
 void PantsEnemy::onSpinningTimer() {
@@ -126,7 +127,7 @@ void PantsEnemy::startSpinning() {
     m_isSpinning = true;
     m_currentFrameIndex = 0;
 
-    qDebug() << "PantsEnemy: 开始释放旋转技能";
+    qCDebug(lcAi) << "PantsEnemy: 开始释放旋转技能";
 
     // 保存当前移速并大幅增加
     m_originalSpeed = speed;
@@ -161,7 +162,7 @@ void PantsEnemy::stopSpinning() {
 
     m_isSpinning = false;
 
-    qDebug() << "PantsEnemy: 旋转技能结束";
+    qCDebug(lcAi) << "PantsEnemy: 旋转技能结束";
 
     // 恢复原始移速
     speed = m_originalSpeed;
@@ -216,7 +217,7 @@ void PantsEnemy::checkSpinningDamage() {
         return;
 
     // 伤害间隔检测（避免连续伤害太快）
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+    qint64 currentTime = GameClock::instance().now();
     if (currentTime - m_lastSpinningDamageTime < 500)  // 0.5秒伤害间隔
         return;
 
@@ -235,7 +236,7 @@ void PantsEnemy::checkSpinningDamage() {
     if (distance <= SPINNING_CIRCLE_RADIUS) {
         player->takeDamage(SPINNING_DAMAGE);
         m_lastSpinningDamageTime = currentTime;
-        qDebug() << "PantsEnemy: 旋转技能命中玩家，造成" << SPINNING_DAMAGE << "点伤害";
+        qCDebug(lcAi) << "PantsEnemy: 旋转技能命中玩家，造成" << SPINNING_DAMAGE << "点伤害";
     }
 }
 
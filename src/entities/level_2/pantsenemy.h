@@ -2,6 +2,7 @@
 #define PANTSENEMY_H
 
 #include <QGraphicsEllipseItem>
+#include "../../core/gametimer.h"
 #include "../enemy.h"
 
 class Player;
@@ -50,11 +51,11 @@ private:
     void checkSpinningDamage();  // 检测旋转圆是否碰到玩家
 
     // 旋转技能相关
-    bool m_isSpinning;                      // 是否正在释放旋转技能
-    QTimer *m_spinningCooldownTimer;        // 技能冷却定时器（20秒）
-    QTimer *m_spinningUpdateTimer;          // 旋转动画更新定时器
-    QTimer *m_spinningDurationTimer;        // 技能持续时间定时器（5秒）
-    QGraphicsEllipseItem *m_spinningCircle; // 旋转形成的伤害圆
+    bool m_isSpinning;                       // 是否正在释放旋转技能
+    GameTimer *m_spinningCooldownTimer;      // 技能冷却定时器（20秒）
+    GameTimer *m_spinningUpdateTimer;        // 旋转动画更新定时器
+    GameTimer *m_spinningDurationTimer;      // 技能持续时间定时器（5秒）
+    QGraphicsEllipseItem *m_spinningCircle;  // 旋转形成的伤害圆
 
     // 旋转动画相关
     QVector<QPixmap> m_rotationFrames; // 旋转动画帧（不同角度）
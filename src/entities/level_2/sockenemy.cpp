@@ -1,10 +1,12 @@
 #include "sockenemy.h"
-#include <QDateTime>
 #include <QDebug>
 #include <QRandomGenerator>
 #include <QTimer>
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
+#include "../../core/timerwheel.h"
 #include "../../items/statuseffect.h"
+#include "../../ui/floatingtextlayer.h"
 #include "../player.h"
 
 // 静态成员初始化
@@ -20,7 +22,7 @@ bool SockEnemy::canApplyPoisonTo(Player* player) {
     if (!player)
         return false;
 
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+    qint64 currentTime = GameClock::instance().now();
 
     if (s_playerPoisonCooldowns.contains(player)) {
         qint64 cooldownEndTime = s_playerPoisonCooldowns[player];
@@ -33,7 +35,7 @@ bool SockEnemy::canApplyPoisonTo(Player* player) {
 
 void SockEnemy::markPoisonCooldownStart(Player* player) {
     // 中毒结束后开始3秒冷却
-    s_playerPoisonCooldowns[player] = QDateTime::currentMSecsSinceEpoch() + POISON_COOLDOWN_MS;
+    s_playerPoisonCooldowns[player] = GameClock::instance().now() + POISON_COOLDOWN_MS;
 }
 
 void SockEnemy::clearAllCooldowns() {
@@ -63,7 +65,7 @@ void SockEnemy::applyPoisonEffect() {
 
     // 检查冷却时间
     if (!canApplyPoisonTo(player)) {
-        qDebug() << "袜子中毒冷却中，无法再次中毒";
+        qCDebug(lcAi) << "袜子中毒冷却中，无法再次中毒";
         return;
     }
 
@@ -71,20 +73,18 @@ void SockEnemy::applyPoisonEffect() {
     if (QRandomGenerator::global()->bounded(2) == 0) {
         // 中毒效果：每秒扣0.5颗心，持续3秒共扣1.5心
         int duration = qMin(3, static_cast<int>(player->getCurrentHealth()));
-        PoisonEffect* effect = new PoisonEffect(player, duration, 1);
-        effect->applyTo(player);
+        EffectManager::instance().apply(player, StatusEffectType::Poison, 1, duration);
 
         // 中毒结束后开始冷却（duration秒后 + 3秒冷却）
-        // 使用QTimer延迟设置冷却开始时间
-        QTimer::singleShot(duration * 1000, [this]() {
-            if (player) {
-                markPoisonCooldownStart(player);
-                qDebug() << "袜子中毒结束，开始3秒冷却";
-            }
+        // 回调绑定玩家而不是袜子，袜子先死亡时冷却仍会正常开始
+        Player* target = player;
+        TimerWheel::instance().schedule(target, duration * 1000, [target]() {
+            markPoisonCooldownStart(target);
+            qCDebug(lcAi) << "袜子中毒结束，开始3秒冷却";
         });
 
-        qDebug() << "袜子怪物触发中毒效果！持续" << duration << "秒，每秒扣1点血";
-        StatusEffect::showFloatText(player->scene(), QString("中毒！"), player->pos(), QColor(100, 50, 0));
+        qCDebug(lcAi) << "袜子怪物触发中毒效果！持续" << duration << "秒，每秒扣1点血";
+        FloatingTextLayer::showFloatText(player->scene(), QString("中毒！"), player->pos(), QColor(100, 50, 0));
     }
 }
 
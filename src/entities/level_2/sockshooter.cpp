@@ -3,6 +3,8 @@
 #include <QGraphicsScene>
 #include <QtMath>
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
+#include "../../core/resourcefactory.h"
 #include "../player.h"
 #include "../projectile.h"
 
@@ -34,11 +36,11 @@ SockShooter::SockShooter(const QPixmap& pic, double scale)
     loadBulletPixmap();
 
     // 创建射击定时器
-    m_shootTimer = new QTimer(this);
-    connect(m_shootTimer, &QTimer::timeout, this, &SockShooter::shootBullet);
+    m_shootTimer = new GameTimer(this);
+    connect(m_shootTimer, &GameTimer::timeout, this, &SockShooter::shootBullet);
     m_shootTimer->start(m_shootCooldown);
 
-    qDebug() << "SockShooter 创建完成 - 子弹伤害:" << m_bulletDamage
+    qCDebug(lcAi) << "SockShooter 创建完成 - 子弹伤害:" << m_bulletDamage
              << " 射击间隔:" << m_shootCooldown << "ms"
              << " 接触伤害:" << contactDamage;
 }
@@ -58,17 +60,15 @@ void SockShooter::loadBulletPixmap() {
         bulletSize = 25;  // 默认值
 
     // 加载子弹图片
-    QPixmap originalBullet("assets/items/bullet_sock_shooter.png");
+    m_bulletPixmap = ResourceFactory::tryLoadSprite("assets/items/bullet_sock_shooter.png", bulletSize, bulletSize);
 
-    if (originalBullet.isNull()) {
+    if (m_bulletPixmap.isNull()) {
         qWarning() << "无法加载 sock_shooter 子弹图片，使用默认黄色子弹";
         // 创建一个默认的黄色子弹
         m_bulletPixmap = QPixmap(bulletSize, bulletSize / 2);
         m_bulletPixmap.fill(Qt::yellow);
     } else {
-        // 缩放子弹图片到配置的大小
-        m_bulletPixmap = originalBullet.scaled(bulletSize, bulletSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        qDebug() << "SockShooter 子弹图片加载成功，大小:" << m_bulletPixmap.size();
+        qCDebug(lcAi) << "SockShooter 子弹图片加载成功，大小:" << m_bulletPixmap.size();
     }
 }
 
@@ -121,13 +121,13 @@ void SockShooter::shootBullet() {
 
     // 检查是否在场景中
     if (!scene()) {
-        qDebug() << "SockShooter::shootBullet - 不在场景中";
+        qCDebug(lcAi) << "SockShooter::shootBullet - 不在场景中";
         return;
     }
 
     // 检查是否能看到玩家（在视野范围内）
     if (!player) {
-        qDebug() << "SockShooter::shootBullet - 没有玩家引用";
+        qCDebug(lcAi) << "SockShooter::shootBullet - 没有玩家引用";
         return;
     }
 
@@ -160,7 +160,7 @@ void SockShooter::shootBullet() {
     // 添加到场景
     scene()->addItem(bullet);
 
-    qDebug() << "SockShooter 发射子弹 - 方向:" << (m_facingRight ? "右" : "左")
+    qCDebug(lcAi) << "SockShooter 发射子弹 - 方向:" << (m_facingRight ? "右" : "左")
              << "位置:" << center << "玩家距离:" << dist
              << "子弹dirX:" << bulletDirX;
 }
@@ -2,6 +2,7 @@
 #define SOCKSHOOTER_H
 
 #include <QGraphicsPixmapItem>
+#include "../../core/gametimer.h"
 #include "../enemy.h"
 
 class Player;
@@ -68,9 +69,9 @@ private:
     void updateFacingDirection();
 
     // 射击相关
-    QTimer *m_shootTimer;   // 射击定时器
-    QPixmap m_bulletPixmap; // 子弹图片
-    bool m_facingRight;     // 面朝方向（true=右，false=左）
+    GameTimer *m_shootTimer;  // 射击定时器
+    QPixmap m_bulletPixmap;   // 子弹图片
+    bool m_facingRight;       // 面朝方向（true=右，false=左）
 
     // 攻击参数
     int m_bulletDamage;   // 子弹伤害（默认：2）
@@ -2,6 +2,7 @@
 #include <QDebug>
 #include <QGraphicsScene>
 #include <QtMath>
+#include "../../core/logging.h"
 #include "../../items/statuseffect.h"
 #include "../player.h"
 
@@ -14,10 +15,11 @@ ToxicGas::ToxicGas(QPointF startPos, QPointF direction, const QPixmap& pic, Play
       m_direction(direction),
       m_speed(4.0),
       m_isStationary(false),
-      m_isPaused(false),
       m_isDestroying(false),
       m_damagePerTick(1),
       m_slowFactor(0.5) {
+    EntityRegistry::instance().add(EntityKind::ToxicGas, this);
+
     setPos(startPos);
     setZValue(50);  // 在敌人之上，UI之下
 
@@ -28,23 +30,24 @@ ToxicGas::ToxicGas(QPointF startPos, QPointF direction, const QPixmap& pic, Play
     }
 
     // 移动定时器
-    m_moveTimer = new QTimer(this);
-    connect(m_moveTimer, &QTimer::timeout, this, &ToxicGas::onMoveTimer);
+    m_moveTimer = new GameTimer(this);
+    connect(m_moveTimer, &GameTimer::timeout, this, &ToxicGas::onMoveTimer);
     m_moveTimer->start(16);  // 约60fps
 
     // 持续伤害定时器（碰到玩家后启动）
-    m_effectTimer = new QTimer(this);
-    connect(m_effectTimer, &QTimer::timeout, this, &ToxicGas::onEffectTimer);
+    m_effectTimer = new GameTimer(this);
+    connect(m_effectTimer, &GameTimer::timeout, this, &ToxicGas::onEffectTimer);
 
     // 消失定时器（碰到玩家后启动，10秒后消失）
-    m_despawnTimer = new QTimer(this);
+    m_despawnTimer = new GameTimer(this);
     m_despawnTimer->setSingleShot(true);
-    connect(m_despawnTimer, &QTimer::timeout, this, &ToxicGas::onDespawnTimer);
+    connect(m_despawnTimer, &GameTimer::timeout, this, &ToxicGas::onDespawnTimer);
 
-    qDebug() << "ToxicGas created at" << startPos << "direction:" << m_direction;
+    qCDebug(lcBoss) << "ToxicGas created at" << startPos << "direction:" << m_direction;
 }
 
 ToxicGas::~ToxicGas() {
+    EntityRegistry::instance().remove(EntityKind::ToxicGas, this);
     if (m_moveTimer) {
         m_moveTimer->stop();
     }
@@ -54,11 +57,11 @@ ToxicGas::~ToxicGas() {
     if (m_despawnTimer) {
         m_despawnTimer->stop();
     }
-    qDebug() << "ToxicGas destroyed";
+    qCDebug(lcBoss) << "ToxicGas destroyed";
 }
 
 void ToxicGas::onMoveTimer() {
-    if (m_isPaused || m_isStationary || m_isDestroying)
+    if (m_isStationary || m_isDestroying)
         return;
 
     // 移动
@@ -101,7 +104,7 @@ void ToxicGas::stopMoving() {
         return;
 
     m_isStationary = true;
-    qDebug() << "ToxicGas hit player, stopping and applying effects";
+    qCDebug(lcBoss) << "ToxicGas hit player, stopping and applying effects";
 
     // 停止移动
     if (m_moveTimer) {
@@ -119,7 +122,7 @@ void ToxicGas::stopMoving() {
 }
 
 void ToxicGas::onEffectTimer() {
-    if (m_isPaused || m_isDestroying)
+    if (m_isDestroying)
         return;
 
     applyDamageAndSlow();
@@ -150,23 +153,9 @@ void ToxicGas::applyDamageAndSlow() {
         m_player->takeDamage(m_damagePerTick);
 
         // 应用减速效果（短时间，会被持续刷新），最多叠加2层
-        if (m_player->canApplySlowStack(2)) {
-            m_player->addSlowStack();
-
-            SpeedEffect* slowEffect = new SpeedEffect(2, m_slowFactor);
-
-            // 连接效果结束信号，减少叠加层数
-            QPointer<Player> playerPtr = m_player;
-            QObject::connect(slowEffect, &QObject::destroyed, [playerPtr]() {
-                if (playerPtr) {
-                    playerPtr->removeSlowStack();
-                }
-            });
+        EffectManager::instance().apply(m_player, StatusEffectType::Slow, m_slowFactor, 2, 2);
 
-            slowEffect->applyTo(m_player);
-        }
-
-        qDebug() << "ToxicGas applied damage and slow to player";
+        qCDebug(lcBoss) << "ToxicGas applied damage and slow to player";
     }
 }
 
@@ -191,7 +180,3 @@ void ToxicGas::onDespawnTimer() {
 
     deleteLater();
 }
-
-void ToxicGas::setPaused(bool paused) {
-    m_isPaused = paused;
-}
@@ -6,6 +6,8 @@
 #include <QPixmap>
 #include <QPointF>
 #include <QTimer>
+#include "../../core/gametimer.h"
+#include "../../world/entityregistry.h"
 
 class Player;
 
@@ -25,9 +27,7 @@ public:
 
     ~ToxicGas() override;
 
-    void setPaused(bool paused);
-
-    bool isPaused() const { return m_isPaused; }
+    [[nodiscard]] int type() const override { return entityItemType(EntityKind::ToxicGas); }
 
     // 设置移动速度
     void setSpeed(double speed) { m_speed = speed; }
@@ -48,14 +48,13 @@ private:
     void stopMoving();
 
     Player *m_player;
-    QTimer *m_moveTimer;     // 移动定时器
-    QTimer *m_effectTimer;   // 持续伤害定时器
-    QTimer *m_despawnTimer;  // 消失定时器
+    GameTimer *m_moveTimer;     // 移动定时器
+    GameTimer *m_effectTimer;   // 持续伤害定时器
+    GameTimer *m_despawnTimer;  // 消失定时器
 
     QPointF m_direction;  // 移动方向（归一化）
     double m_speed;       // 移动速度
     bool m_isStationary;  // 是否已停止（碰到玩家）
-    bool m_isPaused;      // 是否暂停
     bool m_isDestroying;  // 是否正在销毁
 
     int m_damagePerTick;  // 每次伤害量
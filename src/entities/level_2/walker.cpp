@@ -1,13 +1,14 @@
 #include "walker.h"
 #include <QBrush>
-#include <QDateTime>
 #include <QDebug>
 #include <QPen>
 #include <QRadialGradient>
 #include <QRandomGenerator>
 #include <QtMath>
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
 #include "../../items/statuseffect.h"
+#include "../../ui/floatingtextlayer.h"
 #include "../player.h"
 
 // 静态成员初始化
@@ -46,7 +47,7 @@ Walker::Walker(const QPixmap& pic, double scale)
     // 初始化定时器
     initTimers();
 
-    qDebug() << "Walker 创建完成 - 速度:" << m_walkerSpeed
+    qCDebug(lcAi) << "Walker 创建完成 - 速度:" << m_walkerSpeed
              << " 方向切换间隔:" << m_dirChangeInterval << "ms"
              << " 接触伤害:" << contactDamage;
 }
@@ -66,13 +67,13 @@ Walker::~Walker() {
 
 void Walker::initTimers() {
     // 方向切换定时器
-    m_directionTimer = new QTimer(this);
-    connect(m_directionTimer, &QTimer::timeout, this, &Walker::changeDirection);
+    m_directionTimer = new GameTimer(this);
+    connect(m_directionTimer, &GameTimer::timeout, this, &Walker::changeDirection);
     m_directionTimer->start(m_dirChangeInterval);
 
     // 毒痕生成定时器
-    m_trailTimer = new QTimer(this);
-    connect(m_trailTimer, &QTimer::timeout, this, &Walker::spawnPoisonTrail);
+    m_trailTimer = new GameTimer(this);
+    connect(m_trailTimer, &GameTimer::timeout, this, &Walker::spawnPoisonTrail);
     m_trailTimer->start(m_trailSpawnInterval);
 }
 
@@ -118,7 +119,7 @@ void Walker::changeDirection() {
         xdir = -1;
     }
 
-    qDebug() << "Walker 改变方向:" << m_currentDirection;
+    qCDebug(lcAi) << "Walker 改变方向:" << m_currentDirection;
 }
 
 void Walker::spawnPoisonTrail() {
@@ -200,6 +201,8 @@ PoisonTrail::PoisonTrail(const QPointF& center, int duration, double encourageDu
       m_elapsedTime(0),
       m_encourageDuration(encourageDur),
       m_poisonDuration(poisonDur) {
+    EntityRegistry::instance().add(EntityKind::PoisonTrail, this);
+
     // 设置位置
     setPos(center);
 
@@ -213,17 +216,18 @@ PoisonTrail::PoisonTrail(const QPointF& center, int duration, double encourageDu
     setPen(Qt::NoPen);
 
     // 淡出动画定时器
-    m_fadeTimer = new QTimer(this);
-    connect(m_fadeTimer, &QTimer::timeout, this, &PoisonTrail::updateFade);
+    m_fadeTimer = new GameTimer(this);
+    connect(m_fadeTimer, &GameTimer::timeout, this, &PoisonTrail::updateFade);
     m_fadeTimer->start(50);  // 每50ms更新一次透明度
 
     // 碰撞检测定时器
-    m_checkTimer = new QTimer(this);
-    connect(m_checkTimer, &QTimer::timeout, this, &PoisonTrail::checkCollisions);
+    m_checkTimer = new GameTimer(this);
+    connect(m_checkTimer, &GameTimer::timeout, this, &PoisonTrail::checkCollisions);
     m_checkTimer->start(100);  // 每100ms检测一次碰撞
 }
 
 PoisonTrail::~PoisonTrail() {
+    EntityRegistry::instance().remove(EntityKind::PoisonTrail, this);
     if (m_fadeTimer) {
         m_fadeTimer->stop();
     }
@@ -285,16 +289,18 @@ void PoisonTrail::checkCollisions() {
 
     for (QGraphicsItem* item : collidingItems) {
         // 检查是否是玩家
-        if (Player* player = dynamic_cast<Player*>(item)) {
+        if (isEntityKind(item, EntityKind::Player)) {
+            Player* player = static_cast<Player*>(item);
             if (canApplyPoisonTo(player)) {
                 applyPoisonToPlayer(player);
                 markPoisonApplied(player);
             }
         }
         // 检查是否是敌人（非Walker）
-        else if (Enemy* enemy = dynamic_cast<Enemy*>(item)) {
+        else if (isEntityKind(item, EntityKind::Enemy)) {
+            Enemy* enemy = static_cast<Enemy*>(item);
             // 排除Walker类型
-            if (dynamic_cast<Walker*>(enemy) == nullptr) {
+            if (qobject_cast<Walker*>(enemy) == nullptr) {
                 if (canApplyEncourageTo(enemy)) {
                     applyEncourageToEnemy(enemy);
                     markEncourageApplied(enemy);
@@ -308,7 +314,7 @@ bool PoisonTrail::canApplyPoisonTo(Player* player) {
     if (!player)
         return false;
 
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+    qint64 currentTime = GameClock::instance().now();
 
     if (s_playerPoisonCooldowns.contains(player)) {
         qint64 lastApplyTime = s_playerPoisonCooldowns[player];
@@ -323,7 +329,7 @@ bool PoisonTrail::canApplyEncourageTo(Enemy* enemy) {
     if (!enemy)
         return false;
 
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+    qint64 currentTime = GameClock::instance().now();
 
     if (s_enemyEncourageCooldowns.contains(enemy)) {
         qint64 lastApplyTime = s_enemyEncourageCooldowns[enemy];
@@ -335,11 +341,11 @@ bool PoisonTrail::canApplyEncourageTo(Enemy* enemy) {
 }
 
 void PoisonTrail::markPoisonApplied(Player* player) {
-    s_playerPoisonCooldowns[player] = QDateTime::currentMSecsSinceEpoch();
+    s_playerPoisonCooldowns[player] = GameClock::instance().now();
 }
 
 void PoisonTrail::markEncourageApplied(Enemy* enemy) {
-    s_enemyEncourageCooldowns[enemy] = QDateTime::currentMSecsSinceEpoch();
+    s_enemyEncourageCooldowns[enemy] = GameClock::instance().now();
 }
 
 void PoisonTrail::clearCooldowns() {
@@ -357,11 +363,11 @@ void PoisonTrail::applyPoisonToPlayer(Player* player) {
 
     // 如果玩家处于无敌状态（如被吸纳），不施加中毒
     if (player->isInvincible()) {
-        qDebug() << "Walker毒痕：玩家无敌，跳过中毒效果";
+        qCDebug(lcAi) << "Walker毒痕：玩家无敌，跳过中毒效果";
         return;
     }
 
-    qDebug() << "Walker毒痕：对玩家施加中毒效果";
+    qCDebug(lcAi) << "Walker毒痕：对玩家施加中毒效果";
 
     // 100%触发中毒效果
     int duration = static_cast<int>(m_poisonDuration);
@@ -373,20 +379,18 @@ void PoisonTrail::applyPoisonToPlayer(Player* player) {
         duration = 1;
 
     // 伤害1 = 每秒扣0.5颗心（持续3秒共扣1.5心）
-    PoisonEffect* effect = new PoisonEffect(player, duration, 1);
-    effect->applyTo(player);
+    EffectManager::instance().apply(player, StatusEffectType::Poison, 1, duration);
 
     // 显示毒痕中毒提示（位置稍微偏移避免重叠）
-    StatusEffect::showFloatText(player->scene(), QString("中毒！"), player->pos() + QPointF(0, -15), QColor(0, 100, 30));
+    FloatingTextLayer::showFloatText(player->scene(), QString("中毒！"), player->pos() + QPointF(0, -15), QColor(0, 100, 30));
 }
 
 void PoisonTrail::applyEncourageToEnemy(Enemy* enemy) {
     if (!enemy)
         return;
 
-    qDebug() << "Walker毒痕：对敌人施加鼓舞效果 (+50%移速)";
+    qCDebug(lcAi) << "Walker毒痕：对敌人施加鼓舞效果 (+50%移速)";
 
-    // +50%移速效果，持续3秒，使用专用的EncourageEffect（自带文字提示）
-    EncourageEffect* effect = new EncourageEffect(m_encourageDuration, 1.5);
-    effect->applyTo(enemy);
+    // +50%移速效果，持续3秒，使用专用的鼓舞效果（自带文字提示）
+    EffectManager::instance().apply(enemy, StatusEffectType::Encourage, 1.5, m_encourageDuration);
 }
@@ -6,6 +6,7 @@
 #include <QPointer>
 #include <QSet>
 #include <QTimer>
+#include "../../core/gametimer.h"
 #include "../enemy.h"
 
 class Player;
@@ -80,8 +81,8 @@ private:
     QPointF getRandomDirection(); // 获取随机方向向量
 
     // 定时器
-    QTimer *m_directionTimer; // 方向切换定时器
-    QTimer *m_trailTimer;     // 毒痕生成定时器
+    GameTimer *m_directionTimer;  // 方向切换定时器
+    GameTimer *m_trailTimer;      // 毒痕生成定时器
 
     // 当前移动方向（归一化向量）
     QPointF m_currentDirection;
@@ -121,6 +122,8 @@ public:
 
     ~PoisonTrail() override;
 
+    [[nodiscard]] int type() const override { return entityItemType(EntityKind::PoisonTrail); }
+
     void setScene(QGraphicsScene *scene);
 
     // 检测碰撞并应用效果
@@ -148,8 +151,8 @@ private:
 
     void applyEncourageToEnemy(Enemy *enemy);
 
-    QTimer *m_fadeTimer;
-    QTimer *m_checkTimer;
+    GameTimer *m_fadeTimer;
+    GameTimer *m_checkTimer;
     int m_totalDuration;        // 总持续时间
     int m_elapsedTime;          // 已经过时间
     double m_encourageDuration; // 鼓舞效果持续时间
@@ -9,11 +9,16 @@
 #include <QtMath>
 #include "../../core/audiomanager.h"
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
 #include "../../core/resourcefactory.h"
+#include "../../core/timerwheel.h"
 #include "../player.h"
 #include "../projectile.h"
 #include "orbitingsock.h"
 #include "toxicgas.h"
+#include "../../world/bulletpattern.h"
+#include "../../world/enemypool.h"
+#include "../../world/entityregistry.h"
 
 WashMachineBoss::WashMachineBoss(const QPixmap& pic, double scale)
     : Boss(pic, scale),
@@ -66,18 +71,13 @@ WashMachineBoss::WashMachineBoss(const QPixmap& pic, double scale)
     }
 
     if (!basePath.isEmpty()) {
-        m_normalPixmap = QPixmap(basePath + "WashMachineNormally.png")
-                             .scaled(bossSize, bossSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        m_chargePixmap = QPixmap(basePath + "WashMachineCharge.png")
-                             .scaled(bossSize, bossSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        m_angryPixmap = QPixmap(basePath + "WashMachineAngrily.png")
-                            .scaled(bossSize, bossSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        m_mutatedPixmap = QPixmap(basePath + "WashMachineMutated.png")
-                              .scaled(bossSize, bossSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        m_normalPixmap = ResourceFactory::tryLoadSprite(basePath + "WashMachineNormally.png", bossSize, bossSize);
+        m_chargePixmap = ResourceFactory::tryLoadSprite(basePath + "WashMachineCharge.png", bossSize, bossSize);
+        m_angryPixmap = ResourceFactory::tryLoadSprite(basePath + "WashMachineAngrily.png", bossSize, bossSize);
+        m_mutatedPixmap = ResourceFactory::tryLoadSprite(basePath + "WashMachineMutated.png", bossSize, bossSize);
     }
     if (QFile::exists(basePath + "toxic_gas.png")) {
-        m_toxicGasPixmap = QPixmap(basePath + "toxic_gas.png")
-                               .scaled(30, 30, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        m_toxicGasPixmap = ResourceFactory::tryLoadSprite(basePath + "toxic_gas.png", 30, 30);
     } else {
         // 如果没有毒气图片，创建一个绿色圆形
         m_toxicGasPixmap = QPixmap(30, 30);
@@ -91,7 +91,7 @@ WashMachineBoss::WashMachineBoss(const QPixmap& pic, double scale)
     // 启动普通阶段的水柱攻击循环
     startWaterAttackCycle();
 
-    qDebug() << "WashMachine Boss创建，血量:" << health << "阶段: 1";
+    qCDebug(lcBoss) << "WashMachine Boss创建，血量:" << health << "阶段: 1";
 }
 
 WashMachineBoss::~WashMachineBoss() {
@@ -120,7 +120,7 @@ WashMachineBoss::~WashMachineBoss() {
     // 清理旋转臭袜子
     cleanupOrbitingSocks();
 
-    qDebug() << "WashMachine Boss被击败！";
+    qCDebug(lcBoss) << "WashMachine Boss被击败！";
 }
 
 void WashMachineBoss::takeDamage(int damage) {
@@ -166,7 +166,7 @@ void WashMachineBoss::takeDamage(int damage) {
         }
     }
 
-    qDebug() << "WashMachine Boss受到伤害:" << realDamage << "，剩余血量:" << health
+    qCDebug(lcBoss) << "WashMachine Boss受到伤害:" << realDamage << "，剩余血量:" << health
              << "(" << (health * 100 / maxHealth) << "%)";
 
     // 检查阶段转换
@@ -185,13 +185,13 @@ void WashMachineBoss::checkPhaseTransition() {
     if (m_phase == 1 && healthPercent <= 0.7) {
         // 进入愤怒阶段 - 先设置无敌，等待flash结束后再切换
         m_isTransitioning = true;
-        qDebug() << "[WashMachine] 血量降至70%，准备进入愤怒阶段...";
-        QTimer::singleShot(200, this, &WashMachineBoss::enterPhase2);
+        qCDebug(lcBoss) << "[WashMachine] 血量降至70%，准备进入愤怒阶段...";
+        TimerWheel::instance().schedule(this, 200, &WashMachineBoss::enterPhase2);
     } else if (m_phase == 2 && healthPercent <= 0.4) {
         // 进入变异阶段 - 先设置无敌，等待flash结束后再切换
         m_isTransitioning = true;
-        qDebug() << "[WashMachine] 血量降至40%，准备进入变异阶段...";
-        QTimer::singleShot(200, this, &WashMachineBoss::enterPhase3);
+        qCDebug(lcBoss) << "[WashMachine] 血量降至40%，准备进入变异阶段...";
+        TimerWheel::instance().schedule(this, 200, &WashMachineBoss::enterPhase3);
     }
 }
 
@@ -199,7 +199,7 @@ void WashMachineBoss::enterPhase2() {
     m_phase = 2;
     // m_isTransitioning 已在 checkPhaseTransition 中设置
 
-    qDebug() << "[WashMachine] 进入愤怒阶段！";
+    qCDebug(lcBoss) << "[WashMachine] 进入愤怒阶段！";
 
     // 停止水柱攻击
     if (m_waterAttackTimer) {
@@ -213,7 +213,7 @@ void WashMachineBoss::enterPhase2() {
     // 切换到愤怒图片（此时flash已结束）
     if (!m_angryPixmap.isNull()) {
         setPixmap(m_angryPixmap);
-        qDebug() << "[WashMachine] 已切换到愤怒图片，图片大小:" << m_angryPixmap.size();
+        qCDebug(lcBoss) << "[WashMachine] 已切换到愤怒图片，图片大小:" << m_angryPixmap.size();
         // 切换图片后触发闪烁效果（使用新图片）
         flash();
     } else {
@@ -235,9 +235,9 @@ void WashMachineBoss::enterPhase2() {
     startSummonCycle();
 
     // 短暂无敌后恢复
-    QTimer::singleShot(500, this, [this]() {
+    TimerWheel::instance().schedule(this, 500, [this]() {
         m_isTransitioning = false;
-        qDebug() << "[WashMachine] 愤怒阶段激活完成";
+        qCDebug(lcBoss) << "[WashMachine] 愤怒阶段激活完成";
     });
 
     emit phaseChanged(2);
@@ -248,7 +248,7 @@ void WashMachineBoss::enterPhase3() {
     // m_isTransitioning 已在 checkPhaseTransition 中设置
     m_isAbsorbing = true;
 
-    qDebug() << "[WashMachine] 进入变异阶段！开始吸纳动画";
+    qCDebug(lcBoss) << "[WashMachine] 进入变异阶段！开始吸纳动画";
 
     // 停止所有攻击定时器（包括召唤和移动）
     if (m_summonTimer) {
@@ -277,7 +277,7 @@ void WashMachineBoss::enterPhase3() {
 }
 
 void WashMachineBoss::onAbsorbComplete() {
-    qDebug() << "吸纳动画完成，显示变异对话";
+    qCDebug(lcBoss) << "吸纳动画完成，显示变异对话";
 
     m_isAbsorbing = false;
     m_waitingForDialog = true;
@@ -291,7 +291,7 @@ void WashMachineBoss::onDialogFinished() {
 
     // 如果是击败对话结束，则真正死亡
     if (m_isDefeated) {
-        qDebug() << "击败对话结束，Boss真正死亡";
+        qCDebug(lcBoss) << "击败对话结束，Boss真正死亡";
         emit dying(this);
         if (scene()) {
             scene()->removeItem(this);
@@ -303,19 +303,19 @@ void WashMachineBoss::onDialogFinished() {
     // 如果是第一轮对话结束（阶段1）
     if (m_phase == 1 && !m_firstDialogShown) {
         m_firstDialogShown = true;
-        qDebug() << "第一轮对话结束，显示清理提示";
+        qCDebug(lcBoss) << "第一轮对话结束，显示清理提示";
         emit requestShowTransitionText("善良的宿管阿姨已将袜子、内裤以及衣物移出洗衣机。\n         接下来请你全力与洗衣机战斗吧！");
         return;
     }
 
     // 如果不是阶段3（变异阶段），则不需要执行后续逻辑
     if (m_phase != 3) {
-        qDebug() << "对话结束，但不是变异阶段，无需特殊处理";
+        qCDebug(lcBoss) << "对话结束，但不是变异阶段，无需特殊处理";
         return;
     }
 
     // 变异对话结束，继续战斗
-    qDebug() << "变异对话结束，继续变异阶段战斗";
+    qCDebug(lcBoss) << "变异对话结束，继续变异阶段战斗";
 
     // 切换到变异图片
     if (!m_mutatedPixmap.isNull()) {
@@ -350,7 +350,7 @@ void WashMachineBoss::onDialogFinished() {
 }
 
 void WashMachineBoss::onBossDefeated() {
-    qDebug() << "WashMachine Boss被击败！显示胜利对话";
+    qCDebug(lcBoss) << "WashMachine Boss被击败！显示胜利对话";
 
     m_isTransitioning = true;
     m_isDefeated = true;  // 标记已击败，等待对话结束
@@ -365,8 +365,7 @@ void WashMachineBoss::onBossDefeated() {
         m_summonTimer->stop();
     if (m_toxicGasTimer)
         m_toxicGasTimer->stop();
-    if (aiTimer)
-        aiTimer->stop();
+    setAIEnabled(false);
     if (moveTimer)
         moveTimer->stop();
     if (attackTimer)
@@ -378,20 +377,17 @@ void WashMachineBoss::onBossDefeated() {
     // 清理所有子弹和毒气，防止对话时玩家被击中
     QGraphicsScene* currentScene = scene();
     if (currentScene) {
-        QList<QGraphicsItem*> allItems = currentScene->items();
-        for (QGraphicsItem* item : allItems) {
-            // 删除所有Projectile（水柱）
-            if (Projectile* projectile = dynamic_cast<Projectile*>(item)) {
-                currentScene->removeItem(projectile);
-                projectile->deleteLater();
-            }
-            // 删除所有ToxicGas（毒气团）
-            else if (ToxicGas* gas = dynamic_cast<ToxicGas*>(item)) {
-                currentScene->removeItem(gas);
-                gas->deleteLater();
-            }
+        EntityRegistry& registry = EntityRegistry::instance();
+        // 删除所有Projectile（水柱）
+        for (Projectile* projectile : registry.inScene<Projectile>(EntityKind::Projectile, currentScene)) {
+            projectile->destroy();
+        }
+        // 删除所有ToxicGas（毒气团）
+        for (ToxicGas* gas : registry.inScene<ToxicGas>(EntityKind::ToxicGas, currentScene)) {
+            currentScene->removeItem(gas);
+            gas->deleteLater();
         }
-        qDebug() << "[WashMachine] 已清理所有子弹和毒气";
+        qCDebug(lcBoss) << "[WashMachine] 已清理所有子弹和毒气";
     }
 
     // 播放死亡音效
@@ -425,8 +421,8 @@ void WashMachineBoss::attackPlayer() {
 
 void WashMachineBoss::startWaterAttackCycle() {
     if (!m_waterAttackTimer) {
-        m_waterAttackTimer = new QTimer(this);
-        connect(m_waterAttackTimer, &QTimer::timeout, this, &WashMachineBoss::startCharging);
+        m_waterAttackTimer = new GameTimer(this);
+        connect(m_waterAttackTimer, &GameTimer::timeout, this, &WashMachineBoss::startCharging);
     }
     m_waterAttackTimer->start(3000);  // 每3秒攻击一次
 }
@@ -442,13 +438,13 @@ void WashMachineBoss::startCharging() {
         setPixmap(m_chargePixmap);
     }
 
-    qDebug() << "WashMachine Boss开始蓄力...";
+    qCDebug(lcBoss) << "WashMachine Boss开始蓄力...";
 
     // 1秒后发射
     if (!m_chargeTimer) {
-        m_chargeTimer = new QTimer(this);
+        m_chargeTimer = new GameTimer(this);
         m_chargeTimer->setSingleShot(true);
-        connect(m_chargeTimer, &QTimer::timeout, this, &WashMachineBoss::performWaterAttack);
+        connect(m_chargeTimer, &GameTimer::timeout, this, &WashMachineBoss::performWaterAttack);
     }
     m_chargeTimer->start(1000);
 }
@@ -464,7 +460,7 @@ void WashMachineBoss::performWaterAttack() {
         setPixmap(m_normalPixmap);
     }
 
-    qDebug() << "WashMachine Boss发射水柱冲击波！";
+    qCDebug(lcBoss) << "WashMachine Boss发射水柱冲击波！";
 
     // 向四个方向发射水柱
     createWaterWave(0);  // 上
@@ -523,8 +519,8 @@ void WashMachineBoss::createWaterWave(int direction) {
 
 void WashMachineBoss::startSummonCycle() {
     if (!m_summonTimer) {
-        m_summonTimer = new QTimer(this);
-        connect(m_summonTimer, &QTimer::timeout, this, &WashMachineBoss::summonOrbitingSock);
+        m_summonTimer = new GameTimer(this);
+        connect(m_summonTimer, &GameTimer::timeout, this, &WashMachineBoss::summonOrbitingSock);
     }
 
     // 每10秒召唤一只（初始袜子由summonInitialSocks处理）
@@ -535,7 +531,7 @@ void WashMachineBoss::summonInitialSocks() {
     // 从配置读取初始召唤袜子数量
     int sockCount = ConfigManager::instance().getBossInt("washmachine", "phase2", "initial_socks_on_angry", 6);
 
-    qDebug() << "愤怒阶段初始召唤" << sockCount << "只袜子";
+    qCDebug(lcBoss) << "愤怒阶段初始召唤" << sockCount << "只袜子";
 
     // 召唤指定数量的袜子
     for (int i = 0; i < sockCount; ++i) {
@@ -551,7 +547,7 @@ void WashMachineBoss::summonOrbitingSock() {
     // 从配置读取最大袜子数量
     int maxSocks = ConfigManager::instance().getBossInt("washmachine", "phase2", "max_orbiting_socks", 18);
     if (m_orbitingSocks.size() >= maxSocks) {
-        qDebug() << "[WashMachine] 臭袜子已达到上限(" << maxSocks << "只)，不再召唤";
+        qCDebug(lcBoss) << "[WashMachine] 臭袜子已达到上限(" << maxSocks << "只)，不再召唤";
         return;
     }
 
@@ -559,24 +555,26 @@ void WashMachineBoss::summonOrbitingSock() {
     if (!currentScene)
         return;
 
-    qDebug() << "WashMachine Boss召唤旋转臭袜子！";
+    qCDebug(lcBoss) << "WashMachine Boss召唤旋转臭袜子！";
 
-    int enemySize = ConfigManager::instance().getEntitySize("enemies", "sock_normal");
-    if (enemySize <= 0)
-        enemySize = 40;
-
-    QPixmap sockPix;
-    QString sockPath = "assets/enemy/level_2/orbiting_sock.png";
-    if (QFile::exists(sockPath)) {
-        sockPix = QPixmap(sockPath).scaled(enemySize, enemySize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    } else {
-        // 创建默认图片
-        sockPix = QPixmap(enemySize, enemySize);
-        sockPix.fill(QColor(150, 100, 50));
-    }
+    // 创建旋转臭袜子（优先复用对象池中的袜子，只有新建时才加载图片）
+    OrbitingSock* sock = EnemyPool::instance().acquire<OrbitingSock>("orbiting_sock", [this]() {
+        int enemySize = ConfigManager::instance().getEntitySize("enemies", "sock_normal");
+        if (enemySize <= 0)
+            enemySize = 40;
 
-    // 创建旋转臭袜子
-    OrbitingSock* sock = new OrbitingSock(sockPix, this, 1.0);
+        QPixmap sockPix;
+        QString sockPath = "assets/enemy/level_2/orbiting_sock.png";
+        if (QFile::exists(sockPath)) {
+            sockPix = ResourceFactory::tryLoadSprite(sockPath, enemySize, enemySize);
+        } else {
+            // 创建默认图片
+            sockPix = QPixmap(enemySize, enemySize);
+            sockPix.fill(QColor(150, 100, 50));
+        }
+        return new OrbitingSock(sockPix, this, 1.0);
+    });
+    sock->setMaster(this);
 
     // 设置轨道参数，根据已有袜子数量和最大数量计算均匀分布的初始角度
     // 将360度均分成 maxSocks 份，每只袜子占据一个位置
@@ -612,15 +610,15 @@ void WashMachineBoss::cleanupOrbitingSocks() {
 void WashMachineBoss::startToxicGasCycle() {
     // 扩散模式定时器：每5秒发射16个向四周扩散
     if (!m_toxicGasTimer) {
-        m_toxicGasTimer = new QTimer(this);
-        connect(m_toxicGasTimer, &QTimer::timeout, this, &WashMachineBoss::shootSpreadGas);
+        m_toxicGasTimer = new GameTimer(this);
+        connect(m_toxicGasTimer, &GameTimer::timeout, this, &WashMachineBoss::shootSpreadGas);
     }
     m_toxicGasTimer->start(5000);  // 每5秒一次扩散攻击
 
     // 追踪模式定时器：每1.5秒向玩家发射快速毒气
     if (!m_fastGasTimer) {
-        m_fastGasTimer = new QTimer(this);
-        connect(m_fastGasTimer, &QTimer::timeout, this, &WashMachineBoss::shootFastGas);
+        m_fastGasTimer = new GameTimer(this);
+        connect(m_fastGasTimer, &GameTimer::timeout, this, &WashMachineBoss::shootFastGas);
     }
     m_fastGasTimer->start(1500);  // 每1.5秒一次追踪攻击
 }
@@ -636,20 +634,18 @@ void WashMachineBoss::shootSpreadGas() {
     // 计算Boss中心位置
     QPointF bossCenter = pos() + QPointF(pixmap().width() / 2.0, pixmap().height() / 2.0);
 
-    qDebug() << "[WashMachine] 扩散毒气攻击！16个方向";
+    // 16个均匀分布的慢速大毒气团（50x50），参数见 config.json 的 patterns.spread_gas
+    BulletPatternEngine& engine = BulletPatternEngine::instance();
+    BulletPattern spreadDefaults = BulletPattern::ring(16, 2.5, 0);
+    spreadDefaults.size = 50;
+    BulletPattern spreadGas = engine.pattern("washmachine", "spread_gas", spreadDefaults);
+    QPixmap bigToxicGas = engine.sprite(m_toxicGasPixmap, spreadGas.size);
 
-    // 创建较大的毒气图片 (50x50)
-    QPixmap bigToxicGas = m_toxicGasPixmap.scaled(50, 50, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    qCDebug(lcBoss) << "[WashMachine] 扩散毒气攻击！" << spreadGas.count << "个方向";
 
-    // 发射16个均匀分布的毒气（每22.5度一个）
-    for (int i = 0; i < 16; i++) {
-        double angle = i * 22.5;  // 360 / 16 = 22.5度
-        double angleRad = qDegreesToRadians(angle);
-        QPointF direction(qCos(angleRad), qSin(angleRad));
-
-        // 创建慢速毒气团
+    for (const QPointF& direction : engine.directions(spreadGas, 0.0)) {
         ToxicGas* gas = new ToxicGas(bossCenter, direction, bigToxicGas, player);
-        gas->setSpeed(2.5);  // 较慢的速度
+        gas->setSpeed(spreadGas.speed);
         currentScene->addItem(gas);
     }
 }
@@ -669,15 +665,21 @@ void WashMachineBoss::shootFastGas() {
     QPointF playerCenter = player->pos() + QPointF(30, 30);
     QPointF direction = playerCenter - bossCenter;
 
-    qDebug() << "[WashMachine] 追踪毒气攻击！";
+    qCDebug(lcBoss) << "[WashMachine] 追踪毒气攻击！";
 
-    // 创建较大的毒气图片 (45x45)
-    QPixmap fastToxicGas = m_toxicGasPixmap.scaled(45, 45, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    // 快速毒气团（45x45，和dash速度一样快），参数见 config.json 的 patterns.fast_gas
+    BulletPatternEngine& engine = BulletPatternEngine::instance();
+    BulletPattern fastDefaults = BulletPattern::aimed(8.0, 0);
+    fastDefaults.size = 45;
+    BulletPattern fastGasPattern = engine.pattern("washmachine", "fast_gas", fastDefaults);
+    QPixmap fastToxicGas = engine.sprite(m_toxicGasPixmap, fastGasPattern.size);
 
-    // 创建快速毒气团（和dash速度一样）
-    ToxicGas* gas = new ToxicGas(bossCenter, direction, fastToxicGas, player);
-    gas->setSpeed(8.0);  // 和dash速度一样快
-    currentScene->addItem(gas);
+    double aimAngle = qAtan2(direction.y(), direction.x());
+    for (const QPointF& gasDirection : engine.directions(fastGasPattern, aimAngle)) {
+        ToxicGas* gas = new ToxicGas(bossCenter, gasDirection, fastToxicGas, player);
+        gas->setSpeed(fastGasPattern.speed);
+        currentScene->addItem(gas);
+    }
 }
 
 // ==================== 暂停控制 ====================
@@ -788,5 +790,5 @@ void WashMachineBoss::setupLevelConnections(QObject* level) {
     connect(this, SIGNAL(requestSpawnEnemies(QVector<QPair<QString, int>>)),
             level, SLOT(spawnEnemiesForBoss(QVector<QPair<QString, int>>)));
 
-    qDebug() << "[WashMachineBoss] 信号已连接到Level";
+    qCDebug(lcBoss) << "[WashMachineBoss] 信号已连接到Level";
 }
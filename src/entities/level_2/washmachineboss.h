@@ -6,6 +6,7 @@
 #include <QPointer>
 #include <QTimer>
 #include <QVector>
+#include "../../core/gametimer.h"
 #include "../boss.h"
 
 class OrbitingSock;
@@ -106,9 +107,9 @@ class WashMachineBoss : public Boss {
     QGraphicsScene* m_scene;
 
     // ========== 普通阶段 - 水柱攻击 ==========
-    QTimer* m_waterAttackTimer;  // 水柱攻击定时器
-    bool m_isCharging;           // 是否正在蓄力
-    QTimer* m_chargeTimer;       // 蓄力定时器
+    GameTimer* m_waterAttackTimer;  // 水柱攻击定时器
+    bool m_isCharging;              // 是否正在蓄力
+    GameTimer* m_chargeTimer;       // 蓄力定时器
 
     void startWaterAttackCycle();
 
@@ -119,7 +120,7 @@ class WashMachineBoss : public Boss {
     void createWaterWave(int direction);  // 0=上, 1=下, 2=左, 3=右
 
     // ========== 愤怒阶段 - 召唤臭袜子 ==========
-    QTimer* m_summonTimer;                            // 召唤定时器
+    GameTimer* m_summonTimer;                         // 召唤定时器
     QVector<QPointer<OrbitingSock>> m_orbitingSocks;  // 围绕的臭袜子
 
     void startSummonCycle();
@@ -130,9 +131,9 @@ class WashMachineBoss : public Boss {
     void cleanupOrbitingSocks();
 
     // ========== 变异阶段 - 毒气攻击 ==========
-    QTimer* m_toxicGasTimer;  // 扩散毒气定时器
-    QTimer* m_fastGasTimer;   // 追踪毒气定时器
-    double m_spiralAngle;     // 螺旋发射角度（度）
+    GameTimer* m_toxicGasTimer;  // 扩散毒气定时器
+    GameTimer* m_fastGasTimer;   // 追踪毒气定时器
+    double m_spiralAngle;        // 螺旋发射角度（度）
 
     void startToxicGasCycle();
 
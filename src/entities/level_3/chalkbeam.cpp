@@ -4,7 +4,10 @@
 #include <QPen>
 #include <QtMath>
 #include "../../core/audiomanager.h"
-#include "../../ui/explosion.h"
+#include "../../core/logging.h"
+#include "../../core/timerwheel.h"
+#include "../../ui/effectsystem.h"
+#include "../../world/entityregistry.h"
 #include "../player.h"
 
 ChalkBeam::ChalkBeam(QPointF targetPos, const QPixmap &beamPic, QGraphicsScene *scene)
@@ -38,7 +41,7 @@ ChalkBeam::ChalkBeam(QPointF targetPos, const QPixmap &beamPic, QGraphicsScene *
     setVisible(false);
     setZValue(90);  // 在大多数物体之上
 
-    qDebug() << "[ChalkBeam] 创建粉笔光束，目标位置:" << m_targetPos;
+    qCDebug(lcBoss) << "[ChalkBeam] 创建粉笔光束，目标位置:" << m_targetPos;
 }
 
 ChalkBeam::~ChalkBeam() {
@@ -54,7 +57,7 @@ ChalkBeam::~ChalkBeam() {
         m_scene->removeItem(m_warningCircle);
         delete m_warningCircle;
     }
-    qDebug() << "[ChalkBeam] 粉笔光束销毁";
+    qCDebug(lcBoss) << "[ChalkBeam] 粉笔光束销毁";
 }
 
 void ChalkBeam::startWarning() {
@@ -62,12 +65,12 @@ void ChalkBeam::startWarning() {
     createWarningCircle();
 
     // 启动警告定时器
-    m_warningTimer = new QTimer(this);
+    m_warningTimer = new GameTimer(this);
     m_warningTimer->setSingleShot(true);
-    connect(m_warningTimer, &QTimer::timeout, this, &ChalkBeam::onWarningTimeout);
+    connect(m_warningTimer, &GameTimer::timeout, this, &ChalkBeam::onWarningTimeout);
     m_warningTimer->start(m_warningTime);
 
-    qDebug() << "[ChalkBeam] 开始警告，" << m_warningTime << "ms后落下";
+    qCDebug(lcBoss) << "[ChalkBeam] 开始警告，" << m_warningTime << "ms后落下";
 }
 
 void ChalkBeam::createWarningCircle() {
@@ -92,7 +95,7 @@ void ChalkBeam::createWarningCircle() {
 }
 
 void ChalkBeam::onWarningTimeout() {
-    qDebug() << "[ChalkBeam] 警告结束，开始落下";
+    qCDebug(lcBoss) << "[ChalkBeam] 警告结束，开始落下";
     startFalling();
 }
 
@@ -103,8 +106,8 @@ void ChalkBeam::startFalling() {
     setPos(m_targetPos.x() - pixmap().width() / 2, m_currentY);
 
     // 启动下落定时器
-    m_fallTimer = new QTimer(this);
-    connect(m_fallTimer, &QTimer::timeout, this, &ChalkBeam::onFallTimer);
+    m_fallTimer = new GameTimer(this);
+    connect(m_fallTimer, &GameTimer::timeout, this, &ChalkBeam::onFallTimer);
     m_fallTimer->start(16);  // 约60fps
 }
 
@@ -124,18 +127,13 @@ void ChalkBeam::explode() {
         return;
     m_isDestroying = true;
 
-    qDebug() << "[ChalkBeam] 粉笔落地，爆炸！";
+    qCDebug(lcBoss) << "[ChalkBeam] 粉笔落地，爆炸！";
 
     // 播放爆炸音效
     AudioManager::instance().playSound("enemy_death");
 
     // 创建爆炸动画
-    if (m_scene) {
-        Explosion *explosion = new Explosion();
-        explosion->setPos(m_targetPos);
-        m_scene->addItem(explosion);
-        explosion->startAnimation();
-    }
+    EffectSystem::spawnExplosion(m_scene, m_targetPos);
 
     // 对范围内玩家造成伤害
     damagePlayer();
@@ -148,7 +146,7 @@ void ChalkBeam::explode() {
     }
 
     // 延迟删除自己
-    QTimer::singleShot(100, this, &ChalkBeam::onExplosionComplete);
+    TimerWheel::instance().schedule(this, 100, &ChalkBeam::onExplosionComplete);
 }
 
 void ChalkBeam::damagePlayer() {
@@ -156,25 +154,21 @@ void ChalkBeam::damagePlayer() {
         return;
 
     // 查找场景中的玩家
-    QList<QGraphicsItem *> items = m_scene->items();
-    for (QGraphicsItem *item: items) {
-        Player *player = dynamic_cast<Player *>(item);
-        if (player) {
-            // 计算与玩家的距离
-            QPointF playerCenter = player->pos() +
-                                   QPointF(player->boundingRect().width() / 2, player->boundingRect().height() / 2);
-
-            double dx = playerCenter.x() - m_targetPos.x();
-            double dy = playerCenter.y() - m_targetPos.y();
-            double distance = qSqrt(dx * dx + dy * dy);
-
-            // 如果在爆炸范围内
-            if (distance < m_explosionRadius) {
-                player->takeDamage(m_damage);
-                qDebug() << "[ChalkBeam] 玩家在爆炸范围内，造成" << m_damage << "点伤害";
-            }
-            break;
+    for (Player *player: EntityRegistry::instance().inScene<Player>(EntityKind::Player, m_scene)) {
+        // 计算与玩家的距离
+        QPointF playerCenter = player->pos() +
+                               QPointF(player->boundingRect().width() / 2, player->boundingRect().height() / 2);
+
+        double dx = playerCenter.x() - m_targetPos.x();
+        double dy = playerCenter.y() - m_targetPos.y();
+        double distance = qSqrt(dx * dx + dy * dy);
+
+        // 如果在爆炸范围内
+        if (distance < m_explosionRadius) {
+            player->takeDamage(m_damage);
+            qCDebug(lcBoss) << "[ChalkBeam] 玩家在爆炸范围内，造成" << m_damage << "点伤害";
         }
+        break;
     }
 }
 
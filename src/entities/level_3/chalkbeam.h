@@ -8,6 +8,7 @@
 #include <QPixmap>
 #include <QPointF>
 #include <QTimer>
+#include "../../core/gametimer.h"
 
 class Player;
 
@@ -60,8 +61,8 @@ private:
     QPixmap m_beamPixmap;  // 粉笔图片
 
     QGraphicsEllipseItem *m_warningCircle;  // 警告圈
-    QTimer *m_warningTimer;                 // 警告定时器
-    QTimer *m_fallTimer;                    // 下落定时器
+    GameTimer *m_warningTimer;              // 警告定时器
+    GameTimer *m_fallTimer;                 // 下落定时器
 
     int m_warningTime;         // 警告时间（毫秒）
     int m_damage;              // 伤害
@@ -1,6 +1,7 @@
 #include "digitalsystemenemy.h"
 #include <QDebug>
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
 
 DigitalSystemEnemy::DigitalSystemEnemy(const QPixmap& pic, double scale)
     : ScalingEnemy(pic, scale) {
@@ -11,5 +12,5 @@ DigitalSystemEnemy::DigitalSystemEnemy(const QPixmap& pic, double scale)
     setCircleRadius(config.getEnemyDouble("digital_system", "circle_radius", 180.0));
     setSpeed(config.getEnemyDouble("digital_system", "speed", 2.5));
 
-    qDebug() << "创建DigitalSystem敌人";
+    qCDebug(lcAi) << "创建DigitalSystem敌人";
 }
@@ -1,9 +1,10 @@
 #include "exampaper.h"
 #include <QDebug>
-#include <QFont>
 #include <QGraphicsScene>
-#include <QGraphicsTextItem>
 #include "../../core/audiomanager.h"
+#include "../../core/logging.h"
+#include "../../core/timerwheel.h"
+#include "../../ui/floatingtextlayer.h"
 #include "../entity.h"
 #include "../player.h"
 
@@ -38,11 +39,11 @@ ExamPaper::ExamPaper(QPointF startPos, QPointF direction, const QPixmap& pic, Pl
     setTransformOriginPoint(boundingRect().center());
 
     // 启动移动定时器
-    m_moveTimer = new QTimer(this);
-    connect(m_moveTimer, &QTimer::timeout, this, &ExamPaper::onMoveTimer);
+    m_moveTimer = new GameTimer(this);
+    connect(m_moveTimer, &GameTimer::timeout, this, &ExamPaper::onMoveTimer);
     m_moveTimer->start(16);  // 约60fps
 
-    qDebug() << "[ExamPaper] 创建考卷，起始位置:" << startPos;
+    qCDebug(lcBoss) << "[ExamPaper] 创建考卷，起始位置:" << startPos;
 }
 
 ExamPaper::~ExamPaper() {
@@ -51,7 +52,7 @@ ExamPaper::~ExamPaper() {
         delete m_moveTimer;
         m_moveTimer = nullptr;
     }
-    qDebug() << "[ExamPaper] 考卷销毁";
+    qCDebug(lcBoss) << "[ExamPaper] 考卷销毁";
 }
 
 void ExamPaper::onMoveTimer() {
@@ -105,51 +106,34 @@ void ExamPaper::applyStunEffect() {
     if (m_player->isEffectOnCooldown())
         return;
 
-    qDebug() << "[ExamPaper] 考卷击中玩家！触发晕厥效果，持续" << m_stunDuration << "ms";
+    qCDebug(lcBoss) << "[ExamPaper] 考卷击中玩家！触发晕厥效果，持续" << m_stunDuration << "ms";
 
     // 设置效果冷却
     m_player->setEffectCooldown(true);
 
     // 显示"晕厥"文字提示
-    QGraphicsTextItem* stunText = new QGraphicsTextItem("晕厥!");
-    QFont font;
-    font.setPointSize(16);
-    font.setBold(true);
-    stunText->setFont(font);
-    stunText->setDefaultTextColor(QColor(255, 165, 0));  // 橙色
-    stunText->setPos(m_player->pos().x(), m_player->pos().y() - 40);
-    stunText->setZValue(200);
-    scene()->addItem(stunText);
+    FloatingTextLayer::showLabel(scene(), "晕厥!", QColor(255, 165, 0), m_player, QPointF(0, -40), m_stunDuration);  // 橙色
 
     // 禁用玩家移动
     m_player->setCanMove(false);
 
-    // 保存玩家指针和文字指针（用于lambda）
+    // 保存玩家指针（用于lambda）
     QPointer<Player> playerPtr = m_player;
-    QPointer<QGraphicsTextItem> stunTextPtr = stunText;
 
     // 晕厥结束后恢复移动
     // 使用 m_player 作为上下文对象，确保 player 销毁时回调不会执行
-    QTimer::singleShot(m_stunDuration, m_player, [playerPtr, stunTextPtr]() {
+    TimerWheel::instance().schedule(m_player.data(), m_stunDuration, [playerPtr]() {
         if (playerPtr) {
             playerPtr->setCanMove(true);
-            qDebug() << "[ExamPaper] 晕厥效果结束，玩家恢复移动";
+            qCDebug(lcBoss) << "[ExamPaper] 晕厥效果结束，玩家恢复移动";
 
             // 3秒后解除冷却，同样使用 player 作为上下文
-            QTimer::singleShot(3000, playerPtr.data(), [playerPtr]() {
+            TimerWheel::instance().schedule(playerPtr.data(), 3000, [playerPtr]() {
                 if (playerPtr) {
                     playerPtr->setEffectCooldown(false);
                 }
             });
         }
-
-        // 删除文字
-        if (stunTextPtr) {
-            if (stunTextPtr->scene()) {
-                stunTextPtr->scene()->removeItem(stunTextPtr);
-            }
-            delete stunTextPtr;
-        }
     });
 }
 
@@ -7,6 +7,7 @@
 #include <QPointF>
 #include <QPointer>
 #include <QTimer>
+#include "../../core/gametimer.h"
 
 class Player;
 
@@ -51,7 +52,7 @@ private:
     void destroy();
 
     QPointer<Player> m_player;
-    QTimer *m_moveTimer;
+    GameTimer *m_moveTimer;
 
     QPointF m_direction;     // 移动方向（归一化）
     double m_speed;          // 移动速度
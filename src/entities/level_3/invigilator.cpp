@@ -3,6 +3,7 @@
 #include <QGraphicsScene>
 #include <QtMath>
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
 #include "../player.h"
 #include "teacherboss.h"
 
@@ -17,31 +18,19 @@ Invigilator::Invigilator(const QPixmap& normalPic, const QPixmap& angryPic, Teac
       m_patrolSpeed(0.03),
       m_patrolTimer(nullptr),
       m_detectionRange(150.0) {
-    // 从配置文件读取监考员属性
-    ConfigManager& config = ConfigManager::instance();
-    setHealth(config.getEnemyInt("invigilator", "health", 15));
-    setContactDamage(config.getEnemyInt("invigilator", "contact_damage", 1));
-    setVisionRange(config.getEnemyDouble("invigilator", "vision_range", 200));
-    setAttackRange(config.getEnemyDouble("invigilator", "attack_range", 30));
-    setSpeed(config.getEnemyDouble("invigilator", "speed", 2.0));
-    m_patrolRadius = config.getEnemyDouble("invigilator", "patrol_radius", 100.0);
-    m_detectionRange = config.getEnemyDouble("invigilator", "detection_range", 150.0);
-
-    // 标记为被召唤的敌人
-    setIsSummoned(true);
+    applyConfig();
 
     // 停止默认AI，使用自定义巡逻
-    if (aiTimer)
-        aiTimer->stop();
+    setAIEnabled(false);
     if (moveTimer)
         moveTimer->stop();
 
     // 创建巡逻定时器
-    m_patrolTimer = new QTimer(this);
-    connect(m_patrolTimer, &QTimer::timeout, this, &Invigilator::onPatrolTimer);
+    m_patrolTimer = new GameTimer(this);
+    connect(m_patrolTimer, &GameTimer::timeout, this, &Invigilator::onPatrolTimer);
     m_patrolTimer->start(30);  // 约33fps
 
-    qDebug() << "[Invigilator] 监考员创建";
+    qCDebug(lcAi) << "[Invigilator] 监考员创建";
 }
 
 Invigilator::~Invigilator() {
@@ -50,7 +39,36 @@ Invigilator::~Invigilator() {
         delete m_patrolTimer;
         m_patrolTimer = nullptr;
     }
-    qDebug() << "[Invigilator] 监考员销毁";
+    qCDebug(lcAi) << "[Invigilator] 监考员销毁";
+}
+
+void Invigilator::applyConfig() {
+    // 从配置文件读取监考员属性
+    ConfigManager& config = ConfigManager::instance();
+    setHealth(config.getEnemyInt("invigilator", "health", 15));
+    setContactDamage(config.getEnemyInt("invigilator", "contact_damage", 1));
+    setVisionRange(config.getEnemyDouble("invigilator", "vision_range", 200));
+    setAttackRange(config.getEnemyDouble("invigilator", "attack_range", 30));
+    setSpeed(config.getEnemyDouble("invigilator", "speed", 2.0));
+    m_patrolRadius = config.getEnemyDouble("invigilator", "patrol_radius", 100.0);
+    m_detectionRange = config.getEnemyDouble("invigilator", "detection_range", 150.0);
+
+    // 标记为被召唤的敌人
+    setIsSummoned(true);
+}
+
+void Invigilator::onReset() {
+    // 追击状态下修改过的移动参数恢复为 Enemy 的默认值
+    if (m_state == CHASE) {
+        setPixmap(m_normalPixmap);
+        setMovementPattern(MOVE_DIRECT);
+        setDashSpeed(4.0);
+        setDashChargeTime(1500);
+    }
+    m_state = PATROL;
+    m_patrolAngle = 0.0;
+
+    applyConfig();
 }
 
 void Invigilator::onPatrolTimer() {
@@ -103,12 +121,11 @@ void Invigilator::switchToChase() {
     setVisionRange(1000);  // 扩大视野
 
     // 恢复默认AI
-    if (aiTimer)
-        aiTimer->start();
+    setAIEnabled(true);
     if (moveTimer)
         moveTimer->start();
 
-    qDebug() << "[Invigilator] 监考员发现玩家，进入追击状态！";
+    qCDebug(lcAi) << "[Invigilator] 监考员发现玩家，进入追击状态！";
 }
 
 void Invigilator::updatePatrol() {
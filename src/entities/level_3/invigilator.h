@@ -2,6 +2,7 @@
 #define INVIGILATOR_H
 
 #include <QTimer>
+#include "../../core/gametimer.h"
 #include "../enemy.h"
 
 class TeacherBoss;
@@ -32,11 +33,17 @@ public:
     // 获取主人
     TeacherBoss *getMaster() const { return m_master; }
 
+    // 对象池复用时重新绑定主人
+    void setMaster(TeacherBoss *master) { m_master = master; }
+
     // 设置巡逻参数
     void setPatrolRadius(double radius) { m_patrolRadius = radius; }
 
     void setPatrolSpeed(double speed) { m_patrolSpeed = speed; }
 
+protected:
+    void onReset() override;  // 对象池复用：回到巡逻状态
+
 private:
     // 状态
     enum InvigilatorState {
@@ -50,15 +57,16 @@ private:
     QPixmap m_angryPixmap;     // 愤怒图片
 
     // 巡逻参数
-    double m_patrolAngle;   // 当前巡逻角度（弧度）
-    double m_patrolRadius;  // 巡逻半径
-    double m_patrolSpeed;   // 巡逻速度（弧度/帧）
-    QTimer *m_patrolTimer;  // 巡逻更新定时器
+    double m_patrolAngle;      // 当前巡逻角度（弧度）
+    double m_patrolRadius;     // 巡逻半径
+    double m_patrolSpeed;      // 巡逻速度（弧度/帧）
+    GameTimer *m_patrolTimer;  // 巡逻更新定时器
 
     // 视野参数
     double m_detectionRange;  // 发现玩家的距离
 
     // 私有方法
+    void applyConfig();           // 读取配置属性（构造和对象池复用时调用）
     void updatePatrol();          // 更新巡逻位置
     void checkPlayerDetection();  // 检测玩家
     void switchToChase();         // 切换到追击状态
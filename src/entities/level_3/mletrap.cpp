@@ -1,9 +1,11 @@
 #include "mletrap.h"
 #include <QDebug>
-#include <QFont>
 #include <QGraphicsScene>
-#include <QGraphicsTextItem>
 #include <QtMath>
+#include "../../core/logging.h"
+#include "../../core/timerwheel.h"
+#include "../../ui/floatingtextlayer.h"
+#include "../../world/triggersystem.h"
 #include "../player.h"
 
 MleTrap::MleTrap(QPointF position, Player* player)
@@ -23,21 +25,22 @@ MleTrap::MleTrap(QPointF position, Player* player)
     setPos(m_position);
     setZValue(50);  // 在地面之上
 
-    // 启动更新定时器（检测碰撞和动画）
-    m_updateTimer = new QTimer(this);
-    connect(m_updateTimer, &QTimer::timeout, this, &MleTrap::onUpdateTimer);
+    // 启动动画定时器（玩家踩中由加入场景时注册的触发区域检测）
+    m_updateTimer = new GameTimer(this);
+    connect(m_updateTimer, &GameTimer::timeout, this, &MleTrap::onUpdateTimer);
     m_updateTimer->start(30);  // 约33fps
 
     // 启动生命周期定时器
-    m_lifetimeTimer = new QTimer(this);
+    m_lifetimeTimer = new GameTimer(this);
     m_lifetimeTimer->setSingleShot(true);
-    connect(m_lifetimeTimer, &QTimer::timeout, this, &MleTrap::onLifetimeTimeout);
+    connect(m_lifetimeTimer, &GameTimer::timeout, this, &MleTrap::onLifetimeTimeout);
     m_lifetimeTimer->start(m_lifetime);
 
-    qDebug() << "[MleTrap] 创建极大似然估计陷阱，位置:" << m_position;
+    qCDebug(lcCollision) << "[MleTrap] 创建极大似然估计陷阱，位置:" << m_position;
 }
 
 MleTrap::~MleTrap() {
+    TriggerSystem::instance().removeOwner(this);
     if (m_updateTimer) {
         m_updateTimer->stop();
         delete m_updateTimer;
@@ -48,7 +51,25 @@ MleTrap::~MleTrap() {
         delete m_lifetimeTimer;
         m_lifetimeTimer = nullptr;
     }
-    qDebug() << "[MleTrap] 陷阱销毁";
+    qCDebug(lcCollision) << "[MleTrap] 陷阱销毁";
+}
+
+QVariant MleTrap::itemChange(GraphicsItemChange change, const QVariant &value) {
+    if (change == ItemSceneHasChanged) {
+        TriggerSystem::instance().removeOwner(this);
+        if (scene() && !m_triggered && !m_isDestroying) {
+            // 玩家中心进入圆内即触发；放置时玩家已站在圆内也会在下一个移动节拍触发
+            TriggerSystem::instance().addZone(
+                this, TriggerVolume::circle(pos(), m_radius, TriggerAnchor::PlayerCenter),
+                [this](TriggerEvent event) {
+                    if (event == TriggerEvent::Enter) {
+                        onPlayerEntered();
+                    }
+                },
+                true);
+        }
+    }
+    return QGraphicsItem::itemChange(change, value);
 }
 
 QRectF MleTrap::boundingRect() const {
@@ -115,34 +136,20 @@ void MleTrap::onUpdateTimer() {
         m_spiralAngle -= 2 * M_PI;
     }
 
-    // 检测玩家碰撞
-    checkPlayerCollision();
-
     // 触发重绘
     update();
 }
 
-void MleTrap::checkPlayerCollision() {
+void MleTrap::onPlayerEntered() {
     if (!m_player || m_triggered || m_isDestroying)
         return;
 
-    // 计算玩家中心与陷阱中心的距离
-    QPointF playerCenter = m_player->pos() +
-                           QPointF(m_player->boundingRect().width() / 2, m_player->boundingRect().height() / 2);
-    QPointF trapCenter = pos();
-
-    double dx = playerCenter.x() - trapCenter.x();
-    double dy = playerCenter.y() - trapCenter.y();
-    double distance = qSqrt(dx * dx + dy * dy);
+    m_triggered = true;
+    TriggerSystem::instance().removeOwner(this);
+    applyRootEffect();
 
-    // 如果玩家在陷阱范围内
-    if (distance < m_radius) {
-        m_triggered = true;
-        applyRootEffect();
-
-        // 触发后延迟销毁
-        QTimer::singleShot(500, this, &MleTrap::destroy);
-    }
+    // 触发后延迟销毁
+    TimerWheel::instance().schedule(this, 500, &MleTrap::destroy);
 }
 
 void MleTrap::applyRootEffect() {
@@ -157,56 +164,39 @@ void MleTrap::applyRootEffect() {
     if (m_player->isEffectOnCooldown())
         return;
 
-    qDebug() << "[MleTrap] 玩家踩中陷阱！定身" << m_rootDuration << "ms";
+    qCDebug(lcCollision) << "[MleTrap] 玩家踩中陷阱！定身" << m_rootDuration << "ms";
 
     // 设置效果冷却
     m_player->setEffectCooldown(true);
 
     // 显示"定身"文字提示
-    QGraphicsTextItem* rootText = new QGraphicsTextItem("定身!");
-    QFont font;
-    font.setPointSize(16);
-    font.setBold(true);
-    rootText->setFont(font);
-    rootText->setDefaultTextColor(QColor(255, 0, 0));  // 红色
-    rootText->setPos(m_player->pos().x(), m_player->pos().y() - 40);
-    rootText->setZValue(200);
-    scene()->addItem(rootText);
+    FloatingTextLayer::showLabel(scene(), "定身!", QColor(255, 0, 0), m_player, QPointF(0, -40), m_rootDuration);  // 红色
 
     // 禁用玩家移动
     m_player->setCanMove(false);
 
-    // 保存玩家指针和文字指针
+    // 保存玩家指针
     QPointer<Player> playerPtr = m_player;
-    QPointer<QGraphicsTextItem> rootTextPtr = rootText;
 
     // 定身结束后恢复移动
     // 使用 m_player 作为上下文对象，确保 player 销毁时回调不会执行
-    QTimer::singleShot(m_rootDuration, m_player, [playerPtr, rootTextPtr]() {
+    TimerWheel::instance().schedule(m_player.data(), m_rootDuration, [playerPtr]() {
         if (playerPtr) {
             playerPtr->setCanMove(true);
-            qDebug() << "[MleTrap] 定身效果结束，玩家恢复移动";
+            qCDebug(lcCollision) << "[MleTrap] 定身效果结束，玩家恢复移动";
 
             // 3秒后解除冷却，同样使用 player 作为上下文
-            QTimer::singleShot(3000, playerPtr.data(), [playerPtr]() {
+            TimerWheel::instance().schedule(playerPtr.data(), 3000, [playerPtr]() {
                 if (playerPtr) {
                     playerPtr->setEffectCooldown(false);
                 }
             });
         }
-
-        // 删除文字
-        if (rootTextPtr) {
-            if (rootTextPtr->scene()) {
-                rootTextPtr->scene()->removeItem(rootTextPtr);
-            }
-            delete rootTextPtr;
-        }
     });
 }
 
 void MleTrap::onLifetimeTimeout() {
-    qDebug() << "[MleTrap] 陷阱超时，消失";
+    qCDebug(lcCollision) << "[MleTrap] 陷阱超时，消失";
     destroy();
 }
 
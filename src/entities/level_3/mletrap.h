@@ -8,6 +8,7 @@
 #include <QPointF>
 #include <QPointer>
 #include <QTimer>
+#include "../../core/gametimer.h"
 
 class Player;
 
@@ -39,6 +40,9 @@ public:
 
     void setLifetime(int ms) { m_lifetime = ms; }
 
+protected:
+    QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
+
 private slots:
 
     void onUpdateTimer();
@@ -46,7 +50,7 @@ private slots:
     void onLifetimeTimeout();
 
 private:
-    void checkPlayerCollision();
+    void onPlayerEntered();
 
     void applyRootEffect();
 
@@ -55,8 +59,8 @@ private:
     void drawSpiral(QPainter *painter);
 
     QPointer<Player> m_player;
-    QTimer *m_updateTimer;    // 更新定时器
-    QTimer *m_lifetimeTimer;  // 生命周期定时器
+    GameTimer *m_updateTimer;    // 动画定时器
+    GameTimer *m_lifetimeTimer;  // 生命周期定时器
 
     QPointF m_position;    // 陷阱位置
     double m_radius;       // 陷阱半径
@@ -1,6 +1,7 @@
 #include "optimizationenemy.h"
 #include <QDebug>
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
 
 OptimizationEnemy::OptimizationEnemy(const QPixmap& pic, double scale)
     : ScalingEnemy(pic, scale) {
@@ -11,5 +12,5 @@ OptimizationEnemy::OptimizationEnemy(const QPixmap& pic, double scale)
     setCircleRadius(config.getEnemyDouble("optimization", "circle_radius", 180.0));
     setSpeed(config.getEnemyDouble("optimization", "speed", 2.5));
 
-    qDebug() << "创建Optimization敌人";
+    qCDebug(lcAi) << "创建Optimization敌人";
 }
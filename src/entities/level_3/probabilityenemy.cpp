@@ -6,19 +6,22 @@
 #include <QtMath>
 #include "../../core/audiomanager.h"
 #include "../../core/configmanager.h"
-#include "../../ui/explosion.h"
+#include "../../core/logging.h"
+#include "../../core/timerwheel.h"
+#include "../../ui/effectsystem.h"
+#include "../../world/crowdsystem.h"
 #include "../player.h"
 
 // HealTextController 实现
 HealTextController::HealTextController(Enemy* target, QGraphicsTextItem* textItem, QObject* parent)
     : QObject(parent), m_target(target), m_textItem(textItem), m_updateTimer(nullptr) {
     // 创建位置更新定时器
-    m_updateTimer = new QTimer(this);
-    connect(m_updateTimer, &QTimer::timeout, this, &HealTextController::updatePosition);
+    m_updateTimer = new GameTimer(this);
+    connect(m_updateTimer, &GameTimer::timeout, this, &HealTextController::updatePosition);
     m_updateTimer->start(16);  // 约60fps更新位置
 
     // 1.5秒后清理
-    QTimer::singleShot(1500, this, &HealTextController::cleanup);
+    TimerWheel::instance().schedule(this, 1500, &HealTextController::cleanup);
 }
 
 HealTextController::~HealTextController() {
@@ -78,9 +81,7 @@ ProbabilityEnemy::ProbabilityEnemy(const QPixmap& pic, double scale)
     setSpeed(0);        // 不移动
 
     // 停止所有继承的定时器（因为不需要移动、AI和攻击检测）
-    if (aiTimer) {
-        aiTimer->stop();
-    }
+    setAIEnabled(false);
     if (moveTimer) {
         moveTimer->stop();
     }
@@ -92,25 +93,25 @@ ProbabilityEnemy::ProbabilityEnemy(const QPixmap& pic, double scale)
     updateScale();
 
     // 创建成长定时器
-    m_growthTimer = new QTimer(this);
-    connect(m_growthTimer, &QTimer::timeout, this, &ProbabilityEnemy::onGrowthUpdate);
+    m_growthTimer = new GameTimer(this);
+    connect(m_growthTimer, &GameTimer::timeout, this, &ProbabilityEnemy::onGrowthUpdate);
     m_growthTimer->start(GROWTH_UPDATE_INTERVAL);
 
     // 创建闪烁定时器
-    m_blinkTimer = new QTimer(this);
-    connect(m_blinkTimer, &QTimer::timeout, this, &ProbabilityEnemy::onBlinkTimeout);
+    m_blinkTimer = new GameTimer(this);
+    connect(m_blinkTimer, &GameTimer::timeout, this, &ProbabilityEnemy::onBlinkTimeout);
 
     // 创建爆炸定时器
-    m_explodeTimer = new QTimer(this);
+    m_explodeTimer = new GameTimer(this);
     m_explodeTimer->setSingleShot(true);
-    connect(m_explodeTimer, &QTimer::timeout, this, &ProbabilityEnemy::onExplodeTimeout);
+    connect(m_explodeTimer, &GameTimer::timeout, this, &ProbabilityEnemy::onExplodeTimeout);
 
     // 创建接触检测定时器（给敌人回血）
-    m_contactTimer = new QTimer(this);
-    connect(m_contactTimer, &QTimer::timeout, this, &ProbabilityEnemy::onContactCheck);
+    m_contactTimer = new GameTimer(this);
+    connect(m_contactTimer, &GameTimer::timeout, this, &ProbabilityEnemy::onContactCheck);
     m_contactTimer->start(CONTACT_CHECK_INTERVAL);
 
-    qDebug() << "ProbabilityEnemy 创建完成 - 初始缩放:" << m_currentScale
+    qCDebug(lcAi) << "ProbabilityEnemy 创建完成 - 初始缩放:" << m_currentScale
              << "最大缩放:" << m_maxScale << "成长时间:" << GROWTH_DURATION_MS << "ms";
 }
 
@@ -149,23 +150,25 @@ bool ProbabilityEnemy::hasContactingEnemies() const {
     if (!scene())
         return false;
 
-    // 检测是否有其他敌人与概率论接触
-    QList<QGraphicsItem*> collisions = collidingItems();
-    for (QGraphicsItem* item : collisions) {
-        Enemy* enemy = dynamic_cast<Enemy*>(item);
-        if (!enemy)
-            continue;
+    const qint64 now = GameClock::instance().now();
+    if (now == m_contactCheckedAt)
+        return m_hasContact;
+    m_contactCheckedAt = now;
+    m_hasContact = false;
 
+    // 检测是否有其他敌人与概率论接触（网格粗筛包围盒，只对候选做像素检测）
+    for (Enemy* enemy : CrowdSystem::instance().overlapping(this)) {
         // 跳过其他概率论敌人
-        if (dynamic_cast<const ProbabilityEnemy*>(enemy))
+        if (qobject_cast<const ProbabilityEnemy*>(enemy))
             continue;
 
         // 使用像素级碰撞检测
         if (Entity::pixelCollision(const_cast<ProbabilityEnemy*>(this), enemy)) {
-            return true;
+            m_hasContact = true;
+            break;
         }
     }
-    return false;
+    return m_hasContact;
 }
 
 void ProbabilityEnemy::takeDamage(int damage) {
@@ -202,7 +205,7 @@ void ProbabilityEnemy::onGrowthUpdate() {
         m_growthTimer->stop();
         startBlinking();
 
-        qDebug() << "ProbabilityEnemy 成长完成，开始闪烁";
+        qCDebug(lcAi) << "ProbabilityEnemy 成长完成，开始闪烁";
     } else {
         // 线性插值计算当前缩放
         m_currentScale = m_initialScale + (m_maxScale - m_initialScale) * progress;
@@ -252,7 +255,7 @@ void ProbabilityEnemy::startBlinking() {
     // 2.5秒后爆炸
     m_explodeTimer->start(EXPLODE_DELAY);
 
-    qDebug() << "ProbabilityEnemy 开始闪烁，" << EXPLODE_DELAY << "ms 后爆炸";
+    qCDebug(lcAi) << "ProbabilityEnemy 开始闪烁，" << EXPLODE_DELAY << "ms 后爆炸";
 }
 
 void ProbabilityEnemy::onBlinkTimeout() {
@@ -280,16 +283,10 @@ void ProbabilityEnemy::onContactCheck() {
 }
 
 void ProbabilityEnemy::healContactingEnemies() {
-    // 检测与概率论接触的敌人，给它们回血
-    QList<QGraphicsItem*> collisions = collidingItems();
-    for (QGraphicsItem* item : collisions) {
-        // 跳过非敌人
-        Enemy* enemy = dynamic_cast<Enemy*>(item);
-        if (!enemy)
-            continue;
-
+    // 检测与概率论接触的敌人，给它们回血（网格粗筛包围盒，只对候选做像素检测）
+    for (Enemy* enemy : CrowdSystem::instance().overlapping(this)) {
         // 跳过其他概率论敌人
-        if (dynamic_cast<ProbabilityEnemy*>(enemy))
+        if (qobject_cast<ProbabilityEnemy*>(enemy))
             continue;
 
         // 使用像素级碰撞检测
@@ -321,7 +318,7 @@ void ProbabilityEnemy::healContactingEnemies() {
             // 创建控制器来管理文字跟随和清理
             new HealTextController(enemy, textItem);
 
-            qDebug() << "ProbabilityEnemy 给敌人回血" << actualHeal << "点，当前血量:" << newHealth << "/" << maxHealth;
+            qCDebug(lcAi) << "ProbabilityEnemy 给敌人回血" << actualHeal << "点，当前血量:" << newHealth << "/" << maxHealth;
         }
     }
 }
@@ -352,12 +349,7 @@ void ProbabilityEnemy::explode(bool dealDamage) {
     AudioManager::instance().playSound("enemy_death");
 
     // 创建爆炸动画
-    if (scene()) {
-        auto* explosion = new Explosion();
-        explosion->setPos(this->pos());
-        scene()->addItem(explosion);
-        explosion->startAnimation();
-    }
+    EffectSystem::spawnExplosion(scene(), this->pos());
 
     // 发出dying信号并删除自己
     emit dying(this);
@@ -368,60 +360,52 @@ void ProbabilityEnemy::explode(bool dealDamage) {
 
     deleteLater();
 
-    qDebug() << "ProbabilityEnemy 爆炸！造成伤害:" << dealDamage;
+    qCDebug(lcAi) << "ProbabilityEnemy 爆炸！造成伤害:" << dealDamage;
 }
 
 void ProbabilityEnemy::damageAllEntities() {
     if (!scene())
         return;
 
-    qDebug() << "ProbabilityEnemy 概率爆炸！盛宴降临！";
+    qCDebug(lcAi) << "ProbabilityEnemy 概率爆炸！盛宴降临！";
 
-    // 获取场景中所有物品
-    QList<QGraphicsItem*> allItems = scene()->items();
+    EntityRegistry& registry = EntityRegistry::instance();
 
-    for (QGraphicsItem* item : allItems) {
-        // 跳过自己
-        if (item == this)
-            continue;
+    // 对玩家：强制扣到只剩1滴血
+    for (Player* p : registry.inScene<Player>(EntityKind::Player, scene())) {
+        p->setCurrentHealth(1);
+        qCDebug(lcAi) << "ProbabilityEnemy 将玩家血量强制设为1";
+    }
 
-        // 对玩家：强制扣到只剩1滴血
-        if (Player* p = dynamic_cast<Player*>(item)) {
-            p->setCurrentHealth(1);
-            qDebug() << "ProbabilityEnemy 将玩家血量强制设为1";
+    // 对敌人：强制回满血（不包括自己和其他ProbabilityEnemy）
+    for (Enemy* enemy : registry.inScene<Enemy>(EntityKind::Enemy, scene())) {
+        // 跳过其他概率论敌人
+        if (enemy == this || qobject_cast<ProbabilityEnemy*>(enemy))
             continue;
-        }
 
-        // 对敌人：强制回满血（不包括其他ProbabilityEnemy）
-        if (Enemy* enemy = dynamic_cast<Enemy*>(item)) {
-            // 跳过其他概率论敌人
-            if (dynamic_cast<ProbabilityEnemy*>(enemy))
-                continue;
+        int currentHealth = enemy->getHealth();
+        int maxHealth = enemy->getMaxHealth();
 
-            int currentHealth = enemy->getHealth();
-            int maxHealth = enemy->getMaxHealth();
+        // 只有未满血的敌人才需要回满并显示文字
+        if (currentHealth < maxHealth) {
+            // 回满血
+            enemy->setCurrentHealth(maxHealth);
 
-            // 只有未满血的敌人才需要回满并显示文字
-            if (currentHealth < maxHealth) {
-                // 回满血
-                enemy->setCurrentHealth(maxHealth);
-
-                // 显示绿色跟随文字 "恢复至满额状态！"（位置比普通回血文字更高，防止重叠）
-                QGraphicsTextItem* healText = new QGraphicsTextItem("恢复至满额状态！");
-                QFont font;
-                font.setPointSize(14);
-                font.setBold(true);
-                healText->setFont(font);
-                healText->setDefaultTextColor(QColor(0, 200, 0));                // 绿色
-                healText->setPos(enemy->pos().x() + 20, enemy->pos().y() - 55);  // 比普通回血文字高25像素
-                healText->setZValue(300);
-                scene()->addItem(healText);
-
-                // 创建控制器来管理文字跟随和清理
-                new HealTextController(enemy, healText);
-
-                qDebug() << "ProbabilityEnemy 将敌人血量回满至" << maxHealth;
-            }
+            // 显示绿色跟随文字 "恢复至满额状态！"（位置比普通回血文字更高，防止重叠）
+            QGraphicsTextItem* healText = new QGraphicsTextItem("恢复至满额状态！");
+            QFont font;
+            font.setPointSize(14);
+            font.setBold(true);
+            healText->setFont(font);
+            healText->setDefaultTextColor(QColor(0, 200, 0));                // 绿色
+            healText->setPos(enemy->pos().x() + 20, enemy->pos().y() - 55);  // 比普通回血文字高25像素
+            healText->setZValue(300);
+            scene()->addItem(healText);
+
+            // 创建控制器来管理文字跟随和清理
+            new HealTextController(enemy, healText);
+
+            qCDebug(lcAi) << "ProbabilityEnemy 将敌人血量回满至" << maxHealth;
         }
     }
 
@@ -464,7 +448,7 @@ void ProbabilityEnemy::showExplosionText() {
     QPointer<QGraphicsScene> scenePtr(scene());
 
     // 3秒后删除文字，使用 scenePtr 作为上下文对象（因为this在爆炸后会被删除）
-    QTimer::singleShot(3000, scenePtr.data(), [textPtr, scenePtr]() {
+    TimerWheel::instance().schedule(scenePtr.data(), 3000, [textPtr, scenePtr]() {
         if (textPtr) {
             if (scenePtr && textPtr->scene() == scenePtr) {
                 scenePtr->removeItem(textPtr.data());
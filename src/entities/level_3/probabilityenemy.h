@@ -4,6 +4,7 @@
 #include <QTimer>
 #include <QGraphicsTextItem>
 #include <QPointer>
+#include "../../core/gametimer.h"
 #include "../enemy.h"
 
 class Player;
@@ -25,7 +26,7 @@ private slots:
 private:
     QPointer<Enemy> m_target;
     QGraphicsTextItem *m_textItem;
-    QTimer *m_updateTimer;
+    GameTimer *m_updateTimer;
 };
 
 /**
@@ -51,6 +52,9 @@ public:
     // 检查是否有其他敌人在接触/内部
     bool hasContactingEnemies() const;
 
+    // 有其他敌人与之接触时，子弹穿过概率论
+    bool letsProjectilesPass() const override { return hasContactingEnemies(); }
+
     // 暂停/恢复定时器
     void pauseTimers() override;
     void resumeTimers() override;
@@ -74,16 +78,20 @@ private:
     void healContactingEnemies();         // 给接触的敌人回血
 
     // 定时器
-    QTimer *m_growthTimer;  // 成长定时器
-    QTimer *m_blinkTimer;   // 闪烁定时器
-    QTimer *m_explodeTimer; // 爆炸定时器
-    QTimer *m_contactTimer; // 接触检测定时器
+    GameTimer *m_growthTimer;   // 成长定时器
+    GameTimer *m_blinkTimer;    // 闪烁定时器
+    GameTimer *m_explodeTimer;  // 爆炸定时器
+    GameTimer *m_contactTimer;  // 接触检测定时器
 
     // 状态
     bool m_isBlinking; // 是否正在闪烁
     bool m_exploded;   // 是否已爆炸
     bool m_isRed;      // 当前是否显示红色
 
+    // 接触判定缓存：同一游戏时刻内多颗子弹命中只检测一次
+    mutable qint64 m_contactCheckedAt = -1;
+    mutable bool m_hasContact = false;
+
     // 图片
     QPixmap m_originalPixmap; // 原始图片
     QPixmap m_normalPixmap;   // 当前普通图片
@@ -1,14 +1,16 @@
 #include "scalingenemy.h"
 #include <QDebug>
-#include <QFont>
 #include <QGraphicsScene>
-#include <QGraphicsTextItem>
 #include <QPainter>
 #include <QPointer>
 #include <QRandomGenerator>
 #include <QTimer>
 #include "../../core/audiomanager.h"
-#include "../../ui/explosion.h"
+#include "../../core/logging.h"
+#include "../../core/spritevariantcache.h"
+#include "../../core/timerwheel.h"
+#include "../../ui/effectsystem.h"
+#include "../../ui/floatingtextlayer.h"
 #include "../player.h"
 
 ScalingEnemy::ScalingEnemy(const QPixmap& pic, double scale)
@@ -21,8 +23,7 @@ ScalingEnemy::ScalingEnemy(const QPixmap& pic, double scale)
       m_scaleSpeed(0.04),
       m_scalingUp(true),
       m_originalPixmap(pic),  // 保存原始未缩放图片
-      m_isFlashing(false),
-      m_flashTimer(nullptr) {
+      m_mipLevel(-1) {
     // 设置移动模式为绕圈移动
     setMovementPattern(MOVE_CIRCLE);
 
@@ -42,25 +43,13 @@ ScalingEnemy::ScalingEnemy(const QPixmap& pic, double scale)
     // 设置变换原点为图片中心
     setTransformOriginPoint(m_normalPixmap.width() / 2.0, m_normalPixmap.height() / 2.0);
 
-    // 使用setScale来控制初始大小
-    setScale(m_baseScale * m_currentScale);
+    // 使用 mip 图片 + setScale 来控制初始大小
+    applyScale(m_baseScale * m_currentScale);
 
     // 创建缩放定时器
-    m_scalingTimer = new QTimer(this);
-    connect(m_scalingTimer, &QTimer::timeout, this, &ScalingEnemy::updateScaling);
+    m_scalingTimer = new GameTimer(this);
+    connect(m_scalingTimer, &GameTimer::timeout, this, &ScalingEnemy::updateScaling);
     m_scalingTimer->start(50);
-
-    // 创建闪烁定时器
-    m_flashTimer = new QTimer(this);
-    m_flashTimer->setSingleShot(true);
-    connect(m_flashTimer, &QTimer::timeout, this, &ScalingEnemy::endFlashEffect);
-
-    // 预生成闪烁图片（使用原图）
-    m_flashPixmap = m_normalPixmap;
-    QPainter painter(&m_flashPixmap);
-    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
-    painter.fillRect(m_flashPixmap.rect(), QColor(255, 0, 0, 180));
-    painter.end();
 }
 
 ScalingEnemy::~ScalingEnemy() {
@@ -69,11 +58,6 @@ ScalingEnemy::~ScalingEnemy() {
         delete m_scalingTimer;
         m_scalingTimer = nullptr;
     }
-    if (m_flashTimer) {
-        m_flashTimer->stop();
-        delete m_flashTimer;
-        m_flashTimer = nullptr;
-    }
 }
 
 void ScalingEnemy::pauseTimers() {
@@ -81,9 +65,6 @@ void ScalingEnemy::pauseTimers() {
     if (m_scalingTimer) {
         m_scalingTimer->stop();
     }
-    if (m_flashTimer) {
-        m_flashTimer->stop();
-    }
 }
 
 void ScalingEnemy::resumeTimers() {
@@ -93,15 +74,6 @@ void ScalingEnemy::resumeTimers() {
     }
 }
 
-void ScalingEnemy::updateScaledPixmaps() {
-    // 此方法现在仅用于更新闪烁图片
-    m_flashPixmap = m_normalPixmap;
-    QPainter painter(&m_flashPixmap);
-    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
-    painter.fillRect(m_flashPixmap.rect(), QColor(255, 0, 0, 180));
-    painter.end();
-}
-
 void ScalingEnemy::updateScaling() {
     // 更新缩放比例
     if (m_scalingUp) {
@@ -118,51 +90,59 @@ void ScalingEnemy::updateScaling() {
         }
     }
 
-    // 使用setScale进行变换（保持原图不变，只改变渲染缩放）
     // m_baseScale 是基础大小，m_currentScale 是动态伸缩
     double totalScale = m_baseScale * m_currentScale;
-    setScale(totalScale);
+    applyScale(totalScale);
 
     // 调试输出（每50帧输出一次减少日志量）
     static int debugCounter = 0;
     if (++debugCounter >= 50) {
-        qDebug() << "ScalingEnemy::updateScaling - baseScale:" << m_baseScale
+        qCDebug(lcAi) << "ScalingEnemy::updateScaling - baseScale:" << m_baseScale
                  << "currentScale:" << m_currentScale << "totalScale:" << totalScale;
         debugCounter = 0;
     }
 }
 
+void ScalingEnemy::applyScale(double totalScale) {
+    SpriteVariantCache& cache = SpriteVariantCache::instance();
+    SpriteVariantCache::MipSelection mip = cache.selectMip(m_normalPixmap, totalScale);
+
+    if (mip.level != m_mipLevel) {
+        // 只在跨越 mip 级别时换图（mip 图由同类敌人共享，只生成一次）
+        m_mipLevel = mip.level;
+        QPixmap pix = facingRight ? mip.pixmap : cache.mirrored(mip.pixmap);
+        setPixmap(pix);
+
+        // 变换原点固定在原图中心，用 offset 让较小的 mip 图居中于同一点
+        setOffset((m_normalPixmap.width() - pix.width()) / 2.0, (m_normalPixmap.height() - pix.height()) / 2.0);
+    }
+
+    // 剩余缩放量接近1（放大超过原图时除外），逐帧重采样的开销和失真都很小
+    setScale(mip.residualScale);
+}
+
 void ScalingEnemy::takeDamage(int damage) {
-    // 应用闪烁效果
-    applyFlashEffect();
+    // 闪烁效果（闪烁图来自共享缓存，缩放只作用于渲染，不影响闪烁图）
+    flash();
 
-    // 调用父类处理伤害逻辑（但不调用父类的flash）
     int realDamage = qMax(1, damage);
     health -= realDamage;
 
     if (health <= 0) {
         // 停止定时器
-        if (aiTimer)
-            aiTimer->stop();
+        setAIEnabled(false);
         if (moveTimer)
             moveTimer->stop();
         if (attackTimer)
             attackTimer->stop();
         if (m_scalingTimer)
             m_scalingTimer->stop();
-        if (m_flashTimer)
-            m_flashTimer->stop();
 
         // 播放死亡音效
         AudioManager::instance().playSound("enemy_death");
 
         // 创建爆炸动画
-        Explosion* explosion = new Explosion();
-        explosion->setPos(this->pos());
-        if (scene()) {
-            scene()->addItem(explosion);
-            explosion->startAnimation();
-        }
+        EffectSystem::spawnExplosion(scene(), this->pos());
 
         emit dying(this);
 
@@ -173,17 +153,6 @@ void ScalingEnemy::takeDamage(int damage) {
     }
 }
 
-void ScalingEnemy::applyFlashEffect() {
-    m_isFlashing = true;
-    QGraphicsPixmapItem::setPixmap(m_flashPixmap);
-    m_flashTimer->start(120);  // 120ms后结束闪烁
-}
-
-void ScalingEnemy::endFlashEffect() {
-    m_isFlashing = false;
-    QGraphicsPixmapItem::setPixmap(m_normalPixmap);
-}
-
 QRectF ScalingEnemy::boundingRect() const {
     return QGraphicsPixmapItem::boundingRect();
 }
@@ -211,8 +180,8 @@ void ScalingEnemy::attackPlayer() {
 
     QList<QGraphicsItem*> collisions = collidingItems();
     for (QGraphicsItem* item : collisions) {
-        Player* p = dynamic_cast<Player*>(item);
-        if (p) {
+        if (isEntityKind(item, EntityKind::Player)) {
+            Player* p = static_cast<Player*>(item);
             p->takeDamage(contactDamage);
 
             if (QRandomGenerator::global()->bounded(100) < 50) {
@@ -233,40 +202,25 @@ void ScalingEnemy::applySleepEffect() {
     if (player->isEffectOnCooldown())
         return;
 
-    qDebug() << "ScalingEnemy触发昏睡效果！";
+    qCDebug(lcAi) << "ScalingEnemy触发昏睡效果！";
 
     player->setEffectCooldown(true);
 
-    QGraphicsTextItem* sleepText = new QGraphicsTextItem("昏睡ZZZ");
-    QFont font;
-    font.setPointSize(16);
-    font.setBold(true);
-    sleepText->setFont(font);
-    sleepText->setDefaultTextColor(QColor(128, 128, 128));
-    sleepText->setPos(player->pos().x(), player->pos().y() - 40);
-    sleepText->setZValue(200);
-    scene()->addItem(sleepText);
+    FloatingTextLayer::showLabel(scene(), "昏睡ZZZ", QColor(128, 128, 128), player, QPointF(0, -40), 1500);
 
     player->setCanMove(false);
 
     QPointer<Player> playerPtr = player;
-    QPointer<QGraphicsTextItem> sleepTextPtr = sleepText;
 
     // 使用player作为上下文对象，确保player销毁时回调不会执行
-    QTimer::singleShot(1500, player, [playerPtr, sleepTextPtr]() {
+    TimerWheel::instance().schedule(player, 1500, [playerPtr]() {
         if (playerPtr) {
             playerPtr->setCanMove(true);
-            QTimer::singleShot(3000, playerPtr.data(), [playerPtr]() {
+            TimerWheel::instance().schedule(playerPtr.data(), 3000, [playerPtr]() {
                 if (playerPtr) {
                     playerPtr->setEffectCooldown(false);
                 }
             });
         }
-        if (sleepTextPtr) {
-            if (sleepTextPtr->scene()) {
-                sleepTextPtr->scene()->removeItem(sleepTextPtr);
-            }
-            delete sleepTextPtr;
-        }
     });
 }
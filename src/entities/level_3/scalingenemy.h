@@ -2,6 +2,7 @@
 #define SCALINGENEMY_H
 
 #include "../enemy.h"
+#include "../../core/gametimer.h"
 
 /**
  * @brief 缩放敌人基类 - 用于第三关的optimization和digital_system敌人
@@ -49,25 +50,21 @@ protected:
 private slots:
 
     void updateScaling();  // 更新缩放大小
-    void endFlashEffect(); // 结束闪烁效果
 
 private:
     void applySleepEffect();    // 50%概率触发昏睡效果
-    void applyFlashEffect();    // 应用闪烁效果
-    void updateScaledPixmaps(); // 更新缩放后的图片
-
-    QTimer *m_scalingTimer;   // 缩放动画定时器
-    double m_baseScale;       // 基础缩放比例
-    double m_minScale;        // 最小缩放比例
-    double m_maxScale;        // 最大缩放比例
-    double m_currentScale;    // 当前缩放比例
-    double m_scaleSpeed;      // 缩放速度
-    bool m_scalingUp;         // 是否正在放大
-    QPixmap m_originalPixmap; // 原始未缩放图片
-    QPixmap m_normalPixmap;   // 正常显示用的缩放图片
-    QPixmap m_flashPixmap;    // 闪烁用的红色图片
-    bool m_isFlashing;        // 是否正在闪烁
-    QTimer *m_flashTimer;     // 闪烁定时器
+    void applyScale(double totalScale); // 按总缩放选择 mip 图片并施加剩余缩放
+
+    GameTimer *m_scalingTimer;  // 缩放动画定时器
+    double m_baseScale;         // 基础缩放比例
+    double m_minScale;          // 最小缩放比例
+    double m_maxScale;          // 最大缩放比例
+    double m_currentScale;      // 当前缩放比例
+    double m_scaleSpeed;        // 缩放速度
+    bool m_scalingUp;           // 是否正在放大
+    QPixmap m_originalPixmap;   // 原始未缩放图片
+    QPixmap m_normalPixmap;     // 正常显示用的缩放图片
+    int m_mipLevel;             // 当前使用的 mip 级别（-1 表示尚未选择）
 };
 
 #endif // SCALINGENEMY_H
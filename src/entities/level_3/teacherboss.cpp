@@ -7,7 +7,12 @@
 #include <QtMath>
 #include "../../core/audiomanager.h"
 #include "../../core/configmanager.h"
-#include "../../ui/explosion.h"
+#include "../../core/logging.h"
+#include "../../core/resourcefactory.h"
+#include "../../core/timerwheel.h"
+#include "../../world/bulletpattern.h"
+#include "../../world/enemypool.h"
+#include "../../world/entityregistry.h"
 #include "../player.h"
 #include "../projectile.h"
 #include "chalkbeam.h"
@@ -59,7 +64,7 @@ TeacherBoss::TeacherBoss(const QPixmap& pic, double scale)
 
     // 第一阶段技能启动由 setScene() 触发，确保 m_scene 已设置
 
-    qDebug() << "[TeacherBoss] 奶牛张创建，血量:" << health << "阶段: 1";
+    qCDebug(lcBoss) << "[TeacherBoss] 奶牛张创建，血量:" << health << "阶段: 1";
 }
 
 TeacherBoss::~TeacherBoss() {
@@ -108,7 +113,7 @@ TeacherBoss::~TeacherBoss() {
     // 清理监考员
     cleanupInvigilators();
 
-    qDebug() << "[TeacherBoss] 奶牛张被击败！";
+    qCDebug(lcBoss) << "[TeacherBoss] 奶牛张被击败！";
 }
 
 void TeacherBoss::setScene(QGraphicsScene* scene) {
@@ -116,7 +121,7 @@ void TeacherBoss::setScene(QGraphicsScene* scene) {
 
     // 场景设置后延迟启动第一阶段技能
     if (m_scene && !m_isDefeated && m_phase == 1) {
-        QTimer::singleShot(500, this, [this]() {
+        TimerWheel::instance().schedule(this, 500, [this]() {
             if (!m_isDefeated && m_phase == 1 && m_scene) {
                 emit requestShowTransitionText("「随堂测验」开始！");
                 startPhase1Skills();
@@ -138,48 +143,40 @@ void TeacherBoss::loadTextures() {
     for (const QString& basePath : possiblePaths) {
         if (QFile::exists(basePath + "cow.png")) {
             // 加载各阶段图片
-            m_normalPixmap = QPixmap(basePath + "cow.png")
-                                 .scaled(bossSize, bossSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-            m_angryPixmap = QPixmap(basePath + "cowAngry.png")
-                                .scaled(bossSize, bossSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-            m_finalPixmap = QPixmap(basePath + "cowFinal.png")
-                                .scaled(bossSize, bossSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            m_normalPixmap = ResourceFactory::tryLoadSprite(basePath + "cow.png", bossSize, bossSize);
+            m_angryPixmap = ResourceFactory::tryLoadSprite(basePath + "cowAngry.png", bossSize, bossSize);
+            m_finalPixmap = ResourceFactory::tryLoadSprite(basePath + "cowFinal.png", bossSize, bossSize);
 
             // 加载弹幕图片（放大尺寸）
-            m_formulaBulletPixmap = QPixmap(basePath + "formula_bullet.png");
+            m_formulaBulletPixmap = ResourceFactory::tryLoadSprite(basePath + "formula_bullet.png", 50, 50);
             if (m_formulaBulletPixmap.isNull()) {
                 // 创建占位符
                 m_formulaBulletPixmap = QPixmap(50, 50);
                 m_formulaBulletPixmap.fill(Qt::yellow);
-            } else {
-                m_formulaBulletPixmap = m_formulaBulletPixmap.scaled(50, 50, Qt::KeepAspectRatio,
-                                                                     Qt::SmoothTransformation);
             }
 
             // 加载粉笔光束图片
-            m_chalkBeamPixmap = QPixmap(basePath + "chalk_beam.png");
+            m_chalkBeamPixmap = ResourceFactory::tryLoadSprite(basePath + "chalk_beam.png");
             if (m_chalkBeamPixmap.isNull()) {
                 m_chalkBeamPixmap = QPixmap(30, 60);
                 m_chalkBeamPixmap.fill(Qt::white);
             }
 
             // 加载考卷图片（放大尺寸）
-            m_examPaperPixmap = QPixmap(basePath + "exam_paper.png");
+            m_examPaperPixmap = ResourceFactory::tryLoadSprite(basePath + "exam_paper.png", 60, 80);
             if (m_examPaperPixmap.isNull()) {
                 m_examPaperPixmap = QPixmap(60, 80);
                 m_examPaperPixmap.fill(Qt::lightGray);
-            } else {
-                m_examPaperPixmap = m_examPaperPixmap.scaled(60, 80, Qt::KeepAspectRatio, Qt::SmoothTransformation);
             }
 
             // 加载分裂弹图片
-            m_finalBulletPixmap = QPixmap(basePath + "final_bullet.png");
+            m_finalBulletPixmap = ResourceFactory::tryLoadSprite(basePath + "final_bullet.png");
             if (m_finalBulletPixmap.isNull()) {
                 m_finalBulletPixmap = QPixmap(25, 25);
                 m_finalBulletPixmap.fill(Qt::red);
             }
 
-            qDebug() << "[TeacherBoss] 图片资源加载完成";
+            qCDebug(lcBoss) << "[TeacherBoss] 图片资源加载完成";
             break;
         }
     }
@@ -234,7 +231,7 @@ void TeacherBoss::takeDamage(int damage) {
         }
     }
 
-    qDebug() << "[TeacherBoss] 受到伤害:" << realDamage << "，剩余血量:" << health
+    qCDebug(lcBoss) << "[TeacherBoss] 受到伤害:" << realDamage << "，剩余血量:" << health
              << "(" << (health * 100 / maxHealth) << "%)";
 
     checkPhaseTransition();
@@ -250,18 +247,18 @@ void TeacherBoss::checkPhaseTransition() {
 
     if (m_phase == 1 && healthPercent <= 0.6) {
         m_isTransitioning = true;
-        qDebug() << "[TeacherBoss] 血量降至60%，准备进入期中考试阶段...";
-        QTimer::singleShot(200, this, &TeacherBoss::enterPhase2);
+        qCDebug(lcBoss) << "[TeacherBoss] 血量降至60%，准备进入期中考试阶段...";
+        TimerWheel::instance().schedule(this, 200, &TeacherBoss::enterPhase2);
     } else if (m_phase == 2 && healthPercent <= 0.3) {
         m_isTransitioning = true;
-        qDebug() << "[TeacherBoss] 血量降至30%，准备进入调离阶段...";
-        QTimer::singleShot(200, this, &TeacherBoss::enterPhase3);
+        qCDebug(lcBoss) << "[TeacherBoss] 血量降至30%，准备进入调离阶段...";
+        TimerWheel::instance().schedule(this, 200, &TeacherBoss::enterPhase3);
     }
 }
 
 void TeacherBoss::enterPhase2() {
     m_phase = 2;
-    qDebug() << "[TeacherBoss] 进入期中考试阶段！";
+    qCDebug(lcBoss) << "[TeacherBoss] 进入期中考试阶段！";
 
     // 停止第一阶段技能
     stopPhase1Skills();
@@ -289,7 +286,7 @@ void TeacherBoss::enterPhase2() {
 
 void TeacherBoss::enterPhase3() {
     m_phase = 3;
-    qDebug() << "[TeacherBoss] 进入调离阶段！";
+    qCDebug(lcBoss) << "[TeacherBoss] 进入调离阶段！";
 
     // 停止第二阶段技能
     stopPhase2Skills();
@@ -313,12 +310,12 @@ void TeacherBoss::startFlyOutAnimation() {
     m_flyTargetPos = QPointF(900, pos().y());  // 飞出右侧
 
     if (!m_flyTimer) {
-        m_flyTimer = new QTimer(this);
-        connect(m_flyTimer, &QTimer::timeout, this, &TeacherBoss::onFlyAnimationStep);
+        m_flyTimer = new GameTimer(this);
+        connect(m_flyTimer, &GameTimer::timeout, this, &TeacherBoss::onFlyAnimationStep);
     }
     m_flyTimer->start(16);  // 约60fps
 
-    qDebug() << "[TeacherBoss] 开始飞出动画";
+    qCDebug(lcBoss) << "[TeacherBoss] 开始飞出动画";
 }
 
 void TeacherBoss::onFlyAnimationStep() {
@@ -350,13 +347,13 @@ void TeacherBoss::onFlyAnimationStep() {
             startPhase3Skills();
 
             emit phaseChanged(3);
-            qDebug() << "[TeacherBoss] 飞入完成，调离阶段开始！";
+            qCDebug(lcBoss) << "[TeacherBoss] 飞入完成，调离阶段开始！";
         }
     }
 }
 
 void TeacherBoss::onFlyOutComplete() {
-    qDebug() << "[TeacherBoss] 飞出完成，显示对话";
+    qCDebug(lcBoss) << "[TeacherBoss] 飞出完成，显示对话";
 
     // 切换到最终图片
     if (!m_finalPixmap.isNull()) {
@@ -377,12 +374,12 @@ void TeacherBoss::startFlyInAnimation() {
     setPos(m_flyStartPos);
 
     if (!m_flyTimer) {
-        m_flyTimer = new QTimer(this);
-        connect(m_flyTimer, &QTimer::timeout, this, &TeacherBoss::onFlyAnimationStep);
+        m_flyTimer = new GameTimer(this);
+        connect(m_flyTimer, &GameTimer::timeout, this, &TeacherBoss::onFlyAnimationStep);
     }
     m_flyTimer->start(16);
 
-    qDebug() << "[TeacherBoss] 开始飞入动画";
+    qCDebug(lcBoss) << "[TeacherBoss] 开始飞入动画";
 }
 
 void TeacherBoss::onDialogFinished() {
@@ -390,7 +387,7 @@ void TeacherBoss::onDialogFinished() {
 
     // 如果是击败对话结束，则触发背景渐变并死亡
     if (m_isDefeated) {
-        qDebug() << "[TeacherBoss] 击败对话结束，开始地图背景渐变";
+        qCDebug(lcBoss) << "[TeacherBoss] 击败对话结束，开始地图背景渐变";
         // 地图背景从teacher3_map渐变到classroom
         emit requestFadeBackground("assets/background/classRoom.png", 3000);
         emit dying(this);
@@ -405,7 +402,7 @@ void TeacherBoss::onDialogFinished() {
     if (m_phase == 1 && !m_firstDialogShown) {
         m_firstDialogShown = true;
         m_isTransitioning = false;
-        qDebug() << "[TeacherBoss] 初始对话结束，开始授课阶段";
+        qCDebug(lcBoss) << "[TeacherBoss] 初始对话结束，开始授课阶段";
         // 切换到一阶段战斗背景
         emit requestChangeBackground("assets/background/teacher1_map.png");
         emit requestShowTransitionText("「随堂测验」开始！");
@@ -416,7 +413,7 @@ void TeacherBoss::onDialogFinished() {
 
     // 期中考试阶段对话结束
     if (m_phase == 2) {
-        qDebug() << "[TeacherBoss] 期中考试对话结束，继续战斗";
+        qCDebug(lcBoss) << "[TeacherBoss] 期中考试对话结束，继续战斗";
         // 切换到二阶段战斗背景
         emit requestChangeBackground("assets/background/teacher2_map.png");
         emit requestShowTransitionText("「期中考试」开始！");
@@ -428,7 +425,7 @@ void TeacherBoss::onDialogFinished() {
 
     // 调离阶段对话结束，开始飞入动画
     if (m_phase == 3 && !m_isFlyingIn) {
-        qDebug() << "[TeacherBoss] 调离阶段对话结束，开始飞入";
+        qCDebug(lcBoss) << "[TeacherBoss] 调离阶段对话结束，开始飞入";
         // 切换到三阶段战斗背景
         emit requestChangeBackground("assets/background/teacher3_map.png");
         emit requestShowTransitionText("「方差爆炸」！");
@@ -438,7 +435,7 @@ void TeacherBoss::onDialogFinished() {
 }
 
 void TeacherBoss::onBossDefeated() {
-    qDebug() << "[TeacherBoss] 奶牛张被击败！显示胜利对话";
+    qCDebug(lcBoss) << "[TeacherBoss] 奶牛张被击败！显示胜利对话";
 
     m_isTransitioning = true;
     m_isDefeated = true;
@@ -449,8 +446,7 @@ void TeacherBoss::onBossDefeated() {
     stopPhase2Skills();
     stopPhase3Skills();
 
-    if (aiTimer)
-        aiTimer->stop();
+    setAIEnabled(false);
     if (moveTimer)
         moveTimer->stop();
     if (attackTimer)
@@ -461,12 +457,8 @@ void TeacherBoss::onBossDefeated() {
 
     // 清理场上的弹幕
     if (m_scene) {
-        QList<QGraphicsItem*> allItems = m_scene->items();
-        for (QGraphicsItem* item : allItems) {
-            if (Projectile* proj = dynamic_cast<Projectile*>(item)) {
-                m_scene->removeItem(proj);
-                proj->deleteLater();
-            }
+        for (Projectile* proj : EntityRegistry::instance().inScene<Projectile>(EntityKind::Projectile, m_scene)) {
+            proj->destroy();
         }
     }
 
@@ -494,19 +486,19 @@ void TeacherBoss::attackPlayer() {
 // ==================== 第一阶段技能 ====================
 
 void TeacherBoss::startPhase1Skills() {
-    qDebug() << "[TeacherBoss] 启动第一阶段技能";
+    qCDebug(lcBoss) << "[TeacherBoss] 启动第一阶段技能";
 
     // 正态分布弹幕 - 每2.5秒（增加频率）
     if (!m_normalBarrageTimer) {
-        m_normalBarrageTimer = new QTimer(this);
-        connect(m_normalBarrageTimer, &QTimer::timeout, this, &TeacherBoss::fireNormalDistributionBarrage);
+        m_normalBarrageTimer = new GameTimer(this);
+        connect(m_normalBarrageTimer, &GameTimer::timeout, this, &TeacherBoss::fireNormalDistributionBarrage);
     }
     m_normalBarrageTimer->start(2500);
 
     // 随机点名 - 每5秒（增加频率）
     if (!m_rollCallTimer) {
-        m_rollCallTimer = new QTimer(this);
-        connect(m_rollCallTimer, &QTimer::timeout, this, &TeacherBoss::performRollCall);
+        m_rollCallTimer = new GameTimer(this);
+        connect(m_rollCallTimer, &GameTimer::timeout, this, &TeacherBoss::performRollCall);
     }
     m_rollCallTimer->start(5000);
 }
@@ -518,29 +510,6 @@ void TeacherBoss::stopPhase1Skills() {
         m_rollCallTimer->stop();
 }
 
-double TeacherBoss::randomNormal(double mean, double stddev) {
-    // Box-Muller变换生成正态分布随机数
-    static bool hasSpare = false;
-    static double spare;
-
-    if (hasSpare) {
-        hasSpare = false;
-        return mean + stddev * spare;
-    }
-
-    hasSpare = true;
-    double u, v, s;
-    do {
-        u = QRandomGenerator::global()->generateDouble() * 2.0 - 1.0;
-        v = QRandomGenerator::global()->generateDouble() * 2.0 - 1.0;
-        s = u * u + v * v;
-    } while (s >= 1.0 || s == 0.0);
-
-    s = qSqrt(-2.0 * qLn(s) / s);
-    spare = v * s;
-    return mean + stddev * u * s;
-}
-
 void TeacherBoss::fireNormalDistributionBarrage() {
     if (!m_scene || !player || m_isPaused)
         return;
@@ -554,35 +523,13 @@ void TeacherBoss::fireNormalDistributionBarrage() {
     double dy = playerCenter.y() - bossCenter.y();
     double baseAngle = qAtan2(dy, dx);
 
-    // 发射15发弹幕，角度服从正态分布 N(baseAngle, 15°)
-    int bulletCount = ConfigManager::instance().getBossInt("teacher", "phase1", "normal_barrage_count", 15);
-    double stddevDegrees = ConfigManager::instance().getBossDouble("teacher", "phase1", "normal_barrage_stddev", 15.0);
-    double stddevRadians = qDegreesToRadians(stddevDegrees);
-
-    int bulletDamage = ConfigManager::instance().getBossInt("teacher", "phase1", "normal_barrage_damage", 1);
-    double bulletSpeed = ConfigManager::instance().getBossDouble("teacher", "phase1", "normal_barrage_speed", 0.8);
-
-    for (int i = 0; i < bulletCount; ++i) {
-        double angle = randomNormal(baseAngle, stddevRadians);
-
-        // 创建弹幕 - 使用formula_bullet.png图片
-        Projectile* bullet = new Projectile(
-            1,  // 敌人发出
-            bulletDamage,
-            bossCenter,
-            m_formulaBulletPixmap,
-            1.0);
-
-        // 设置方向 - 降低速度（参考毒气速度4.0）
-        double vx = qCos(angle) * bulletSpeed;
-        double vy = qSin(angle) * bulletSpeed;
-        bullet->setDir(static_cast<int>(vx * 10), static_cast<int>(vy * 10));
-
-        m_scene->addItem(bullet);
-    }
+    // 15发弹幕，角度服从正态分布 N(baseAngle, 15°)，参数见 config.json 的 patterns.normal_barrage
+    BulletPatternEngine& engine = BulletPatternEngine::instance();
+    BulletPattern barrage = engine.pattern("teacher", "normal_barrage", BulletPattern::normalFan(15, 15.0, 0.6, 1));
+    int bulletCount = engine.fire(m_scene, barrage, bossCenter, baseAngle, m_formulaBulletPixmap);
 
     AudioManager::instance().playSound("enemy_attack");
-    qDebug() << "[TeacherBoss] 发射正态分布弹幕，共" << bulletCount << "发";
+    qCDebug(lcBoss) << "[TeacherBoss] 发射正态分布弹幕，共" << bulletCount << "发";
 }
 
 void TeacherBoss::performRollCall() {
@@ -632,32 +579,32 @@ void TeacherBoss::performRollCall() {
         beam->startWarning();
     }
 
-    qDebug() << "[TeacherBoss] 随机点名！生成" << beamCount << "个红圈";
+    qCDebug(lcBoss) << "[TeacherBoss] 随机点名！生成" << beamCount << "个红圈";
 }
 
 // ==================== 第二阶段技能 ====================
 
 void TeacherBoss::startPhase2Skills() {
-    qDebug() << "[TeacherBoss] 启动第二阶段技能";
+    qCDebug(lcBoss) << "[TeacherBoss] 启动第二阶段技能";
 
     // 考卷攻击 - 每5秒
     if (!m_examPaperTimer) {
-        m_examPaperTimer = new QTimer(this);
-        connect(m_examPaperTimer, &QTimer::timeout, this, &TeacherBoss::throwExamPaper);
+        m_examPaperTimer = new GameTimer(this);
+        connect(m_examPaperTimer, &GameTimer::timeout, this, &TeacherBoss::throwExamPaper);
     }
     m_examPaperTimer->start(5000);
 
     // 极大似然估计陷阱 - 每7秒（增加频率）
     if (!m_mleTrapTimer) {
-        m_mleTrapTimer = new QTimer(this);
-        connect(m_mleTrapTimer, &QTimer::timeout, this, &TeacherBoss::placeMleTrap);
+        m_mleTrapTimer = new GameTimer(this);
+        connect(m_mleTrapTimer, &GameTimer::timeout, this, &TeacherBoss::placeMleTrap);
     }
     m_mleTrapTimer->start(7000);
 
     // 召唤监考员 - 每10秒（增加频率）
     if (!m_summonInvigilatorTimer) {
-        m_summonInvigilatorTimer = new QTimer(this);
-        connect(m_summonInvigilatorTimer, &QTimer::timeout, this, &TeacherBoss::summonInvigilator);
+        m_summonInvigilatorTimer = new GameTimer(this);
+        connect(m_summonInvigilatorTimer, &GameTimer::timeout, this, &TeacherBoss::summonInvigilator);
     }
     m_summonInvigilatorTimer->start(10000);
 }
@@ -691,7 +638,7 @@ void TeacherBoss::throwExamPaper() {
     m_scene->addItem(paper);
 
     AudioManager::instance().playSound("enemy_attack");
-    qDebug() << "[TeacherBoss] 抛出期中考卷！";
+    qCDebug(lcBoss) << "[TeacherBoss] 抛出期中考卷！";
 }
 
 void TeacherBoss::placeMleTrap() {
@@ -723,57 +670,63 @@ void TeacherBoss::placeMleTrap() {
     MleTrap* trap = new MleTrap(predictedPos, player);
     m_scene->addItem(trap);
 
-    qDebug() << "[TeacherBoss] 放置极大似然估计陷阱，位置:" << predictedPos;
+    qCDebug(lcBoss) << "[TeacherBoss] 放置极大似然估计陷阱，位置:" << predictedPos;
 }
 
 void TeacherBoss::summonInvigilator() {
     if (!m_scene || !player || m_isPaused)
         return;
 
-    // 尝试多个可能的路径加载监考员图片
-    QStringList possiblePaths = {
-        "assets/boss/Teacher/",
-        "../assets/boss/Teacher/",
-        "../../our_game/assets/boss/Teacher/"};
-
-    QPixmap normalPix;
-    QPixmap angryPix;
+    // 优先复用对象池中的监考员，只有新建时才加载图片
+    Invigilator* invigilator = EnemyPool::instance().acquire<Invigilator>("invigilator", [this]() {
+        // 尝试多个可能的路径加载监考员图片
+        QStringList possiblePaths = {
+            "assets/boss/Teacher/",
+            "../assets/boss/Teacher/",
+            "../../our_game/assets/boss/Teacher/"};
+
+        QPixmap normalPix;
+        QPixmap angryPix;
+
+        for (const QString& basePath : possiblePaths) {
+            if (QFile::exists(basePath + "invigilatorNormal.png")) {
+                normalPix = ResourceFactory::tryLoadSprite(basePath + "invigilatorNormal.png", 70, 70);
+                angryPix = ResourceFactory::tryLoadSprite(basePath + "invigilatorAngry.png", 70, 70);
+                break;
+            }
+        }
 
-    for (const QString& basePath : possiblePaths) {
-        if (QFile::exists(basePath + "invigilatorNormal.png")) {
-            normalPix = QPixmap(basePath + "invigilatorNormal.png");
-            angryPix = QPixmap(basePath + "invigilatorAngry.png");
-            break;
+        if (normalPix.isNull()) {
+            normalPix = QPixmap(70, 70);
+            normalPix.fill(Qt::gray);
         }
-    }
 
-    if (normalPix.isNull()) {
-        normalPix = QPixmap(70, 70);
-        normalPix.fill(Qt::gray);
-    } else {
-        normalPix = normalPix.scaled(70, 70, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    }
+        if (angryPix.isNull()) {
+            angryPix = QPixmap(70, 70);
+            angryPix.fill(Qt::red);
+        }
 
-    if (angryPix.isNull()) {
-        angryPix = QPixmap(70, 70);
-        angryPix.fill(Qt::red);
-    } else {
-        angryPix = angryPix.scaled(70, 70, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    }
+        return new Invigilator(normalPix, angryPix, this, 1.0);
+    });
 
     // 在Boss附近生成监考员
     QPointF spawnPos = pos() + QPointF(
                                    QRandomGenerator::global()->bounded(-50, 50),
                                    QRandomGenerator::global()->bounded(-50, 50));
 
-    Invigilator* invigilator = new Invigilator(normalPix, angryPix, this, 1.0);
+    invigilator->setMaster(this);
     invigilator->setPos(spawnPos);
     invigilator->setPlayer(player);
     m_scene->addItem(invigilator);
 
     m_invigilators.append(invigilator);
 
-    qDebug() << "[TeacherBoss] 召唤监考员！当前监考员数量:" << m_invigilators.size();
+    // 死亡后可能回到对象池，需及时移出列表，避免清理时销毁池中的对象
+    connect(invigilator, &Enemy::dying, this, [this, invigilator]() {
+        m_invigilators.removeAll(QPointer<Invigilator>(invigilator));
+    });
+
+    qCDebug(lcBoss) << "[TeacherBoss] 召唤监考员！当前监考员数量:" << m_invigilators.size();
 }
 
 void TeacherBoss::cleanupInvigilators() {
@@ -791,7 +744,7 @@ void TeacherBoss::cleanupInvigilators() {
 // ==================== 第三阶段技能 ====================
 
 void TeacherBoss::startPhase3Skills() {
-    qDebug() << "[TeacherBoss] 启动第三阶段技能";
+    qCDebug(lcBoss) << "[TeacherBoss] 启动第三阶段技能";
 
     // 切换到高速保持距离模式
     setMovementPattern(MOVE_KEEP_DISTANCE);
@@ -801,30 +754,30 @@ void TeacherBoss::startPhase3Skills() {
 
     // 挂科警告 - 每3秒（增加频率，更难躲避）
     if (!m_failWarningTimer) {
-        m_failWarningTimer = new QTimer(this);
-        connect(m_failWarningTimer, &QTimer::timeout, this, &TeacherBoss::performFailWarning);
+        m_failWarningTimer = new GameTimer(this);
+        connect(m_failWarningTimer, &GameTimer::timeout, this, &TeacherBoss::performFailWarning);
     }
     m_failWarningTimer->start(3000);
 
     // 公式轰炸 - 每2.5秒（增加频率）
     if (!m_formulaBombTimer) {
-        m_formulaBombTimer = new QTimer(this);
-        connect(m_formulaBombTimer, &QTimer::timeout, this, &TeacherBoss::fireFormulaBomb);
+        m_formulaBombTimer = new GameTimer(this);
+        connect(m_formulaBombTimer, &GameTimer::timeout, this, &TeacherBoss::fireFormulaBomb);
     }
     m_formulaBombTimer->start(2500);
 
     // 喜忧参半分裂弹 - 每5秒（增加频率）
     if (!m_splitBulletTimer) {
-        m_splitBulletTimer = new QTimer(this);
-        connect(m_splitBulletTimer, &QTimer::timeout, this, &TeacherBoss::fireSplitBullet);
+        m_splitBulletTimer = new GameTimer(this);
+        connect(m_splitBulletTimer, &GameTimer::timeout, this, &TeacherBoss::fireSplitBullet);
     }
     m_splitBulletTimer->start(5000);
 
     // 召唤xuke - 每10秒
     int xukeInterval = ConfigManager::instance().getBossInt("teacher", "phase3", "summon_xuke_interval", 10000);
     if (!m_summonXukeTimer) {
-        m_summonXukeTimer = new QTimer(this);
-        connect(m_summonXukeTimer, &QTimer::timeout, this, &TeacherBoss::summonXuke);
+        m_summonXukeTimer = new GameTimer(this);
+        connect(m_summonXukeTimer, &GameTimer::timeout, this, &TeacherBoss::summonXuke);
     }
     m_summonXukeTimer->start(xukeInterval);
 }
@@ -891,7 +844,7 @@ void TeacherBoss::performFailWarning() {
         beam->startWarning();
     }
 
-    qDebug() << "[TeacherBoss] 挂科警告！生成" << beamCount << "个粉笔陷阱，警告时间:" << warningTime << "ms";
+    qCDebug(lcBoss) << "[TeacherBoss] 挂科警告！生成" << beamCount << "个粉笔陷阱，警告时间:" << warningTime << "ms";
 }
 
 void TeacherBoss::fireFormulaBomb() {
@@ -901,32 +854,12 @@ void TeacherBoss::fireFormulaBomb() {
     QPointF bossCenter = pos() + QPointF(pixmap().width() / 2, pixmap().height() / 2);
 
     // 12发弹幕均匀分布360度，随机起始角度
-    int bulletCount = ConfigManager::instance().getBossInt("teacher", "phase3", "formula_bomb_count", 12);
-    double startAngle = QRandomGenerator::global()->generateDouble() * 2 * M_PI;
-
-    int bulletDamage = ConfigManager::instance().getBossInt("teacher", "phase3", "formula_bomb_damage", 1);
-    double bulletSpeed = ConfigManager::instance().getBossDouble("teacher", "phase3", "formula_bomb_speed", 0.4);
-
-    for (int i = 0; i < bulletCount; ++i) {
-        double angle = startAngle + (2 * M_PI * i / bulletCount);
-
-        Projectile* bullet = new Projectile(
-            1,
-            bulletDamage,
-            bossCenter,
-            m_formulaBulletPixmap,
-            1.0);
-
-        // 降低速度（原来4*10=40，现在2.5*10=25）
-        double vx = qCos(angle) * bulletSpeed;
-        double vy = qSin(angle) * bulletSpeed;
-        bullet->setDir(static_cast<int>(vx * 10), static_cast<int>(vy * 10));
-
-        m_scene->addItem(bullet);
-    }
+    BulletPatternEngine& engine = BulletPatternEngine::instance();
+    BulletPattern bomb = engine.pattern("teacher", "formula_bomb", BulletPattern::ring(12, 0.4, 1, true));
+    int bulletCount = engine.fire(m_scene, bomb, bossCenter, 0.0, m_formulaBulletPixmap);
 
     AudioManager::instance().playSound("enemy_attack");
-    qDebug() << "[TeacherBoss] 公式轰炸！发射" << bulletCount << "发环形弹幕";
+    qCDebug(lcBoss) << "[TeacherBoss] 公式轰炸！发射" << bulletCount << "发环形弹幕";
 }
 
 void TeacherBoss::fireSplitBullet() {
@@ -940,131 +873,52 @@ void TeacherBoss::fireSplitBullet() {
     // 计算朝向玩家的方向和距离
     QPointF direction = playerCenter - bossCenter;
     double totalDistance = qSqrt(direction.x() * direction.x() + direction.y() * direction.y());
-    if (totalDistance > 0) {
-        direction /= totalDistance;
-    }
+    double baseAngle = qAtan2(direction.y(), direction.x());
 
-    // 分裂距离：发射时Boss与玩家距离的三分之二
-    double splitDistance = totalDistance * 2.0 / 3.0;
-
-    // 从配置读取子弹参数
-    int mainDamage = ConfigManager::instance().getBossInt("teacher", "phase3", "split_bullet_main_damage", 2);
-    double mainSpeed = ConfigManager::instance().getBossDouble("teacher", "phase3", "split_bullet_main_speed", 0.3);
-    int smallDamage = ConfigManager::instance().getBossInt("teacher", "phase3", "split_bullet_small_damage", 1);
-    double smallSpeed = ConfigManager::instance().getBossDouble("teacher", "phase3", "split_bullet_small_speed", 0.6);
-    int splitCount = ConfigManager::instance().getBossInt("teacher", "phase3", "split_bullet_count", 5);
-    double spreadAngleDeg = ConfigManager::instance().getBossDouble("teacher", "phase3", "split_bullet_spread_angle", 30.0);
-
-    // 创建大弹幕（使用缩放的final_bullet.png）
-    QPixmap bigBullet = m_finalBulletPixmap.scaled(40, 40, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-
-    Projectile* mainBullet = new Projectile(
-        1,
-        mainDamage,
-        bossCenter,
-        bigBullet,
-        1.0);
-
-    // 设置速度（参考毒气速度4.0，setDir需乘10）
-    double vx = direction.x() * mainSpeed;
-    double vy = direction.y() * mainSpeed;
-    mainBullet->setDir(static_cast<int>(vx * 10), static_cast<int>(vy * 10));
-
-    m_scene->addItem(mainBullet);
-
-    // 使用定时器检查距离，到达分裂距离时分裂
-    QPointer<Projectile> bulletPtr = mainBullet;
-    QPointer<QGraphicsScene> scenePtr = m_scene;
-    QPointF startPos = bossCenter;
-    QPointF dir = direction;
-    QPixmap smallPix = m_finalBulletPixmap.scaled(20, 20, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    double splitDist = splitDistance;
-
-    // 创建检查定时器
-    QTimer* checkTimer = new QTimer(this);
-    connect(checkTimer, &QTimer::timeout, this,
-            [bulletPtr, scenePtr, startPos, dir, smallPix, splitDist, checkTimer, smallDamage, smallSpeed, splitCount, spreadAngleDeg]() {
-                if (!bulletPtr || !scenePtr) {
-                    checkTimer->stop();
-                    checkTimer->deleteLater();
-                    return;
-                }
+    // 大弹（40px）飞到发射时Boss与玩家距离的三分之二处，分裂为5发小弹（20px）扇形散开；
+    // 分裂距离由弹幕引擎随时钟节拍检查
+    BulletPattern smallFan = BulletPattern::spreadFan(5, 30.0, 0.6, 1);
+    smallFan.size = 20;
+    BulletPattern splitDefaults = BulletPattern::split(0.3, 2, 2.0 / 3.0, smallFan);
+    splitDefaults.size = 40;
 
-                // 计算当前飞行距离
-                QPointF currentPos = bulletPtr->pos();
-                double dx = currentPos.x() - startPos.x();
-                double dy = currentPos.y() - startPos.y();
-                double currentDistance = qSqrt(dx * dx + dy * dy);
-
-                // 到达分裂距离
-                if (currentDistance >= splitDist) {
-                    checkTimer->stop();
-                    checkTimer->deleteLater();
-
-                    QPointF splitPos = currentPos;
-
-                    // 删除主弹
-                    scenePtr->removeItem(bulletPtr);
-                    bulletPtr->deleteLater();
-
-                    // 生成小弹幕，扇形散开
-                    double baseAngle = qAtan2(dir.y(), dir.x());
-                    double spreadAngle = qDegreesToRadians(spreadAngleDeg);
-
-                    for (int i = 0; i < splitCount; ++i) {
-                        double angle = baseAngle - spreadAngle + (spreadAngle * 2 * i / (splitCount - 1));
-
-                        Projectile* smallBullet = new Projectile(
-                            1,
-                            smallDamage,
-                            splitPos,
-                            smallPix,
-                            1.0);
-
-                        // 分裂后速度
-                        double svx = qCos(angle) * smallSpeed;
-                        double svy = qSin(angle) * smallSpeed;
-                        smallBullet->setDir(static_cast<int>(svx * 10), static_cast<int>(svy * 10));
-
-                        scenePtr->addItem(smallBullet);
-                    }
-                    qDebug() << "[TeacherBoss] 分裂弹已分裂，距离:" << currentDistance;
-                }
-            });
-    checkTimer->start(50);  // 每50毫秒检查一次
+    BulletPatternEngine& engine = BulletPatternEngine::instance();
+    BulletPattern splitBullet = engine.pattern("teacher", "split_bullet", splitDefaults);
+    engine.fire(m_scene, splitBullet, bossCenter, baseAngle, m_finalBulletPixmap, totalDistance);
 
     AudioManager::instance().playSound("enemy_attack");
-    qDebug() << "[TeacherBoss] 喜忧参半！发射分裂弹，分裂距离:" << splitDistance;
+    qCDebug(lcBoss) << "[TeacherBoss] 喜忧参半！发射分裂弹，分裂距离:" << totalDistance * splitBullet.splitAt;
 }
 
 void TeacherBoss::summonXuke() {
     if (!m_scene || !player || m_isPaused)
         return;
 
-    // 加载xuke图片
-    int xukeSize = ConfigManager::instance().getEntitySize("enemies", "xuke");
-    if (xukeSize <= 0)
-        xukeSize = 80;
-
-    QStringList possiblePaths = {
-        "assets/enemy/level_3/",
-        "../assets/enemy/level_3/",
-        "../../our_game/assets/enemy/level_3/"};
-
-    QPixmap xukePix;
-    for (const QString& basePath : possiblePaths) {
-        if (QFile::exists(basePath + "xuke.png")) {
-            xukePix = QPixmap(basePath + "xuke.png");
-            break;
+    // 优先复用对象池中的xuke，只有新建时才加载图片
+    XukeEnemy* xuke = EnemyPool::instance().acquire<XukeEnemy>("xuke", []() {
+        int xukeSize = ConfigManager::instance().getEntitySize("enemies", "xuke");
+        if (xukeSize <= 0)
+            xukeSize = 80;
+
+        QStringList possiblePaths = {
+            "assets/enemy/level_3/",
+            "../assets/enemy/level_3/",
+            "../../our_game/assets/enemy/level_3/"};
+
+        QPixmap xukePix;
+        for (const QString& basePath : possiblePaths) {
+            if (QFile::exists(basePath + "xuke.png")) {
+                xukePix = ResourceFactory::tryLoadSprite(basePath + "xuke.png", xukeSize, xukeSize);
+                break;
+            }
         }
-    }
 
-    if (xukePix.isNull()) {
-        xukePix = QPixmap(xukeSize, xukeSize);
-        xukePix.fill(Qt::darkGray);
-    } else {
-        xukePix = xukePix.scaled(xukeSize, xukeSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    }
+        if (xukePix.isNull()) {
+            xukePix = QPixmap(xukeSize, xukeSize);
+            xukePix.fill(Qt::darkGray);
+        }
+        return new XukeEnemy(xukePix, 1.0);
+    });
 
     // 在Boss附近生成xuke
     QPointF spawnPos = pos() + QPointF(
@@ -1075,17 +929,18 @@ void TeacherBoss::summonXuke() {
     spawnPos.setX(qBound(50.0, spawnPos.x(), 750.0));
     spawnPos.setY(qBound(50.0, spawnPos.y(), 550.0));
 
-    XukeEnemy* xuke = new XukeEnemy(xukePix, 1.0);
     xuke->setPos(spawnPos);
     xuke->setPlayer(player);
     xuke->setIsSummoned(true);  // 标记为召唤的敌人
-    xuke->preloadCollisionMask();
+    if (!xuke->hasCollisionMask()) {
+        xuke->preloadCollisionMask();
+    }
     m_scene->addItem(xuke);
 
     // 通知Level追踪这个敌人
     emit enemySpawned(xuke);
 
-    qDebug() << "[TeacherBoss] 召唤沙鹰狙神！位置:" << spawnPos;
+    qCDebug(lcBoss) << "[TeacherBoss] 召唤沙鹰狙神！位置:" << spawnPos;
 }
 
 // ==================== 暂停控制 ====================
@@ -1235,5 +1090,5 @@ void TeacherBoss::setupLevelConnections(QObject* level) {
         QMetaObject::invokeMethod(level, "onBossEnemySpawned", Qt::DirectConnection, Q_ARG(Enemy*, enemy));
     });
 
-    qDebug() << "[TeacherBoss] 信号已连接到Level";
+    qCDebug(lcBoss) << "[TeacherBoss] 信号已连接到Level";
 }
@@ -6,6 +6,7 @@
 #include <QPointer>
 #include <QTimer>
 #include <QVector>
+#include "../../core/gametimer.h"
 #include "../boss.h"
 
 class Enemy;
@@ -109,7 +110,7 @@ class TeacherBoss : public Boss {
     bool m_isFlyingIn;        // 正在执行飞入动画
     QPointF m_flyStartPos;    // 飞行起始位置
     QPointF m_flyTargetPos;   // 飞行目标位置
-    QTimer* m_flyTimer;       // 飞行动画定时器
+    GameTimer* m_flyTimer;    // 飞行动画定时器
 
     // ========== 图片资源 ==========
     QPixmap m_normalPixmap;         // cow.png - 授课阶段
@@ -124,8 +125,8 @@ class TeacherBoss : public Boss {
     QGraphicsScene* m_scene;
 
     // ========== 第一阶段：授课阶段 ==========
-    QTimer* m_normalBarrageTimer;  // 正态分布弹幕定时器
-    QTimer* m_rollCallTimer;       // 随机点名定时器
+    GameTimer* m_normalBarrageTimer;  // 正态分布弹幕定时器
+    GameTimer* m_rollCallTimer;       // 随机点名定时器
 
     void startPhase1Skills();
 
@@ -135,9 +136,9 @@ class TeacherBoss : public Boss {
     void performRollCall();                // 随机点名（红圈+粉笔光束）
 
     // ========== 第二阶段：期中考试阶段 ==========
-    QTimer* m_examPaperTimer;                       // 考卷定时器
-    QTimer* m_mleTrapTimer;                         // 极大似然估计陷阱定时器
-    QTimer* m_summonInvigilatorTimer;               // 召唤监考员定时器
+    GameTimer* m_examPaperTimer;                    // 考卷定时器
+    GameTimer* m_mleTrapTimer;                      // 极大似然估计陷阱定时器
+    GameTimer* m_summonInvigilatorTimer;            // 召唤监考员定时器
     QVector<QPointer<Invigilator>> m_invigilators;  // 监考员列表
 
     void startPhase2Skills();
@@ -150,10 +151,10 @@ class TeacherBoss : public Boss {
     void cleanupInvigilators();  // 清理监考员
 
     // ========== 第三阶段：调离阶段 ==========
-    QTimer* m_failWarningTimer;  // 挂科警告定时器
-    QTimer* m_formulaBombTimer;  // 公式轰炸定时器
-    QTimer* m_splitBulletTimer;  // 喜忧参半分裂弹定时器
-    QTimer* m_summonXukeTimer;   // 召唤xuke定时器
+    GameTimer* m_failWarningTimer;  // 挂科警告定时器
+    GameTimer* m_formulaBombTimer;  // 公式轰炸定时器
+    GameTimer* m_splitBulletTimer;  // 喜忧参半分裂弹定时器
+    GameTimer* m_summonXukeTimer;   // 召唤xuke定时器
 
     void startPhase3Skills();
 
@@ -181,8 +182,7 @@ class TeacherBoss : public Boss {
     QStringList getDefeatedDialog();  // 被击败对话
 
     // ========== 辅助方法 ==========
-    void loadTextures();                              // 加载图片资源
-    double randomNormal(double mean, double stddev);  // 正态分布随机数
+    void loadTextures();  // 加载图片资源
 };
 
 #endif  // TEACHERBOSS_H
@@ -6,6 +6,9 @@
 #include <QTimer>
 #include <QtMath>
 #include "../../core/configmanager.h"
+#include "../../core/logging.h"
+#include "../../core/resourcefactory.h"
+#include "../../core/timerwheel.h"
 #include "../player.h"
 
 XukeEnemy::XukeEnemy(const QPixmap& pic, double scale)
@@ -13,28 +16,17 @@ XukeEnemy::XukeEnemy(const QPixmap& pic, double scale)
       m_shootTimer(nullptr),
       m_shotCount(0),
       m_facingRight(true) {
-    // 从配置文件读取徐轲属性
-    ConfigManager& config = ConfigManager::instance();
-    setHealth(config.getEnemyInt("xuke", "health", 15));
-    setContactDamage(0);     // 纯远程敌人，无接触伤害！
-    setVisionRange(9999.0);  // 全图视野！
-    setAttackRange(9999.0);  // 全图攻击范围
-    setAttackCooldown(config.getEnemyInt("xuke", "shoot_cooldown", SHOOT_COOLDOWN));
-    setSpeed(config.getEnemyDouble("xuke", "speed", 1.0));
-
-    // 使用保持距离移动模式（远程敌人专用）
-    setMovementPattern(MOVE_KEEP_DISTANCE);
-    setPreferredDistance(config.getEnemyDouble("xuke", "keep_distance", KEEP_DISTANCE));
+    applyConfig();
 
     // 加载子弹图片
     loadBulletPixmaps();
 
     // 创建射击定时器
-    m_shootTimer = new QTimer(this);
-    connect(m_shootTimer, &QTimer::timeout, this, &XukeEnemy::shootBullet);
+    m_shootTimer = new GameTimer(this);
+    connect(m_shootTimer, &GameTimer::timeout, this, &XukeEnemy::shootBullet);
     m_shootTimer->start(SHOOT_COOLDOWN);
 
-    qDebug() << "XukeEnemy 创建完成 - 射击间隔:" << SHOOT_COOLDOWN << "ms"
+    qCDebug(lcAi) << "XukeEnemy 创建完成 - 射击间隔:" << SHOOT_COOLDOWN << "ms"
              << "接触伤害:" << contactDamage << "移动模式:MOVE_KEEP_DISTANCE";
 }
 
@@ -46,6 +38,27 @@ XukeEnemy::~XukeEnemy() {
     }
 }
 
+void XukeEnemy::applyConfig() {
+    // 从配置文件读取徐轲属性
+    ConfigManager& config = ConfigManager::instance();
+    setHealth(config.getEnemyInt("xuke", "health", 15));
+    setContactDamage(0);     // 纯远程敌人，无接触伤害！
+    setVisionRange(9999.0);  // 全图视野！
+    setAttackRange(9999.0);  // 全图攻击范围
+    setAttackCooldown(config.getEnemyInt("xuke", "shoot_cooldown", SHOOT_COOLDOWN));
+    setSpeed(config.getEnemyDouble("xuke", "speed", 1.0));
+
+    // 使用保持距离移动模式（远程敌人专用）
+    setMovementPattern(MOVE_KEEP_DISTANCE);
+    setPreferredDistance(config.getEnemyDouble("xuke", "keep_distance", KEEP_DISTANCE));
+}
+
+void XukeEnemy::onReset() {
+    // 子弹图片在构造时已加载，复用时只恢复属性和射击计数
+    applyConfig();
+    m_shotCount = 0;
+}
+
 void XukeEnemy::loadBulletPixmaps() {
     // 从配置文件读取子弹尺寸
     int normalBulletSize = ConfigManager::instance().getBulletSize("xuke");
@@ -57,25 +70,23 @@ void XukeEnemy::loadBulletPixmaps() {
         specialBulletSize = 20;  // 默认值
 
     // 加载普通子弹图片
-    QPixmap bullet1("assets/items/bullet_xuke1.png");
-    if (bullet1.isNull()) {
+    m_bulletPixmap1 = ResourceFactory::tryLoadSprite("assets/items/bullet_xuke1.png", normalBulletSize, normalBulletSize);
+    if (m_bulletPixmap1.isNull()) {
         qWarning() << "无法加载 bullet_xuke1.png，使用默认子弹";
         m_bulletPixmap1 = QPixmap(normalBulletSize, normalBulletSize);
         m_bulletPixmap1.fill(Qt::yellow);
     } else {
-        m_bulletPixmap1 = bullet1.scaled(normalBulletSize, normalBulletSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        qDebug() << "XukeEnemy 普通子弹图片加载成功，尺寸:" << normalBulletSize;
+        qCDebug(lcAi) << "XukeEnemy 普通子弹图片加载成功，尺寸:" << normalBulletSize;
     }
 
     // 加载强化子弹图片
-    QPixmap bullet2("assets/items/bullet_xuke2.png");
-    if (bullet2.isNull()) {
+    m_bulletPixmap2 = ResourceFactory::tryLoadSprite("assets/items/bullet_xuke2.png", specialBulletSize, specialBulletSize);
+    if (m_bulletPixmap2.isNull()) {
         qWarning() << "无法加载 bullet_xuke2.png，使用默认强化子弹";
         m_bulletPixmap2 = QPixmap(specialBulletSize, specialBulletSize);
         m_bulletPixmap2.fill(Qt::red);
     } else {
-        m_bulletPixmap2 = bullet2.scaled(specialBulletSize, specialBulletSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        qDebug() << "XukeEnemy 强化子弹图片加载成功，尺寸:" << specialBulletSize;
+        qCDebug(lcAi) << "XukeEnemy 强化子弹图片加载成功，尺寸:" << specialBulletSize;
     }
 }
 
@@ -124,13 +135,13 @@ void XukeEnemy::shootBullet() {
 
     // 检查是否在场景中
     if (!scene()) {
-        qDebug() << "XukeEnemy::shootBullet - 不在场景中";
+        qCDebug(lcAi) << "XukeEnemy::shootBullet - 不在场景中";
         return;
     }
 
     // 检查玩家引用
     if (!player) {
-        qDebug() << "XukeEnemy::shootBullet - 没有玩家引用";
+        qCDebug(lcAi) << "XukeEnemy::shootBullet - 没有玩家引用";
         return;
     }
 
@@ -179,7 +190,7 @@ void XukeEnemy::shootBullet() {
 
     scene()->addItem(bullet);
 
-    qDebug() << "XukeEnemy 发射子弹 - 类型:" << (isSpecialShot ? "强化" : "普通")
+    qCDebug(lcAi) << "XukeEnemy 发射子弹 - 类型:" << (isSpecialShot ? "强化" : "普通")
              << "计数:" << m_shotCount << "方向:(" << dirX << "," << dirY << ")"
              << "玩家距离:" << dist;
 }
@@ -189,7 +200,7 @@ XukeProjectile::XukeProjectile(BulletType type, int baseDamage, QPointF pos, con
       m_bulletType(type),
       m_targetPlayer(targetPlayer),
       m_hasHit(false) {
-    qDebug() << "XukeProjectile 创建 - 类型:" << (type == SPECIAL ? "强化" : "普通")
+    qCDebug(lcAi) << "XukeProjectile 创建 - 类型:" << (type == SPECIAL ? "强化" : "普通")
              << "位置:" << pos << "伤害:" << baseDamage;
 }
 
@@ -210,8 +221,8 @@ void XukeProjectile::move() {
     if (m_targetPlayer && !m_hasHit) {
         QList<QGraphicsItem*> collisions = collidingItems();
         for (QGraphicsItem* item : collisions) {
-            Player* player = dynamic_cast<Player*>(item);
-            if (player && player == m_targetPlayer) {
+            if (isEntityKind(item, EntityKind::Player) && static_cast<Player*>(item) == m_targetPlayer.data()) {
+                Player* player = m_targetPlayer.data();
                 // 使用像素级碰撞检测
                 if (Entity::pixelCollision(this, player)) {
                     // 应用爆头伤害逻辑
@@ -276,7 +287,7 @@ void XukeProjectile::checkHeadshotAndApplyDamage(Player* player) {
         showHeadshotText(headshotText);
     }
 
-    qDebug() << "XukeProjectile 命中玩家 - 类型:" << (m_bulletType == SPECIAL ? "强化" : "普通")
+    qCDebug(lcAi) << "XukeProjectile 命中玩家 - 类型:" << (m_bulletType == SPECIAL ? "强化" : "普通")
              << "爆头:" << isHeadshot << "伤害:" << damage;
 }
 
@@ -298,7 +309,7 @@ void XukeProjectile::showHeadshotText(const QString& text) {
     QPointer<QGraphicsTextItem> textPtr(textItem);
 
     // 1秒后删除文字，使用 m_targetPlayer 作为上下文对象
-    QTimer::singleShot(1000, m_targetPlayer, [textPtr]() {
+    TimerWheel::instance().schedule(m_targetPlayer.data(), 1000, [textPtr]() {
         if (textPtr) {
             if (textPtr->scene()) {
                 textPtr->scene()->removeItem(textPtr.data());
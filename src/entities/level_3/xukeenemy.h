@@ -4,6 +4,7 @@
 #include <QGraphicsPixmapItem>
 #include <QGraphicsTextItem>
 #include <QPointer>
+#include "../../core/gametimer.h"
 #include "../enemy.h"
 #include "../projectile.h"
 
@@ -41,20 +42,22 @@ public:
 
 protected:
     void attackPlayer() override;
+    void onReset() override;
 
 private slots:
     void shootBullet();
 
 private:
+    void applyConfig();  // 读取配置属性（构造和对象池复用时调用）
     void loadBulletPixmaps();
     void updateFacingDirection();
 
     // 射击相关
-    QTimer *m_shootTimer;    // 射击定时器
-    QPixmap m_bulletPixmap1; // 普通子弹图片
-    QPixmap m_bulletPixmap2; // 强化子弹图片
-    int m_shotCount;         // 已发射子弹计数
-    bool m_facingRight;      // 面朝方向
+    GameTimer *m_shootTimer;  // 射击定时器
+    QPixmap m_bulletPixmap1;  // 普通子弹图片
+    QPixmap m_bulletPixmap2;  // 强化子弹图片
+    int m_shotCount;          // 已发射子弹计数
+    bool m_facingRight;       // 面朝方向
 
     // ========== 参数常量 ==========
     static constexpr int SHOOT_COOLDOWN = 1200;    // 射击间隔 1.2秒
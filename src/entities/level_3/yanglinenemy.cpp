@@ -7,7 +7,7 @@
 #include <QtMath>
 #include "../../core/audiomanager.h"
 #include "../../core/configmanager.h"
-#include "../../ui/explosion.h"
+#include "../../core/logging.h"
 #include "../player.h"
 
 YanglinEnemy::YanglinEnemy(const QPixmap& pic, double scale)
@@ -36,26 +36,26 @@ YanglinEnemy::YanglinEnemy(const QPixmap& pic, double scale)
     setTransformOriginPoint(pixmap().width() / 2.0, pixmap().height() / 2.0);
 
     // 创建技能冷却定时器（30秒）
-    m_spinningCooldownTimer = new QTimer(this);
+    m_spinningCooldownTimer = new GameTimer(this);
     m_spinningCooldownTimer->setInterval(SPINNING_COOLDOWN);
-    connect(m_spinningCooldownTimer, &QTimer::timeout, this, &YanglinEnemy::onSpinningTimer);
+    connect(m_spinningCooldownTimer, &GameTimer::timeout, this, &YanglinEnemy::onSpinningTimer);
 
     // 创建旋转动画更新定时器
-    m_spinningUpdateTimer = new QTimer(this);
+    m_spinningUpdateTimer = new GameTimer(this);
     m_spinningUpdateTimer->setInterval(SPINNING_UPDATE_INTERVAL);
-    connect(m_spinningUpdateTimer, &QTimer::timeout, this, &YanglinEnemy::onSpinningUpdate);
+    connect(m_spinningUpdateTimer, &GameTimer::timeout, this, &YanglinEnemy::onSpinningUpdate);
 
     // 创建技能持续时间定时器（5秒，单次触发）
-    m_spinningDurationTimer = new QTimer(this);
+    m_spinningDurationTimer = new GameTimer(this);
     m_spinningDurationTimer->setSingleShot(true);
     m_spinningDurationTimer->setInterval(SPINNING_DURATION);
-    connect(m_spinningDurationTimer, &QTimer::timeout, this, &YanglinEnemy::onSpinningEnd);
+    connect(m_spinningDurationTimer, &GameTimer::timeout, this, &YanglinEnemy::onSpinningEnd);
 
     // 开局10秒后释放第一次技能
-    m_firstSpinningTimer = new QTimer(this);
+    m_firstSpinningTimer = new GameTimer(this);
     m_firstSpinningTimer->setSingleShot(true);
     m_firstSpinningTimer->setInterval(FIRST_SPINNING_DELAY);
-    connect(m_firstSpinningTimer, &QTimer::timeout, this, &YanglinEnemy::onFirstSpinning);
+    connect(m_firstSpinningTimer, &GameTimer::timeout, this, &YanglinEnemy::onFirstSpinning);
     m_firstSpinningTimer->start();
 }
 
@@ -84,7 +84,7 @@ YanglinEnemy::~YanglinEnemy() {
 
 void YanglinEnemy::onFirstSpinning() {
     // 开局10秒后释放第一次技能
-    qDebug() << "YanglinEnemy: 开局10秒，释放第一次旋转技能！";
+    qCDebug(lcAi) << "YanglinEnemy: 开局10秒，释放第一次旋转技能！";
     startSpinning();
 
     // 启动30秒冷却定时器
@@ -105,7 +105,7 @@ void YanglinEnemy::startSpinning() {
     m_isSpinning = true;
     m_rotationAngle = 0.0;
 
-    qDebug() << "YanglinEnemy: 开始释放旋转技能！（无可视圆，持续5秒）当前缩放:" << getTotalScale();
+    qCDebug(lcAi) << "YanglinEnemy: 开始释放旋转技能！（无可视圆，持续5秒）当前缩放:" << getTotalScale();
 
     // 保存当前移速并增加（与pants类似）
     m_originalSpeed = speed;
@@ -124,7 +124,7 @@ void YanglinEnemy::stopSpinning() {
 
     m_isSpinning = false;
 
-    qDebug() << "YanglinEnemy: 旋转技能结束，当前角度:" << m_rotationAngle;
+    qCDebug(lcAi) << "YanglinEnemy: 旋转技能结束，当前角度:" << m_rotationAngle;
 
     // 恢复原始移速
     speed = m_originalSpeed;
@@ -153,7 +153,7 @@ void YanglinEnemy::onSpinningUpdate() {
                 m_rotationAngle = 0.0;
                 m_isReturningToNormal = false;
                 m_spinningUpdateTimer->stop();
-                qDebug() << "YanglinEnemy: 回正完成";
+                qCDebug(lcAi) << "YanglinEnemy: 回正完成";
             }
         } else {
             // 反转回0度
@@ -162,7 +162,7 @@ void YanglinEnemy::onSpinningUpdate() {
                 m_rotationAngle = 0.0;
                 m_isReturningToNormal = false;
                 m_spinningUpdateTimer->stop();
-                qDebug() << "YanglinEnemy: 回正完成";
+                qCDebug(lcAi) << "YanglinEnemy: 回正完成";
             }
         }
         setRotation(m_rotationAngle);
@@ -221,7 +221,7 @@ void YanglinEnemy::checkSpinningDamage() {
     if (distance <= currentRadius) {
         player->takeDamage(SPINNING_DAMAGE);
         m_lastSpinningDamageTime = currentTime;
-        qDebug() << "YanglinEnemy: 旋转技能命中玩家，造成" << SPINNING_DAMAGE
+        qCDebug(lcAi) << "YanglinEnemy: 旋转技能命中玩家，造成" << SPINNING_DAMAGE
                  << "点伤害，当前半径:" << currentRadius << "当前缩放:" << currentScale;
     }
 }
@@ -2,6 +2,7 @@
 #define YANGLINENEMY_H
 
 #include "scalingenemy.h"
+#include "../../core/gametimer.h"
 
 class Player;
 
@@ -51,11 +52,11 @@ private:
     double getCurrentSpinningRadius() const; // 获取当前缩放下的旋转伤害半径
 
     // 旋转技能相关
-    bool m_isSpinning;               // 是否正在释放旋转技能
-    QTimer *m_spinningCooldownTimer; // 技能冷却定时器（30秒）
-    QTimer *m_spinningUpdateTimer;   // 旋转动画更新定时器
-    QTimer *m_spinningDurationTimer; // 技能持续时间定时器（5秒）
-    QTimer *m_firstSpinningTimer;    // 开局10秒定时器
+    bool m_isSpinning;                   // 是否正在释放旋转技能
+    GameTimer *m_spinningCooldownTimer;  // 技能冷却定时器（30秒）
+    GameTimer *m_spinningUpdateTimer;    // 旋转动画更新定时器
+    GameTimer *m_spinningDurationTimer;  // 技能持续时间定时器（5秒）
+    GameTimer *m_firstSpinningTimer;     // 开局10秒定时器
 
     // 旋转动画相关
     double m_rotationAngle;     // 当前旋转角度
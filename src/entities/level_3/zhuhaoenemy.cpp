@@ -8,7 +8,11 @@
 #include <QtMath>
 #include "../../core/audiomanager.h"
 #include "../../core/configmanager.h"
-#include "../../ui/explosion.h"
+#include "../../core/logging.h"
+#include "../../core/resourcefactory.h"
+#include "../../core/timerwheel.h"
+#include "../../ui/floatingtextlayer.h"
+#include "../../world/bulletpattern.h"
 #include "../player.h"
 
 ZhuhaoEnemy::ZhuhaoEnemy(const QPixmap& pic, double scale)
@@ -39,19 +43,19 @@ ZhuhaoEnemy::ZhuhaoEnemy(const QPixmap& pic, double scale)
     // Level会在添加到场景后调用此方法
 
     // 创建移动定时器
-    m_moveTimer = new QTimer(this);
-    connect(m_moveTimer, &QTimer::timeout, this, &ZhuhaoEnemy::onMoveTimer);
+    m_moveTimer = new GameTimer(this);
+    connect(m_moveTimer, &GameTimer::timeout, this, &ZhuhaoEnemy::onMoveTimer);
     m_moveTimer->start(16);  // 约60fps
 
     // 创建射击定时器
-    m_shootTimer = new QTimer(this);
-    connect(m_shootTimer, &QTimer::timeout, this, &ZhuhaoEnemy::onShootTimer);
+    m_shootTimer = new GameTimer(this);
+    connect(m_shootTimer, &GameTimer::timeout, this, &ZhuhaoEnemy::onShootTimer);
     m_shootTimer->start(SHOOT_COOLDOWN);
 
     // 随机决定顺时针或逆时针
     m_movingClockwise = QRandomGenerator::global()->bounded(2) == 0;
 
-    qDebug() << "创建祝昊精英怪 - 血量:" << health << "边缘移动速度:" << m_edgeSpeed;
+    qCDebug(lcAi) << "创建祝昊精英怪 - 血量:" << health << "边缘移动速度:" << m_edgeSpeed;
 }
 
 ZhuhaoEnemy::~ZhuhaoEnemy() {
@@ -108,7 +112,7 @@ void ZhuhaoEnemy::initializeAtRandomEdge() {
 
     // 将中心坐标转换回左上角坐标来设置位置
     setPos(centerX - halfWidth, centerY - halfHeight);
-    qDebug() << "祝昊初始化位置(中心):" << centerX << centerY << "当前边:" << m_currentEdge;
+    qCDebug(lcAi) << "祝昊初始化位置(中心):" << centerX << centerY << "当前边:" << m_currentEdge;
 }
 
 void ZhuhaoEnemy::onMoveTimer() {
@@ -330,18 +334,15 @@ void ZhuhaoEnemy::shootBarrage() {
     if (!scene())
         return;
 
-    // 360°均匀发射
-    double angleStep = 2 * M_PI / m_bulletCount;  // 360° / 12 = 30°每发
-
     QPointF myPos = pos();
     QPointF bulletStart(myPos.x() + boundingRect().width() / 2,
                         myPos.y() + boundingRect().height() / 2);
 
-    qDebug() << "祝昊发射360°弹幕 - 位置:" << bulletStart << "子弹数:" << m_bulletCount;
-
-    for (int i = 0; i < m_bulletCount; ++i) {
-        double angle = i * angleStep;
+    qCDebug(lcAi) << "祝昊发射360°弹幕 - 位置:" << bulletStart << "子弹数:" << m_bulletCount;
 
+    // 360°均匀发射，方向取自弹幕引擎缓存的方向表
+    BulletPattern ring = BulletPattern::ring(m_bulletCount, m_bulletSpeed, 0);
+    for (const QPointF& direction : BulletPatternEngine::instance().directions(ring, 0.0)) {
         // 随机选择子弹类型
         int bulletTypeRand = QRandomGenerator::global()->bounded(3);
         ZhuhaoProjectile::BulletType bulletType;
@@ -359,7 +360,7 @@ void ZhuhaoEnemy::shootBarrage() {
         }
 
         ZhuhaoProjectile* projectile = new ZhuhaoProjectile(
-            bulletType, bulletStart, angle, m_bulletSpeed, scene());
+            bulletType, bulletStart, direction, m_bulletSpeed, scene());
 
         scene()->addItem(projectile);
     }
@@ -396,11 +397,10 @@ void ZhuhaoEnemy::resumeTimers() {
         m_shootTimer->start(SHOOT_COOLDOWN);
 }
 
-ZhuhaoProjectile::ZhuhaoProjectile(BulletType type, QPointF startPos, double angle, double speed, QGraphicsScene* scene)
+ZhuhaoProjectile::ZhuhaoProjectile(BulletType type, QPointF startPos, QPointF direction, double speed, QGraphicsScene* scene)
     : QObject(nullptr),
       QGraphicsPixmapItem(),
       m_type(type),
-      m_angle(angle),
       m_speed(speed),
       m_moveTimer(nullptr),
       m_collisionTimer(nullptr),
@@ -408,9 +408,9 @@ ZhuhaoProjectile::ZhuhaoProjectile(BulletType type, QPointF startPos, double ang
       m_isDestroying(false) {
     Q_UNUSED(scene);
 
-    // 计算移动方向
-    m_dx = qCos(angle) * speed;
-    m_dy = qSin(angle) * speed;
+    // 计算移动方向（direction 为单位向量）
+    m_dx = direction.x() * speed;
+    m_dy = direction.y() * speed;
 
     setPos(startPos);
     setZValue(50);
@@ -419,13 +419,13 @@ ZhuhaoProjectile::ZhuhaoProjectile(BulletType type, QPointF startPos, double ang
     createVisual();
 
     // 创建移动定时器
-    m_moveTimer = new QTimer(this);
-    connect(m_moveTimer, &QTimer::timeout, this, &ZhuhaoProjectile::onMoveTimer);
+    m_moveTimer = new GameTimer(this);
+    connect(m_moveTimer, &GameTimer::timeout, this, &ZhuhaoProjectile::onMoveTimer);
     m_moveTimer->start(16);
 
     // 创建碰撞检测定时器
-    m_collisionTimer = new QTimer(this);
-    connect(m_collisionTimer, &QTimer::timeout, this, &ZhuhaoProjectile::checkCollision);
+    m_collisionTimer = new GameTimer(this);
+    connect(m_collisionTimer, &GameTimer::timeout, this, &ZhuhaoProjectile::checkCollision);
     m_collisionTimer->start(50);
 }
 
@@ -443,61 +443,62 @@ ZhuhaoProjectile::~ZhuhaoProjectile() {
 }
 
 void ZhuhaoProjectile::createVisual() {
-    QPixmap bulletPix;
-
-    switch (m_type) {
-        case SLEEP_ZZZ: {
-            // 创建 "zzz" 文字图片 - 带背景的圆形气泡
-            bulletPix = QPixmap(50, 30);
-            bulletPix.fill(Qt::transparent);
-            QPainter painter(&bulletPix);
-            painter.setRenderHint(QPainter::Antialiasing);
-            // 绘制蓝色气泡背景
-            painter.setBrush(QColor(100, 100, 255, 180));
-            painter.setPen(QPen(QColor(50, 50, 200), 2));
-            painter.drawRoundedRect(2, 2, 46, 26, 10, 10);
-            // 绘制文字
-            QFont font;
-            font.setPointSize(16);
-            font.setBold(true);
-            painter.setFont(font);
-            painter.setPen(Qt::white);
-            painter.drawText(bulletPix.rect(), Qt::AlignCenter, "zzz");
-            painter.end();
-            break;
-        }
-        case CONFUSED: {
-            // 创建 "叽里咕噜" 文字图片 - 带背景的椭圆气泡
-            bulletPix = QPixmap(90, 30);
-            bulletPix.fill(Qt::transparent);
-            QPainter painter(&bulletPix);
-            painter.setRenderHint(QPainter::Antialiasing);
-            // 绘制橙色气泡背景
-            painter.setBrush(QColor(255, 165, 0, 180));
-            painter.setPen(QPen(QColor(200, 100, 0), 2));
-            painter.drawRoundedRect(2, 2, 86, 26, 12, 12);
-            // 绘制文字
-            QFont font;
-            font.setPointSize(12);
-            font.setBold(true);
-            painter.setFont(font);
-            painter.setPen(Qt::white);
-            painter.drawText(bulletPix.rect(), Qt::AlignCenter, "叽里咕噜");
-            painter.end();
-            break;
-        }
-        case CPU: {
-            // 加载 CPU 子弹图片
-            bulletPix = QPixmap("assets/items/bullet_cpu.png");
-            if (bulletPix.isNull()) {
-                // 如果加载失败，创建占位符
-                bulletPix = QPixmap(30, 30);
-                bulletPix.fill(Qt::cyan);
-            } else {
-                // 缩放到合适大小
-                bulletPix = bulletPix.scaled(30, 30, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    // 每种子弹的图片只绘制/加载一次，之后的子弹共享同一张图
+    static QPixmap s_visuals[3];
+    QPixmap& bulletPix = s_visuals[m_type];
+
+    if (bulletPix.isNull()) {
+        switch (m_type) {
+            case SLEEP_ZZZ: {
+                // 创建 "zzz" 文字图片 - 带背景的圆形气泡
+                bulletPix = QPixmap(50, 30);
+                bulletPix.fill(Qt::transparent);
+                QPainter painter(&bulletPix);
+                painter.setRenderHint(QPainter::Antialiasing);
+                // 绘制蓝色气泡背景
+                painter.setBrush(QColor(100, 100, 255, 180));
+                painter.setPen(QPen(QColor(50, 50, 200), 2));
+                painter.drawRoundedRect(2, 2, 46, 26, 10, 10);
+                // 绘制文字
+                QFont font;
+                font.setPointSize(16);
+                font.setBold(true);
+                painter.setFont(font);
+                painter.setPen(Qt::white);
+                painter.drawText(bulletPix.rect(), Qt::AlignCenter, "zzz");
+                painter.end();
+                break;
+            }
+            case CONFUSED: {
+                // 创建 "叽里咕噜" 文字图片 - 带背景的椭圆气泡
+                bulletPix = QPixmap(90, 30);
+                bulletPix.fill(Qt::transparent);
+                QPainter painter(&bulletPix);
+                painter.setRenderHint(QPainter::Antialiasing);
+                // 绘制橙色气泡背景
+                painter.setBrush(QColor(255, 165, 0, 180));
+                painter.setPen(QPen(QColor(200, 100, 0), 2));
+                painter.drawRoundedRect(2, 2, 86, 26, 12, 12);
+                // 绘制文字
+                QFont font;
+                font.setPointSize(12);
+                font.setBold(true);
+                painter.setFont(font);
+                painter.setPen(Qt::white);
+                painter.drawText(bulletPix.rect(), Qt::AlignCenter, "叽里咕噜");
+                painter.end();
+                break;
+            }
+            case CPU: {
+                // 加载 CPU 子弹图片
+                bulletPix = ResourceFactory::tryLoadSprite("assets/items/bullet_cpu.png", 30, 30);
+                if (bulletPix.isNull()) {
+                    // 如果加载失败，创建占位符
+                    bulletPix = QPixmap(30, 30);
+                    bulletPix.fill(Qt::cyan);
+                }
+                break;
             }
-            break;
         }
     }
 
@@ -534,8 +535,8 @@ void ZhuhaoProjectile::checkCollision() {
 
     QList<QGraphicsItem*> collisions = collidingItems();
     for (QGraphicsItem* item : collisions) {
-        Player* player = dynamic_cast<Player*>(item);
-        if (player) {
+        if (isEntityKind(item, EntityKind::Player)) {
+            Player* player = static_cast<Player*>(item);
             applyEffect(player);
 
             m_isDestroying = true;
@@ -563,43 +564,29 @@ void ZhuhaoProjectile::applyEffect(Player* player) {
                 player->setCanMove(false);
 
                 // 显示"昏睡ZZZ"文字提示（与枕头一致）
-                QGraphicsTextItem* sleepText = new QGraphicsTextItem("昏睡ZZZ");
-                QFont font;
-                font.setPointSize(16);
-                font.setBold(true);
-                sleepText->setFont(font);
-                sleepText->setDefaultTextColor(QColor(128, 128, 128));  // 灰色，与枕头一致
-                sleepText->setPos(player->pos().x(), player->pos().y() - 40);
-                sleepText->setZValue(200);
-                scene()->addItem(sleepText);
+                FloatingTextLayer::showLabel(scene(), "昏睡ZZZ", QColor(128, 128, 128), player, QPointF(0, -40),
+                                             1500);  // 灰色，与枕头一致
 
                 QPointer<Player> playerPtr = player;
-                QPointer<QGraphicsTextItem> sleepTextPtr = sleepText;
 
                 // 1.5秒后恢复移动（与枕头一致，不跟随移动）
                 // 使用player作为上下文对象，确保player销毁时回调不会执行
-                QTimer::singleShot(1500, player, [playerPtr, sleepTextPtr]() {
+                TimerWheel::instance().schedule(player, 1500, [playerPtr]() {
                     if (playerPtr) {
                         playerPtr->setCanMove(true);
-                        QTimer::singleShot(3000, playerPtr.data(), [playerPtr]() {
+                        TimerWheel::instance().schedule(playerPtr.data(), 3000, [playerPtr]() {
                             if (playerPtr) {
                                 playerPtr->setEffectCooldown(false);
                             }
                         });
                     }
-                    if (sleepTextPtr) {
-                        if (sleepTextPtr->scene()) {
-                            sleepTextPtr->scene()->removeItem(sleepTextPtr);
-                        }
-                        delete sleepTextPtr;
-                    }
                 });
             }
             break;
 
         case CONFUSED: {
             // 2点伤害，50%昏迷或50%惊吓
-            qDebug() << "叽里咕噜子弹命中 - 2点伤害，50%昏迷或50%惊吓";
+            qCDebug(lcAi) << "叽里咕噜子弹命中 - 2点伤害，50%昏迷或50%惊吓";
             player->takeDamage(2);
             if (!player->isEffectOnCooldown()) {
                 player->setEffectCooldown(true);
@@ -611,83 +598,43 @@ void ZhuhaoProjectile::applyEffect(Player* player) {
                     if (player->canMove()) {
                         player->setCanMove(false);
 
-                        QGraphicsTextItem* sleepText = new QGraphicsTextItem("昏睡ZZZ");
-                        QFont font;
-                        font.setPointSize(16);
-                        font.setBold(true);
-                        sleepText->setFont(font);
-                        sleepText->setDefaultTextColor(QColor(128, 128, 128));  // 灰色，与枕头一致
-                        sleepText->setPos(player->pos().x(), player->pos().y() - 40);
-                        sleepText->setZValue(200);
-                        currentScene->addItem(sleepText);
-                        QPointer<QGraphicsTextItem> sleepTextPtr = sleepText;
+                        FloatingTextLayer::showLabel(currentScene, "昏睡ZZZ", QColor(128, 128, 128), player,
+                                                     QPointF(0, -40), 1500);  // 灰色，与枕头一致
 
                         // 1.5秒后恢复移动（与枕头一致，不跟随移动）
                         // 使用player作为上下文对象，确保player销毁时回调不会执行
-                        QTimer::singleShot(1500, player, [playerPtr, sleepTextPtr]() {
+                        TimerWheel::instance().schedule(player, 1500, [playerPtr]() {
                             if (playerPtr) {
                                 playerPtr->setCanMove(true);
-                                QTimer::singleShot(3000, playerPtr.data(), [playerPtr]() {
+                                TimerWheel::instance().schedule(playerPtr.data(), 3000, [playerPtr]() {
                                     if (playerPtr) {
                                         playerPtr->setEffectCooldown(false);
                                     }
                                 });
                             }
-                            if (sleepTextPtr) {
-                                if (sleepTextPtr->scene()) {
-                                    sleepTextPtr->scene()->removeItem(sleepTextPtr);
-                                }
-                                delete sleepTextPtr;
-                            }
                         });
                     }
                 } else {
                     // 50%惊吓效果（与闹钟一致：移动速度增加但受伤提升150%）
                     if (!player->isScared()) {
                         // 显示"惊吓！！"文字提示
-                        QGraphicsTextItem* scareText = new QGraphicsTextItem("惊吓！！");
-                        QFont font;
-                        font.setPointSize(16);
-                        font.setBold(true);
-                        scareText->setFont(font);
-                        scareText->setDefaultTextColor(QColor(128, 128, 128));  // 灰色，与闹钟一致
-                        scareText->setPos(player->pos().x(), player->pos().y() - 40);
-                        scareText->setZValue(200);
-                        currentScene->addItem(scareText);
+                        // 文字跟随玩家移动（灰色，与闹钟一致）
+                        FloatingTextLayer::showLabel(currentScene, "惊吓！！", QColor(128, 128, 128), player,
+                                                     QPointF(0, -40), 3000, true);
 
                         // 应用惊吓效果
                         player->setScared(true);
-                        QPointer<QGraphicsTextItem> scareTextPtr = scareText;
-
-                        // 以player为父对象，确保player销毁时定时器也被销毁
-                        QTimer* followTimer = new QTimer(player);
-                        QObject::connect(followTimer, &QTimer::timeout, [playerPtr, scareTextPtr]() {
-                            if (playerPtr && scareTextPtr && scareTextPtr->scene()) {
-                                scareTextPtr->setPos(playerPtr->pos().x(), playerPtr->pos().y() - 40);
-                            }
-                        });
-                        followTimer->start(16);
 
                         // 3秒后恢复
-                        QTimer::singleShot(3000, player, [playerPtr, scareTextPtr, followTimer]() {
-                            if (followTimer) {
-                                followTimer->stop();
-                                followTimer->deleteLater();
-                            }
+                        TimerWheel::instance().schedule(player, 3000, [playerPtr]() {
                             if (playerPtr) {
                                 playerPtr->setScared(false);
-                                QTimer::singleShot(3000, playerPtr.data(), [playerPtr]() {
+                                TimerWheel::instance().schedule(playerPtr.data(), 3000, [playerPtr]() {
                                     if (playerPtr) {
                                         playerPtr->setEffectCooldown(false);
                                     }
                                 });
                             }
-                            if (scareTextPtr) {
-                                if (scareTextPtr->scene()) {
-                                    scareTextPtr->scene()->removeItem(scareTextPtr);
-                                }
-                                delete scareTextPtr;
-                            }
                         });
                     } else {
                         // 已经惊吓中，解除冷却
@@ -700,7 +647,7 @@ void ZhuhaoProjectile::applyEffect(Player* player) {
 
         case CPU: {
             // 2点伤害，100%惊吓效果
-            qDebug() << "CPU子弹命中 - 2点伤害，100%惊吓";
+            qCDebug(lcAi) << "CPU子弹命中 - 2点伤害，100%惊吓";
             player->takeDamage(2);
             if (!player->isEffectOnCooldown() && !player->isScared()) {
                 player->setEffectCooldown(true);
@@ -708,49 +655,23 @@ void ZhuhaoProjectile::applyEffect(Player* player) {
                 QGraphicsScene* currentScene = scene();
 
                 // 显示"惊吓！！"文字提示
-                QGraphicsTextItem* scareText = new QGraphicsTextItem("惊吓！！");
-                QFont font;
-                font.setPointSize(16);
-                font.setBold(true);
-                scareText->setFont(font);
-                scareText->setDefaultTextColor(QColor(128, 128, 128));  // 灰色，与闹钟一致
-                scareText->setPos(player->pos().x(), player->pos().y() - 40);
-                scareText->setZValue(200);
-                currentScene->addItem(scareText);
+                // 文字跟随玩家移动（灰色，与闹钟一致）
+                FloatingTextLayer::showLabel(currentScene, "惊吓！！", QColor(128, 128, 128), player,
+                                             QPointF(0, -40), 3000, true);
 
                 // 应用惊吓效果（与闹钟一致：移动速度增加但受伤提升150%）
                 player->setScared(true);
-                QPointer<QGraphicsTextItem> scareTextPtr = scareText;
-
-                // 以player为父对象，确保player销毁时定时器也被销毁
-                QTimer* followTimer = new QTimer(player);
-                QObject::connect(followTimer, &QTimer::timeout, [playerPtr, scareTextPtr]() {
-                    if (playerPtr && scareTextPtr && scareTextPtr->scene()) {
-                        scareTextPtr->setPos(playerPtr->pos().x(), playerPtr->pos().y() - 40);
-                    }
-                });
-                followTimer->start(16);
 
                 // 3秒后恢复
-                QTimer::singleShot(3000, player, [playerPtr, scareTextPtr, followTimer]() {
-                    if (followTimer) {
-                        followTimer->stop();
-                        followTimer->deleteLater();
-                    }
+                TimerWheel::instance().schedule(player, 3000, [playerPtr]() {
                     if (playerPtr) {
                         playerPtr->setScared(false);
-                        QTimer::singleShot(3000, playerPtr.data(), [playerPtr]() {
+                        TimerWheel::instance().schedule(playerPtr.data(), 3000, [playerPtr]() {
                             if (playerPtr) {
                                 playerPtr->setEffectCooldown(false);
                             }
                         });
                     }
-                    if (scareTextPtr) {
-                        if (scareTextPtr->scene()) {
-                            scareTextPtr->scene()->removeItem(scareTextPtr);
-                        }
-                        delete scareTextPtr;
-                    }
                 });
             }
             break;
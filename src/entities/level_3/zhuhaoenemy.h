@@ -4,6 +4,7 @@
 #include "../enemy.h"
 #include <QTimer>
 #include <QVector>
+#include "../../core/gametimer.h"
 
 class Player;
 
@@ -72,7 +73,7 @@ private:
     double getInwardAngle();               // 获取向内的角度（用于计算弹幕方向）
 
     // 移动相关
-    QTimer *m_moveTimer;
+    GameTimer *m_moveTimer;
     double m_edgeSpeed;     // 沿边缘移动速度
     bool m_movingClockwise; // 是否顺时针移动
     int m_currentEdge;      // 当前所在边 0=上 1=右 2=下 3=左
@@ -85,7 +86,7 @@ private:
     static constexpr double CORNER_THRESHOLD = 40.0; // 角落检测阈值
 
     // 射击相关
-    QTimer *m_shootTimer;
+    GameTimer *m_shootTimer;
     int m_bulletCount;    // 一波弹幕数量
     double m_bulletSpeed; // 子弹速度
 
@@ -109,7 +110,7 @@ public:
         CPU        // CPU子弹
     };
 
-    ZhuhaoProjectile(BulletType type, QPointF startPos, double angle, double speed, QGraphicsScene *scene);
+    ZhuhaoProjectile(BulletType type, QPointF startPos, QPointF direction, double speed, QGraphicsScene *scene);
 
     ~ZhuhaoProjectile() override;
 
@@ -128,11 +129,10 @@ private:
     void applyEffect(Player *player); // 应用效果到玩家
 
     BulletType m_type;
-    double m_angle; // 移动角度（弧度）
     double m_speed;
     double m_dx, m_dy; // 移动方向
-    QTimer *m_moveTimer;
-    QTimer *m_collisionTimer;
+    GameTimer *m_moveTimer;
+    GameTimer *m_collisionTimer;
     bool m_isPaused;
     bool m_isDestroying;
 };
@@ -1,64 +1,20 @@
 #include "player.h"
-#include <QDateTime>
 #include <QElapsedTimer>
-#include <QGraphicsEllipseItem>
 #include <QGraphicsScene>
-#include <QPen>
 #include <QRandomGenerator>
 #include <QtGlobal>
 #include <cmath>
 #include "../core/configmanager.h"
+#include "../core/logging.h"
+#include "../core/resourcefactory.h"
+#include "../core/spritevariantcache.h"
 #include "../items/itemeffectconfig.h"
+#include "../ui/effectsystem.h"
+#include "../world/triggersystem.h"
 #include "constants.h"
 #include "enemy.h"
 
 namespace {
-class TeleportEffectItem : public QObject, public QGraphicsEllipseItem {
-   public:
-    TeleportEffectItem(QGraphicsScene* scene, const QPointF& center, qreal radius = 35.0)
-        : QObject(scene), QGraphicsEllipseItem(-radius, -radius, radius * 2, radius * 2) {
-        if (!scene) {
-            deleteLater();
-            return;
-        }
-
-        setPen(QPen(QColor(120, 220, 255, 220), 3));
-        setBrush(Qt::NoBrush);
-        setZValue(900);
-        setPos(center);
-        scene->addItem(this);
-
-        m_timer = new QTimer(this);
-        connect(m_timer, &QTimer::timeout, this, [this]() { advanceEffect(); });
-        m_timer->start(16);
-    }
-
-   private:
-    void advanceEffect() {
-        m_elapsed += 16;
-        qreal progress = qBound(0.0, m_elapsed / m_duration, 1.0);
-        setOpacity(1.0 - progress);
-        setScale(1.0 + progress * 0.5);
-
-        if (m_elapsed >= m_duration) {
-            if (scene()) {
-                scene()->removeItem(this);
-            }
-            deleteLater();
-        }
-    }
-
-    QTimer* m_timer = nullptr;
-    qreal m_elapsed = 0.0;
-    qreal m_duration = 220.0;
-};
-
-void spawnTeleportEffect(QGraphicsScene* scene, const QPointF& center) {
-    if (!scene)
-        return;
-    new TeleportEffectItem(scene, center);
-}
-
 // 计算图片非透明像素的中心点（相对于图片左上角）
 QPointF getOpaqueCenter(const QPixmap& pixmap, int alphaThreshold = 50) {
     if (pixmap.isNull())
@@ -94,6 +50,7 @@ QPointF getOpaqueCenter(const QPixmap& pixmap, int alphaThreshold = 50) {
 Player::Player(const QPixmap& pic_player, double scale)
     : redContainers(8), redHearts(8.0), blackHearts(0), shootCooldown(150), lastShootTime(0), bulletHurt(5), isDead(false), keys(1), m_frostChance(0), m_shieldCount(0), m_shieldSprite(nullptr) {
     setTransformationMode(Qt::SmoothTransformation);
+    registerKind(EntityKind::Player);
 
     // 从配置文件读取玩家属性
     ConfigManager& config = ConfigManager::instance();
@@ -109,15 +66,14 @@ Player::Player(const QPixmap& pic_player, double scale)
     m_bulletScaleMultiplier = config.getPlayerDouble("ultimate_bullet_scale", 2.0);
 
     // 加载寒冰子弹图片并缩放到与普通子弹相同大小
-    QPixmap frostPic("assets/items/bullet_frost.png");
-    if (frostPic.isNull()) {
+    // 缩放到与普通子弹相同的大小（20x20）
+    m_frostBulletPic = ResourceFactory::tryLoadSprite("assets/items/bullet_frost.png", 20, 20);
+    if (m_frostBulletPic.isNull()) {
         qWarning() << "无法加载寒冰子弹图片";
     } else {
-        // 缩放到与普通子弹相同的大小（20x20）
-        m_frostBulletPic = frostPic.scaled(20, 20, Qt::KeepAspectRatio, Qt::SmoothTransformation);
         // 预计算寒冰子弹的非透明中心点
         m_frostBulletOpaqueCenter = getOpaqueCenter(m_frostBulletPic);
-        qDebug() << "寒冰子弹图片加载成功，大小:" << m_frostBulletPic.size() << "非透明中心:" << m_frostBulletOpaqueCenter;
+        qCDebug(lcAssets) << "寒冰子弹图片加载成功，大小:" << m_frostBulletPic.size() << "非透明中心:" << m_frostBulletOpaqueCenter;
     }
 
     // 如果scale是1.0，直接使用原始pixmap，否则按比例缩放
@@ -160,26 +116,25 @@ Player::Player(const QPixmap& pic_player, double scale)
     keysPressed[Qt::Key_Space] = false;
     keysPressed[Qt::Key_E] = false;
 
-    keysTimer = new QTimer(this);
-    connect(keysTimer, &QTimer::timeout, this, &Player::move);
+    keysTimer = new GameTimer(this);
+    connect(keysTimer, &GameTimer::timeout, this, &Player::move);
     keysTimer->start(16);
 
-    crashTimer = new QTimer(this);
-    connect(crashTimer, &QTimer::timeout, this, &Player::crashEnemy);
+    crashTimer = new GameTimer(this);
+    connect(crashTimer, &GameTimer::timeout, this, &Player::crashEnemy);
     crashTimer->start(50);
 
     // 射击检测定时器（持续检测射击按键状态）
-    shootTimer = new QTimer(this);
-    connect(shootTimer, &QTimer::timeout, this, &Player::checkShoot);
+    shootTimer = new GameTimer(this);
+    connect(shootTimer, &GameTimer::timeout, this, &Player::checkShoot);
     shootTimer->start(16);  // 每16ms检测一次
     // 增伤技能初始即可使用
-    m_lastUltimateTime = QDateTime::currentMSecsSinceEpoch() - m_ultimateCooldownMs;
+    m_lastUltimateTime = GameClock::instance().now() - m_ultimateCooldownMs;
 
-    // 初始无敌时间，防止刚进入游戏时被判定碰撞闪烁
-    invincible = true;
     // 确保 isFlashing 初始为 false
     isFlashing = false;
-    QTimer::singleShot(1000, this, [this]() { invincible = false; });
+    // 初始无敌时间，防止刚进入游戏时被判定碰撞闪烁
+    setInvincible();
 }
 
 void Player::keyPressEvent(QKeyEvent* event) {
@@ -201,6 +156,10 @@ void Player::keyPressEvent(QKeyEvent* event) {
     // 处理移动按键（方向键）
     if (keysPressed.count(event->key())) {
         keysPressed[event->key()] = true;
+        // 空格为交互键：派发给玩家所在的触发区域（宝箱等）
+        if (event->key() == Qt::Key_Space && !event->isAutoRepeat()) {
+            TriggerSystem::instance().playerInteract(this);
+        }
         event->accept();
         return;
     }
@@ -249,7 +208,7 @@ void Player::checkShoot() {
 
     // 如果有按键按下，检查冷却时间
     if (shootKey != -1) {
-        qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+        qint64 currentTime = GameClock::instance().now();
         if (currentTime - lastShootTime >= shootCooldown) {
             shoot(shootKey);
             lastShootTime = currentTime;
@@ -374,6 +333,9 @@ void Player::move() {
 
     this->setPos(clampedPos);
 
+    // 检测触发区域（出门、宝箱、陷阱、掉落物）
+    TriggerSystem::instance().playerMoved(this);
+
     // 更新护盾位置
     if (m_shieldSprite) {
         updateShieldDisplay();
@@ -388,8 +350,9 @@ void Player::tryTeleport() {
     if (qFuzzyIsNull(dir.x()) && qFuzzyIsNull(dir.y()))
         return;
 
-    qint64 now = QDateTime::currentMSecsSinceEpoch();
-    if (now - m_lastTeleportTime < m_teleportCooldownMs)
+    // 游戏时间从0开始计，0 表示尚未瞬移过
+    qint64 now = GameClock::instance().now();
+    if (m_lastTeleportTime != 0 && now - m_lastTeleportTime < m_teleportCooldownMs)
         return;
 
     QPointF desiredPos = pos() + dir * m_teleportDistance;
@@ -399,13 +362,14 @@ void Player::tryTeleport() {
     QPointF centerOffset(bounds.width() / 2.0, bounds.height() / 2.0);
 
     if (scenePtr) {
-        spawnTeleportEffect(scenePtr, pos() + centerOffset);
+        EffectSystem::spawnTeleportRing(scenePtr, pos() + centerOffset);
     }
 
     AudioManager::instance().playSound("player_teleport");
     setPos(clampedPos);
+    TriggerSystem::instance().playerMoved(this);
     if (scenePtr) {
-        spawnTeleportEffect(scenePtr, clampedPos + centerOffset);
+        EffectSystem::spawnTeleportRing(scenePtr, clampedPos + centerOffset);
     }
     m_lastTeleportTime = now;
 }
@@ -470,7 +434,7 @@ int Player::getTeleportRemainingMs() const {
     if (m_lastTeleportTime == 0)
         return 0;
 
-    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 now = GameClock::instance().now();
     int remaining = m_teleportCooldownMs - static_cast<int>(now - m_lastTeleportTime);
     return qMax(0, remaining);
 }
@@ -496,7 +460,7 @@ void Player::activateUltimate() {
     if (m_isUltimateActive)
         return;
 
-    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 now = GameClock::instance().now();
     if (now - m_lastUltimateTime < m_ultimateCooldownMs)
         return;
 
@@ -507,22 +471,14 @@ void Player::activateUltimate() {
     // 伤害变为2倍
     bulletHurt = qMax(1, bulletHurt * 2);
 
-    // 子弹变大（普通子弹和寒冰子弹都放大）
+    // 子弹变大（普通子弹和寒冰子弹都放大，放大图缓存复用，再次开大招不再重新缩放）
     if (!pic_bullet.isNull()) {
-        pic_bullet = pic_bullet.scaled(
-            pic_bullet.width() * m_bulletScaleMultiplier,
-            pic_bullet.height() * m_bulletScaleMultiplier,
-            Qt::KeepAspectRatio,
-            Qt::SmoothTransformation);
+        pic_bullet = SpriteVariantCache::instance().scaledVariant(pic_bullet, m_bulletScaleMultiplier);
         // 重新计算放大后的子弹中心点
         m_bulletOpaqueCenter = getOpaqueCenter(pic_bullet);
     }
     if (!m_frostBulletPic.isNull()) {
-        m_frostBulletPic = m_frostBulletPic.scaled(
-            m_frostBulletPic.width() * m_bulletScaleMultiplier,
-            m_frostBulletPic.height() * m_bulletScaleMultiplier,
-            Qt::KeepAspectRatio,
-            Qt::SmoothTransformation);
+        m_frostBulletPic = SpriteVariantCache::instance().scaledVariant(m_frostBulletPic, m_bulletScaleMultiplier);
         // 重新计算放大后的寒冰子弹中心点
         m_frostBulletOpaqueCenter = getOpaqueCenter(m_frostBulletPic);
     }
@@ -531,9 +487,9 @@ void Player::activateUltimate() {
     m_lastUltimateTime = now;
 
     if (!m_ultimateTimer) {
-        m_ultimateTimer = new QTimer(this);
+        m_ultimateTimer = new GameTimer(this);
         m_ultimateTimer->setSingleShot(true);
-        connect(m_ultimateTimer, &QTimer::timeout, this, &Player::endUltimate);
+        connect(m_ultimateTimer, &GameTimer::timeout, this, &Player::endUltimate);
     }
     m_ultimateTimer->start(m_ultimateDurationMs);
 
@@ -574,7 +530,7 @@ int Player::getUltimateRemainingMs() const {
     if (m_lastUltimateTime == 0)
         return 0;
 
-    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 now = GameClock::instance().now();
     int remaining = m_ultimateCooldownMs - static_cast<int>(now - m_lastUltimateTime);
     return qMax(0, remaining);
 }
@@ -626,7 +582,7 @@ void Player::takeDamage(int damage) {
         m_shieldCount--;
         updateShieldDisplay();
         setInvincible();  // 护盾抵消后也给予短暂无敌
-        qDebug() << "护盾抵消伤害，剩余护盾:" << m_shieldCount;
+        qCDebug(lcPlayer) << "护盾抵消伤害，剩余护盾:" << m_shieldCount;
         return;
     }
 
@@ -668,7 +624,7 @@ void Player::forceTakeDamage(int damage) {
         m_shieldCount--;
         updateShieldDisplay();
         setInvincible();
-        qDebug() << "护盾抵消强制伤害，剩余护盾:" << m_shieldCount;
+        qCDebug(lcPlayer) << "护盾抵消强制伤害，剩余护盾:" << m_shieldCount;
         return;
     }
 
@@ -709,7 +665,7 @@ void Player::die() {
 
     // 暂未使用实际的player_death.wav
     AudioManager::instance().playSound("player_death");
-    qDebug() << "玩家死亡音效已触发";
+    qCDebug(lcAudio) << "玩家死亡音效已触发";
 
     // 停止所有定时器
     if (keysTimer) {
@@ -732,13 +688,20 @@ void Player::die() {
 // 短暂无敌效果，有待UI同学的具体实现
 void Player::setInvincible() {
     invincible = true;
-    QTimer::singleShot(1000, this, [this]() { invincible = false; });
+    // 连续受击时从最后一次开始重新计时，旧的结束回调不能提前取消无敌
+    TimerWheel::instance().cancel(m_invincibleTimer);
+    m_invincibleTimer = TimerWheel::instance().schedule(this, 1000, [this]() {
+        invincible = false;
+        m_invincibleTimer = TimerHandle();
+    });
 }
 
 // 持久无敌（需要手动取消）
 void Player::setPermanentInvincible(bool inv) {
+    // 取消尚未结束的短暂无敌，避免它到期时解除持久无敌
+    TimerWheel::instance().cancel(m_invincibleTimer);
     invincible = inv;
-    qDebug() << "[Player] 持久无敌设置为:" << inv;
+    qCDebug(lcPlayer) << "[Player] 持久无敌设置为:" << inv;
 }
 
 void Player::crashEnemy() {
@@ -755,7 +718,8 @@ void Player::crashEnemy() {
     // 使用collidingItems代替遍历整个场景
     QList<QGraphicsItem*> collisions = collidingItems();
     for (QGraphicsItem* item : collisions) {
-        if (auto enemy = dynamic_cast<Enemy*>(item)) {
+        if (isEntityKind(item, EntityKind::Enemy)) {
+            auto enemy = static_cast<Enemy*>(item);
             // 使用像素级碰撞检测
             if (Entity::pixelCollision(this, enemy)) {
                 this->takeDamage(enemy->getContactDamage());
@@ -776,24 +740,91 @@ void Player::setBulletPic(const QPixmap& pic) {
     pic_bullet = pic;
     // 预计算普通子弹的非透明中心点
     m_bulletOpaqueCenter = getOpaqueCenter(pic_bullet);
-    qDebug() << "普通子弹图片设置成功，非透明中心:" << m_bulletOpaqueCenter;
+    qCDebug(lcAssets) << "普通子弹图片设置成功，非透明中心:" << m_bulletOpaqueCenter;
 }
 
 void Player::addFrostChance(int amount) {
     m_frostChance = qMin(60, m_frostChance + amount);
-    qDebug() << "寒冰子弹概率增加到:" << m_frostChance << "%";
+    qCDebug(lcPlayer) << "寒冰子弹概率增加到:" << m_frostChance << "%";
+}
+
+PlayerState Player::saveState() const {
+    PlayerState state;
+    state.pos = pos();
+    state.redContainers = redContainers;
+    state.redHearts = redHearts;
+    state.blackHearts = blackHearts;
+    state.keys = keys;
+    state.bulletHurt = m_isUltimateActive && m_ultimateOriginalBulletHurt > 0 ? m_ultimateOriginalBulletHurt : bulletHurt;
+    state.shootCooldown = shootCooldown;
+    // 惊吓状态是临时的，保存惊吓前的速度和受伤倍率
+    state.speed = m_isScared ? m_originalSpeed : speed;
+    state.shootSpeed = shootSpeed;
+    state.hurt = hurt;
+    state.damageScale = m_isScared ? m_originalDamageScale : damageScale;
+    state.frostChance = m_frostChance;
+    state.shieldCount = m_shieldCount;
+    return state;
+}
+
+void Player::restoreState(const PlayerState& state) {
+    endUltimate();
+    m_isScared = false;
+
+    setPos(state.pos);
+    redContainers = state.redContainers;
+    redHearts = state.redHearts;
+    blackHearts = state.blackHearts;
+    keys = state.keys;
+    bulletHurt = state.bulletHurt;
+    shootCooldown = state.shootCooldown;
+    speed = state.speed;
+    shootSpeed = state.shootSpeed;
+    hurt = state.hurt;
+    damageScale = state.damageScale;
+    m_frostChance = state.frostChance;
+    m_shieldCount = state.shieldCount;
+    updateShieldDisplay();
+
+    emit healthChanged(redHearts, getMaxHealth());
+}
+
+void Player::revive() {
+    isDead = false;
+    m_canMove = true;
+    m_canShoot = true;
+    m_isPaused = false;
+    m_effectOnCooldown = false;
+    cancelFlash();
+
+    // 清除死亡前按住的按键，避免复活后自动移动/射击
+    for (auto it = keysPressed.begin(); it != keysPressed.end(); ++it) {
+        it.value() = false;
+    }
+    for (auto it = shootKeysPressed.begin(); it != shootKeysPressed.end(); ++it) {
+        it.value() = false;
+    }
+
+    setScale(1.0);
+    setVisible(true);
+    keysTimer->start(16);
+    crashTimer->start(50);
+    shootTimer->start(16);
+
+    // 复活后短暂无敌
+    setInvincible();
 }
 
 void Player::addShield(int count) {
     m_shieldCount += count;
     updateShieldDisplay();
-    qDebug() << "护盾增加，当前护盾数:" << m_shieldCount;
+    qCDebug(lcPlayer) << "护盾增加，当前护盾数:" << m_shieldCount;
 }
 
 void Player::removeShield(int count) {
     m_shieldCount = qMax(0, m_shieldCount - count);
     updateShieldDisplay();
-    qDebug() << "护盾减少，当前护盾数:" << m_shieldCount;
+    qCDebug(lcPlayer) << "护盾减少，当前护盾数:" << m_shieldCount;
 }
 
 void Player::updateShieldDisplay() {
@@ -847,7 +878,7 @@ bool Player::tryBlackHeartRevive() {
         return false;  // 没有黑心，无法复活
     }
 
-    qDebug() << "触发黑心复活！黑心数:" << blackHearts;
+    qCDebug(lcPlayer) << "触发黑心复活！黑心数:" << blackHearts;
 
     // 从配置文件读取每个黑心转化的血量
     ItemEffectData blackHeartConfig = ItemEffectConfig::instance().getItemEffect("black_heart");
@@ -873,7 +904,7 @@ bool Player::tryBlackHeartRevive() {
     // 发出血量变化信号
     emit healthChanged(redHearts, getMaxHealth());
 
-    qDebug() << "黑心复活成功！使用黑心:" << usedBlackHearts << "，恢复血量:" << newHealth
+    qCDebug(lcPlayer) << "黑心复活成功！使用黑心:" << usedBlackHearts << "，恢复血量:" << newHealth
              << "（每个黑心转化" << healPerHeart << "点血量）";
 
     return true;
@@ -7,21 +7,42 @@
 #include <QTimer>
 #include <QVector>
 #include "../core/audiomanager.h"
+#include "../core/gametimer.h"
+#include "../core/timerwheel.h"
 #include "constants.h"
 #include "entity.h"
 #include "projectile.h"
 
+/**
+ * @brief 玩家可恢复状态的值快照（属性与道具），用于房间重试
+ */
+struct PlayerState {
+    QPointF pos;
+    int redContainers = 0;
+    double redHearts = 0.0;
+    int blackHearts = 0;
+    int keys = 0;
+    int bulletHurt = 1;  // 不含增伤技能的加成
+    int shootCooldown = 0;
+    double speed = 0.0;
+    double shootSpeed = 0.0;
+    double hurt = 0.0;
+    double damageScale = 1.0;
+    int frostChance = 0;
+    int shieldCount = 0;
+};
+
 class Player : public Entity {
     Q_OBJECT
     int redContainers;
     double redHearts;
     int blackHearts;                   // 黑心数量（用于复活）
     QMap<int, bool> shootKeysPressed;  // 射击按键状态
-    QTimer* keysTimer;
-    QTimer* crashTimer;
-    QTimer* shootTimer;  // 射击检测定时器（持续检测）
-    int shootCooldown;   // 射击冷却时间（毫秒）
-    int shootType;       // 0=普通, 1=激光
+    GameTimer* keysTimer;
+    GameTimer* crashTimer;
+    GameTimer* shootTimer;  // 射击检测定时器（持续检测）
+    int shootCooldown;      // 射击冷却时间（毫秒）
+    int shootType;          // 0=普通, 1=激光
     QPixmap pic_bullet;
     qint64 lastShootTime;  // 上次射击的时间戳
     void shoot(int key);   // 射击方法
@@ -185,6 +206,11 @@ class Player : public Entity {
     // 黑心复活系统
     bool tryBlackHeartRevive();  // 尝试使用黑心复活，返回是否成功
 
+    // 房间重试：保存/恢复属性与道具，并在原地复活
+    [[nodiscard]] PlayerState saveState() const;
+    void restoreState(const PlayerState& state);
+    void revive();  // 清除死亡和各种临时状态，重新启动输入定时器
+
    signals:
     void blackHeartReviveStarted();   // 黑心复活动画开始信号
     void blackHeartReviveFinished();  // 黑心复活动画结束信号
@@ -213,7 +239,8 @@ class Player : public Entity {
     double m_bulletScaleMultiplier = 2.0;  // 技能期间子弹缩放倍率
     QPixmap m_originalBulletPic;           // 原始子弹图片
     QPixmap m_originalFrostBulletPic;      // 原始寒冰子弹图片
-    QTimer* m_ultimateTimer = nullptr;     // 技能持续计时
+    GameTimer* m_ultimateTimer = nullptr;  // 技能持续计时
+    TimerHandle m_invincibleTimer;         // 短暂无敌的结束回调
 
     QPointF currentMoveDirection() const;
 
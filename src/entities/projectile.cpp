@@ -2,15 +2,17 @@
 #include <QDebug>
 #include <QPointer>
 #include <QRandomGenerator>
+#include "../core/logging.h"
 #include "../items/itemeffectconfig.h"
+#include "../world/projectilepool.h"
 #include "enemy.h"
 #include "player.h"
-#include "level_3/probabilityenemy.h"
 #include "statuseffect.h"
 
 Projectile::Projectile(int _mode, double _hurt, QPointF pos, const QPixmap& pic_bullet, double scale)
-    : mode(_mode), isDestroying(false), m_isPaused(false), m_isFrostBullet(false) {
+    : mode(_mode), isDestroying(false), m_isFrostBullet(false) {
     setTransformationMode(Qt::SmoothTransformation);
+    registerKind(EntityKind::Projectile);
 
     // 禁用缓存以避免留下轨迹
     setCacheMode(QGraphicsItem::NoCache);
@@ -42,12 +44,12 @@ Projectile::Projectile(int _mode, double _hurt, QPointF pos, const QPixmap& pic_
     // 预加载碰撞掩码（子弹图片通常很小，生成开销低）
     preloadCollisionMask();
 
-    moveTimer = new QTimer(this);
-    connect(moveTimer, &QTimer::timeout, this, &Projectile::move);
+    moveTimer = new GameTimer(this);
+    connect(moveTimer, &GameTimer::timeout, this, &Projectile::move);
     moveTimer->start(16);
 
-    crashTimer = new QTimer(this);
-    connect(crashTimer, &QTimer::timeout, this, &Projectile::checkCrash);
+    crashTimer = new GameTimer(this);
+    connect(crashTimer, &GameTimer::timeout, this, &Projectile::checkCrash);
     crashTimer->start(50);
 }
 
@@ -62,9 +64,33 @@ Projectile::~Projectile() {
     }
 }
 
+void Projectile::reset(int _mode, double _hurt, QPointF pos, const QPixmap& pic_bullet) {
+    mode = _mode;
+    hurt = _hurt;
+    isDestroying = false;
+    m_isFrostBullet = false;
+    ++m_generation;
+
+    xdir = 0;
+    ydir = 0;
+    speed = 1.0;
+
+    // 上次使用时可能因向左飞行被翻转，换图时恢复朝右
+    if (!pic_bullet.isNull() && (!facingRight || pixmap().cacheKey() != pic_bullet.cacheKey())) {
+        facingRight = true;
+        this->setPixmap(pic_bullet);
+        preloadCollisionMask();
+    }
+
+    this->setPos(pos);
+
+    moveTimer->start(16);
+    crashTimer->start(50);
+}
+
 void Projectile::move() {
-    // 如果正在销毁或暂停，不再执行任何操作
-    if (isDestroying || m_isPaused) {
+    // 如果正在销毁，不再执行任何操作
+    if (isDestroying) {
         return;
     }
 
@@ -98,31 +124,15 @@ void applyFrostEffect(Enemy* enemy) {
     double slowDuration = frostConfig.getSlowDuration();
     double slowFactor = frostConfig.getSlowFactor();
 
-    // 检查是否已达到最大叠加层数
-    if (!enemy->canApplySlowStack(maxStacks)) {
-        qDebug() << "Frost effect: max slow stacks reached, skipping";
-        return;
+    // 叠加层数由效果表维护，达到上限时只刷新持续时间
+    if (!EffectManager::instance().apply(enemy, StatusEffectType::Slow, slowFactor, slowDuration, maxStacks)) {
+        qCDebug(lcCollision) << "Frost effect: max slow stacks reached, refreshing duration";
     }
-
-    // 增加减速层数
-    enemy->addSlowStack();
-
-    SpeedEffect* frostSlow = new SpeedEffect(slowDuration, slowFactor);
-
-    // 连接效果结束信号，减少叠加层数
-    QPointer<Enemy> enemyPtr = enemy;
-    QObject::connect(frostSlow, &QObject::destroyed, [enemyPtr]() {
-        if (enemyPtr) {
-            enemyPtr->removeSlowStack();
-        }
-    });
-
-    frostSlow->applyTo(enemy);
 }
 
 void Projectile::checkCrash() {
-    // 如果正在销毁或暂停，不再执行任何操作
-    if (isDestroying || m_isPaused) {
+    // 如果正在销毁，不再执行任何操作
+    if (isDestroying) {
         return;
     }
 
@@ -140,7 +150,8 @@ void Projectile::checkCrash() {
     if (mode) {
         // 敌人子弹，检测玩家碰撞
         for (QGraphicsItem* item : collisions) {
-            if (auto player = dynamic_cast<Player*>(item)) {
+            if (isEntityKind(item, EntityKind::Player)) {
+                auto player = static_cast<Player*>(item);
                 // 使用像素级碰撞检测
                 if (Entity::pixelCollision(this, player)) {
                     player->takeDamage(hurt);
@@ -152,12 +163,11 @@ void Projectile::checkCrash() {
     } else {
         // 玩家子弹，检测敌人碰撞
         for (QGraphicsItem* item : collisions) {
-            if (auto enemy = dynamic_cast<Enemy*>(item)) {
-                // 特殊处理：如果是ProbabilityEnemy且有其他敌人与之接触，则跳过
-                if (auto probEnemy = dynamic_cast<ProbabilityEnemy*>(enemy)) {
-                    if (probEnemy->hasContactingEnemies()) {
-                        continue;  // 跳过概率论，让子弹继续检测其他敌人
-                    }
+            if (isEntityKind(item, EntityKind::Enemy)) {
+                auto enemy = static_cast<Enemy*>(item);
+                // 特殊处理：如概率论有其他敌人与之接触，则跳过，让子弹继续检测其他敌人
+                if (enemy->letsProjectilesPass()) {
+                    continue;
                 }
 
                 // 使用像素级碰撞检测
@@ -200,10 +210,11 @@ void Projectile::destroy() {
         scene()->removeItem(this);
     }
 
+    // 池化子弹放回空闲列表，池已满时照常删除
+    if (m_pooled && ProjectilePool::instance().release(this)) {
+        return;
+    }
+
     // 这是唯一调用deleteLater的地方
     deleteLater();
 }
-
-void Projectile::setPaused(bool paused) {
-    m_isPaused = paused;
-}
@@ -5,21 +5,33 @@
 #include <QPixmap>
 #include <QPointF>
 #include <QVector>
+#include "../core/gametimer.h"
 #include "entity.h"
 
 class Projectile : public Entity {
-    QTimer* moveTimer;
-    QTimer* crashTimer;
+    GameTimer* moveTimer;
+    GameTimer* crashTimer;
     int mode;              // Player发出：0, Enemy发出：1
     bool isDestroying;     // 标记对象正在销毁，防止重复操作
-    bool m_isPaused;       // 暂停状态
     bool m_isFrostBullet;  // 是否为寒冰子弹
+    bool m_pooled = false;     // 由 ProjectilePool 创建，销毁时回收而不是 deleteLater
+    quint32 m_generation = 0;  // 每次从池中复用时递增，用于识别旧引用
 
    public:
     Projectile(int _mode, double _hurt, QPointF pos, const QPixmap& pic_bullet, double scale = 1.0);
 
     ~Projectile();
 
+    /**
+     * @brief 从对象池取出时恢复初始状态并重新启动定时器（图片相同时不重建碰撞掩码）
+     */
+    void reset(int _mode, double _hurt, QPointF pos, const QPixmap& pic_bullet);
+
+    void setPooled(bool pooled) { m_pooled = pooled; }
+    bool isPooled() const { return m_pooled; }
+    quint32 generation() const { return m_generation; }
+    bool isDestroyed() const { return isDestroying; }
+
     void setDir(int x, int y) {
         xdir = x;
         ydir = y;
@@ -29,12 +41,7 @@ class Projectile : public Entity {
 
     void checkCrash();
 
-    void destroy();  // 唯一的删除入口
-
-    // 暂停控制
-    void setPaused(bool paused);
-
-    bool isPaused() const { return m_isPaused; }
+    void destroy();  // 唯一的删除入口（池化子弹回收到 ProjectilePool）
 
     // 寒冰子弹
     void setIsFrostBullet(bool isFrost) { m_isFrostBullet = isFrost; }
@@ -3,6 +3,7 @@
 #include <QFile>
 #include <QGraphicsOpacityEffect>
 #include <QGraphicsScene>
+#include "../core/logging.h"
 #include "../core/resourcefactory.h"
 #include "../items/chest.h"
 #include "../items/droppeditemfactory.h"
@@ -33,7 +34,7 @@ Usagi::Usagi(QGraphicsScene* scene, Player* player, int levelNumber, const QStri
     // 设置初始位置（屏幕上方）
     setPos(m_targetPos.x(), -100);
 
-    qDebug() << "[Usagi] 创建乌萨奇，目标位置:" << m_targetPos;
+    qCDebug(lcBoss) << "[Usagi] 创建乌萨奇，目标位置:" << m_targetPos;
 }
 
 Usagi::~Usagi() {
@@ -45,7 +46,7 @@ Usagi::~Usagi() {
         m_disappearTimer->stop();
         delete m_disappearTimer;
     }
-    qDebug() << "[Usagi] 乌萨奇已销毁";
+    qCDebug(lcBoss) << "[Usagi] 乌萨奇已销毁";
 }
 
 void Usagi::loadUsagiImage() {
@@ -57,7 +58,7 @@ void Usagi::loadUsagiImage() {
 
     for (const QString& path : possiblePaths) {
         if (QFile::exists(path)) {
-            usagiPix = QPixmap(path);
+            usagiPix = ResourceFactory::tryLoadSprite(path, 80, 80);
             break;
         }
     }
@@ -67,16 +68,13 @@ void Usagi::loadUsagiImage() {
         usagiPix = QPixmap(80, 80);
         usagiPix.fill(Qt::magenta);
         qWarning() << "[Usagi] 无法加载乌萨奇图片，使用占位符";
-    } else {
-        // 缩放乌萨奇图片
-        usagiPix = usagiPix.scaled(80, 80, Qt::KeepAspectRatio, Qt::SmoothTransformation);
     }
 
     setPixmap(usagiPix);
 }
 
 void Usagi::startRewardSequence() {
-    qDebug() << "[Usagi] 开始Boss奖励流程";
+    qCDebug(lcBoss) << "[Usagi] 开始Boss奖励流程";
 
     // 添加到场景
     if (m_scene) {
@@ -91,10 +89,10 @@ void Usagi::startFalling() {
     if (m_hasLanded)
         return;
 
-    qDebug() << "[Usagi] 开始下落动画";
+    qCDebug(lcBoss) << "[Usagi] 开始下落动画";
 
-    m_fallTimer = new QTimer(this);
-    connect(m_fallTimer, &QTimer::timeout, this, &Usagi::onFallTimer);
+    m_fallTimer = new GameTimer(this);
+    connect(m_fallTimer, &GameTimer::timeout, this, &Usagi::onFallTimer);
     m_fallTimer->start(16);  // 约60fps
 }
 
@@ -118,7 +116,7 @@ void Usagi::onFallTimer() {
             m_fallTimer->stop();
         }
 
-        qDebug() << "[Usagi] 乌萨奇已落地";
+        qCDebug(lcBoss) << "[Usagi] 乌萨奇已落地";
         onLanded();
     }
 
@@ -126,7 +124,7 @@ void Usagi::onFallTimer() {
 }
 
 void Usagi::onLanded() {
-    qDebug() << "[Usagi] 显示恭喜对话";
+    qCDebug(lcBoss) << "[Usagi] 显示恭喜对话";
 
     // 生成对话并请求Level显示
     QStringList dialog = generateCongratsDialog();
@@ -188,7 +186,7 @@ QStringList Usagi::generateCongratsDialog() {
 }
 
 void Usagi::onDialogFinished() {
-    qDebug() << "[Usagi] 对话结束，开始消失";
+    qCDebug(lcBoss) << "[Usagi] 对话结束，开始消失";
     startDisappearing();
 }
 
@@ -197,10 +195,10 @@ void Usagi::startDisappearing() {
         return;
 
     m_isDisappearing = true;
-    qDebug() << "[Usagi] 开始消失动画";
+    qCDebug(lcBoss) << "[Usagi] 开始消失动画";
 
-    m_disappearTimer = new QTimer(this);
-    connect(m_disappearTimer, &QTimer::timeout, this, &Usagi::onDisappearTimer);
+    m_disappearTimer = new GameTimer(this);
+    connect(m_disappearTimer, &GameTimer::timeout, this, &Usagi::onDisappearTimer);
     m_disappearTimer->start(50);  // 渐隐速度
 }
 
@@ -213,7 +211,7 @@ void Usagi::onDisappearTimer() {
             m_disappearTimer->stop();
         }
 
-        qDebug() << "[Usagi] 乌萨奇已消失，生成奖励宝箱";
+        qCDebug(lcBoss) << "[Usagi] 乌萨奇已消失，生成奖励宝箱";
 
         // 从场景移除自身
         if (scene()) {
@@ -262,13 +260,13 @@ void Usagi::spawnRewardChests() {
 
         // 连接车票掉落信号 - 发送给Level让它直接连接
         connect(chest, &BossChest::ticketDropped, this, [this](DroppedItem* ticket) {
-            qDebug() << "[Usagi] 收到宝箱的ticketDropped信号，发送ticketCreated给Level";
+            qCDebug(lcBoss) << "[Usagi] 收到宝箱的ticketDropped信号，发送ticketCreated给Level";
             if (ticket) {
                 emit ticketCreated(ticket);
             }
         });
 
-        qDebug() << "[Usagi] 第三关Boss特供宝箱已生成（车票）";
+        qCDebug(lcBoss) << "[Usagi] 第三关Boss特供宝箱已生成（车票）";
     } else {
         // 前两关给两个宝箱
         QPointF chest1Pos(300, 300);
@@ -293,10 +291,10 @@ void Usagi::spawnRewardChests() {
             }
             chest1->setCustomItems(chest1Items);
             chest2->setCustomItems(chest2Items);
-            qDebug() << "[Usagi] 使用自定义物品配置，宝箱1:" << chest1Items.size() << "个，宝箱2:" << chest2Items.size() << "个";
+            qCDebug(lcBoss) << "[Usagi] 使用自定义物品配置，宝箱1:" << chest1Items.size() << "个，宝箱2:" << chest2Items.size() << "个";
         } else {
             // 没有配置物品时，使用默认的Boss宝箱掉落池
-            qDebug() << "[Usagi] 没有配置自定义物品，使用默认Boss宝箱掉落池";
+            qCDebug(lcBoss) << "[Usagi] 没有配置自定义物品，使用默认Boss宝箱掉落池";
         }
 
         // 添加到场景
@@ -310,12 +308,12 @@ void Usagi::spawnRewardChests() {
         connect(chest1, &Chest::opened, this, &Usagi::onChestOpened);
         connect(chest2, &Chest::opened, this, &Usagi::onChestOpened);
 
-        qDebug() << "[Usagi] Boss特供宝箱已生成，共2个";
+        qCDebug(lcBoss) << "[Usagi] Boss特供宝箱已生成，共2个";
     }
 }
 
 void Usagi::onChestOpened(Chest* chest) {
-    qDebug() << "[Usagi] 奖励宝箱被打开";
+    qCDebug(lcBoss) << "[Usagi] 奖励宝箱被打开";
 
     // 从列表中移除
     QPointer<Chest> chestPtr(chest);
@@ -333,12 +331,12 @@ void Usagi::checkAllChestsOpened() {
         m_rewardChests.end());
 
     if (m_rewardChests.isEmpty()) {
-        qDebug() << "[Usagi] 所有奖励宝箱已打开，通知Level打开门";
+        qCDebug(lcBoss) << "[Usagi] 所有奖励宝箱已打开，通知Level打开门";
         emit rewardSequenceCompleted();
 
         // 删除自身
         deleteLater();
     } else {
-        qDebug() << "[Usagi] 还有" << m_rewardChests.size() << "个奖励宝箱未打开";
+        qCDebug(lcBoss) << "[Usagi] 还有" << m_rewardChests.size() << "个奖励宝箱未打开";
     }
 }
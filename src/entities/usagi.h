@@ -9,6 +9,7 @@
 #include <QPointer>
 #include <QTimer>
 #include <QVector>
+#include "../core/gametimer.h"
 #include "../world/levelconfig.h"
 
 class Player;
@@ -92,8 +93,8 @@ class Usagi : public QObject, public QGraphicsPixmapItem {
     int m_levelNumber;
     QStringList m_usagiChestItems;  // 乌萨奇宝箱物品名称列表
 
-    QTimer* m_fallTimer;
-    QTimer* m_disappearTimer;
+    GameTimer* m_fallTimer;
+    GameTimer* m_disappearTimer;
 
     QPointF m_targetPos;    // 目标落地位置
     double m_fallSpeed;     // 下落速度
@@ -6,6 +6,8 @@
 #include <QtMath>
 #include "../constants.h"
 #include "../core/audiomanager.h"
+#include "../core/logging.h"
+#include "../world/triggersystem.h"
 #include "droppeditemfactory.h"
 #include "player.h"
 
@@ -22,21 +24,15 @@ Chest::Chest(Player* pl, ChestType type, const QPixmap& pic_chest, double scale)
     }
 
     // 创建提示文字定时器
-    m_hintTimer = new QTimer(this);
+    m_hintTimer = new GameTimer(this);
     m_hintTimer->setSingleShot(true);
-    connect(m_hintTimer, &QTimer::timeout, this, &Chest::hideHint);
+    connect(m_hintTimer, &GameTimer::timeout, this, &Chest::hideHint);
 
-    // 创建检查打开定时器
-    m_checkOpenTimer = new QTimer(this);
-    connect(m_checkOpenTimer, &QTimer::timeout, this, &Chest::tryOpen);
-    m_checkOpenTimer->start(16);
+    // 开启范围的触发区域在加入场景时注册（见 itemChange）
 }
 
 Chest::~Chest() {
-    if (m_checkOpenTimer) {
-        m_checkOpenTimer->stop();
-        disconnect(m_checkOpenTimer, nullptr, this, nullptr);
-    }
+    TriggerSystem::instance().removeOwner(this);
     if (m_hintTimer) {
         m_hintTimer->stop();
     }
@@ -47,6 +43,29 @@ void Chest::initItems() {
     // 基类不初始化物品，由子类实现
 }
 
+QVariant Chest::itemChange(GraphicsItemChange change, const QVariant& value) {
+    if (change == ItemSceneHasChanged) {
+        updateOpenTrigger();
+    }
+    return QGraphicsPixmapItem::itemChange(change, value);
+}
+
+void Chest::updateOpenTrigger() {
+    TriggerSystem::instance().removeOwner(this);
+    if (!scene() || m_isOpened) {
+        return;
+    }
+
+    // 玩家位置与宝箱位置在两个方向上都不超过 open_r 时可以打开
+    QRectF area(pos().x() - open_r, pos().y() - open_r, open_r * 2, open_r * 2);
+    TriggerSystem::instance().addZone(this, TriggerVolume::box(area, TriggerAnchor::PlayerPos),
+                                      [this](TriggerEvent event) {
+                                          if (event != TriggerEvent::Exit) {
+                                              tryOpen();
+                                          }
+                                      });
+}
+
 void Chest::showHint(const QString& text, const QColor& color) {
     if (!scene())
         return;
@@ -97,10 +116,8 @@ void Chest::tryOpen() {
         return;
     }
 
-    // 检查玩家是否在范围内并按下空格键
-    if (m_player->isKeyPressed(Qt::Key_Space) &&
-        abs(m_player->pos().x() - this->pos().x()) <= open_r &&
-        abs(m_player->pos().y() - this->pos().y()) <= open_r) {
+    // 玩家已在范围内（由触发区域保证），检查是否按下空格键
+    if (m_player->isKeyPressed(Qt::Key_Space)) {
         doOpen();
     }
 }
@@ -111,15 +128,12 @@ void Chest::doOpen() {
 
     emit opened(this);
 
-    // 立即停止并断开定时器，防止重复触发
-    if (m_checkOpenTimer) {
-        m_checkOpenTimer->stop();
-        disconnect(m_checkOpenTimer, nullptr, this, nullptr);
-    }
+    // 立即移除触发区域，防止重复触发
+    TriggerSystem::instance().removeOwner(this);
 
     AudioManager::instance().playSound("chest_open");
-    qDebug() << "宝箱开启音效已触发";
-    qDebug() << "宝箱被打开，类型:" << static_cast<int>(m_chestType);
+    qCDebug(lcRoom) << "宝箱开启音效已触发";
+    qCDebug(lcRoom) << "宝箱被打开，类型:" << static_cast<int>(m_chestType);
 
     // 保存player的QPointer副本
     QPointer<Player> playerPtr = m_player;
@@ -164,7 +178,7 @@ void Chest::dropItems(int count) {
     // 使用工厂类掉落物品
     DroppedItemFactory::dropItemsScattered(pool, chestPos, count, m_player.data(), scene());
 
-    qDebug() << "[Chest] 从位置" << chestPos << "掉落" << count << "个物品，类型:" << static_cast<int>(m_chestType);
+    qCDebug(lcRoom) << "[Chest] 从位置" << chestPos << "掉落" << count << "个物品，类型:" << static_cast<int>(m_chestType);
 }
 
 NormalChest::NormalChest(Player* pl, const QPixmap& pic_chest, double scale)
@@ -227,10 +241,8 @@ void LockedChest::tryOpen() {
         return;
     }
 
-    // 检查玩家是否在范围内并按下空格键
-    if (m_player->isKeyPressed(Qt::Key_Space) &&
-        abs(m_player->pos().x() - this->pos().x()) <= open_r &&
-        abs(m_player->pos().y() - this->pos().y()) <= open_r) {
+    // 玩家已在范围内（由触发区域保证），检查是否按下空格键
+    if (m_player->isKeyPressed(Qt::Key_Space)) {
         // 检查是否有钥匙
         if (m_player->getKeys() > 0) {
             m_player->addKeys(-1);  // 消耗一把钥匙
@@ -271,7 +283,7 @@ void BossChest::initItems() {
 
 void BossChest::setCustomItems(const QVector<QString>& itemNames) {
     m_customItemNames = itemNames;
-    qDebug() << "[BossChest] 设置自定义物品:" << itemNames;
+    qCDebug(lcRoom) << "[BossChest] 设置自定义物品:" << itemNames;
 }
 
 void BossChest::doOpen() {
@@ -280,14 +292,11 @@ void BossChest::doOpen() {
 
     emit opened(this);
 
-    // 立即停止并断开定时器，防止重复触发
-    if (m_checkOpenTimer) {
-        m_checkOpenTimer->stop();
-        disconnect(m_checkOpenTimer, nullptr, this, nullptr);
-    }
+    // 立即移除触发区域，防止重复触发
+    TriggerSystem::instance().removeOwner(this);
 
     AudioManager::instance().playSound("chest_open");
-    qDebug() << "Boss宝箱开启！";
+    qCDebug(lcRoom) << "Boss宝箱开启！";
 
     // 保存player的QPointer副本
     QPointer<Player> playerPtr = m_player;
@@ -306,15 +315,15 @@ void BossChest::doOpen() {
         for (DroppedItem* item : items) {
             if (item && item->getType() == DroppedItemType::TICKET) {
                 emit ticketDropped(item);
-                qDebug() << "Boss宝箱掉落了车票！";
+                qCDebug(lcRoom) << "Boss宝箱掉落了车票！";
             }
         }
 
-        qDebug() << "Boss宝箱掉落自定义物品:" << m_customItemNames.size() << "个";
+        qCDebug(lcRoom) << "Boss宝箱掉落自定义物品:" << m_customItemNames.size() << "个";
     } else {
         // 默认行为：每个Boss宝箱掉落2个物品
         dropItems(2);
-        qDebug() << "Boss宝箱掉落默认2个物品";
+        qCDebug(lcRoom) << "Boss宝箱掉落默认2个物品";
     }
 
     // 隐藏提示
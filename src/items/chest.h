@@ -7,6 +7,7 @@
 #include <QPointer>
 #include <QTimer>
 #include <QVector>
+#include "../core/gametimer.h"
 #include "droppeditem.h"
 #include "item.h"
 #include "player.h"
@@ -33,14 +34,16 @@ class Chest : public QObject, public QGraphicsPixmapItem {
     ChestType m_chestType;
     bool m_isOpened;
     QVector<Item*> m_items;
-    QTimer* m_checkOpenTimer;
     QPointer<Player> m_player;
     QGraphicsTextItem* m_hintText;  // 提示文字
-    QTimer* m_hintTimer;            // 提示文字消失定时器
+    GameTimer* m_hintTimer;         // 提示文字消失定时器
 
     virtual void initItems();                                              // 初始化物品列表
     void showHint(const QString& text, const QColor& color = Qt::yellow);  // 显示提示文字
     void hideHint();                                                       // 隐藏提示文字
+    void updateOpenTrigger();                                              // 按当前场景和位置注册开启范围
+
+    QVariant itemChange(GraphicsItemChange change, const QVariant& value) override;
 
    public:
     Chest(Player* pl, ChestType type, const QPixmap& pic_chest, double scale = 1.0);
@@ -53,7 +56,7 @@ class Chest : public QObject, public QGraphicsPixmapItem {
 
     bool isOpened() const { return m_isOpened; }
 
-    virtual void tryOpen();       // 尝试打开（检查条件）
+    virtual void tryOpen();       // 尝试打开（玩家进入范围或在范围内按空格时由触发区域调用）
     virtual void doOpen();        // 执行打开逻辑
 
     // 掉落物品到场景中
@@ -2,12 +2,15 @@
 #include <QDebug>
 #include <QFile>
 #include <QGraphicsScene>
-#include <QGraphicsTextItem>
 #include <QRandomGenerator>
 #include <QtMath>
 #include "../core/audiomanager.h"
 #include "../core/configmanager.h"
+#include "../core/logging.h"
+#include "../core/resourcefactory.h"
 #include "../entities/player.h"
+#include "../ui/floatingtextlayer.h"
+#include "../world/triggersystem.h"
 #include "itemeffectconfig.h"
 
 DroppedItem::DroppedItem(DroppedItemType type, const QPointF& pos, Player* player, QObject* parent)
@@ -16,8 +19,9 @@ DroppedItem::DroppedItem(DroppedItemType type, const QPointF& pos, Player* playe
       m_player(player),
       m_canPickup(false),
       m_isPickingUp(false),
-      m_isPaused(false),
       m_hasScatterTarget(false) {
+    EntityRegistry::instance().add(EntityKind::DroppedItem, this);
+
     // 加载道具图片
     loadItemPixmap();
 
@@ -27,22 +31,16 @@ DroppedItem::DroppedItem(DroppedItemType type, const QPointF& pos, Player* playe
     // 设置Z值，确保道具显示在合适的层级
     setZValue(50);
 
-    // 创建碰撞检测定时器
-    m_collisionTimer = new QTimer(this);
-    connect(m_collisionTimer, &QTimer::timeout, this, &DroppedItem::checkPlayerCollision);
-    m_collisionTimer->start(50);  // 每50ms检测一次
-
-    // 创建拾取延迟定时器（1秒后才能拾取）
-    m_pickupDelayTimer = new QTimer(this);
+    // 创建拾取延迟定时器（1秒后才能拾取，届时注册拾取触发区域）
+    m_pickupDelayTimer = new GameTimer(this);
     m_pickupDelayTimer->setSingleShot(true);
-    connect(m_pickupDelayTimer, &QTimer::timeout, this, &DroppedItem::enablePickup);
+    connect(m_pickupDelayTimer, &GameTimer::timeout, this, &DroppedItem::enablePickup);
     m_pickupDelayTimer->start(1000);  // 1秒延迟
 }
 
 DroppedItem::~DroppedItem() {
-    if (m_collisionTimer) {
-        m_collisionTimer->stop();
-    }
+    EntityRegistry::instance().remove(EntityKind::DroppedItem, this);
+    TriggerSystem::instance().removeOwner(this);
     if (m_pickupDelayTimer) {
         m_pickupDelayTimer->stop();
     }
@@ -104,16 +102,14 @@ QString DroppedItem::getItemName() const {
 
 void DroppedItem::loadItemPixmap() {
     QString path = getItemImagePath(m_type);
-    QPixmap pix(path);
+    // 缩放到合适大小（32x32），同种道具共用精灵缓存中的同一份图片
+    QPixmap pix = ResourceFactory::tryLoadSprite(path, 32, 32);
 
     if (pix.isNull()) {
         qWarning() << "DroppedItem: 无法加载道具图片:" << path;
         // 创建一个默认的彩色方块作为占位符
         pix = QPixmap(32, 32);
         pix.fill(Qt::yellow);
-    } else {
-        // 缩放到合适大小（32x32）
-        pix = pix.scaled(32, 32, Qt::KeepAspectRatio, Qt::SmoothTransformation);
     }
 
     setPixmap(pix);
@@ -141,50 +137,49 @@ void DroppedItem::startScatterAnimation() {
     moveAnim->start(QAbstractAnimation::DeleteWhenStopped);
 }
 
-void DroppedItem::setPaused(bool paused) {
-    m_isPaused = paused;
+void DroppedItem::enablePickup() {
+    m_canPickup = true;
+    qCDebug(lcCollision) << "DroppedItem:" << getItemName() << "现在可以拾取了";
 
-    if (paused) {
-        if (m_collisionTimer)
-            m_collisionTimer->stop();
-        if (m_pickupDelayTimer && m_pickupDelayTimer->isActive()) {
-            m_pickupDelayTimer->stop();
-        }
-    } else {
-        if (m_collisionTimer && !m_isPickingUp)
-            m_collisionTimer->start(50);
-        // 注意：延迟定时器如果已经完成就不需要重新启动
+    // 延迟期间被移出场景（保留在房间中）的物品，重新加入场景时再注册
+    if (scene()) {
+        registerPickupZone();
     }
 }
 
-void DroppedItem::enablePickup() {
-    m_canPickup = true;
-    qDebug() << "DroppedItem:" << getItemName() << "现在可以拾取了";
+void DroppedItem::suspendPickup() {
+    TriggerSystem::instance().removeOwner(this);
 }
 
-void DroppedItem::checkPlayerCollision() {
-    if (!m_canPickup || m_isPickingUp || m_isPaused || !m_player || !scene()) {
+void DroppedItem::resumePickup() {
+    if (!m_canPickup || m_isPickingUp || !scene())
         return;
-    }
-
-    // 计算与玩家的距离
-    QPointF playerCenter = m_player->pos() + QPointF(m_player->pixmap().width() / 2,
-                                                     m_player->pixmap().height() / 2);
-    QPointF itemCenter = pos() + QPointF(pixmap().width() / 2, pixmap().height() / 2);
-
-    double dx = playerCenter.x() - itemCenter.x();
-    double dy = playerCenter.y() - itemCenter.y();
-    double distance = qSqrt(dx * dx + dy * dy);
+    TriggerSystem::instance().removeOwner(this);
+    registerPickupZone();
+}
 
-    // 拾取距离（玩家半径 + 道具半径）
-    double pickupRange = 40;
+void DroppedItem::registerPickupZone() {
+    // 拾取距离（玩家半径 + 道具半径），以两者中心计算；玩家已站在道具上时下一个移动节拍拾取
+    const double pickupRange = 40;
+    QPointF itemCenter = restingPos() + QPointF(pixmap().width() / 2, pixmap().height() / 2);
+    TriggerSystem::instance().addZone(this, TriggerVolume::circle(itemCenter, pickupRange, TriggerAnchor::PlayerCenter),
+                                      [this](TriggerEvent event) {
+                                          if (event == TriggerEvent::Enter) {
+                                              onPlayerEntered();
+                                          }
+                                      },
+                                      true);
+}
 
-    if (distance < pickupRange) {
-        // 触发拾取
-        m_isPickingUp = true;
-        m_collisionTimer->stop();
-        startPickupAnimation();
+void DroppedItem::onPlayerEntered() {
+    if (!m_canPickup || m_isPickingUp || !m_player || !scene()) {
+        return;
     }
+
+    // 触发拾取
+    m_isPickingUp = true;
+    TriggerSystem::instance().removeOwner(this);
+    startPickupAnimation();
 }
 
 void DroppedItem::startPickupAnimation() {
@@ -328,11 +323,11 @@ void DroppedItem::applyEffect() {
         pickupText = config.pickupText;
     } else if (m_type == DroppedItemType::TICKET) {
         // 车票：通关奖励，不显示普通提示，而是触发通关动画
-        qDebug() << "DroppedItem: 车票applyEffect开始执行";
+        qCDebug(lcCollision) << "DroppedItem: 车票applyEffect开始执行";
         ConfigManager::instance().setGameCompleted(true);
-        qDebug() << "DroppedItem: 即将发送ticketPickedUp信号";
+        qCDebug(lcCollision) << "DroppedItem: 即将发送ticketPickedUp信号";
         emit ticketPickedUp();
-        qDebug() << "DroppedItem: ticketPickedUp信号已发送";
+        qCDebug(lcCollision) << "DroppedItem: ticketPickedUp信号已发送";
         return;  // 车票不显示普通提示，由通关动画处理
     } else {
         // 未知类型
@@ -342,7 +337,7 @@ void DroppedItem::applyEffect() {
     // 显示拾取提示
     showPickupText(pickupText, textColor);
 
-    qDebug() << "DroppedItem: 玩家拾取了" << config.name;
+    qCDebug(lcCollision) << "DroppedItem: 玩家拾取了" << config.name;
 }
 
 QString DroppedItem::getItemConfigKey() const {
@@ -376,63 +371,7 @@ void DroppedItem::showPickupText(const QString& text, const QColor& color) {
     if (!scene() || !m_player)
         return;
 
-    QGraphicsTextItem* textItem = new QGraphicsTextItem(text);
-    textItem->setDefaultTextColor(color);
-    textItem->setFont(QFont("Microsoft YaHei", 12, QFont::Bold));
-    textItem->setZValue(1000);
-
-    // 显示在玩家上方
-    QPointF textPos = m_player->pos() + QPointF(
-                                            m_player->pixmap().width() / 2 - textItem->boundingRect().width() / 2,
-                                            -30);
-    textItem->setPos(textPos);
-
-    scene()->addItem(textItem);
-
-    // 上浮并淡出动画
-    QPointer<QGraphicsTextItem> textPtr(textItem);
-    QPointer<QGraphicsScene> scenePtr(scene());
-
-    // 使用QTimer实现简单的上浮动画
-    QTimer* moveTimer = new QTimer;
-    QTimer* fadeTimer = new QTimer;
-
-    auto stepPtr = std::make_shared<int>(0);
-
-    QObject::connect(moveTimer, &QTimer::timeout, [textPtr, moveTimer, stepPtr]() {
-        if (!textPtr) {
-            moveTimer->stop();
-            moveTimer->deleteLater();
-            return;
-        }
-        textPtr->setPos(textPtr->pos() + QPointF(0, -1.5));
-        (*stepPtr)++;
-        if (*stepPtr >= 30) {
-            moveTimer->stop();
-            moveTimer->deleteLater();
-        }
-    });
-
-    QObject::connect(fadeTimer, &QTimer::timeout, [textPtr, scenePtr, fadeTimer]() {
-        if (!textPtr) {
-            fadeTimer->stop();
-            fadeTimer->deleteLater();
-            return;
-        }
-
-        qreal opacity = textPtr->opacity() - 0.04;
-        if (opacity <= 0) {
-            if (scenePtr && textPtr->scene() == scenePtr) {
-                scenePtr->removeItem(textPtr.data());
-            }
-            delete textPtr.data();
-            fadeTimer->stop();
-            fadeTimer->deleteLater();
-        } else {
-            textPtr->setOpacity(opacity);
-        }
-    });
-
-    moveTimer->start(30);
-    fadeTimer->start(50);
+    // 显示在玩家上方，水平居中
+    QPointF textPos = m_player->pos() + QPointF(m_player->pixmap().width() / 2.0, -30);
+    FloatingTextLayer::showFloatText(scene(), text, textPos, color, FloatingTextLayer::PickupText, true);
 }
@@ -6,6 +6,8 @@
 #include <QPointer>
 #include <QPropertyAnimation>
 #include <QTimer>
+#include "../core/gametimer.h"
+#include "../world/entityregistry.h"
 
 class Player;
 class QGraphicsScene;
@@ -49,6 +51,8 @@ class DroppedItem : public QObject, public QGraphicsPixmapItem {
 
     ~DroppedItem() override;
 
+    [[nodiscard]] int type() const override { return entityItemType(EntityKind::DroppedItem); }
+
     /**
      * @brief 获取道具类型
      */
@@ -66,9 +70,24 @@ class DroppedItem : public QObject, public QGraphicsPixmapItem {
     void setScatterTarget(const QPointF& targetPos);
 
     /**
-     * @brief 暂停道具（用于游戏暂停）
+     * @brief 静止位置（散落动画中返回动画终点，用于离开房间时保存快照）
+     */
+    [[nodiscard]] QPointF restingPos() const { return m_hasScatterTarget ? m_scatterTarget : pos(); }
+
+    /**
+     * @brief 是否正在播放拾取动画
+     */
+    [[nodiscard]] bool isPickingUp() const { return m_isPickingUp; }
+
+    /**
+     * @brief 移出场景（离开房间时保留原对象）前注销拾取触发区域，避免在场景外被拾取
+     */
+    void suspendPickup();
+
+    /**
+     * @brief 重新加入场景后恢复拾取触发区域（拾取延迟尚未结束时由 enablePickup() 注册）
      */
-    void setPaused(bool paused);
+    void resumePickup();
 
    signals:
     /**
@@ -77,11 +96,6 @@ class DroppedItem : public QObject, public QGraphicsPixmapItem {
     void ticketPickedUp();
 
    private slots:
-    /**
-     * @brief 检测与玩家的碰撞
-     */
-    void checkPlayerCollision();
-
     /**
      * @brief 延迟结束后允许拾取
      */
@@ -93,6 +107,16 @@ class DroppedItem : public QObject, public QGraphicsPixmapItem {
     void onPickupAnimationFinished();
 
    private:
+    /**
+     * @brief 玩家进入拾取范围（由触发区域回调）
+     */
+    void onPlayerEntered();
+
+    /**
+     * @brief 以静止位置为中心注册拾取触发区域
+     */
+    void registerPickupZone();
+
     /**
      * @brief 加载道具图片
      */
@@ -125,15 +149,13 @@ class DroppedItem : public QObject, public QGraphicsPixmapItem {
      */
     void startScatterAnimation();
 
-    DroppedItemType m_type;      // 道具类型
-    QPointer<Player> m_player;   // 玩家引用
-    QTimer* m_collisionTimer;    // 碰撞检测定时器
-    QTimer* m_pickupDelayTimer;  // 拾取延迟定时器
-    bool m_canPickup;            // 是否可以拾取
-    bool m_isPickingUp;          // 是否正在拾取中
-    bool m_isPaused;             // 是否暂停
-    QPointF m_scatterTarget;     // 散落目标位置
-    bool m_hasScatterTarget;     // 是否有散落目标
+    DroppedItemType m_type;         // 道具类型
+    QPointer<Player> m_player;      // 玩家引用
+    GameTimer* m_pickupDelayTimer;  // 拾取延迟定时器
+    bool m_canPickup;               // 是否可以拾取
+    bool m_isPickingUp;             // 是否正在拾取中
+    QPointF m_scatterTarget;        // 散落目标位置
+    bool m_hasScatterTarget;        // 是否有散落目标
 
     // 道具图片路径映射
     static QString getItemImagePath(DroppedItemType type);
@@ -3,6 +3,7 @@
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include "../core/logging.h"
 
 ItemEffectConfig& ItemEffectConfig::instance() {
     static ItemEffectConfig instance;
@@ -57,11 +58,11 @@ bool ItemEffectConfig::loadConfig(const QString& filePath) {
         effectData.color = QColor(colorStr);
 
         m_itemEffects[key] = effectData;
-        qDebug() << "ItemEffectConfig: 加载道具配置:" << key << "-" << effectData.name;
+        qCDebug(lcAssets) << "ItemEffectConfig: 加载道具配置:" << key << "-" << effectData.name;
     }
 
     m_loaded = true;
-    qDebug() << "ItemEffectConfig: 成功加载" << m_itemEffects.size() << "个道具配置";
+    qCDebug(lcAssets) << "ItemEffectConfig: 成功加载" << m_itemEffects.size() << "个道具配置";
     return true;
 }
 
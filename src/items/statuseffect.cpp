@@ -1,106 +1,306 @@
 #include "statuseffect.h"
-#include <memory>
+#include <QtMath>
+#include "../core/gameclock.h"
+#include "../ui/floatingtextlayer.h"
 
-StatusEffect::StatusEffect(double dur, QObject* parent)
-    : QObject{parent}, duration(dur), target(nullptr) {
-    effTimer = new QTimer(this);
-    effTimer->setSingleShot(true);
-    connect(effTimer, &QTimer::timeout, this, &StatusEffect::expire);
+EffectManager& EffectManager::instance() {
+    static EffectManager instance;
+    return instance;
 }
 
-void StatusEffect::applyTo(Entity* tgt) {
-    if (!tgt)
-        return;
-    target = tgt;
-    onApplyEffect(target);
-    effTimer->start(static_cast<int>(duration * 1000));
+bool EffectManager::apply(Entity* target, StatusEffectType type, double magnitude, double durationSec, int maxStacks,
+                          bool showText) {
+    if (!target)
+        return false;
+
+    // 倍率类效果的数值必须为正，否则无法在移除时按比值还原
+    if (type != StatusEffectType::Poison && type != StatusEffectType::Invincible &&
+        type != StatusEffectType::DamageReduction && magnitude <= 0) {
+        qWarning() << "EffectManager: 无效的效果倍率" << magnitude;
+        return false;
+    }
+
+    const qint64 expiryMs = m_nowMs + static_cast<qint64>(durationSec * 1000);
+    EffectTable& table = m_tables[target];
+
+    bool applied = true;
+    ActiveEffect* existing = nullptr;
+    for (ActiveEffect& effect : table.effects) {
+        if (effect.type == type && qFuzzyCompare(effect.magnitude, magnitude)) {
+            existing = &effect;
+            break;
+        }
+    }
+
+    if (existing) {
+        if (existing->stacks < maxStacks) {
+            existing->stacks++;
+        } else if (maxStacks > 1) {
+            applied = false;  // 已达叠加上限，只刷新持续时间
+        }
+        existing->expiryMs = qMax(existing->expiryMs, expiryMs);
+    } else {
+        table.effects.append({type, magnitude, expiryMs, 1, m_nowMs + kPoisonIntervalMs});
+    }
+
+    recompute(target, table);
+    ensureTicking();
+
+    if (applied && showText) {
+        showApplyText(target, type, magnitude);
+    }
+
+    // 中毒施加时立即扣一次血（与原中毒效果一致）
+    if (applied && type == StatusEffectType::Poison) {
+        poisonPulse(target, static_cast<int>(magnitude));
+    }
+    return applied;
 }
 
-void StatusEffect::expire() {
-    if (target) {
-        onRemoveEffect(target);
+int EffectManager::stackCount(Entity* target, StatusEffectType type) const {
+    auto it = m_tables.constFind(target);
+    if (it == m_tables.constEnd())
+        return 0;
+
+    int stacks = 0;
+    for (const ActiveEffect& effect : it->effects) {
+        if (effect.type == type) {
+            stacks += effect.stacks;
+        }
     }
-    effTimer->stop();
-    deleteLater();  // 自我销毁，防止内存泄漏
+    return stacks;
+}
+
+void EffectManager::forget(Entity* target) {
+    m_tables.remove(target);
 }
 
-PoisonEffect::PoisonEffect(Entity* target_, double duration, int damage_)
-    : StatusEffect(duration), damage(damage_), poisonTimer(nullptr) {
-    // 无论 target_ 是否为空，都创建定时器
-    // 定时器会在 onApplyEffect 中启动
-    poisonTimer = new QTimer(this);
-    connect(poisonTimer, &QTimer::timeout, this, &PoisonEffect::emitApplyEffect);
-    Q_UNUSED(target_);  // target_ 参数目前未使用，保留用于兼容性
+QVector<StatusEffectRecord> EffectManager::capture(Entity* target) const {
+    QVector<StatusEffectRecord> records;
+    auto it = m_tables.constFind(target);
+    if (it == m_tables.constEnd())
+        return records;
+
+    for (const ActiveEffect& effect : it->effects) {
+        records.append({effect.type, effect.magnitude, static_cast<int>(qMax<qint64>(0, effect.expiryMs - m_nowMs)),
+                        effect.stacks, static_cast<int>(qMax<qint64>(0, effect.nextPulseMs - m_nowMs))});
+    }
+    return records;
 }
 
-void StatusEffect::showFloatText(QGraphicsScene* scene, const QString& text, const QPointF& position, const QColor& color) {
-    if (!scene)
+void EffectManager::restore(Entity* target, const QVector<StatusEffectRecord>& records) {
+    if (!target)
         return;
 
-    QGraphicsTextItem* textItem = new QGraphicsTextItem(text);
-    textItem->setPos(position);
-    textItem->setDefaultTextColor(color);
-    textItem->setFont(QFont("Microsoft YaHei", 10, QFont::Black));
-    textItem->setZValue(1000);
+    m_tables.remove(target);
+    if (records.isEmpty())
+        return;
 
-    scene->addItem(textItem);
+    EffectTable& table = m_tables[target];
+    for (const StatusEffectRecord& record : records) {
+        table.effects.append({record.type, record.magnitude, m_nowMs + record.remainingMs, record.stacks,
+                              m_nowMs + record.pulseInMs});
+    }
 
-    // 使用 QPointer 追踪 textItem 和 scene，防止清理后访问悬空指针
-    QPointer<QGraphicsTextItem> textPtr(textItem);
-    QPointer<QGraphicsScene> scenePtr(scene);
+    // 实体属性已经包含这些倍率，只记录下来，移除效果时按比值还原
+    const DerivedStats derived = derive(table.effects);
+    table.speedFactor = derived.speed;
+    table.bulletSpeedFactor = derived.bulletSpeed;
+    table.shootSpeedFactor = derived.shootSpeed;
+    table.hurtFactor = derived.hurt;
+    table.damageReduced = derived.damageReduced;
+    table.invincible = derived.invincible;
 
-    // 使用shared_ptr存储所有需要的状态
-    auto stepPtr = std::make_shared<int>(0);
-    auto textDeleted = std::make_shared<bool>(false);
+    ensureTicking();
+}
 
-    // 创建定时器
-    QTimer* moveTimer = new QTimer;
-    QTimer* fadeTimer = new QTimer;
+void EffectManager::ensureTicking() {
+    if (!m_tickConnection) {
+        m_tickConnection = QObject::connect(&GameClock::instance(), &GameClock::tick, &GameClock::instance(),
+                                            [](int dtMs) { EffectManager::instance().advance(dtMs); });
+    }
+}
 
-    // 上升动画
-    connect(moveTimer, &QTimer::timeout, [textPtr, moveTimer, stepPtr, textDeleted]() {
-        if (*textDeleted || !textPtr) {
-            moveTimer->stop();
-            moveTimer->deleteLater();
-            return;
+void EffectManager::advance(int dtMs) {
+    m_nowMs += dtMs;
+
+    // 先收集中毒扣血，遍历结束后再结算（扣血可能导致实体死亡并移除效果表）
+    QVector<QPair<QPointer<Entity>, int>> pulses;
+
+    for (auto it = m_tables.begin(); it != m_tables.end();) {
+        EffectTable& table = it.value();
+        bool changed = false;
+
+        for (int i = table.effects.size() - 1; i >= 0; --i) {
+            ActiveEffect& effect = table.effects[i];
+            if (effect.type == StatusEffectType::Poison) {
+                while (effect.nextPulseMs <= m_nowMs && effect.nextPulseMs < effect.expiryMs) {
+                    pulses.append({QPointer<Entity>(it.key()), static_cast<int>(effect.magnitude)});
+                    effect.nextPulseMs += kPoisonIntervalMs;
+                }
+            }
+            if (effect.expiryMs <= m_nowMs) {
+                table.effects.removeAt(i);
+                changed = true;
+            }
         }
-        textPtr->setPos(textPtr->pos() + QPointF(0, -2));
-        (*stepPtr)++;
-        if (*stepPtr >= 25) {
-            moveTimer->stop();
-            moveTimer->deleteLater();
+
+        if (changed) {
+            recompute(it.key(), table);
         }
-    });
 
-    // 淡出动画
-    connect(fadeTimer, &QTimer::timeout, [textPtr, scenePtr, fadeTimer, textDeleted]() {
-        if (*textDeleted) {
-            fadeTimer->stop();
-            fadeTimer->deleteLater();
-            return;
+        if (table.effects.isEmpty()) {
+            it = m_tables.erase(it);
+        } else {
+            ++it;
         }
+    }
 
-        if (!textPtr) {
-            *textDeleted = true;
-            fadeTimer->stop();
-            fadeTimer->deleteLater();
-            return;
+    for (const auto& pulse : pulses) {
+        if (pulse.first) {
+            poisonPulse(pulse.first, pulse.second);
         }
+    }
 
-        qreal opacity = textPtr->opacity() - 0.05;
-        if (opacity <= 0) {
-            *textDeleted = true;
-            if (scenePtr && textPtr->scene() == scenePtr) {
-                scenePtr->removeItem(textPtr.data());
-            }
-            delete textPtr.data();
-            fadeTimer->stop();
-            fadeTimer->deleteLater();
-        } else {
-            textPtr->setOpacity(opacity);
+    if (m_tables.isEmpty()) {
+        QObject::disconnect(m_tickConnection);
+        m_tickConnection = QMetaObject::Connection();
+    }
+}
+
+EffectManager::DerivedStats EffectManager::derive(const QVector<ActiveEffect>& effects) {
+    DerivedStats derived;
+    for (const ActiveEffect& effect : effects) {
+        double factor = qPow(effect.magnitude, effect.stacks);
+        switch (effect.type) {
+            case StatusEffectType::Speed:
+            case StatusEffectType::Encourage:
+            case StatusEffectType::Slow:
+                derived.speed *= factor;
+                break;
+            case StatusEffectType::BulletSpeed:
+                derived.bulletSpeed *= factor;
+                break;
+            case StatusEffectType::ShootSpeed:
+                derived.shootSpeed *= factor;
+                break;
+            case StatusEffectType::Damage:
+                derived.hurt *= factor;
+                break;
+            case StatusEffectType::DamageReduction:
+                derived.damageScale =
+                    derived.damageReduced ? qMin(derived.damageScale, effect.magnitude) : effect.magnitude;
+                derived.damageReduced = true;
+                break;
+            case StatusEffectType::Invincible:
+                derived.invincible = true;
+                break;
+            case StatusEffectType::Poison:
+                break;
         }
-    });
+    }
+    return derived;
+}
 
-    moveTimer->start(150);
-    fadeTimer->start(100);
+void EffectManager::recompute(Entity* target, EffectTable& table) {
+    const DerivedStats derived = derive(table.effects);
+    const double speed = derived.speed;
+    const double bulletSpeed = derived.bulletSpeed;
+    const double shootSpeed = derived.shootSpeed;
+    const double hurt = derived.hurt;
+    const bool damageReduced = derived.damageReduced;
+    const double damageScale = derived.damageScale;
+    const bool invincible = derived.invincible;
+
+    // 只在派生倍率变化时修改实体属性
+    if (!qFuzzyCompare(speed, table.speedFactor)) {
+        target->setSpeed(target->getSpeed() * speed / table.speedFactor);
+        table.speedFactor = speed;
+    }
+    if (!qFuzzyCompare(bulletSpeed, table.bulletSpeedFactor)) {
+        target->setshootSpeed(target->getshootSpeed() * bulletSpeed / table.bulletSpeedFactor);
+        table.bulletSpeedFactor = bulletSpeed;
+    }
+    if (!qFuzzyCompare(shootSpeed, table.shootSpeedFactor)) {
+        if (auto p = dynamic_cast<Player*>(target)) {
+            p->setShootCooldown(qRound(p->getShootCooldown() * table.shootSpeedFactor / shootSpeed));
+        }
+        table.shootSpeedFactor = shootSpeed;
+    }
+    if (!qFuzzyCompare(hurt, table.hurtFactor)) {
+        target->setHurt(target->getHurt() * hurt / table.hurtFactor);
+        table.hurtFactor = hurt;
+    }
+    if (damageReduced) {
+        target->damageScale = damageScale;
+    } else if (table.damageReduced) {
+        target->damageScale = 1.0;
+    }
+    table.damageReduced = damageReduced;
+    if (invincible != table.invincible) {
+        target->setInvincible(invincible);
+        table.invincible = invincible;
+    }
+}
+
+void EffectManager::poisonPulse(Entity* target, int damage) {
+    // 对玩家使用 forceTakeDamage（无视无敌，不触发新无敌）
+    // 但如果玩家处于持久无敌状态（如被吸纳），跳过伤害
+    if (Player* player = dynamic_cast<Player*>(target)) {
+        if (player->isInvincible()) {
+            return;
+        }
+        player->forceTakeDamage(damage);
+    } else {
+        target->takeDamage(damage);
+    }
+    FloatingTextLayer::showFloatText(target->scene(), QString("中毒"), target->pos(), Qt::darkGreen);
+}
+
+void EffectManager::showApplyText(Entity* target, StatusEffectType type, double magnitude) {
+    QGraphicsScene* scene = target->scene();
+    const QPointF pos = target->pos();
+
+    switch (type) {
+        case StatusEffectType::Speed:
+        case StatusEffectType::Slow:
+            if (magnitude > 1)
+                FloatingTextLayer::showFloatText(scene, QString("⚡短暂速度提升↑"), pos, Qt::blue);
+            else if (magnitude < 1)
+                FloatingTextLayer::showFloatText(scene, QString("⚡短暂速度下降↓"), pos, Qt::blue);
+            break;
+        case StatusEffectType::Encourage:
+            // 鼓舞专用文字，位置稍微偏上
+            FloatingTextLayer::showFloatText(scene, QString("🔥鼓舞!"), pos + QPointF(0, -20), QColor(255, 100, 0));
+            break;
+        case StatusEffectType::BulletSpeed:
+            if (magnitude > 1)
+                FloatingTextLayer::showFloatText(scene, QString("短暂子弹速度提升↑"), pos);
+            else if (magnitude < 1)
+                FloatingTextLayer::showFloatText(scene, QString("短暂子弹速度下降↓"), pos);
+            break;
+        case StatusEffectType::ShootSpeed:
+            if (!dynamic_cast<Player*>(target))
+                break;
+            if (magnitude > 1)
+                FloatingTextLayer::showFloatText(scene, QString("🔫短暂射速提升↑"), pos);
+            else if (magnitude < 1)
+                FloatingTextLayer::showFloatText(scene, QString("🔫短暂射速下降↓"), pos);
+            break;
+        case StatusEffectType::Damage:
+            if (magnitude > 1)
+                FloatingTextLayer::showFloatText(scene, QString("⚔️短暂伤害提升↑"), pos, Qt::red);
+            else if (magnitude < 1)
+                FloatingTextLayer::showFloatText(scene, QString("⚔️短暂伤害下降↓"), pos, Qt::red);
+            break;
+        case StatusEffectType::DamageReduction:
+            FloatingTextLayer::showFloatText(scene, QString("🛡️短暂伤害减免"), pos, Qt::green);
+            break;
+        case StatusEffectType::Invincible:
+            FloatingTextLayer::showFloatText(scene, QString("🛡️短暂无敌"), pos, Qt::darkYellow);
+            break;
+        case StatusEffectType::Poison:
+            // 中毒文字随每次扣血显示
+            break;
+    }
 }
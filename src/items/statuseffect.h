@@ -2,276 +2,147 @@
 #define STATUSEFFECT_H
 
 #include <QDebug>
-#include <QObject>
+#include <QHash>
 #include <QPainter>
 #include <QPointer>
-#include "Entity.h"
+#include <QVector>
+#include "entity.h"
 #include "player.h"
 
-class StatusEffect : public QObject {
-    Q_OBJECT
-    double duration;  // 状态效果持续时间，以秒计
-    QTimer* effTimer;
-
-   protected:
-    QPointer<Entity> target;  // 使用 QPointer 自动处理对象销毁
-
-   public:
-    explicit StatusEffect(double dur, QObject* parent = nullptr);
-
-    void applyTo(Entity* tgt);  // 应用效果到实体
-    // virtual void update(float deltaTime);//更新效果
-    void expire();  // 过期或移除
-    virtual void onApplyEffect(Entity* target) {};
-
-    virtual void onRemoveEffect(Entity* target) {};
-
-    static void
-    showFloatText(QGraphicsScene* scene, const QString& text, const QPointF& position, const QColor& color = Qt::black);
-
-   signals:
-};
-
-// 速度
-class SpeedEffect : public StatusEffect {
-   protected:
-    double multiplier;  // 速度倍数，<1减速，>1加速
-    bool showText;      // 是否显示文字提示
-   public:
-    SpeedEffect(double duration, double mul, bool showTextHint = true)
-        : StatusEffect(duration), multiplier(mul), showText(showTextHint) {}
-
-    void onApplyEffect(Entity* target) override {
-        if (!target)
-            return;
-        target->setSpeed(target->getSpeed() * multiplier);
-        if (showText) {
-            if (multiplier > 1) {
-                showFloatText(target->scene(), QString("⚡短暂速度提升↑"), target->pos(), Qt::blue);
-            } else if (multiplier < 1)
-                showFloatText(target->scene(), QString("⚡短暂速度下降↓"), target->pos(), Qt::blue);
-        }
-    }
-
-    void onRemoveEffect(Entity* target) override {
-        if (!target)
-            return;
-        target->setSpeed(target->getSpeed() / multiplier);
-    }
-};
-
-// 鼓舞效果（Walker毒痕专用）- 增加移速但使用不同的文字提示
-class EncourageEffect : public SpeedEffect {
-   public:
-    EncourageEffect(double duration, double mul)
-        : SpeedEffect(duration, mul, false) {}  // 不显示默认的速度提升文字
-    void onApplyEffect(Entity* target) override {
-        if (!target)
-            return;
-        target->setSpeed(target->getSpeed() * multiplier);
-        // 显示鼓舞专用文字，位置稍微偏上
-        showFloatText(target->scene(), QString("🔥鼓舞!"), target->pos() + QPointF(0, -20), QColor(255, 100, 0));
-    }
+/**
+ * @brief 状态效果类型
+ */
+enum class StatusEffectType {
+    Speed,            // 移动速度倍率（<1减速，>1加速）
+    Encourage,        // 鼓舞（Walker毒痕专用）：移动速度倍率，使用专用文字提示
+    Slow,             // 可叠加的减速（寒冰子弹、毒气），每层乘一次倍率
+    BulletSpeed,      // 子弹速度倍率
+    ShootSpeed,       // 射速倍率（射击冷却 ÷ 倍率，仅对玩家生效）
+    Damage,           // 伤害倍率
+    DamageReduction,  // 伤害减免（受伤系数直接设为 magnitude）
+    Invincible,       // 无敌
+    Poison            // 中毒：每秒扣 magnitude 点血
 };
 
-// 子弹速度
-class bulletSpeedEffect : public StatusEffect {
-    double multiplier;
-
-   public:
-    bulletSpeedEffect(double duration, double mul)
-        : StatusEffect(duration), multiplier(mul) {}
-
-    void onApplyEffect(Entity* target) override {
-        if (!target)
-            return;
-        target->setshootSpeed(target->getshootSpeed() * multiplier);
-        if (multiplier > 1)
-            showFloatText(target->scene(), QString("短暂子弹速度提升↑"), target->pos());
-        else if (multiplier < 1)
-            showFloatText(target->scene(), QString("短暂子弹速度下降↓"), target->pos());
-    }
-
-    void onRemoveEffect(Entity* target) override {
-        if (!target)
-            return;
-        target->setshootSpeed(target->getshootSpeed() / multiplier);
-    }
+/**
+ * @brief 一行效果的值快照（时间相对快照时刻），用于房间重试
+ */
+struct StatusEffectRecord {
+    StatusEffectType type;
+    double magnitude;
+    int remainingMs;
+    int stacks;
+    int pulseInMs;  // 中毒距下一次扣血的时间
 };
 
-// 射速（冷却时间降低）
-class shootSpeedEffect : public StatusEffect {
-    double multiplier;
-    int temp;
-
+/**
+ * @brief 状态效果管理器 - 用每个实体一张紧凑的效果表代替一个效果一个 QObject
+ *
+ * 效果表的每一行是 (类型, 数值, 到期时刻, 层数)。同类型同数值的效果合并为一行：
+ * 可叠加效果在上限内加层，其余效果刷新到期时刻。
+ * 每次效果表变化时只重新计算一次派生属性，并按与上次的比值修正实体属性，
+ * 因此与其他代码对速度/伤害的直接修改（道具拾取、惊吓等）互不覆盖。
+ * 到期与中毒扣血都在 GameClock 的 tick 中推进，施加和移除效果不需要定时器或信号连接。
+ */
+class EffectManager {
    public:
-    shootSpeedEffect(double duration, double mul)
-        : StatusEffect(duration), multiplier(mul) {}
-
-    void onApplyEffect(Entity* target) override {
-        if (!target)
-            return;
-        if (auto p = dynamic_cast<Player*>(target)) {
-            temp = p->getShootCooldown();
-            p->setShootCooldown((int)(temp / multiplier));
-            if (multiplier > 1)
-                showFloatText(target->scene(), QString("🔫短暂射速提升↑"), target->pos());
-            else if (multiplier < 1)
-                showFloatText(target->scene(), QString("🔫短暂射速下降↓"), target->pos());
-        }
-    }
-
-    void onRemoveEffect(Entity* target) override {
-        if (!target)
-            return;
-        if (auto p = dynamic_cast<Player*>(target))
-            p->setShootCooldown(temp);
-    }
-};
-
-// 伤害提升/降低
-class DamageEffect : public StatusEffect {
-    double multiplier;  // 伤害倍数
-   public:
-    DamageEffect(double duration, double mul)
-        : StatusEffect(duration), multiplier(mul) {};
-
-    void onApplyEffect(Entity* target) override {
-        if (!target)
-            return;
-        target->setHurt(target->getHurt() * multiplier);
-        if (multiplier > 1)
-            showFloatText(target->scene(), QString("⚔️短暂伤害提升↑"), target->pos(), Qt::red);
-        else if (multiplier < 1)
-            showFloatText(target->scene(), QString("⚔️短暂伤害下降↓"), target->pos(), Qt::red);
-    }
-
-    void onRemoveEffect(Entity* target) override {
-        if (!target)
-            return;
-        target->setHurt(target->getHurt() / multiplier);
-    }
-};
-
-// 提升护盾
-class shieldEffect : public StatusEffect {
-    int shields;
-
-   public:
-    shieldEffect(Player* pl, int n) : StatusEffect(1), shields(n) {
-                                          // 构造函数不再直接应用效果，而是通过 onApplyEffect
-                                      };
-
-    void onApplyEffect(Entity* target) override {
-        if (auto pl = dynamic_cast<Player*>(target)) {
-            pl->addShield(shields);
-            StatusEffect::showFloatText(pl->scene(), QString("🛡️ ++护盾"), pl->pos(), Qt::green);
-        }
-    }
-};
-
-class blackHeartEffect : public StatusEffect {
-    int hearts;
-
-   public:
-    blackHeartEffect(Player* pl, int n) : StatusEffect(1), hearts(n) {
-                                              // 构造函数不再直接应用效果
-                                          };
-
-    void onApplyEffect(Entity* target) override {
-        if (auto pl = dynamic_cast<Player*>(target)) {
-            pl->addBlackHearts(hearts);
-            StatusEffect::showFloatText(pl->scene(), QString("♥ ++黑心"), pl->pos(), Qt::darkGray);
-        }
-    }
-};
-
-// 伤害减免
-class decDamage : public StatusEffect {
-    double scale;
-
-   public:
-    decDamage(double duration, double s)
-        : StatusEffect(duration), scale(s) {};
-
-    void onApplyEffect(Entity* target) override {
-        if (!target)
-            return;
-        target->damageScale = scale;
-        showFloatText(target->scene(), QString("🛡️短暂伤害减免"), target->pos(), Qt::green);
-    }
-
-    void onRemoveEffect(Entity* target) override {
-        if (!target)
-            return;
-        target->damageScale = 1.0;
-    }
-};
-
-// 中毒(一段时间内持续减血)
-class PoisonEffect : public StatusEffect {
-    int damage;
-    QTimer* poisonTimer;
-    // Entity* target; // 使用基类的 QPointer<Entity> target
+    static EffectManager& instance();
+
+    static constexpr int kPoisonIntervalMs = 1000;  // 中毒扣血间隔
+
+    /**
+     * @brief 对实体施加状态效果
+     * @param magnitude 倍率/数值（中毒为每次扣血量）
+     * @param durationSec 持续时间（秒）
+     * @param maxStacks 最大叠加层数，1 表示不可叠加（重复施加时刷新持续时间）
+     * @param showText 是否显示文字提示
+     * @return 可叠加效果已达上限时返回 false（只刷新持续时间），否则返回 true
+     */
+    bool apply(Entity* target, StatusEffectType type, double magnitude, double durationSec, int maxStacks = 1,
+               bool showText = true);
+
+    /**
+     * @brief 查询实体某类效果的总层数
+     */
+    [[nodiscard]] int stackCount(Entity* target, StatusEffectType type) const;
+
+    [[nodiscard]] bool hasEffect(Entity* target, StatusEffectType type) const {
+        return stackCount(target, type) > 0;
+    }
+
+    /**
+     * @brief 丢弃实体的效果表（实体析构时调用，不再修改实体属性）
+     */
+    void forget(Entity* target);
+
+    /**
+     * @brief 导出实体当前的效果表
+     */
+    [[nodiscard]] QVector<StatusEffectRecord> capture(Entity* target) const;
+
+    /**
+     * @brief 用快照替换实体的效果表
+     *
+     * 调用方需先把实体属性恢复为快照时的值（已包含这些效果的倍率），
+     * 这里只重建效果表和派生倍率，不再修改实体属性。
+     */
+    void restore(Entity* target, const QVector<StatusEffectRecord>& records);
+
+   private:
+    EffectManager() = default;
+
+    EffectManager(const EffectManager&) = delete;
+
+    EffectManager& operator=(const EffectManager&) = delete;
+
+    struct ActiveEffect {
+        StatusEffectType type;
+        double magnitude;
+        qint64 expiryMs;     // 到期时刻（管理器时钟）
+        int stacks;
+        qint64 nextPulseMs;  // 中毒的下一次扣血时刻
+    };
 
-   public:
-    PoisonEffect(Entity* target_, double duration, int damage_);
+    struct EffectTable {
+        QVector<ActiveEffect> effects;
+        // 已作用到实体上的派生倍率/状态，变化时按比值修正
+        double speedFactor = 1.0;
+        double bulletSpeedFactor = 1.0;
+        double shootSpeedFactor = 1.0;
+        double hurtFactor = 1.0;
+        bool damageReduced = false;
+        bool invincible = false;
+    };
 
-    void emitApplyEffect() {
-        if (target)
-            this->onApplyEffect(target);
+    // 效果表推导出的倍率/状态
+    struct DerivedStats {
+        double speed = 1.0;
+        double bulletSpeed = 1.0;
+        double shootSpeed = 1.0;
+        double hurt = 1.0;
+        bool damageReduced = false;
+        double damageScale = 1.0;
+        bool invincible = false;
     };
 
-    void onApplyEffect(Entity* target) override {
-        if (!target)
-            return;
+    // 推进到期与中毒扣血（连接到 GameClock::tick）
+    void advance(int dtMs);
 
-        // 对玩家使用 forceTakeDamage（无视无敌，不触发新无敌）
-        // 但如果玩家处于持久无敌状态（如被吸纳），跳过伤害
-        if (Player* player = dynamic_cast<Player*>(target)) {
-            if (player->isInvincible()) {
-                // 玩家无敌时不造成伤害，但不停止中毒计时器
-                return;
-            }
-            player->forceTakeDamage(damage);
-        } else {
-            target->takeDamage(damage);
-        }
-        showFloatText(target->scene(), QString("中毒"), target->pos(), Qt::darkGreen);
+    // 有效果时才订阅 GameClock::tick
+    void ensureTicking();
 
-        // 如果是第一次应用，启动中毒定时器
-        if (poisonTimer && !poisonTimer->isActive()) {
-            qDebug() << "启动中毒定时器";
-            poisonTimer->start(1000);
-        }
-    }
+    static DerivedStats derive(const QVector<ActiveEffect>& effects);
 
-    void onRemoveEffect(Entity* target) override {
-        if (!target)
-            return;
-        if (!poisonTimer)
-            return;
-        poisonTimer->stop();
-    }
-};
+    // 根据效果表重新计算派生属性并写回实体
+    static void recompute(Entity* target, EffectTable& table);
 
-// 无敌
-class InvincibleEffect : public StatusEffect {
-   public:
-    InvincibleEffect(double duration) : StatusEffect(duration) {};
+    static void poisonPulse(Entity* target, int damage);
 
-    void onApplyEffect(Entity* target) override {
-        if (!target)
-            return;
-        target->setInvincible(true);
-        showFloatText(target->scene(), QString("🛡️短暂无敌"), target->pos(), Qt::darkYellow);
-    }
+    static void showApplyText(Entity* target, StatusEffectType type, double magnitude);
 
-    void onRemoveEffect(Entity* target) override {
-        if (!target)
-            return;
-        target->setInvincible(false);
-    }
+    QHash<Entity*, EffectTable> m_tables;
+    qint64 m_nowMs = 0;
+    QMetaObject::Connection m_tickConnection;
 };
 
 #endif  // STATUSEFFECT_H
@@ -1,14 +1,50 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDebug>
+#include <QJsonObject>
 #include "core/configmanager.h"
 #include "core/configvalidator.h"
+#include "core/gameclock.h"
 #include "core/gamewindow.h"
 #include "core/logging.h"
+#include "core/objectcensus.h"
 #include "items/itemeffectconfig.h"
+#include "world/stressbenchmark.h"
 
 int main(int argc, char* argv[]) {
 
+    // 无窗口压力测试使用 offscreen 平台（必须在创建 QApplication 之前设置）
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--benchmark-headless") == 0 && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+    }
+
     QApplication a(argc, argv);
+
+    // 命令行：--fast-forward 2|4|8|max 以快进模式启动（浸泡测试用）
+    //         --benchmark <子弹数> 运行弹幕压力测试后退出
+    //         --census-assert 每次清空房间后对象数未回到基线时终止（浸泡测试用）
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption fastForwardOption("fast-forward", "以快进模式运行游戏逻辑（2、4、8 或 max）", "factor");
+    QCommandLineOption benchmarkOption("benchmark", "运行弹幕压力测试（子弹总数，标准规模 500、2000、10000）", "bullets");
+    QCommandLineOption benchmarkSecondsOption("benchmark-seconds", "压力测试运行时间（秒，默认 10）", "seconds", "10");
+    QCommandLineOption benchmarkHeadlessOption("benchmark-headless", "压力测试不显示窗口（offscreen 渲染）");
+    QCommandLineOption benchmarkMixOption("benchmark-mix", "单独指定各类数量，如 enemy=1400,player=400,gas=100,beam=100,enemies=48", "mix");
+    QCommandLineOption benchmarkOutputOption("benchmark-output", "压力测试结果 JSON 的输出路径", "file");
+    QCommandLineOption censusOption("census", "统计存活 QObject、定时器和定时器唤醒次数（开发模式和快进时默认启用，压力测试需显式指定）");
+    QCommandLineOption censusAssertOption("census-assert", "房间清空后对象数未回到基线时终止程序");
+    parser.addOption(fastForwardOption);
+    parser.addOption(benchmarkOption);
+    parser.addOption(benchmarkSecondsOption);
+    parser.addOption(benchmarkHeadlessOption);
+    parser.addOption(benchmarkMixOption);
+    parser.addOption(benchmarkOutputOption);
+    parser.addOption(censusOption);
+    parser.addOption(censusAssertOption);
+    parser.process(a);
+
     // 加载配置文件
     if (!ConfigManager::instance().loadConfig("assets/config.json")) {
         qCritical() << "无法加载配置文件，程序退出";
@@ -19,6 +55,12 @@ int main(int argc, char* argv[]) {
     bool enableQDebug = ConfigManager::instance().getLoggingDebug(false);
     Logging::initializeLogging(enableQDebug);
 
+    // logging.categories 单独打开或关闭某些分类的 debug 输出，如 {"boss": true, "ai": false}
+    const QJsonObject logCategories = ConfigManager::instance().getLoggingCategories();
+    for (auto it = logCategories.begin(); it != logCategories.end(); ++it) {
+        Logging::setCategoryDebugEnabled(it.key(), it.value().toBool());
+    }
+
     // 加载道具效果配置
     if (!ItemEffectConfig::instance().loadConfig("assets/item_effects.json")) {
         qWarning() << "无法加载道具效果配置文件，将使用默认值";
@@ -33,6 +75,52 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    // 对象普查：开发模式和浸泡测试（快进）默认启用，正常游戏不安装钩子；
+    // 压力测试只在显式 --census 时启用（钩子和事件过滤器会计入帧时间和分配次数）
+    const bool censusByDefault = !parser.isSet(benchmarkOption) &&
+                                 (parser.isSet(fastForwardOption) || ConfigManager::instance().isDevModeEnabled());
+    if (parser.isSet(censusOption) || parser.isSet(censusAssertOption) || censusByDefault) {
+        ObjectCensus::instance().enable();
+        ObjectCensus::instance().setAssertOnLeak(parser.isSet(censusAssertOption));
+    }
+
+    // 启动全局游戏时钟（闪烁等短时效果由它驱动）
+    GameClock::instance().start();
+
+    if (parser.isSet(fastForwardOption)) {
+        const QString value = parser.value(fastForwardOption);
+        bool ok = false;
+        int factor = value.toInt(&ok);
+        if (value == "max") {
+            GameClock::instance().setFastForward(GameClock::kFastForwardUnbounded);
+        } else if (ok && factor >= 1) {
+            GameClock::instance().setFastForward(factor);
+        } else {
+            qWarning() << "无效的 --fast-forward 参数:" << value;
+        }
+    }
+
+    if (parser.isSet(benchmarkOption)) {
+        bool ok = false;
+        int bullets = parser.value(benchmarkOption).toInt(&ok);
+        int seconds = parser.value(benchmarkSecondsOption).toInt();
+        if (!ok || bullets < 0 || seconds <= 0) {
+            qCritical() << "无效的压力测试参数:" << parser.value(benchmarkOption) << parser.value(benchmarkSecondsOption);
+            return 1;
+        }
+
+        StressBenchmarkConfig config = StressBenchmarkConfig::forBulletCount(bullets);
+        if (parser.isSet(benchmarkMixOption) && !config.applyMix(parser.value(benchmarkMixOption))) {
+            return 1;
+        }
+        config.seconds = seconds;
+        config.headless = parser.isSet(benchmarkHeadlessOption);
+        config.outputPath = parser.value(benchmarkOutputOption);
+
+        StressBenchmark benchmark(config);
+        return benchmark.run();
+    }
+
     GameWindow w;
     w.show();
     return QApplication::exec();
@@ -526,9 +526,9 @@ void Codex::loadBossData() {
     teacher.attackMethod = "授课阶段：正态分布弹幕、随机点名红圈\n期中考试：追踪考卷、极大似然估计陷阱、召唤监考员\n方差爆炸：环形弹幕、挂科警告、喜忧参半分裂弹";
     teacher.skills = QString(
             "【正态分布弹幕】发射%1发弹幕，角度服从N(μ,%2°)\n【随机点名】在玩家位置生成延时伤害红圈\n【极大似然估计】预判玩家移动方向放置陷阱\n【喜忧参半】发射在2/3距离处分裂成%3发的大型弹幕")
-            .arg(config.getBossInt("teacher", "phase1", "normal_barrage_count", 15))
-            .arg(static_cast<int>(config.getBossDouble("teacher", "phase1", "normal_barrage_stddev", 15.0)))
-            .arg(config.getBossInt("teacher", "phase3", "split_bullet_count", 5));
+            .arg(config.getBossPattern("teacher", "normal_barrage").value("count").toInt(15))
+            .arg(static_cast<int>(config.getBossPattern("teacher", "normal_barrage").value("spread").toDouble(15.0)))
+            .arg(config.getBossPattern("teacher", "split_bullet").value("child").toObject().value("count").toInt(5));
     teacher.traits = QString("三阶段Boss，调离阶段会飞出屏幕后以更强姿态返回（%1%血量和%2%血量触发），拥有全图视野")
             .arg(static_cast<int>(config.getBossDouble("teacher", "phase2", "health_threshold", 0.6) * 100))
             .arg(static_cast<int>(config.getBossDouble("teacher", "phase3", "health_threshold", 0.3) * 100));
@@ -4,6 +4,7 @@
 #include <QFont>
 #include <QLinearGradient>
 #include <QPainter>
+#include "../core/logging.h"
 #include "../core/resourcefactory.h"
 #include "../entities/level_3/teacherboss.h"
 
@@ -135,7 +136,7 @@ void DialogSystem::setupTeacherBossCowSprite(bool isBossDialog) {
         QString cowImageName = m_bossDefeated ? "cowFinal.png" : "cow.png";
         showStaticBossSprite(cowImageName, QPointF(250, 180));
         if (m_teacherBoss) {
-            qDebug() << "[DialogSystem] TeacherBoss阶段" << m_teacherBoss->getPhase() << "对话：cow直接出现";
+            qCDebug(lcRoom) << "[DialogSystem] TeacherBoss阶段" << m_teacherBoss->getPhase() << "对话：cow直接出现";
         }
     }
 }
@@ -225,7 +226,7 @@ void DialogSystem::nextDialog() {
 
     // 第一次显示对话时，检查是否有待执行的对话框背景渐变
     if (m_currentDialogIndex == 0 && !m_pendingFadeDialogBackground.isEmpty()) {
-        qDebug() << "[DialogSystem] 执行待处理的对话框背景渐变:" << m_pendingFadeDialogBackground;
+        qCDebug(lcRoom) << "[DialogSystem] 执行待处理的对话框背景渐变:" << m_pendingFadeDialogBackground;
         QTimer::singleShot(100, this, [this]() {
             fadeDialogBackgroundTo(m_pendingFadeDialogBackground, m_pendingFadeDialogDuration);
             m_pendingFadeDialogBackground.clear();
@@ -236,7 +237,7 @@ void DialogSystem::nextDialog() {
     // 检查是否需要在当前对话索引处切换背景
     if (m_pendingDialogBackgrounds.contains(m_currentDialogIndex)) {
         QString backgroundPath = m_pendingDialogBackgrounds.value(m_currentDialogIndex);
-        qDebug() << "[DialogSystem] 对话中切换背景到:" << backgroundPath;
+        qCDebug(lcRoom) << "[DialogSystem] 对话中切换背景到:" << backgroundPath;
 
         QString fullPath = backgroundPath;
         if (!backgroundPath.startsWith("assets/")) {
@@ -261,7 +262,7 @@ void DialogSystem::nextDialog() {
     }
     m_currentDialogIndex++;
 
-    qDebug() << "DialogSystem: 显示对话:" << m_currentDialogIndex << "/" << m_currentDialogs.size();
+    qCDebug(lcRoom) << "DialogSystem: 显示对话:" << m_currentDialogIndex << "/" << m_currentDialogs.size();
 }
 
 void DialogSystem::onDialogClicked() {
@@ -271,7 +272,7 @@ void DialogSystem::onDialogClicked() {
 }
 
 void DialogSystem::finishStory() {
-    qDebug() << "DialogSystem: 剧情播放完毕";
+    qCDebug(lcRoom) << "DialogSystem: 剧情播放完毕";
     m_skipRequested = false;
 
     // 清理待切换的背景
@@ -360,7 +361,7 @@ void DialogSystem::showLevelStartText(const QString& levelName) {
     levelTextItem->setZValue(10010);
     m_scene->addItem(levelTextItem);
     m_scene->update();
-    qDebug() << "DialogSystem: 关卡文字已添加，Z值:" << levelTextItem->zValue();
+    qCDebug(lcRoom) << "DialogSystem: 关卡文字已添加，Z值:" << levelTextItem->zValue();
 
     // 停止之前的定时器
     if (m_levelTextTimer) {
@@ -369,17 +370,17 @@ void DialogSystem::showLevelStartText(const QString& levelName) {
     }
 
     // 2秒后自动移除
-    m_levelTextTimer = new QTimer(this);
+    m_levelTextTimer = new GameTimer(this, ClockDomain::Dialog);
     m_levelTextTimer->setSingleShot(true);
     QPointer<QGraphicsScene> scenePtr(m_scene);
     QPointer<QGraphicsTextItem> levelTextItemPtr(levelTextItem);
-    connect(m_levelTextTimer, &QTimer::timeout, [levelTextItemPtr, scenePtr]() {
+    connect(m_levelTextTimer, &GameTimer::timeout, [levelTextItemPtr, scenePtr]() {
         if (levelTextItemPtr) {
             if (scenePtr && levelTextItemPtr->scene() == scenePtr) {
                 scenePtr->removeItem(levelTextItemPtr.data());
             }
             delete levelTextItemPtr.data();
-            qDebug() << "DialogSystem: 关卡文字已移除";
+            qCDebug(lcRoom) << "DialogSystem: 关卡文字已移除";
         }
     });
     m_levelTextTimer->start(2000);
@@ -404,7 +405,7 @@ void DialogSystem::showPhaseTransitionText(const QString& text, const QColor& co
                 scenePtr->removeItem(textItemPtr.data());
             }
             delete textItemPtr.data();
-            qDebug() << "DialogSystem: 阶段转换文字已移除";
+            qCDebug(lcRoom) << "DialogSystem: 阶段转换文字已移除";
         }
     });
 }
@@ -505,7 +506,7 @@ void DialogSystem::fadeDialogBackgroundTo(const QString& imagePath, int duration
     });
 
     anim->start(QAbstractAnimation::DeleteWhenStopped);
-    qDebug() << "[DialogSystem] 对话框背景渐变动画开始:" << fullPath;
+    qCDebug(lcRoom) << "[DialogSystem] 对话框背景渐变动画开始:" << fullPath;
 }
 
 void DialogSystem::setPendingFadeDialogBackground(const QString& path, int duration) {
@@ -567,7 +568,7 @@ void DialogSystem::createBossEntryAnimation(const QString& imagePath, QPointF st
             });
 
     m_dialogBossFlyAnimation->start();
-    qDebug() << "[DialogSystem] Boss入场动画开始";
+    qCDebug(lcRoom) << "[DialogSystem] Boss入场动画开始";
 }
 
 void DialogSystem::showStaticBossSprite(const QString& imagePath, QPointF pos) {
@@ -595,5 +596,5 @@ void DialogSystem::showStaticBossSprite(const QString& imagePath, QPointF pos) {
     m_dialogBossSprite->setPos(pos);
     m_dialogBossSprite->setZValue(10001);
     m_scene->addItem(m_dialogBossSprite);
-    qDebug() << "[DialogSystem] 静态Boss图片已显示";
+    qCDebug(lcRoom) << "[DialogSystem] 静态Boss图片已显示";
 }
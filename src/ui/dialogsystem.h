@@ -13,6 +13,7 @@
 #include <QStringList>
 #include <QTimer>
 #include <QVariantAnimation>
+#include "../core/gametimer.h"
 
 class Player;
 class TeacherBoss;
@@ -271,7 +272,7 @@ class DialogSystem : public QObject {
     int m_pendingFadeDialogDuration = 0;            // 渐变持续时间
 
     // 关卡文字显示定时器
-    QTimer* m_levelTextTimer = nullptr;
+    GameTimer* m_levelTextTimer = nullptr;
 };
 
 #endif  // DIALOGSYSTEM_H
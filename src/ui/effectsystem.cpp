@@ -0,0 +1,211 @@
+#include "effectsystem.h"
+#include <QDebug>
+#include <QGraphicsScene>
+#include <QPen>
+#include "../core/gameclock.h"
+#include "../core/resourcefactory.h"
+#include "../core/spritevariantcache.h"
+
+QHash<QGraphicsScene *, QPointer<EffectSystem>> EffectSystem::s_layers;
+QVector<QPixmap> EffectSystem::s_explosionFrames;
+bool EffectSystem::s_explosionFramesLoaded = false;
+
+EffectSystem::EffectSystem() : QGraphicsObject(), m_activeCount(0) {
+    setZValue(900);
+    setAcceptedMouseButtons(Qt::NoButton);
+}
+
+EffectSystem *EffectSystem::forScene(QGraphicsScene *scene) {
+    if (!scene)
+        return nullptr;
+
+    // scene->clear() 会删除特效层，QPointer 失效后重新创建
+    QPointer<EffectSystem> &layer = s_layers[scene];
+    if (!layer || layer->scene() != scene) {
+        layer = new EffectSystem();
+        scene->addItem(layer);
+    }
+    return layer;
+}
+
+void EffectSystem::preloadExplosionFrames() {
+    if (s_explosionFramesLoaded)
+        return;
+
+    s_explosionFrames.clear();
+    s_explosionFrames.reserve(16);
+
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            QString path = QString("assets/explosion/cell_%1_%2.png").arg(i).arg(j);
+            QPixmap frame = ResourceFactory::tryLoadSprite(path);
+            if (!frame.isNull()) {
+                s_explosionFrames.append(frame);
+            } else {
+                qWarning() << "加载爆炸帧失败:" << path;
+                QPixmap placeholder(50, 50);
+                placeholder.fill(Qt::transparent);
+                QPainter painter(&placeholder);
+                painter.setBrush(Qt::red);
+                painter.setPen(Qt::NoPen);
+                painter.drawEllipse(5, 5, 40, 40);
+                painter.end();
+                s_explosionFrames.append(placeholder);
+            }
+        }
+    }
+
+    // 爆炸逐帧放大（1.0x -> 1.5x）：预先生成每一帧放大后的图片，播放时不再逐帧缩放采样
+    const int frameCount = s_explosionFrames.size();
+    for (int i = 0; i < frameCount; ++i) {
+        qreal scale = 1.0 + (i * 0.5 / frameCount);
+        s_explosionFrames[i] = SpriteVariantCache::instance().scaledVariant(s_explosionFrames[i], scale);
+    }
+
+    s_explosionFramesLoaded = true;
+    qDebug() << "爆炸动画帧预加载完成，共" << s_explosionFrames.size() << "帧";
+}
+
+void EffectSystem::spawnExplosion(QGraphicsScene *scene, const QPointF &topLeft) {
+    EffectSystem *layer = forScene(scene);
+    if (!layer)
+        return;
+
+    preloadExplosionFrames();
+    const QVector<QPixmap> &frames = s_explosionFrames;
+    if (frames.isEmpty())
+        return;
+
+    Effect &effect = layer->acquire();
+    effect.type = ExplosionEffect;
+    effect.center = topLeft + QRectF(frames.first().rect()).center();
+    effect.elapsedMs = 0;
+    layer->updateBounds();
+}
+
+void EffectSystem::spawnTeleportRing(QGraphicsScene *scene, const QPointF &center, qreal radius) {
+    EffectSystem *layer = forScene(scene);
+    if (!layer)
+        return;
+
+    Effect &effect = layer->acquire();
+    effect.type = TeleportRingEffect;
+    effect.center = center;
+    effect.radius = radius;
+    effect.elapsedMs = 0;
+    layer->updateBounds();
+}
+
+EffectSystem::Effect &EffectSystem::acquire() {
+    // 优先使用空闲槽位；池满时复用播放时间最长的特效
+    Effect *oldest = &m_pool[0];
+    for (Effect &effect : m_pool) {
+        if (effect.type == NoEffect) {
+            ++m_activeCount;
+            if (!m_tickConnection) {
+                m_tickConnection = connect(&GameClock::instance(), &GameClock::tick, this, &EffectSystem::onTick);
+            }
+            return effect;
+        }
+        if (effect.elapsedMs > oldest->elapsedMs) {
+            oldest = &effect;
+        }
+    }
+    return *oldest;
+}
+
+void EffectSystem::onTick(int dtMs) {
+    const int explosionDuration = s_explosionFrames.size() * kExplosionFrameMs;
+
+    for (Effect &effect : m_pool) {
+        if (effect.type == NoEffect)
+            continue;
+
+        effect.elapsedMs += dtMs;
+        int duration = (effect.type == ExplosionEffect) ? explosionDuration : kTeleportDurationMs;
+        if (effect.elapsedMs >= duration) {
+            effect.type = NoEffect;
+            --m_activeCount;
+        }
+    }
+
+    updateBounds();
+
+    if (m_activeCount == 0) {
+        disconnect(m_tickConnection);
+        m_tickConnection = QMetaObject::Connection();
+    }
+}
+
+QRectF EffectSystem::effectRect(const Effect &effect) const {
+    if (effect.type == ExplosionEffect) {
+        const QVector<QPixmap> &frames = s_explosionFrames;
+        QSizeF size = frames.isEmpty() ? QSizeF() : QSizeF(frames.last().size());
+        return QRectF(effect.center - QPointF(size.width() / 2.0, size.height() / 2.0), size);
+    }
+    // 光环最大放大到1.5倍，外加画笔宽度
+    qreal r = effect.radius * 1.5 + 5.0;
+    return QRectF(effect.center - QPointF(r, r), QSizeF(r * 2, r * 2));
+}
+
+void EffectSystem::updateBounds() {
+    QRectF bounds;
+    for (const Effect &effect : m_pool) {
+        if (effect.type != NoEffect) {
+            bounds |= effectRect(effect);
+        }
+    }
+
+    if (bounds != m_bounds) {
+        prepareGeometryChange();
+        m_bounds = bounds;
+    }
+    update();
+}
+
+QRectF EffectSystem::boundingRect() const {
+    return m_bounds;
+}
+
+void EffectSystem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    if (m_activeCount == 0)
+        return;
+
+    const QVector<QPixmap> &frames = s_explosionFrames;
+    if (m_fragmentsByFrame.size() != frames.size()) {
+        m_fragmentsByFrame.resize(frames.size());
+    }
+    for (auto &fragments : m_fragmentsByFrame) {
+        fragments.clear();
+    }
+
+    const qreal baseOpacity = painter->opacity();
+    for (const Effect &effect : m_pool) {
+        if (effect.type == ExplosionEffect) {
+            int frame = qMin(effect.elapsedMs / kExplosionFrameMs, static_cast<int>(frames.size()) - 1);
+            if (frame < 0)
+                continue;
+            m_fragmentsByFrame[frame].append(
+                    QPainter::PixmapFragment::create(effect.center, QRectF(frames[frame].rect())));
+        } else if (effect.type == TeleportRingEffect) {
+            qreal progress = qBound(0.0, effect.elapsedMs / static_cast<qreal>(kTeleportDurationMs), 1.0);
+            qreal scale = 1.0 + progress * 0.5;
+            painter->setOpacity(baseOpacity * (1.0 - progress));
+            painter->setPen(QPen(QColor(120, 220, 255, 220), 3 * scale));
+            painter->setBrush(Qt::NoBrush);
+            painter->drawEllipse(effect.center, effect.radius * scale, effect.radius * scale);
+        }
+    }
+    painter->setOpacity(baseOpacity);
+
+    // 同一帧的所有爆炸一次画出
+    for (int i = 0; i < m_fragmentsByFrame.size(); ++i) {
+        const auto &fragments = m_fragmentsByFrame[i];
+        if (!fragments.isEmpty()) {
+            painter->drawPixmapFragments(fragments.constData(), fragments.size(), frames[i]);
+        }
+    }
+}
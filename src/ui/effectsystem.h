@@ -0,0 +1,95 @@
+#ifndef EFFECTSYSTEM_H
+#define EFFECTSYSTEM_H
+
+#include <QGraphicsObject>
+#include <QHash>
+#include <QPainter>
+#include <QPixmap>
+#include <QPointer>
+#include <QVector>
+#include <array>
+
+/**
+ * @brief 特效系统 - 爆炸、传送光环等短时特效的对象池
+ *
+ * 每个场景只有一个特效层图元：特效实例是池中的普通结构体，
+ * 由 GameClock 统一推进，在一次 paint 中批量绘制（爆炸帧为所有场景共享的静态帧，
+ * 同一帧的多个爆炸用一次 drawPixmapFragments 画出）。
+ * 生成特效不再创建 QObject 或定时器，大量敌人同时死亡时开销恒定。
+ */
+class EffectSystem : public QGraphicsObject {
+    Q_OBJECT
+
+public:
+    static constexpr int kPoolSize = 64;            // 同时存在的特效上限（满时复用最旧的特效）
+    static constexpr int kExplosionFrameMs = 50;    // 爆炸每帧时长
+    static constexpr int kTeleportDurationMs = 220; // 传送光环持续时间
+
+    /**
+     * @brief 获取场景的特效层（不存在时创建并加入场景）
+     */
+    static EffectSystem *forScene(QGraphicsScene *scene);
+
+    /**
+     * @brief 生成爆炸特效
+     * @param topLeft 爆炸第一帧的左上角
+     */
+    static void spawnExplosion(QGraphicsScene *scene, const QPointF &topLeft);
+
+    /**
+     * @brief 生成传送光环特效
+     * @param center 光环中心
+     * @param radius 初始半径
+     */
+    static void spawnTeleportRing(QGraphicsScene *scene, const QPointF &center, qreal radius = 35.0);
+
+    /**
+     * @brief 预加载爆炸帧（在游戏初始化时调用一次，之后直接返回）
+     */
+    static void preloadExplosionFrames();
+
+    // 预先逐帧放大好的爆炸帧
+    static const QVector<QPixmap> &explosionFrames() { return s_explosionFrames; }
+
+    [[nodiscard]] int activeCount() const { return m_activeCount; }
+
+    [[nodiscard]] QRectF boundingRect() const override;
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+private:
+    EffectSystem();
+
+    enum EffectType {
+        NoEffect,
+        ExplosionEffect,
+        TeleportRingEffect
+    };
+
+    struct Effect {
+        EffectType type = NoEffect;
+        QPointF center;
+        qreal radius = 0.0;
+        int elapsedMs = 0;
+    };
+
+    Effect &acquire();
+
+    void onTick(int dtMs);
+
+    [[nodiscard]] QRectF effectRect(const Effect &effect) const;
+
+    void updateBounds();
+
+    std::array<Effect, kPoolSize> m_pool;
+    int m_activeCount;
+    QRectF m_bounds;
+    QMetaObject::Connection m_tickConnection;
+    QVector<QVector<QPainter::PixmapFragment>> m_fragmentsByFrame;  // 绘制时按帧分组（复用容量）
+
+    static QHash<QGraphicsScene *, QPointer<EffectSystem>> s_layers;
+    static QVector<QPixmap> s_explosionFrames;
+    static bool s_explosionFramesLoaded;
+};
+
+#endif // EFFECTSYSTEM_H
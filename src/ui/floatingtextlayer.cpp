@@ -0,0 +1,253 @@
+#include "floatingtextlayer.h"
+#include <QFontMetrics>
+#include <QGraphicsScene>
+#include <QGuiApplication>
+#include "../core/gameclock.h"
+#include "../entities/entity.h"
+
+QHash<QGraphicsScene *, QPointer<FloatingTextLayer>> FloatingTextLayer::s_layers;
+QCache<QString, QPixmap> FloatingTextLayer::s_glyphs(2 * 1024);  // 成本单位为KB，上限2MB
+
+namespace {
+    // QGraphicsTextItem 的默认文档边距，保留它使文字位置与原来一致
+    constexpr int kTextMargin = 4;
+
+    struct StyleSpec {
+        qreal risePerMs;  // 上浮速度（像素/毫秒）
+        int riseMs;       // 上浮持续时间
+        int durationMs;   // 淡出总时长
+    };
+
+    // 与原定时器动画等价：状态提示每150ms上移2像素、每100ms淡出0.05；
+    // 拾取提示每30ms上移1.5像素（共30步）、每50ms淡出0.04
+    StyleSpec styleSpec(FloatingTextLayer::TextStyle style) {
+        switch (style) {
+            case FloatingTextLayer::PickupText:
+                return {1.5 / 30.0, 900, 1250};
+            case FloatingTextLayer::StatusText:
+            default:
+                return {2.0 / 150.0, 3750, 2000};
+        }
+    }
+
+    const QFont &styleFont(FloatingTextLayer::TextStyle style) {
+        // 字体只构造一次，避免每次弹出文字都重新匹配字体
+        static const QFont statusFont("Microsoft YaHei", 10, QFont::Black);
+        static const QFont pickupFont("Microsoft YaHei", 12, QFont::Bold);
+        static const QFont alertFont = [] {
+            QFont font;
+            font.setPointSize(16);
+            font.setBold(true);
+            return font;
+        }();
+
+        switch (style) {
+            case FloatingTextLayer::PickupText:
+                return pickupFont;
+            case FloatingTextLayer::AlertText:
+                return alertFont;
+            case FloatingTextLayer::StatusText:
+            default:
+                return statusFont;
+        }
+    }
+
+    // 字形按屏幕像素比分配，逻辑尺寸 = 像素尺寸 / devicePixelRatio
+    QSizeF logicalSize(const QPixmap &glyph) {
+        return QSizeF(glyph.size()) / glyph.devicePixelRatio();
+    }
+}
+
+FloatingTextLayer::FloatingTextLayer() : QGraphicsObject(), m_activeCount(0) {
+    setZValue(1000);
+    setAcceptedMouseButtons(Qt::NoButton);
+}
+
+FloatingTextLayer *FloatingTextLayer::forScene(QGraphicsScene *scene) {
+    if (!scene)
+        return nullptr;
+
+    // scene->clear() 会删除文字层，QPointer 失效后重新创建
+    QPointer<FloatingTextLayer> &layer = s_layers[scene];
+    if (!layer || layer->scene() != scene) {
+        layer = new FloatingTextLayer();
+        scene->addItem(layer);
+    }
+    return layer;
+}
+
+QPixmap FloatingTextLayer::glyphFor(const QString &text, const QColor &color, TextStyle style) {
+    // 高分屏上按设备像素绘制，否则放大显示会模糊
+    const qreal dpr = qGuiApp ? qGuiApp->devicePixelRatio() : 1.0;
+    QString key = QString("%1|%2|%3|%4").arg(style).arg(color.rgba()).arg(dpr).arg(text);
+    if (QPixmap *cached = s_glyphs.object(key))
+        return *cached;
+
+    const QFont &font = styleFont(style);
+    QFontMetrics metrics(font);
+    QSize size(metrics.horizontalAdvance(text) + kTextMargin * 2, metrics.height() + kTextMargin * 2);
+
+    QPixmap glyph(size * dpr);
+    glyph.setDevicePixelRatio(dpr);
+    glyph.fill(Qt::transparent);
+    QPainter painter(&glyph);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    painter.setFont(font);
+    painter.setPen(color);
+    painter.drawText(kTextMargin, kTextMargin + metrics.ascent(), text);
+    painter.end();
+
+    int cost = qMax(1, glyph.width() * glyph.height() * 4 / 1024);
+    s_glyphs.insert(key, new QPixmap(glyph), cost);
+    return glyph;
+}
+
+void FloatingTextLayer::clearGlyphCache() {
+    s_glyphs.clear();
+}
+
+void FloatingTextLayer::showFloatText(QGraphicsScene *scene, const QString &text, const QPointF &position,
+                                      const QColor &color, TextStyle style, bool hCenter) {
+    FloatingTextLayer *layer = forScene(scene);
+    if (!layer || text.isEmpty())
+        return;
+
+    StyleSpec spec = styleSpec(style);
+    QPixmap glyph = glyphFor(text, color, style);
+
+    TextEntry &entry = layer->acquire();
+    entry.glyph = glyph;
+    entry.origin = hCenter ? position - QPointF(logicalSize(glyph).width() / 2.0, 0) : position;
+    entry.pos = entry.origin;
+    entry.target = nullptr;
+    entry.offset = QPointF();
+    entry.risePerMs = spec.risePerMs;
+    entry.riseMs = spec.riseMs;
+    entry.durationMs = spec.durationMs;
+    entry.fade = true;
+    entry.opacity = 1.0;
+    entry.elapsedMs = 0;
+    layer->updateBounds();
+}
+
+void FloatingTextLayer::showLabel(QGraphicsScene *scene, const QString &text, const QColor &color, Entity *target,
+                                  const QPointF &offset, int durationMs, bool follow) {
+    FloatingTextLayer *layer = forScene(scene);
+    if (!layer || !target || text.isEmpty())
+        return;
+
+    TextEntry &entry = layer->acquire();
+    entry.glyph = glyphFor(text, color, AlertText);
+    entry.origin = target->pos() + offset;
+    entry.pos = entry.origin;
+    entry.target = follow ? target : nullptr;
+    entry.offset = offset;
+    entry.risePerMs = 0.0;
+    entry.riseMs = 0;
+    entry.durationMs = durationMs;
+    entry.fade = false;
+    entry.opacity = 1.0;
+    entry.elapsedMs = 0;
+    layer->updateBounds();
+}
+
+FloatingTextLayer::TextEntry &FloatingTextLayer::acquire() {
+    // 优先使用空闲槽位；池满时复用显示时间最长的条目
+    TextEntry *oldest = &m_pool[0];
+    for (TextEntry &entry : m_pool) {
+        if (!entry.active) {
+            entry.active = true;
+            ++m_activeCount;
+            if (!m_tickConnection) {
+                m_tickConnection = connect(&GameClock::instance(), &GameClock::tick, this,
+                                           &FloatingTextLayer::onTick);
+            }
+            return entry;
+        }
+        if (entry.elapsedMs > oldest->elapsedMs) {
+            oldest = &entry;
+        }
+    }
+    return *oldest;
+}
+
+void FloatingTextLayer::onTick(int dtMs) {
+    for (TextEntry &entry : m_pool) {
+        if (!entry.active)
+            continue;
+
+        entry.elapsedMs += dtMs;
+        if (entry.elapsedMs >= entry.durationMs) {
+            entry.active = false;
+            entry.glyph = QPixmap();
+            entry.target = nullptr;
+            --m_activeCount;
+            continue;
+        }
+
+        if (entry.target) {
+            entry.origin = entry.target->pos() + entry.offset;
+        }
+        entry.pos = entry.origin - QPointF(0, entry.risePerMs * qMin(entry.elapsedMs, entry.riseMs));
+        if (entry.fade) {
+            entry.opacity = 1.0 - entry.elapsedMs / static_cast<qreal>(entry.durationMs);
+        }
+    }
+
+    updateBounds();
+
+    if (m_activeCount == 0) {
+        disconnect(m_tickConnection);
+        m_tickConnection = QMetaObject::Connection();
+    }
+}
+
+void FloatingTextLayer::updateBounds() {
+    QRectF bounds;
+    for (const TextEntry &entry : m_pool) {
+        if (entry.active) {
+            bounds |= QRectF(entry.pos, logicalSize(entry.glyph));
+        }
+    }
+
+    if (bounds != m_bounds) {
+        prepareGeometryChange();
+        m_bounds = bounds;
+    }
+    update();
+}
+
+QRectF FloatingTextLayer::boundingRect() const {
+    return m_bounds;
+}
+
+void FloatingTextLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    if (m_activeCount == 0)
+        return;
+
+    // 共用同一字形的条目一次画出（例如多个敌人同时中毒）
+    std::array<bool, kPoolSize> drawn{};
+    for (int i = 0; i < kPoolSize; ++i) {
+        const TextEntry &first = m_pool[i];
+        if (!first.active || drawn[i])
+            continue;
+
+        m_fragments.clear();
+        const qint64 glyphKey = first.glyph.cacheKey();
+        const QRectF source(first.glyph.rect());  // 设备像素，按 1/dpr 缩放回逻辑尺寸
+        const qreal scale = 1.0 / first.glyph.devicePixelRatio();
+        const QPointF center = source.center() * scale;
+        for (int j = i; j < kPoolSize; ++j) {
+            const TextEntry &entry = m_pool[j];
+            if (!entry.active || drawn[j] || entry.glyph.cacheKey() != glyphKey)
+                continue;
+            drawn[j] = true;
+            m_fragments.append(QPainter::PixmapFragment::create(entry.pos + center, source, scale, scale, 0,
+                                                                entry.opacity));
+        }
+        painter->drawPixmapFragments(m_fragments.constData(), m_fragments.size(), first.glyph);
+    }
+}
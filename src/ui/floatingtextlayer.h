@@ -0,0 +1,107 @@
+#ifndef FLOATINGTEXTLAYER_H
+#define FLOATINGTEXTLAYER_H
+
+#include <QCache>
+#include <QColor>
+#include <QGraphicsObject>
+#include <QHash>
+#include <QPainter>
+#include <QPointer>
+#include <QVector>
+#include <array>
+
+class Entity;
+
+/**
+ * @brief 漂浮文字层 - 状态提示、拾取提示、"昏睡ZZZ"等弹出文字的对象池
+ *
+ * 每个场景只有一个文字层图元：文字条目是池中的普通结构体，
+ * 字符串只排版一次并缓存为字形图片（按 样式+颜色+文字 共享），
+ * 上浮、淡出和跟随目标都在 GameClock 的 tick 中统一推进，一次 paint 批量画出。
+ * 弹出文字不再创建 QGraphicsTextItem 或定时器，也不再每次重新匹配字体。
+ */
+class FloatingTextLayer : public QGraphicsObject {
+    Q_OBJECT
+
+public:
+    static constexpr int kPoolSize = 64;  // 同时存在的文字上限（满时复用最旧的条目）
+
+    /**
+     * @brief 文字样式（决定字体和动画参数）
+     */
+    enum TextStyle {
+        StatusText,  // 状态/道具效果提示：小号粗体，上浮并淡出
+        PickupText,  // 掉落物拾取提示：较大粗体，较快上浮并淡出
+        AlertText    // 控制效果提示（昏睡、惊吓、定身等）：大号粗体，停留固定时长
+    };
+
+    /**
+     * @brief 获取场景的文字层（不存在时创建并加入场景）
+     */
+    static FloatingTextLayer *forScene(QGraphicsScene *scene);
+
+    /**
+     * @brief 显示上浮淡出的文字
+     * @param position 文字左上角（与原 QGraphicsTextItem::setPos 相同的约定）
+     * @param hCenter 为 true 时 position.x() 表示文字的水平中心
+     */
+    static void showFloatText(QGraphicsScene *scene, const QString &text, const QPointF &position,
+                              const QColor &color = Qt::black, TextStyle style = StatusText, bool hCenter = false);
+
+    /**
+     * @brief 在目标上方显示停留固定时长的提示文字
+     * @param offset 相对目标位置的偏移
+     * @param durationMs 显示时长
+     * @param follow 为 true 时文字跟随目标移动，否则停留在生成位置
+     */
+    static void showLabel(QGraphicsScene *scene, const QString &text, const QColor &color, Entity *target,
+                          const QPointF &offset, int durationMs, bool follow = false);
+
+    /**
+     * @brief 清空字形缓存
+     */
+    static void clearGlyphCache();
+
+    [[nodiscard]] int activeCount() const { return m_activeCount; }
+
+    [[nodiscard]] QRectF boundingRect() const override;
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+private:
+    FloatingTextLayer();
+
+    struct TextEntry {
+        bool active = false;
+        QPixmap glyph;            // 缓存的字形图片（隐式共享）
+        QPointF origin;           // 生成时的左上角
+        QPointF pos;              // 当前左上角
+        QPointer<Entity> target;  // 跟随目标（为空时不跟随）
+        QPointF offset;           // 相对跟随目标的偏移
+        qreal risePerMs = 0.0;    // 上浮速度（像素/毫秒）
+        int riseMs = 0;           // 上浮持续时间
+        int durationMs = 0;       // 总显示时长
+        bool fade = false;        // 是否在显示期间线性淡出
+        qreal opacity = 1.0;
+        int elapsedMs = 0;
+    };
+
+    static QPixmap glyphFor(const QString &text, const QColor &color, TextStyle style);
+
+    TextEntry &acquire();
+
+    void onTick(int dtMs);
+
+    void updateBounds();
+
+    std::array<TextEntry, kPoolSize> m_pool;
+    int m_activeCount;
+    QRectF m_bounds;
+    QMetaObject::Connection m_tickConnection;
+    QVector<QPainter::PixmapFragment> m_fragments;  // 绘制时复用的片段缓冲
+
+    static QHash<QGraphicsScene *, QPointer<FloatingTextLayer>> s_layers;
+    static QCache<QString, QPixmap> s_glyphs;
+};
+
+#endif // FLOATINGTEXTLAYER_H
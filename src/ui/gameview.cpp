@@ -15,11 +15,19 @@
 #include <QtMath>
 #include "../core/GameWindow.cpp"
 #include "../core/audiomanager.h"
+#include "../core/configmanager.h"
+#include "../core/gameclock.h"
+#include "../core/objectcensus.h"
 #include "../core/resourcefactory.h"
+#include "../core/timerwheel.h"
 #include "../entities/level_2/sockenemy.h"
 #include "../entities/level_2/walker.h"
+#include "../world/bulletpattern.h"
+#include "../world/enemypool.h"
+#include "../world/projectilepool.h"
+#include "../world/triggersystem.h"
 #include "dialogsystem.h"
-#include "explosion.h"
+#include "effectsystem.h"
 #include "level.h"
 #include "pausemenu.h"
 
@@ -58,6 +66,10 @@ GameView::GameView(QWidget* parent) : QWidget(parent), player(nullptr), level(nu
     layout->addWidget(view);
 
     setLayout(layout);
+
+    // 快进由命令行或开发者热键开启，渲染降到低频固定帧率，把时间留给模拟
+    connect(&GameClock::instance(), &GameClock::fastForwardChanged, this, &GameView::onFastForwardChanged);
+    onFastForwardChanged(GameClock::instance().fastForward());
 }
 
 GameView::~GameView() {
@@ -77,6 +89,13 @@ void GameView::cleanupGame() {
     isLevelTransition = false;
     currentLevel = 1;
 
+    // 丢弃上一局尚未执行的延迟回调、触发区域、待分裂的母弹和对象池中的空闲敌人、子弹
+    TimerWheel::instance().clear();
+    TriggerSystem::instance().clear();
+    BulletPatternEngine::instance().clear();
+    EnemyPool::instance().clear();
+    ProjectilePool::instance().clear();
+
     // 清理暂停菜单
     if (m_pauseMenu) {
         disconnect(m_pauseMenu, nullptr, this, nullptr);
@@ -203,9 +222,7 @@ void GameView::initGame() {
         m_devSkipToBoss = savedDevSkipToBoss;
 
         // 预加载爆炸动画帧（只在首次加载）
-        if (!Explosion::isFramesLoaded()) {
-            Explosion::preloadFrames();
-        }
+        EffectSystem::preloadExplosionFrames();
 
         // 初始化音频系统
         initAudio();
@@ -298,6 +315,7 @@ void GameView::initGame() {
 
         // 使用开发者设置的起始关卡（默认为1）
         currentLevel = m_startLevel;
+        ObjectCensus::instance().resetBaseline();
         level->init(currentLevel);
 
         // 重置起始关卡为1（下次正常开始游戏时从第1关开始）
@@ -509,6 +527,7 @@ void GameView::advanceToNextLevel() {
     // 初始化新关卡
     if (level) {
         player->setPos(1000, 800);
+        ObjectCensus::instance().resetBaseline();
         level->init(currentLevel);
 
         connect(level, &Level::storyFinished, this, &GameView::onStoryFinished);
@@ -568,6 +587,18 @@ void GameView::keyPressEvent(QKeyEvent* event) {
         return;
     }
 
+    // F8 切换快进（仅开发者模式）
+    if (event->key() == Qt::Key_F8 && (m_isDevMode || ConfigManager::instance().isDevModeEnabled())) {
+        cycleFastForward();
+        return;
+    }
+
+    // F9 显示/隐藏对象普查浮层（仅开发者模式）
+    if (event->key() == Qt::Key_F9 && (m_isDevMode || ConfigManager::instance().isDevModeEnabled())) {
+        toggleCensusOverlay();
+        return;
+    }
+
     // G键进入下一关（在Boss房间奖励完成后激活）
     if (event->key() == Qt::Key_G && level && level->isGKeyEnabled()) {
         level->triggerNextLevelByGKey();
@@ -818,7 +849,7 @@ void GameView::handlePlayerDeath() {
             }
             // 使用 QTimer::singleShot 延迟发出信号，确保按钮点击事件完全处理完毕
             QTimer::singleShot(0, this, [this]() {
-                emit requestRestart();
+                retryFromRoomStart();
             });
         });
 
@@ -838,6 +869,31 @@ void GameView::handlePlayerDeath() {
     });
 }
 
+void GameView::retryFromRoomStart() {
+    if (!level || !player || !level->retryFromRoomStart()) {
+        emit requestRestart();
+        return;
+    }
+
+    // 死亡界面的背景、按钮代理都是遮罩的子项，随遮罩一起删除
+    if (m_deathOverlay) {
+        if (scene)
+            scene->removeItem(m_deathOverlay);
+        delete m_deathOverlay;
+    }
+    m_deathOverlay = nullptr;
+    m_retryButton = nullptr;
+    m_menuButton2 = nullptr;
+    m_quitButton2 = nullptr;
+    m_retryProxy = nullptr;
+    m_menuProxy2 = nullptr;
+    m_quitProxy2 = nullptr;
+
+    connect(player, &Player::playerDied, this, &GameView::handlePlayerDeath, Qt::UniqueConnection);
+    updateHUD();
+    setFocus();
+}
+
 void GameView::onEnemiesCleared(int roomIndex, bool up, bool down, bool left, bool right) {
     qDebug() << "GameView::onEnemiesCleared 被调用，房间:" << roomIndex;
 
@@ -871,6 +927,17 @@ void GameView::onEnemiesCleared(int roomIndex, bool up, bool down, bool left, bo
             delete hintPtr;
         }
     });
+
+    // 浸泡测试：房间清空、尸体和特效销毁后，存活对象应回到本关基线（基线在本关首个房间生成敌人前记录）
+    if (ObjectCensus::instance().isEnabled() && ObjectCensus::instance().hasBaseline()) {
+        const QString label = QString("第%1关 房间%2 清空").arg(currentLevel).arg(roomIndex);
+        TimerWheel::instance().schedule(this, kCensusCheckpointDelayMs, [this, label, roomIndex]() {
+            // 等待期间已进入下一个房间时跳过，新房间的敌人不应算作泄漏
+            if (level && level->currentRoomIndex() == roomIndex) {
+                ObjectCensus::instance().checkpoint(label);
+            }
+        });
+    }
 }
 
 void GameView::onBossDoorsOpened() {
@@ -917,6 +984,8 @@ void GameView::pauseGame() {
         connect(m_pauseMenu, &PauseMenu::returnToMenu, this, [this]() {
             // 返回主菜单前，重置暂停状态
             m_isPaused = false;
+            GameClock::instance().setPaused(ClockDomain::Gameplay, false);
+            GameClock::instance().setPaused(ClockDomain::Dialog, false);
             if (m_pauseMenu) {
                 m_pauseMenu->hide();
             }
@@ -934,6 +1003,9 @@ void GameView::pauseGame() {
         level->setPaused(true);
     }
 
+    // 剧情对话的计时也一并暂停，界面时间域不受影响
+    GameClock::instance().setPaused(ClockDomain::Dialog, true);
+
     // 显示暂停菜单
     m_pauseMenu->show();
 }
@@ -959,10 +1031,88 @@ void GameView::resumeGame() {
         level->setPaused(false);
     }
 
+    GameClock::instance().setPaused(ClockDomain::Dialog, false);
+
     // 确保游戏视图获得焦点
     setFocus();
 }
 
+void GameView::cycleFastForward() {
+    GameClock& clock = GameClock::instance();
+    switch (clock.fastForward()) {
+        case 1:
+            clock.setFastForward(2);
+            break;
+        case 2:
+            clock.setFastForward(4);
+            break;
+        case 4:
+            clock.setFastForward(8);
+            break;
+        case 8:
+            clock.setFastForward(GameClock::kFastForwardUnbounded);
+            break;
+        default:
+            clock.setFastForward(1);
+            break;
+    }
+}
+
+void GameView::onFastForwardChanged(int factor) {
+    if (!view)
+        return;
+
+    if (factor == 1) {
+        if (m_fastForwardRenderTimer) {
+            m_fastForwardRenderTimer->stop();
+        }
+        view->setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+        view->viewport()->update();
+        return;
+    }
+
+    // 场景变化不再触发重绘，只按固定间隔整帧刷新
+    view->setViewportUpdateMode(QGraphicsView::NoViewportUpdate);
+    if (!m_fastForwardRenderTimer) {
+        m_fastForwardRenderTimer = new QTimer(this);
+        connect(m_fastForwardRenderTimer, &QTimer::timeout, this, [this]() {
+            if (view)
+                view->viewport()->update();
+        });
+    }
+    m_fastForwardRenderTimer->start(kFastForwardRenderIntervalMs);
+}
+
+void GameView::toggleCensusOverlay() {
+    if (m_censusOverlay && m_censusOverlay->isVisible()) {
+        m_censusOverlay->hide();
+        m_censusRefreshTimer->stop();
+        return;
+    }
+
+    // 普查未在启动时启用则从现在开始统计（之前创建的对象不计入）
+    ObjectCensus::instance().enable();
+    if (!m_censusOverlay) {
+        m_censusOverlay = new QLabel(this);
+        m_censusOverlay->setAttribute(Qt::WA_TransparentForMouseEvents);
+        m_censusOverlay->setStyleSheet("QLabel { background: rgba(0, 0, 0, 160); color: #7CFC00; padding: 6px; }");
+        m_censusOverlay->setFont(QFont("Consolas", 9));
+        m_censusOverlay->move(8, 8);
+
+        m_censusRefreshTimer = new QTimer(this);
+        connect(m_censusRefreshTimer, &QTimer::timeout, this, [this]() {
+            m_censusOverlay->setText(ObjectCensus::instance().sample().summary());
+            m_censusOverlay->adjustSize();
+        });
+    }
+    ObjectCensus::instance().sample();  // 丢弃之前累计的唤醒次数，速率从现在开始计算
+    m_censusOverlay->setText("对象普查中…");
+    m_censusOverlay->adjustSize();
+    m_censusOverlay->show();
+    m_censusOverlay->raise();
+    m_censusRefreshTimer->start(1000);
+}
+
 void GameView::showEvent(QShowEvent* event) {
     QWidget::showEvent(event);
     adjustViewToWindow();
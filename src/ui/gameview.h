@@ -4,8 +4,10 @@
 #include <QGraphicsScene>
 #include <QGraphicsView>
 #include <QKeyEvent>
+#include <QLabel>
 #include <QList>
 #include <QPushButton>
+#include <QTimer>
 #include <QWidget>
 #include "../entities/enemy.h"
 #include "../entities/player.h"
@@ -35,6 +37,12 @@ class GameView : public QWidget {
     int m_devMaxHealth = 3;         // 开发者模式血量上限
     int m_devBulletDamage = 1;      // 开发者模式子弹伤害
     bool m_devSkipToBoss = false;   // 开发者模式直接进入Boss房
+    QTimer* m_fastForwardRenderTimer = nullptr;  // 快进时的低频重绘定时器
+    QLabel* m_censusOverlay = nullptr;           // 对象普查浮层（F9，仅开发者模式）
+    QTimer* m_censusRefreshTimer = nullptr;
+
+    static constexpr int kFastForwardRenderIntervalMs = 100;  // 快进时约10帧/秒
+    static constexpr int kCensusCheckpointDelayMs = 2000;     // 清空房间后等待尸体和特效销毁再普查
 
    public:
     explicit GameView(QWidget* parent = nullptr);
@@ -74,6 +82,11 @@ class GameView : public QWidget {
     void togglePause();  // 切换暂停状态
     void resumeGame();   // 继续游戏
     void pauseGame();    // 暂停游戏
+
+    void retryFromRoomStart();  // 死亡后从当前房间入口重试，不可重试时冷启动
+
+    void cycleFastForward();  // 开发者快进：1x → 2x → 4x → 8x → 不限 → 1x
+    void toggleCensusOverlay();  // 开发者对象普查浮层：存活对象、定时器和唤醒速率
     void applyCharacterAbility(Player* player, const QString& characterPath);
 
     [[nodiscard]] QString resolveCharacterKey(const QString& characterPath) const;
@@ -116,6 +129,8 @@ class GameView : public QWidget {
 
     void onTicketPickedUp();  // 车票拾取时的处理
 
+    void onFastForwardChanged(int factor);  // 快进时改为低频固定重绘
+
    signals:
 
     void backToMenu();
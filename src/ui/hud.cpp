@@ -9,20 +9,20 @@ HUD::HUD(Player *pl, QGraphicsItem *parent)
           flashCount(0), currentRoomIndex(0) {
     player = pl;
 
-    flashTimer = new QTimer(this);
-    connect(flashTimer, &QTimer::timeout, this, &HUD::endDamageFlash);
+    flashTimer = new GameTimer(this, ClockDomain::UI);
+    connect(flashTimer, &GameTimer::timeout, this, &HUD::endDamageFlash);
 
-    screenFlashTimer = new QTimer(this);
+    screenFlashTimer = new GameTimer(this, ClockDomain::UI);
     screenFlashTimer->setSingleShot(true);
-    connect(screenFlashTimer, &QTimer::timeout, this, [this]() {
+    connect(screenFlashTimer, &GameTimer::timeout, this, [this]() {
         isScreenFlashing = false;
         update();
     });
 
     // 设置 this 为父对象，确保 HUD 销毁时定时器也被销毁
-    m_hudTimer = new QTimer(this);
+    m_hudTimer = new GameTimer(this, ClockDomain::UI);
     m_hudTimer->setInterval(16);
-    connect(m_hudTimer, &QTimer::timeout, [this]() {
+    connect(m_hudTimer, &GameTimer::timeout, [this]() {
         this->update();  // 直接调用 HUD 的 update()
     });
     m_hudTimer->start();
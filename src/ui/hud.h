@@ -4,6 +4,7 @@
 #include <QDebug>
 #include <QGraphicsItem>
 #include <QObject>
+#include "../core/gametimer.h"
 #include "player.h"
 
 class HUD : public QObject, public QGraphicsItem {
@@ -61,12 +62,12 @@ private:
     float maxHealth;
     bool isFlashing;
     bool isScreenFlashing;
-    QTimer *flashTimer;
+    GameTimer *flashTimer;
     int flashCount;
-    QTimer *screenFlashTimer;
+    GameTimer *screenFlashTimer;
     Player *player;
     int currentRoomIndex;
-    QTimer *m_hudTimer;  // HUD刷新定时器
+    GameTimer *m_hudTimer;  // HUD刷新定时器
 
     QVector<RoomNode> mapNodes;
 };
@@ -0,0 +1,165 @@
+#include "aisystem.h"
+#include <QtMath>
+#include "../core/gameclock.h"
+#include "../entities/enemy.h"
+#include "../entities/player.h"
+#include "flowfield.h"
+
+AISystem &AISystem::instance() {
+    static AISystem instance;
+    return instance;
+}
+
+void AISystem::add(Enemy *enemy) {
+    if (!enemy || enemy->m_aiSlot >= 0)
+        return;
+
+    if (!m_tickConnection) {
+        m_tickConnection = QObject::connect(&GameClock::instance(), &GameClock::tick, &GameClock::instance(),
+                                            [](int dtMs) { AISystem::instance().advance(dtMs); });
+    }
+
+    enemy->m_aiSlot = m_agents.size();
+    m_agents.append(enemy);
+    m_lastStep.append(m_step);
+}
+
+void AISystem::remove(Enemy *enemy) {
+    if (!enemy || enemy->m_aiSlot < 0)
+        return;
+
+    const int slot = enemy->m_aiSlot;
+    enemy->m_aiSlot = -1;
+    m_agents[slot] = nullptr;
+    ++m_holes;
+
+    if (!m_dispatching)
+        compact();
+}
+
+void AISystem::advance(int dtMs) {
+    m_accumMs += dtMs;
+    int steps = 0;
+    while (m_accumMs >= kStepMs && steps < kMaxStepsPerTick) {
+        m_accumMs -= kStepMs;
+        step();
+        ++steps;
+    }
+    // 超出补步上限的部分直接丢弃（与 GameTimer 单次节拍的补发上限一致）
+    if (m_accumMs >= kStepMs)
+        m_accumMs %= kStepMs;
+}
+
+void AISystem::step() {
+    ++m_step;
+    m_lastUpdated = 0;
+
+    const int count = m_agents.size();
+    m_active.clear();
+    m_posX.resize(count);
+    m_posY.resize(count);
+    m_targetX.resize(count);
+    m_targetY.resize(count);
+    m_dx.resize(count);
+    m_dy.resize(count);
+    m_distSq.resize(count);
+
+    // 1. 收集位置：同一个玩家只读取一次 pos()，并以它为目标更新流场（跨格时才重建）
+    const Player *cachedPlayer = nullptr;
+    QPointF playerPos;
+    for (int i = 0; i < count; ++i) {
+        Enemy *enemy = m_agents[i];
+        if (!enemy || enemy->m_isPaused || !enemy->scene())
+            continue;
+
+        if (enemy->player != cachedPlayer) {
+            cachedPlayer = enemy->player;
+            if (cachedPlayer) {
+                playerPos = cachedPlayer->pos();
+                FlowField::instance().setTarget(playerPos);
+            }
+        }
+
+        const QPointF enemyPos = enemy->pos();
+        m_posX[i] = enemyPos.x();
+        m_posY[i] = enemyPos.y();
+        // 没有玩家时目标取自身位置，距离为 0，由 LOD 按空闲处理
+        m_targetX[i] = cachedPlayer ? playerPos.x() : enemyPos.x();
+        m_targetY[i] = cachedPlayer ? playerPos.y() : enemyPos.y();
+        m_active.append(i);
+    }
+
+    // 2. 一次遍历算出玩家相对向量和距离平方（纯数组运算）
+    for (int i : m_active) {
+        const double dx = m_targetX[i] - m_posX[i];
+        const double dy = m_targetY[i] - m_posY[i];
+        m_dx[i] = dx;
+        m_dy[i] = dy;
+        m_distSq[i] = dx * dx + dy * dy;
+    }
+
+    for (std::size_t p = 0; p < m_byPattern.size(); ++p) {
+        m_byPattern[p].clear();
+    }
+
+    // 3. 按距离分级决定本步是否更新，更新状态并把需要移动的敌人按模式分组
+    m_dispatching = true;
+    for (int i : m_active) {
+        Enemy *enemy = m_agents[i];
+        if (!enemy)
+            continue;
+
+        int stride = 1;
+        if (!enemy->player || enemy->currentState == Enemy::IDLE) {
+            stride = kIdleStride;
+        } else {
+            const double farRange = enemy->visionRange + kFarMargin;
+            if (m_distSq[i] > farRange * farRange)
+                stride = kFarStride;
+        }
+
+        const qint64 stepsSince = m_step - m_lastStep[i];
+        if (stepsSince < stride)
+            continue;
+        m_lastStep[i] = m_step;
+        ++m_lastUpdated;
+
+        // 暂停或移出场景期间不累计时间
+        const int elapsedMs = static_cast<int>(qMin<qint64>(stepsSince, stride)) * kStepMs;
+        enemy->setPlayerVector(m_dx[i], m_dy[i], m_distSq[i]);
+        if (enemy->updateAIState(elapsedMs)) {
+            const int pattern = qBound(0, static_cast<int>(enemy->m_movePattern), int(m_byPattern.size()) - 1);
+            m_byPattern[pattern].append(i);
+        }
+    }
+
+    // 4. 同一移动模式的敌人连续执行
+    for (const QVector<int> &bucket : m_byPattern) {
+        for (int i : bucket) {
+            if (Enemy *enemy = m_agents[i])
+                enemy->executeMovement();
+        }
+    }
+    m_dispatching = false;
+
+    compact();
+}
+
+void AISystem::compact() {
+    if (m_holes == 0)
+        return;
+
+    for (int i = m_agents.size() - 1; i >= 0; --i) {
+        if (m_agents[i])
+            continue;
+        const int last = m_agents.size() - 1;
+        if (i != last) {
+            m_agents[i] = m_agents[last];
+            m_lastStep[i] = m_lastStep[last];
+            m_agents[i]->m_aiSlot = i;
+        }
+        m_agents.removeLast();
+        m_lastStep.removeLast();
+    }
+    m_holes = 0;
+}
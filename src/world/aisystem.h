@@ -0,0 +1,84 @@
+#ifndef AISYSTEM_H
+#define AISYSTEM_H
+
+#include <QMetaObject>
+#include <QVector>
+#include <array>
+
+class Enemy;
+
+/**
+ * @brief 敌人 AI 批量更新系统
+ *
+ * 替代每个敌人各自的 100ms aiTimer：由 GameClock::tick 推进，每 kStepMs 执行一步。
+ * 每一步先把敌人和玩家的位置收集到连续数组中，一次遍历算出玩家相对向量和距离平方，
+ * 再把需要移动的敌人按移动模式分组依次执行，各移动模式直接使用预先算好的向量，
+ * 不再各自读取 player->pos()、重复开方。追击方向由共享的 FlowField 提供。
+ *
+ * 更新频率分级（LOD）：视野外较远的敌人、没有玩家可追的敌人降低更新频率，
+ * 两次更新间经过的时间会传给敌人（冲刺蓄力、漫游冷却按实际时间推进）。
+ */
+class AISystem {
+public:
+    static AISystem &instance();
+
+    static constexpr int kStepMs = 100;          // 一步的间隔（与原 aiTimer 相同）
+    static constexpr int kFarStride = 4;         // 视野外较远的敌人每 4 步更新一次
+    static constexpr int kIdleStride = 2;        // 没有玩家或处于空闲状态的敌人每 2 步更新一次
+    static constexpr double kFarMargin = 100.0;  // 视野范围外再加的缓冲距离
+    static constexpr int kMaxStepsPerTick = 8;   // 单次节拍最多补的步数
+
+    /**
+     * @brief 加入批量更新（Enemy::setAIEnabled 调用）
+     */
+    void add(Enemy *enemy);
+
+    /**
+     * @brief 退出批量更新，可在更新过程中调用
+     */
+    void remove(Enemy *enemy);
+
+    [[nodiscard]] int agentCount() const { return m_agents.size() - m_holes; }
+
+    /**
+     * @brief 上一步实际更新的敌人数（其余被暂停、不在场景中或被 LOD 跳过）
+     */
+    [[nodiscard]] int lastUpdatedCount() const { return m_lastUpdated; }
+
+private:
+    AISystem() = default;
+
+    AISystem(const AISystem &) = delete;
+
+    AISystem &operator=(const AISystem &) = delete;
+
+    void advance(int dtMs);
+
+    void step();
+
+    // 移除更新过程中留下的空位（交换删除并更新敌人记录的下标）
+    void compact();
+
+    QVector<Enemy *> m_agents;
+    QVector<qint64> m_lastStep;  // 与 m_agents 对应：上次更新所在的步数
+
+    // 每步收集的结构数组（复用缓冲，避免每步分配）
+    QVector<double> m_posX;
+    QVector<double> m_posY;
+    QVector<double> m_targetX;
+    QVector<double> m_targetY;
+    QVector<double> m_dx;
+    QVector<double> m_dy;
+    QVector<double> m_distSq;
+    QVector<int> m_active;  // 参与本步的 agent 下标（在场景中且未暂停）
+    std::array<QVector<int>, 7> m_byPattern;  // 需要移动的 agent 按 Enemy::MovementPattern 分组
+
+    qint64 m_step = 0;
+    int m_accumMs = 0;
+    int m_lastUpdated = 0;
+    int m_holes = 0;
+    bool m_dispatching = false;
+    QMetaObject::Connection m_tickConnection;
+};
+
+#endif // AISYSTEM_H
@@ -4,6 +4,7 @@
 #include <QGraphicsScene>
 #include <QPropertyAnimation>
 #include <QtMath>
+#include "../core/logging.h"
 #include "../entities/boss.h"
 #include "../entities/enemy.h"
 #include "../entities/level_1/nightmareboss.h"
@@ -11,6 +12,7 @@
 #include "../entities/level_3/teacherboss.h"
 #include "../entities/player.h"
 #include "../entities/projectile.h"
+#include "entityregistry.h"
 
 BossFight::BossFight(Player* player, QGraphicsScene* scene, QObject* parent)
     : QObject(parent), m_player(player), m_scene(scene) {
@@ -56,7 +58,7 @@ void BossFight::initNightmareBoss(NightmareBoss* boss) {
                 emit requestFadeBackground(QString("assets/background/nightmare2_map.png"), 3000);
             });
 
-    qDebug() << "[BossFight] NightmareBoss信号已连接";
+    qCDebug(lcBoss) << "[BossFight] NightmareBoss信号已连接";
 }
 
 void BossFight::initWashMachineBoss(WashMachineBoss* boss) {
@@ -101,21 +103,21 @@ void BossFight::connectWashMachineBossSignals(WashMachineBoss* boss) {
     connect(boss, &WashMachineBoss::requestSpawnEnemies,
             this, &BossFight::requestSpawnEnemies);
 
-    qDebug() << "[BossFight] WashMachineBoss信号已连接";
+    qCDebug(lcBoss) << "[BossFight] WashMachineBoss信号已连接";
 }
 
 void BossFight::onWashMachineBossRequestDialog(const QStringList& dialogs, const QString& background) {
-    qDebug() << "[BossFight] WashMachineBoss请求显示对话";
+    qCDebug(lcBoss) << "[BossFight] WashMachineBoss请求显示对话";
     emit requestShowDialog(dialogs, true, background);
 }
 
 void BossFight::onWashMachineBossRequestChangeBackground(const QString& backgroundPath) {
-    qDebug() << "[BossFight] WashMachineBoss请求更换背景:" << backgroundPath;
+    qCDebug(lcBoss) << "[BossFight] WashMachineBoss请求更换背景:" << backgroundPath;
     changeBackground(backgroundPath);
 }
 
 void BossFight::onWashMachineBossRequestAbsorb() {
-    qDebug() << "[BossFight] WashMachineBoss请求执行吸纳动画";
+    qCDebug(lcBoss) << "[BossFight] WashMachineBoss请求执行吸纳动画";
     // 吸纳动画需要敌人列表，由Level层调用performAbsorbAnimation
 }
 
@@ -156,37 +158,37 @@ void BossFight::connectTeacherBossSignals(TeacherBoss* boss) {
     // 设置场景引用
     boss->setScene(m_scene);
 
-    qDebug() << "[BossFight] TeacherBoss信号已连接";
+    qCDebug(lcBoss) << "[BossFight] TeacherBoss信号已连接";
 }
 
 void BossFight::onTeacherBossRequestDialog(const QStringList& dialogs, const QString& background) {
-    qDebug() << "[BossFight] TeacherBoss请求显示对话";
+    qCDebug(lcBoss) << "[BossFight] TeacherBoss请求显示对话";
     emit requestShowDialog(dialogs, true, background);
 }
 
 void BossFight::onTeacherBossRequestChangeBackground(const QString& backgroundPath) {
-    qDebug() << "[BossFight] TeacherBoss请求切换背景:" << backgroundPath;
+    qCDebug(lcBoss) << "[BossFight] TeacherBoss请求切换背景:" << backgroundPath;
     changeBackground(backgroundPath);
 }
 
 void BossFight::onTeacherBossRequestTransitionText(const QString& text) {
-    qDebug() << "[BossFight] TeacherBoss请求显示文字:" << text;
+    qCDebug(lcBoss) << "[BossFight] TeacherBoss请求显示文字:" << text;
     showPhaseTransitionText(text);
 }
 
 void BossFight::onTeacherBossRequestFadeBackground(const QString& backgroundPath, int duration) {
-    qDebug() << "[BossFight] TeacherBoss请求渐变背景:" << backgroundPath << "持续" << duration << "ms";
+    qCDebug(lcBoss) << "[BossFight] TeacherBoss请求渐变背景:" << backgroundPath << "持续" << duration << "ms";
     emit requestFadeBackground(backgroundPath, duration);
 }
 
 void BossFight::onTeacherBossRequestFadeDialogBackground(const QString& backgroundPath, int duration) {
-    qDebug() << "[BossFight] TeacherBoss请求渐变对话背景:" << backgroundPath << "持续" << duration << "ms";
+    qCDebug(lcBoss) << "[BossFight] TeacherBoss请求渐变对话背景:" << backgroundPath << "持续" << duration << "ms";
     m_pendingFadeDialogBackground = backgroundPath;
     m_pendingFadeDialogDuration = duration;
 }
 
 void BossFight::onTeacherBossRequestDialogBackgroundChange(int dialogIndex, const QString& backgroundName) {
-    qDebug() << "[BossFight] TeacherBoss请求在对话索引" << dialogIndex << "时切换背景到:" << backgroundName;
+    qCDebug(lcBoss) << "[BossFight] TeacherBoss请求在对话索引" << dialogIndex << "时切换背景到:" << backgroundName;
     m_pendingDialogBackgrounds[dialogIndex] = backgroundName;
     emit dialogBackgroundChangeRequested(dialogIndex, backgroundName);
 }
@@ -201,7 +203,7 @@ void BossFight::changeBackground(const QString& backgroundPath) {
     if (!bg.isNull()) {
         m_backgroundItem->setPixmap(bg.scaled(800, 600, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
         m_currentBackgroundPath = backgroundPath;
-        qDebug() << "[BossFight] 背景已切换为:" << backgroundPath;
+        qCDebug(lcBoss) << "[BossFight] 背景已切换为:" << backgroundPath;
     } else {
         qWarning() << "[BossFight] 无法加载背景图片:" << backgroundPath;
     }
@@ -223,7 +225,7 @@ void BossFight::showPhaseTransitionText(const QString& text, const QColor& color
     // 此方法在Level中实现，这里只是接口
     Q_UNUSED(text)
     Q_UNUSED(color)
-    qDebug() << "[BossFight] 显示阶段转换文字:" << text;
+    qCDebug(lcBoss) << "[BossFight] 显示阶段转换文字:" << text;
 }
 
 void BossFight::pauseAllEnemyTimers(const QVector<QPointer<Enemy>>& enemies) {
@@ -254,11 +256,8 @@ void BossFight::performAbsorbAnimation(WashMachineBoss* boss, const QVector<QPoi
     m_absorbCenter = boss->pos() + QPointF(boss->pixmap().width() / 2.0, boss->pixmap().height() / 2.0);
 
     // 清理场景中所有子弹
-    QList<QGraphicsItem*> allItems = m_scene->items();
-    for (QGraphicsItem* item : allItems) {
-        if (Projectile* proj = dynamic_cast<Projectile*>(item)) {
-            proj->destroy();
-        }
+    for (Projectile* proj : EntityRegistry::instance().inScene<Projectile>(EntityKind::Projectile, m_scene)) {
+        proj->destroy();
     }
 
     // 收集需要被吸纳的实体
@@ -275,7 +274,7 @@ void BossFight::performAbsorbAnimation(WashMachineBoss* boss, const QVector<QPoi
     m_player->setCanMove(false);
     m_player->setCanShoot(false);
     m_player->setPermanentInvincible(true);
-    qDebug() << "[BossFight] 玩家已设置为无敌状态";
+    qCDebug(lcBoss) << "[BossFight] 玩家已设置为无敌状态";
 
     // 添加所有敌人（除了Boss）
     for (const QPointer<Enemy>& enemyPtr : enemies) {
@@ -301,12 +300,12 @@ void BossFight::performAbsorbAnimation(WashMachineBoss* boss, const QVector<QPoi
 
     // 创建动画定时器
     if (!m_absorbAnimationTimer) {
-        m_absorbAnimationTimer = new QTimer(this);
-        connect(m_absorbAnimationTimer, &QTimer::timeout, this, &BossFight::onAbsorbAnimationStep);
+        m_absorbAnimationTimer = new GameTimer(this);
+        connect(m_absorbAnimationTimer, &GameTimer::timeout, this, &BossFight::onAbsorbAnimationStep);
     }
     m_absorbAnimationTimer->start(16);  // ~60fps
 
-    qDebug() << "[BossFight] 吸纳动画开始，共" << m_absorbingItems.size() << "个实体";
+    qCDebug(lcBoss) << "[BossFight] 吸纳动画开始，共" << m_absorbingItems.size() << "个实体";
 }
 
 void BossFight::onAbsorbAnimationStep() {
@@ -327,11 +326,8 @@ void BossFight::onAbsorbAnimationStep() {
 
         // 清理子弹
         if (m_scene) {
-            QList<QGraphicsItem*> allItems = m_scene->items();
-            for (QGraphicsItem* item : allItems) {
-                if (Projectile* proj = dynamic_cast<Projectile*>(item)) {
-                    proj->destroy();
-                }
+            for (Projectile* proj : EntityRegistry::instance().inScene<Projectile>(EntityKind::Projectile, m_scene)) {
+                proj->destroy();
             }
         }
 
@@ -343,15 +339,12 @@ void BossFight::onAbsorbAnimationStep() {
 
             item->setVisible(false);
 
-            if (item != m_player) {
-                Enemy* enemy = dynamic_cast<Enemy*>(item);
-                if (enemy) {
-                    enemy->pauseTimers();
-                }
+            if (item != m_player && isEntityKind(item, EntityKind::Enemy)) {
+                static_cast<Enemy*>(item)->pauseTimers();
             }
         }
 
-        qDebug() << "[BossFight] 吸纳动画完成";
+        qCDebug(lcBoss) << "[BossFight] 吸纳动画完成";
         emit absorbAnimationCompleted();
         return;
     }
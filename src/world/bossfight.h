@@ -11,6 +11,7 @@
 #include <QStringList>
 #include <QTimer>
 #include <QVector>
+#include "../core/gametimer.h"
 
 class Boss;
 class NightmareBoss;
@@ -208,7 +209,7 @@ class BossFight : public QObject {
 
     // 吸纳动画相关
     bool m_isAbsorbAnimationActive = false;
-    QTimer* m_absorbAnimationTimer = nullptr;
+    GameTimer* m_absorbAnimationTimer = nullptr;
     QVector<QGraphicsItem*> m_absorbingItems;
     QVector<QPointF> m_absorbStartPositions;
     QVector<double> m_absorbAngles;
@@ -0,0 +1,306 @@
+#include "bulletpattern.h"
+#include <QDebug>
+#include <QGraphicsScene>
+#include <QRandomGenerator>
+#include <QtMath>
+#include "../core/configmanager.h"
+#include "../core/gameclock.h"
+#include "../entities/projectile.h"
+#include "projectilepool.h"
+
+namespace {
+    BulletPattern::Type typeFromName(const QString &name, bool *ok) {
+        *ok = true;
+        if (name == "ring")
+            return BulletPattern::Ring;
+        if (name == "spread")
+            return BulletPattern::Spread;
+        if (name == "aimed")
+            return BulletPattern::Aimed;
+        if (name == "split")
+            return BulletPattern::Split;
+        if (name == "normal_fan")
+            return BulletPattern::NormalFan;
+        *ok = false;
+        return BulletPattern::Aimed;
+    }
+
+    // Box-Muller 变换生成标准正态分布随机数（成对生成，保留一个备用）
+    double standardNormal() {
+        static bool hasSpare = false;
+        static double spare;
+
+        if (hasSpare) {
+            hasSpare = false;
+            return spare;
+        }
+
+        hasSpare = true;
+        double u, v, s;
+        do {
+            u = QRandomGenerator::global()->generateDouble() * 2.0 - 1.0;
+            v = QRandomGenerator::global()->generateDouble() * 2.0 - 1.0;
+            s = u * u + v * v;
+        } while (s >= 1.0 || s == 0.0);
+
+        s = qSqrt(-2.0 * qLn(s) / s);
+        spare = v * s;
+        return u * s;
+    }
+}
+
+// ==================== BulletPattern ====================
+
+BulletPattern BulletPattern::ring(int count, double speed, double damage, bool randomRotation) {
+    BulletPattern p;
+    p.type = Ring;
+    p.count = count;
+    p.speed = speed;
+    p.damage = damage;
+    p.randomRotation = randomRotation;
+    return p;
+}
+
+BulletPattern BulletPattern::spreadFan(int count, double halfAngleDeg, double speed, double damage) {
+    BulletPattern p;
+    p.type = Spread;
+    p.count = count;
+    p.spread = halfAngleDeg;
+    p.speed = speed;
+    p.damage = damage;
+    return p;
+}
+
+BulletPattern BulletPattern::aimed(double speed, double damage) {
+    BulletPattern p;
+    p.type = Aimed;
+    p.speed = speed;
+    p.damage = damage;
+    return p;
+}
+
+BulletPattern BulletPattern::normalFan(int count, double stddevDeg, double speed, double damage) {
+    BulletPattern p;
+    p.type = NormalFan;
+    p.count = count;
+    p.spread = stddevDeg;
+    p.speed = speed;
+    p.damage = damage;
+    return p;
+}
+
+BulletPattern BulletPattern::split(double speed, double damage, double splitAt, const BulletPattern &child) {
+    BulletPattern p;
+    p.type = Split;
+    p.speed = speed;
+    p.damage = damage;
+    p.splitAt = splitAt;
+    p.child.push_back(child);
+    return p;
+}
+
+BulletPattern BulletPattern::fromJson(const QJsonObject &json, const BulletPattern &defaults) {
+    BulletPattern p = defaults;
+    if (json.isEmpty())
+        return p;
+
+    if (json.contains("type")) {
+        bool ok = false;
+        const QString name = json.value("type").toString();
+        const Type type = typeFromName(name, &ok);
+        if (ok) {
+            p.type = type;
+        } else {
+            qWarning() << "BulletPattern: 未知的弹幕类型" << name << "，使用默认类型";
+        }
+    }
+    p.count = qBound(1, json.value("count").toInt(p.count), BulletPatternEngine::kMaxCount);
+    p.spread = json.value("spread").toDouble(p.spread);
+    p.speed = json.value("speed").toDouble(p.speed);
+    p.damage = json.value("damage").toDouble(p.damage);
+    p.size = qMax(0, json.value("size").toInt(p.size));
+    p.randomRotation = json.value("random_rotation").toBool(p.randomRotation);
+    p.splitAt = json.value("split_at").toDouble(p.splitAt);
+
+    if (json.contains("child")) {
+        const BulletPattern childDefaults = p.child.empty() ? BulletPattern() : p.child.front();
+        p.child.assign(1, fromJson(json.value("child").toObject(), childDefaults));
+    }
+    if (p.type == Split && p.child.empty()) {
+        qWarning() << "BulletPattern: split 弹幕缺少 child，母弹不会分裂";
+    }
+    return p;
+}
+
+// ==================== BulletPatternEngine ====================
+
+BulletPatternEngine &BulletPatternEngine::instance() {
+    static BulletPatternEngine instance;
+    return instance;
+}
+
+BulletPatternEngine::BulletPatternEngine() {
+    m_unit.resize(kAngleSteps);
+    for (int i = 0; i < kAngleSteps; ++i) {
+        const double angle = 2.0 * M_PI * i / kAngleSteps;
+        m_unit[i] = QPointF(qCos(angle), qSin(angle));
+    }
+}
+
+QPointF BulletPatternEngine::unitAt(double angle) const {
+    const double steps = angle * (kAngleSteps / (2.0 * M_PI));
+    int index = qRound(steps) % kAngleSteps;
+    if (index < 0)
+        index += kAngleSteps;
+    return m_unit[index];
+}
+
+const QVector<QPointF> &BulletPatternEngine::table(BulletPattern::Type type, int count, double spread) {
+    // 键：类型 | 数量 | 角度（千分之一度）
+    const auto spreadKey = static_cast<quint32>(qRound(qAbs(spread) * 1000.0));
+    const quint64 key = (quint64(type) << 56) | (quint64(count) << 32) | spreadKey;
+    auto it = m_tables.find(key);
+    if (it != m_tables.end())
+        return *it;
+
+    QVector<QPointF> dirs(count);
+    const double halfAngle = qDegreesToRadians(spread);
+    for (int i = 0; i < count; ++i) {
+        double angle = 0.0;
+        if (type == BulletPattern::Ring) {
+            angle = 2.0 * M_PI * i / count;
+        } else if (type == BulletPattern::Spread && count > 1) {
+            angle = -halfAngle + 2.0 * halfAngle * i / (count - 1);
+        }
+        dirs[i] = QPointF(qCos(angle), qSin(angle));
+    }
+    return *m_tables.insert(key, dirs);
+}
+
+const QVector<QPointF> &BulletPatternEngine::directions(const BulletPattern &pattern, double aimAngle) {
+    const int count = pattern.type == BulletPattern::Split ? 1 : qBound(0, pattern.count, kMaxCount);
+    m_batch.resize(count);
+    if (count == 0)
+        return m_batch;
+
+    if (pattern.type == BulletPattern::NormalFan) {
+        // 每发角度独立采样，查表取单位向量
+        const double stddev = qDegreesToRadians(pattern.spread);
+        for (int i = 0; i < count; ++i) {
+            m_batch[i] = unitAt(aimAngle + standardNormal() * stddev);
+        }
+        return m_batch;
+    }
+
+    if (pattern.type == BulletPattern::Ring && pattern.randomRotation) {
+        aimAngle += QRandomGenerator::global()->generateDouble() * 2.0 * M_PI;
+    }
+
+    // 整张相对方向表绕基准方向旋转
+    const BulletPattern::Type tableType = pattern.type == BulletPattern::Split ? BulletPattern::Aimed : pattern.type;
+    const QVector<QPointF> &relative = table(tableType, count, pattern.spread);
+    const QPointF base = unitAt(aimAngle);
+    const double c = base.x();
+    const double s = base.y();
+    for (int i = 0; i < count; ++i) {
+        const QPointF &r = relative[i];
+        m_batch[i] = QPointF(c * r.x() - s * r.y(), s * r.x() + c * r.y());
+    }
+    return m_batch;
+}
+
+QPixmap BulletPatternEngine::sprite(const QPixmap &source, int size) {
+    if (size <= 0 || source.isNull())
+        return source;
+
+    const QPair<qint64, int> key(source.cacheKey(), size);
+    auto it = m_sprites.find(key);
+    if (it != m_sprites.end())
+        return *it;
+    return *m_sprites.insert(key, source.scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+}
+
+BulletPattern BulletPatternEngine::pattern(const QString &owner, const QString &name, const BulletPattern &defaults) {
+    const QString key = owner + '/' + name;
+    auto it = m_patterns.constFind(key);
+    if (it != m_patterns.constEnd())
+        return *it;
+
+    const BulletPattern parsed = BulletPattern::fromJson(ConfigManager::instance().getBossPattern(owner, name), defaults);
+    m_patterns.insert(key, parsed);
+    return parsed;
+}
+
+int BulletPatternEngine::fire(QGraphicsScene *scene, const BulletPattern &pattern, const QPointF &origin,
+                              double aimAngle, const QPixmap &sprite, double targetDistance) {
+    if (!scene)
+        return 0;
+
+    const QPixmap bulletPixmap = this->sprite(sprite, pattern.size);
+    const QVector<QPointF> &dirs = directions(pattern, aimAngle);
+    const double step = pattern.speed * 10.0;  // Projectile::setDir 的单位为速度 ×10
+
+    ProjectilePool &pool = ProjectilePool::instance();
+    for (const QPointF &dir : dirs) {
+        Projectile *bullet = pool.acquire(1, pattern.damage, origin, bulletPixmap);
+        bullet->setDir(static_cast<int>(dir.x() * step), static_cast<int>(dir.y() * step));
+        scene->addItem(bullet);
+
+        if (pattern.type == BulletPattern::Split && !pattern.child.empty()) {
+            const double splitDist = targetDistance * pattern.splitAt;
+            PendingSplit split;
+            split.bullet = bullet;
+            split.generation = bullet->generation();
+            split.start = origin;
+            split.splitDistSq = splitDist * splitDist;
+            split.angle = aimAngle;
+            split.child = pattern.child.front();
+            split.sprite = sprite;
+            split.scene = scene;
+            m_splits.append(split);
+        }
+    }
+
+    if (!m_splits.isEmpty() && !m_tickConnection) {
+        m_tickConnection = QObject::connect(&GameClock::instance(), &GameClock::tick, &GameClock::instance(),
+                                            [](int) { BulletPatternEngine::instance().updateSplits(); });
+    }
+    return dirs.size();
+}
+
+void BulletPatternEngine::updateSplits() {
+    if (m_splits.isEmpty())
+        return;
+
+    // 先取出到达分裂距离的母弹，再统一发射（子弹幕本身也可能是分裂弹）
+    QVector<PendingSplit> ready;
+    for (int i = m_splits.size() - 1; i >= 0; --i) {
+        PendingSplit &split = m_splits[i];
+        Projectile *bullet = split.bullet.data();
+        const bool alive = bullet && split.scene && !bullet->isDestroyed() &&
+                           bullet->generation() == split.generation && bullet->scene() == split.scene;
+        if (!alive) {
+            m_splits.removeAt(i);
+            continue;
+        }
+
+        const QPointF offset = bullet->pos() - split.start;
+        if (offset.x() * offset.x() + offset.y() * offset.y() >= split.splitDistSq) {
+            ready.append(split);
+            m_splits.removeAt(i);
+        }
+    }
+
+    for (const PendingSplit &split : ready) {
+        Projectile *bullet = split.bullet.data();
+        const QPointF splitPos = bullet->pos();
+        bullet->destroy();
+        fire(split.scene, split.child, splitPos, split.angle, split.sprite);
+    }
+}
+
+void BulletPatternEngine::clear() {
+    m_patterns.clear();
+    m_sprites.clear();
+    m_splits.clear();
+}
@@ -0,0 +1,149 @@
+#ifndef BULLETPATTERN_H
+#define BULLETPATTERN_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QMetaObject>
+#include <QPair>
+#include <QPixmap>
+#include <QPointF>
+#include <QPointer>
+#include <QString>
+#include <QVector>
+#include <vector>
+
+class Projectile;
+class QGraphicsScene;
+
+/**
+ * @brief 弹幕描述 - 一次发射的形状、数量、速度和伤害
+ *
+ * 由 config.json 中 bosses.<boss>.patterns.<name> 描述，字段缺省时取代码给出的默认值：
+ *   type：ring（环形均匀分布）、spread（扇形均匀分布）、aimed（朝基准方向）、
+ *         split（母弹飞行一段距离后分裂为 child）、normal_fan（角度服从正态分布的扇形）
+ *   count、spread（度：spread 为扇形半角，normal_fan 为标准差）、speed、damage、
+ *   size（子弹图片边长，0 为原图）、random_rotation（ring 随机起始角）、
+ *   split_at（split 在发射时目标距离的该比例处分裂）、child（split 分裂出的弹幕）
+ */
+struct BulletPattern {
+    enum Type {
+        Ring,
+        Spread,
+        Aimed,
+        Split,
+        NormalFan
+    };
+
+    Type type = Aimed;
+    int count = 1;
+    double spread = 0.0;
+    double speed = 1.0;
+    double damage = 1.0;
+    int size = 0;
+    bool randomRotation = false;
+    double splitAt = 2.0 / 3.0;
+    std::vector<BulletPattern> child;  // split 的子弹幕（0 或 1 个）
+
+    static BulletPattern ring(int count, double speed, double damage, bool randomRotation = false);
+
+    static BulletPattern spreadFan(int count, double halfAngleDeg, double speed, double damage);
+
+    static BulletPattern aimed(double speed, double damage);
+
+    static BulletPattern normalFan(int count, double stddevDeg, double speed, double damage);
+
+    static BulletPattern split(double speed, double damage, double splitAt, const BulletPattern &child);
+
+    /**
+     * @brief 用 JSON 中出现的字段覆盖 defaults
+     */
+    static BulletPattern fromJson(const QJsonObject &json, const BulletPattern &defaults);
+};
+
+/**
+ * @brief 弹幕引擎 - 按 BulletPattern 成批发射子弹
+ *
+ * 每种 (类型, 数量, 角度) 的相对方向表只计算一次并缓存，发射时用一次查表得到的
+ * 基准方向旋转整张表，不再逐发调用三角函数；任意角度（正态扇形）查 kAngleSteps 格的单位向量表。
+ * 敌方子弹从 ProjectilePool 取出，缩放后的子弹图片按 (原图, 边长) 缓存，
+ * 64 发的环形弹幕也只是一次 fire() 调用。
+ * 分裂弹由引擎统一跟踪，随 GameClock::tick 检查飞行距离，不再为每发母弹创建轮询定时器。
+ */
+class BulletPatternEngine {
+public:
+    static BulletPatternEngine &instance();
+
+    static constexpr int kAngleSteps = 1024;  // 单位向量表的角度分辨率（约 0.35°）
+    static constexpr int kMaxCount = 256;     // 单次发射的子弹上限
+
+    /**
+     * @brief 读取 bosses.<owner>.patterns.<name>（首次读取后缓存，clear() 后重新读取）
+     */
+    BulletPattern pattern(const QString &owner, const QString &name, const BulletPattern &defaults);
+
+    /**
+     * @brief 发射一组敌方子弹
+     * @param origin 子弹位置（与 Projectile 相同，为图片左上角）
+     * @param aimAngle 基准方向（弧度）：aimed/spread/split/normal_fan 以它为中心，ring 以它为起始角
+     * @param sprite 子弹原图，按 pattern.size 缩放
+     * @param targetDistance 发射时到目标的距离，split 据此计算分裂距离
+     * @return 发射的子弹数
+     */
+    int fire(QGraphicsScene *scene, const BulletPattern &pattern, const QPointF &origin, double aimAngle,
+             const QPixmap &sprite, double targetDistance = 0.0);
+
+    /**
+     * @brief 计算一次发射的单位方向（供毒气团等非 Projectile 子弹使用）
+     * @return 引擎内部缓冲，下次调用前有效
+     */
+    const QVector<QPointF> &directions(const BulletPattern &pattern, double aimAngle);
+
+    /**
+     * @brief 按边长缩放子弹图片（保持宽高比），结果按 (原图, 边长) 缓存
+     */
+    QPixmap sprite(const QPixmap &source, int size);
+
+    [[nodiscard]] int pendingSplits() const { return m_splits.size(); }
+
+    /**
+     * @brief 丢弃弹幕缓存、图片缓存和未分裂的母弹记录（重新开始游戏时调用）
+     */
+    void clear();
+
+private:
+    BulletPatternEngine();
+
+    BulletPatternEngine(const BulletPatternEngine &) = delete;
+
+    BulletPatternEngine &operator=(const BulletPatternEngine &) = delete;
+
+    struct PendingSplit {
+        QPointer<Projectile> bullet;
+        quint32 generation = 0;  // 母弹被回收复用后不再分裂
+        QPointF start;
+        double splitDistSq = 0.0;
+        double angle = 0.0;
+        BulletPattern child;
+        QPixmap sprite;
+        QPointer<QGraphicsScene> scene;
+    };
+
+    // 任意角度的单位向量（查表）
+    [[nodiscard]] QPointF unitAt(double angle) const;
+
+    // 以 0 弧度为基准的相对方向表（ring/spread/aimed）
+    const QVector<QPointF> &table(BulletPattern::Type type, int count, double spread);
+
+    // 检查分裂弹的飞行距离（连接到 GameClock::tick）
+    void updateSplits();
+
+    QVector<QPointF> m_unit;  // kAngleSteps 个单位向量
+    QHash<quint64, QVector<QPointF>> m_tables;
+    QHash<QString, BulletPattern> m_patterns;
+    QHash<QPair<qint64, int>, QPixmap> m_sprites;
+    QVector<QPointF> m_batch;
+    QVector<PendingSplit> m_splits;
+    QMetaObject::Connection m_tickConnection;
+};
+
+#endif // BULLETPATTERN_H
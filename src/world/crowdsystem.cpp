@@ -0,0 +1,179 @@
+#include "crowdsystem.h"
+#include <QtMath>
+#include "../constants.h"
+#include "../core/gameclock.h"
+#include "../entities/enemy.h"
+#include "entityregistry.h"
+
+CrowdSystem &CrowdSystem::instance() {
+    static CrowdSystem instance;
+    return instance;
+}
+
+void CrowdSystem::ensureTicking() {
+    if (!m_tickConnection) {
+        m_tickConnection = QObject::connect(&GameClock::instance(), &GameClock::tick, &GameClock::instance(),
+                                            [](int) { CrowdSystem::instance().update(); });
+    }
+}
+
+void CrowdSystem::forget(Enemy *enemy) {
+    const int slot = enemy ? enemy->m_crowdSlot : -1;
+    if (slot >= 0 && slot < m_enemies.size() && m_enemies[slot] == enemy) {
+        m_enemies[slot] = nullptr;
+    }
+}
+
+int CrowdSystem::cellCoord(float v, int count) const {
+    return qBound(0, static_cast<int>(v) / kCellSize, count - 1);
+}
+
+void CrowdSystem::update() {
+    gather();
+    buildGrid();
+    separate();
+}
+
+void CrowdSystem::gather() {
+    m_enemies.clear();
+    m_cx.clear();
+    m_cy.clear();
+    m_radius.clear();
+    m_rects.clear();
+    m_separates.clear();
+    m_maxRadius = 0.0f;
+    m_maxHalfExtent = 0.0f;
+
+    for (QGraphicsItem *item : EntityRegistry::instance().items(EntityKind::Enemy)) {
+        Enemy *enemy = static_cast<Enemy *>(item);
+        enemy->m_crowdSlot = -1;
+        enemy->m_separationX = 0.0;
+        enemy->m_separationY = 0.0;
+        if (!enemy->scene())
+            continue;
+
+        const QRectF rect = enemy->sceneBoundingRect();
+        const float halfW = static_cast<float>(rect.width()) * 0.5f;
+        const float halfH = static_cast<float>(rect.height()) * 0.5f;
+        const float radius = qMin(halfW, halfH) * 2.0f * kRadiusScale;
+
+        enemy->m_crowdSlot = m_enemies.size();
+        m_enemies.append(enemy);
+        m_cx.append(static_cast<float>(rect.center().x()));
+        m_cy.append(static_cast<float>(rect.center().y()));
+        m_radius.append(radius);
+        m_rects.append(rect);
+        m_separates.append(enemy->m_aiEnabled && !enemy->m_isPaused && enemy->m_movePattern != Enemy::MOVE_NONE);
+        m_maxRadius = qMax(m_maxRadius, radius);
+        m_maxHalfExtent = qMax(m_maxHalfExtent, qMax(halfW, halfH));
+    }
+}
+
+void CrowdSystem::buildGrid() {
+    m_cols = qMax(1, (scene_bound_x + kCellSize - 1) / kCellSize);
+    m_rows = qMax(1, (scene_bound_y + kCellSize - 1) / kCellSize);
+    const int cells = m_cols * m_rows;
+    const int count = m_enemies.size();
+
+    // 计数排序：统计每格数量 → 前缀和 → 放入
+    m_cellStart.fill(0, cells + 1);
+    m_cellOf.resize(count);
+    for (int i = 0; i < count; ++i) {
+        const int cell = cellCoord(m_cy[i], m_rows) * m_cols + cellCoord(m_cx[i], m_cols);
+        m_cellOf[i] = cell;
+        ++m_cellStart[cell + 1];
+    }
+    for (int c = 0; c < cells; ++c) {
+        m_cellStart[c + 1] += m_cellStart[c];
+    }
+    m_cellItems.resize(count);
+    QVector<int> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (int i = 0; i < count; ++i) {
+        m_cellItems[fill[m_cellOf[i]]++] = i;
+    }
+}
+
+void CrowdSystem::separate() {
+    const int count = m_enemies.size();
+    m_pushX.fill(0.0f, count);
+    m_pushY.fill(0.0f, count);
+
+    for (int i = 0; i < count; ++i) {
+        if (!m_separates[i])
+            continue;
+
+        // 查询范围覆盖可能与之重叠的最大邻居
+        const float reach = m_radius[i] + m_maxRadius;
+        const int col0 = cellCoord(m_cx[i] - reach, m_cols);
+        const int col1 = cellCoord(m_cx[i] + reach, m_cols);
+        const int row0 = cellCoord(m_cy[i] - reach, m_rows);
+        const int row1 = cellCoord(m_cy[i] + reach, m_rows);
+
+        float pushX = 0.0f;
+        float pushY = 0.0f;
+        for (int row = row0; row <= row1; ++row) {
+            const int rowBase = row * m_cols;
+            const int begin = m_cellStart[rowBase + col0];
+            const int end = m_cellStart[rowBase + col1 + 1];  // 同一行的相邻格在 m_cellItems 中连续
+            for (int k = begin; k < end; ++k) {
+                const int j = m_cellItems[k];
+                if (j == i || !m_separates[j])
+                    continue;
+
+                const float dx = m_cx[i] - m_cx[j];
+                const float dy = m_cy[i] - m_cy[j];
+                const float minDist = m_radius[i] + m_radius[j];
+                const float distSq = dx * dx + dy * dy;
+                if (distSq >= minDist * minDist)
+                    continue;
+
+                const float dist = qSqrt(distSq);
+                const float overlap = minDist - dist;
+                if (dist > 0.01f) {
+                    pushX += dx / dist * overlap;
+                    pushY += dy / dist * overlap;
+                } else {
+                    // 完全重合时按下标错开方向
+                    pushX += (i < j ? -overlap : overlap);
+                }
+            }
+        }
+        m_pushX[i] = pushX * kPushRate;
+        m_pushY[i] = pushY * kPushRate;
+    }
+
+    // 限制单步推开量后写回
+    for (int i = 0; i < count; ++i) {
+        const float len = qSqrt(m_pushX[i] * m_pushX[i] + m_pushY[i] * m_pushY[i]);
+        if (len <= 0.0f)
+            continue;
+        const float scale = len > kMaxPush ? kMaxPush / len : 1.0f;
+        m_enemies[i]->m_separationX = m_pushX[i] * scale;
+        m_enemies[i]->m_separationY = m_pushY[i] * scale;
+    }
+}
+
+QVector<Enemy *> CrowdSystem::overlapping(const Enemy *enemy) const {
+    QVector<Enemy *> result;
+    if (!enemy || !enemy->scene() || m_enemies.isEmpty() || m_cols == 0)
+        return result;
+
+    const QRectF rect = enemy->sceneBoundingRect();
+    // 网格按中心存放，查询范围向外扩展最大半宽
+    const int col0 = cellCoord(static_cast<float>(rect.left()) - m_maxHalfExtent, m_cols);
+    const int col1 = cellCoord(static_cast<float>(rect.right()) + m_maxHalfExtent, m_cols);
+    const int row0 = cellCoord(static_cast<float>(rect.top()) - m_maxHalfExtent, m_rows);
+    const int row1 = cellCoord(static_cast<float>(rect.bottom()) + m_maxHalfExtent, m_rows);
+
+    for (int row = row0; row <= row1; ++row) {
+        const int rowBase = row * m_cols;
+        for (int k = m_cellStart[rowBase + col0]; k < m_cellStart[rowBase + col1 + 1]; ++k) {
+            const int j = m_cellItems[k];
+            Enemy *other = m_enemies[j];
+            if (other && other != enemy && m_rects[j].intersects(rect)) {
+                result.append(other);
+            }
+        }
+    }
+    return result;
+}
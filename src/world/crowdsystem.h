@@ -0,0 +1,86 @@
+#ifndef CROWDSYSTEM_H
+#define CROWDSYSTEM_H
+
+#include <QMetaObject>
+#include <QRectF>
+#include <QVector>
+
+class Enemy;
+
+/**
+ * @brief 敌人群体分离 - 基于均匀网格的邻居查询
+ *
+ * 每个时钟节拍把场景中的敌人收集到结构数组（中心、半径、包围盒），
+ * 用计数排序按中心放入均匀网格，再为每个敌人只检查附近格子中的邻居，
+ * 重叠时沿连线方向累加推开量，写回敌人，由 Enemy::move 在移动步骤中叠加，
+ * 追击时不再叠成一团。
+ *
+ * 同一网格也提供"与某敌人包围盒重叠的敌人"查询，替代 collidingItems()：
+ * 只在少数候选上做像素级检测（概率论的接触判定）。
+ * 只有参与 AI 移动的敌人互相推开；静止的、自定义移动的敌人不推也不被推。
+ */
+class CrowdSystem {
+public:
+    static CrowdSystem &instance();
+
+    static constexpr int kCellSize = 64;
+    static constexpr float kRadiusScale = 0.35f;  // 半径 = 图像短边 × 比例（留出贴图的透明边）
+    static constexpr float kPushRate = 0.25f;     // 每个移动步推开重叠深度的比例
+    static constexpr float kMaxPush = 2.0f;       // 每个移动步最多推开的像素
+
+    /**
+     * @brief 开始随 GameClock::tick 更新（首个敌人创建时调用）
+     */
+    void ensureTicking();
+
+    /**
+     * @brief 敌人析构时调用，避免查询结果中出现已销毁的对象
+     */
+    void forget(Enemy *enemy);
+
+    /**
+     * @brief 包围盒与 enemy 当前包围盒重叠的其他敌人（基于最近一次网格，位置最多滞后一个节拍）
+     *
+     * 只做包围盒粗筛，精确判定由调用方完成。
+     */
+    [[nodiscard]] QVector<Enemy *> overlapping(const Enemy *enemy) const;
+
+private:
+    CrowdSystem() = default;
+
+    CrowdSystem(const CrowdSystem &) = delete;
+
+    CrowdSystem &operator=(const CrowdSystem &) = delete;
+
+    void update();
+
+    // 收集场景中的敌人到结构数组
+    void gather();
+
+    // 按中心所在格子计数排序
+    void buildGrid();
+
+    // 计算每个参与分离的敌人的推开量并写回
+    void separate();
+
+    [[nodiscard]] int cellCoord(float v, int count) const;
+
+    QVector<Enemy *> m_enemies;
+    QVector<float> m_cx;
+    QVector<float> m_cy;
+    QVector<float> m_radius;
+    QVector<QRectF> m_rects;
+    QVector<quint8> m_separates;
+    QVector<int> m_cellOf;
+    QVector<int> m_cellStart;  // 每格在 m_cellItems 中的起始位置（多一个结尾哨兵）
+    QVector<int> m_cellItems;
+    QVector<float> m_pushX;
+    QVector<float> m_pushY;
+    int m_cols = 0;
+    int m_rows = 0;
+    float m_maxRadius = 0.0f;
+    float m_maxHalfExtent = 0.0f;
+    QMetaObject::Connection m_tickConnection;
+};
+
+#endif // CROWDSYSTEM_H
@@ -1,41 +1,41 @@
 #include "door.h"
+#include "../core/logging.h"
 #include "../core/resourcefactory.h"
 #include "../core/configmanager.h"
+#include "../core/gameclock.h"
 #include <QDebug>
+#include <QMap>
 
 Door::Door(Direction dir, bool isBossDoor, QGraphicsItem *parent)
-        : QGraphicsPixmapItem(parent), m_direction(dir), m_state(Closed), m_isBossDoor(isBossDoor), m_currentFrame(0) {
-    loadImages();
-    setPixmap(m_closedImage);
+        : QGraphicsPixmapItem(parent), m_direction(dir), m_state(Closed), m_isBossDoor(isBossDoor),
+          m_frames(&sharedFrames(dir, isBossDoor)), m_frameElapsedMs(0), m_currentFrame(0) {
+    setPixmap(m_frames->closed);
     setZValue(50); // 确保门在其他物体之上
 
-    m_animationTimer = new QTimer(this);
-    connect(m_animationTimer, &QTimer::timeout, this, [this]() {
-        if (m_currentFrame < m_animationFrames.size()) {
-            setPixmap(m_animationFrames[m_currentFrame]);
-            m_currentFrame++;
-        } else {
-            m_animationTimer->stop();
-            setPixmap(m_openImage);
-            m_state = Open;
-            emit openingFinished();
-        }
-    });
-
     m_fadeAnimation = new QPropertyAnimation(this, "opacity");
 }
 
 Door::~Door() {
-    if (m_animationTimer) {
-        m_animationTimer->stop();
+    disconnect(m_tickConnection);
+}
+
+const Door::DoorFrames &Door::sharedFrames(Direction dir, bool isBossDoor) {
+    // 门图原图很大（最大2048x2048），按 方向+是否Boss门 缓存，整个进程只加载一次
+    static QMap<int, DoorFrames> cache;  // QMap 节点稳定，已返回的引用不会因插入而失效
+    const int key = static_cast<int>(dir) * 2 + (isBossDoor ? 1 : 0);
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+        it = cache.insert(key, loadFrames(dir, isBossDoor));
     }
+    return it.value();
 }
 
-void Door::loadImages() {
+Door::DoorFrames Door::loadFrames(Direction dir, bool isBossDoor) {
+    DoorFrames frames;
     try {
         // 根据门的方向加载对应的图片
         QString dirName;
-        switch (m_direction) {
+        switch (dir) {
             case Up:
                 dirName = "up";
                 break;
@@ -53,25 +53,9 @@ void Door::loadImages() {
         // 直接构建assets路径（不通过ConfigManager）
         QString basePath = "assets/door/" + dirName + "/";
 
-        // 加载原始图片
-        QString closedPath = basePath + QString("door_%1_closed.png").arg(dirName);
-        QPixmap originalClosed = ResourceFactory::loadImage(closedPath);
-
-        // 根据是否是boss门选择打开状态的图片
-        QString openPath;
-        if (m_isBossDoor) {
-            openPath = basePath + QString("door_%1_open_boss.png").arg(dirName);
-        } else {
-            openPath = basePath + QString("door_%1_open.png").arg(dirName);
-        }
-        QPixmap originalOpen = ResourceFactory::loadImage(openPath);
-
-        QString halfPath = basePath + QString("door_%1_openhalf.png").arg(dirName);
-        QPixmap originalHalf = ResourceFactory::loadImage(halfPath);
-
         // 根据方向确定缩放尺寸
         int targetWidth, targetHeight;
-        if (m_direction == Up || m_direction == Down) {
+        if (dir == Up || dir == Down) {
             // 上下门：横向门，宽度较大
             targetWidth = 120; // 门的宽度
             targetHeight = 80; // 门的高度
@@ -81,32 +65,39 @@ void Door::loadImages() {
             targetHeight = 120; // 门的高度
         }
 
-        // 缩放图片到合适尺寸
-        m_closedImage = originalClosed.scaled(targetWidth, targetHeight,
-                                              Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-        m_openImage = originalOpen.scaled(targetWidth, targetHeight,
-                                          Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-        QPixmap halfImage = originalHalf.scaled(targetWidth, targetHeight,
-                                                Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        // 根据是否是boss门选择打开状态的图片
+        QString closedPath = basePath + QString("door_%1_closed.png").arg(dirName);
+        QString openPath;
+        if (isBossDoor) {
+            openPath = basePath + QString("door_%1_open_boss.png").arg(dirName);
+        } else {
+            openPath = basePath + QString("door_%1_open.png").arg(dirName);
+        }
+        QString halfPath = basePath + QString("door_%1_openhalf.png").arg(dirName);
+
+        // 加载并缩放
+        frames.closed = ResourceFactory::loadImageScaled(closedPath, targetWidth, targetHeight, Qt::IgnoreAspectRatio);
+        frames.open = ResourceFactory::loadImageScaled(openPath, targetWidth, targetHeight, Qt::IgnoreAspectRatio);
+        QPixmap halfImage = ResourceFactory::loadImageScaled(halfPath, targetWidth, targetHeight, Qt::IgnoreAspectRatio);
 
         // 创建动画序列：关闭 -> 半开 -> 半开 -> 打开 -> 打开
-        m_animationFrames.clear();
-        m_animationFrames.append(m_closedImage); // 第1帧：关闭
-        m_animationFrames.append(halfImage);     // 第2帧：半开
-        m_animationFrames.append(halfImage);     // 第3帧：半开（停留）
-        m_animationFrames.append(m_openImage);   // 第4帧：打开
-        m_animationFrames.append(m_openImage);   // 第5帧：打开（停留）
-
-        qDebug() << "门图片加载完成:" << dirName << "方向，缩放至" << targetWidth << "x" << targetHeight 
-                 << (m_isBossDoor ? "（Boss门）" : "");
+        frames.animation.clear();
+        frames.animation.append(frames.closed); // 第1帧：关闭
+        frames.animation.append(halfImage);     // 第2帧：半开
+        frames.animation.append(halfImage);     // 第3帧：半开（停留）
+        frames.animation.append(frames.open);   // 第4帧：打开
+        frames.animation.append(frames.open);   // 第5帧：打开（停留）
+
+        qCDebug(lcRoom) << "门图片加载完成:" << dirName << "方向，缩放至" << targetWidth << "x" << targetHeight 
+                 << (isBossDoor ? "（Boss门）" : "");
     }
     catch (const QString &error) {
         qWarning() << "加载门图片失败:" << error;
         // 创建简单的占位图
-        m_closedImage = QPixmap(80, 80);
-        m_closedImage.fill(Qt::darkRed);
-        m_openImage = QPixmap(80, 80);
-        m_openImage.fill(m_isBossDoor ? Qt::darkMagenta : Qt::darkGreen);
+        frames.closed = QPixmap(80, 80);
+        frames.closed.fill(Qt::darkRed);
+        frames.open = QPixmap(80, 80);
+        frames.open.fill(isBossDoor ? Qt::darkMagenta : Qt::darkGreen);
 
         // 创建简单的动画帧
         for (int i = 0; i < 5; i++) {
@@ -114,9 +105,11 @@ void Door::loadImages() {
             int red = 255 - (i * 50);
             int green = (i * 50);
             frame.fill(QColor(red, green, 0));
-            m_animationFrames.append(frame);
+            frames.animation.append(frame);
         }
     }
+
+    return frames;
 }
 
 void Door::open() {
@@ -124,7 +117,7 @@ void Door::open() {
         return;
     }
 
-    qDebug() << "开始播放开门动画";
+    qCDebug(lcRoom) << "开始播放开门动画";
     m_state = Opening;
     playOpeningAnimation();
 }
@@ -135,17 +128,53 @@ void Door::setOpenState() {
         return;
     }
 
+    disconnect(m_tickConnection);
     m_state = Open;
-    setPixmap(m_openImage);
-    qDebug() << "门设置为打开状态（无动画）";
+    setPixmap(m_frames->open);
+    qCDebug(lcRoom) << "门设置为打开状态（无动画）";
+}
+
+void Door::setClosedState() {
+    if (m_state == Closed) {
+        return;
+    }
+
+    disconnect(m_tickConnection);
+    m_state = Closed;
+    m_currentFrame = 0;
+    m_frameElapsedMs = 0;
+    setPixmap(m_frames->closed);
+    qCDebug(lcRoom) << "门设置为关闭状态";
 }
 
 void Door::playOpeningAnimation() {
     m_currentFrame = 0;
+    m_frameElapsedMs = 0;
 
     // 使用逐帧动画，5帧动画总时长约400ms
-    // 每帧80ms，让开门动画流畅但不会太快
-    m_animationTimer->start(80);
+    // 每帧80ms，让开门动画流畅但不会太快；由全局游戏时钟推进，不再单独创建定时器
+    disconnect(m_tickConnection);
+    m_tickConnection = connect(&GameClock::instance(), &GameClock::tick, this, &Door::onTick);
+
+    qCDebug(lcRoom) << "开门动画启动，总帧数:" << m_frames->animation.size();
+}
 
-    qDebug() << "开门动画启动，总帧数:" << m_animationFrames.size();
+void Door::onTick(int dtMs) {
+    m_frameElapsedMs += dtMs;
+    while (m_state == Opening && m_frameElapsedMs >= kFrameIntervalMs) {
+        m_frameElapsedMs -= kFrameIntervalMs;
+        advanceFrame();
+    }
+}
+
+void Door::advanceFrame() {
+    if (m_currentFrame < m_frames->animation.size()) {
+        setPixmap(m_frames->animation[m_currentFrame]);
+        m_currentFrame++;
+    } else {
+        disconnect(m_tickConnection);
+        setPixmap(m_frames->open);
+        m_state = Open;
+        emit openingFinished();
+    }
 }
@@ -2,9 +2,9 @@
 #define DOOR_H
 
 #include <QGraphicsPixmapItem>
+#include <QList>
 #include <QObject>
 #include <QPropertyAnimation>
-#include <QTimer>
 
 class Door : public QObject, public QGraphicsPixmapItem {
 Q_OBJECT
@@ -30,6 +30,7 @@ public:
     void open();
 
     void setOpenState(); // 直接设置为打开状态（用于邻房间）
+    void setClosedState(); // 直接设置为关闭状态，中止开门动画（用于重试恢复房间快照）
     bool isOpen() const { return m_state == Open; }
 
     DoorState state() const { return m_state; }
@@ -38,20 +39,36 @@ public:
     
     bool isBossDoor() const { return m_isBossDoor; } // 是否是通往boss房的门
 
+    static constexpr int kFrameIntervalMs = 80;  // 开门动画每帧时长
+
 private:
-    void loadImages();
+    /**
+     * @brief 门的共享帧集 - 每种方向/变体只解码、缩放一次，所有门实例共用
+     */
+    struct DoorFrames {
+        QPixmap closed;
+        QPixmap open;
+        QList<QPixmap> animation; // 开门动画帧
+    };
+
+    static const DoorFrames &sharedFrames(Direction dir, bool isBossDoor);
+
+    static DoorFrames loadFrames(Direction dir, bool isBossDoor);
 
     void playOpeningAnimation();
 
+    void onTick(int dtMs);      // 由 GameClock 推进开门动画
+
+    void advanceFrame();
+
     Direction m_direction;
     DoorState m_state;
     bool m_isBossDoor;  // 是否是通往boss房间的门
 
-    QPixmap m_closedImage;
-    QPixmap m_openImage;
-    QList<QPixmap> m_animationFrames; // 开门动画帧
+    const DoorFrames *m_frames; // 指向共享帧集
 
-    QTimer *m_animationTimer;
+    QMetaObject::Connection m_tickConnection;
+    int m_frameElapsedMs;
     int m_currentFrame;
     QPropertyAnimation *m_fadeAnimation;
 
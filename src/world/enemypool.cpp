@@ -0,0 +1,44 @@
+#include "enemypool.h"
+#include <QGraphicsScene>
+#include "../entities/enemy.h"
+#include "../items/statuseffect.h"
+
+EnemyPool &EnemyPool::instance() {
+    static EnemyPool instance;
+    return instance;
+}
+
+bool EnemyPool::release(Enemy *enemy) {
+    if (!enemy || enemy->poolKey().isEmpty())
+        return false;
+
+    QVector<Enemy *> &idle = m_idle[enemy->poolKey()];
+    if (idle.contains(enemy))
+        return true;  // 同一帧内重复死亡
+    if (idle.size() >= kMaxIdlePerType)
+        return false;
+
+    // 停止所有定时器（包括子类自己的），清除闪烁和状态效果
+    enemy->pauseTimers();
+    enemy->cancelFlash();
+    EffectManager::instance().forget(enemy);
+    enemy->setPlayer(nullptr);
+
+    // 断开该敌人发出的所有信号，下次使用时由召唤方重新连接
+    QObject::disconnect(enemy, nullptr, nullptr, nullptr);
+
+    if (enemy->scene()) {
+        enemy->scene()->removeItem(enemy);
+    }
+
+    idle.append(enemy);
+    ObjectCensus::instance().setRetained(enemy, true);  // 空闲对象不计入房间清空检查点
+    return true;
+}
+
+void EnemyPool::clear() {
+    for (QVector<Enemy *> &idle : m_idle) {
+        qDeleteAll(idle);
+    }
+    m_idle.clear();
+}
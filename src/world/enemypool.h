@@ -0,0 +1,71 @@
+#ifndef ENEMYPOOL_H
+#define ENEMYPOOL_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include "../core/objectcensus.h"
+
+class Enemy;
+
+/**
+ * @brief 敌人对象池 - 按类型复用Boss召唤的小怪
+ *
+ * Boss阶段会成批召唤、成批击杀同一种小怪。死亡的池化敌人不再 deleteLater，
+ * 而是停止定时器、断开信号并移出场景后放回空闲列表；下次召唤同类型时
+ * 直接取出并 reset()，不再重新创建 QObject、定时器、缩放图片和碰撞掩码。
+ *
+ * 生命周期：acquire() 取出（或首次创建）→ 加入场景 → 死亡时 Enemy::retire()
+ * 调用 release() 回收 → 下次 acquire() 时 reset()。
+ * 空闲对象不在任何场景中，由 clear() 统一销毁（重新开始游戏时调用）。
+ */
+class EnemyPool {
+public:
+    static EnemyPool &instance();
+
+    static constexpr int kMaxIdlePerType = 32;  // 每种类型最多保留的空闲对象
+
+    /**
+     * @brief 取出一个指定类型的敌人
+     * @param key 池化类型键（如 "clock_boom"）
+     * @param create 空闲列表为空时调用的创建函数，返回 T*
+     * @return 已恢复初始状态、定时器运行中、尚未加入场景的敌人
+     */
+    template<typename T, typename Create>
+    T *acquire(const QString &key, Create &&create) {
+        QVector<Enemy *> &idle = m_idle[key];
+        if (!idle.isEmpty()) {
+            T *enemy = static_cast<T *>(idle.takeLast());
+            ObjectCensus::instance().setRetained(enemy, false);
+            enemy->reset();
+            return enemy;
+        }
+        T *enemy = create();
+        enemy->setPoolKey(key);
+        return enemy;
+    }
+
+    /**
+     * @brief 回收一个已死亡的敌人
+     * @return 已放回空闲列表时返回 true；未池化或空闲列表已满时返回 false，由调用方销毁
+     */
+    bool release(Enemy *enemy);
+
+    [[nodiscard]] int idleCount(const QString &key) const { return m_idle.value(key).size(); }
+
+    /**
+     * @brief 销毁所有空闲对象
+     */
+    void clear();
+
+private:
+    EnemyPool() = default;
+
+    EnemyPool(const EnemyPool &) = delete;
+
+    EnemyPool &operator=(const EnemyPool &) = delete;
+
+    QHash<QString, QVector<Enemy *>> m_idle;
+};
+
+#endif // ENEMYPOOL_H
@@ -0,0 +1,23 @@
+#include "entityregistry.h"
+
+EntityRegistry &EntityRegistry::instance() {
+    static EntityRegistry instance;
+    return instance;
+}
+
+void EntityRegistry::add(EntityKind kind, QGraphicsItem *item) {
+    if (!item)
+        return;
+    m_lists[static_cast<int>(kind)].append(item);
+}
+
+void EntityRegistry::remove(EntityKind kind, QGraphicsItem *item) {
+    QVector<QGraphicsItem *> &list = m_lists[static_cast<int>(kind)];
+    int index = list.lastIndexOf(item);
+    if (index < 0)
+        return;
+
+    // 顺序无关，与末尾交换后删除
+    list[index] = list.last();
+    list.removeLast();
+}
@@ -0,0 +1,84 @@
+#ifndef ENTITYREGISTRY_H
+#define ENTITYREGISTRY_H
+
+#include <QGraphicsItem>
+#include <QVector>
+#include <array>
+
+class QGraphicsScene;
+
+/**
+ * @brief 游戏对象种类（同时作为 QGraphicsItem::type() 的标签）
+ */
+enum class EntityKind {
+    Player,
+    Enemy,        // 所有敌人（含Boss）
+    Projectile,   // Projectile 及其子类
+    PoisonTrail,  // Walker 毒痕
+    ToxicGas,     // 洗衣机Boss毒气团
+    DroppedItem,  // 掉落物
+    KindCount
+};
+
+/**
+ * @brief 种类对应的图元类型值，供各类覆写 type() 使用
+ */
+constexpr int entityItemType(EntityKind kind) {
+    return QGraphicsItem::UserType + 1 + static_cast<int>(kind);
+}
+
+/**
+ * @brief 判断图元是否属于指定种类（替代 dynamic_cast）
+ */
+inline bool isEntityKind(const QGraphicsItem *item, EntityKind kind) {
+    return item && item->type() == entityItemType(kind);
+}
+
+/**
+ * @brief 实体注册表 - 按种类维护存活的游戏对象列表
+ *
+ * 各类在构造时注册、析构时注销。清理子弹、暂停、击杀小怪等逻辑
+ * 直接遍历对应种类的列表，不再扫描整个场景并逐个 dynamic_cast。
+ */
+class EntityRegistry {
+public:
+    static EntityRegistry &instance();
+
+    void add(EntityKind kind, QGraphicsItem *item);
+
+    void remove(EntityKind kind, QGraphicsItem *item);
+
+    /**
+     * @brief 获取某种类的所有存活对象（包括已移出场景、等待 deleteLater 的对象）
+     */
+    [[nodiscard]] const QVector<QGraphicsItem *> &items(EntityKind kind) const {
+        return m_lists[static_cast<int>(kind)];
+    }
+
+    /**
+     * @brief 获取某种类中位于指定场景内的对象快照
+     *
+     * 返回副本，遍历时销毁对象不会影响结果。
+     */
+    template<typename T>
+    [[nodiscard]] QVector<T *> inScene(EntityKind kind, const QGraphicsScene *scene) const {
+        QVector<T *> result;
+        for (QGraphicsItem *item : items(kind)) {
+            if (item->scene() == scene) {
+                result.append(static_cast<T *>(item));
+            }
+        }
+        return result;
+    }
+
+private:
+    EntityRegistry() = default;
+
+    EntityRegistry(const EntityRegistry &) = delete;
+
+    EntityRegistry &operator=(const EntityRegistry &) = delete;
+
+    std::array<QVector<QGraphicsItem *>, static_cast<int>(EntityKind::KindCount)> m_lists;
+};
+
+#endif // ENTITYREGISTRY_H
@@ -3,6 +3,7 @@
 #include "../entities/boss.h"
 
 // 各关卡Boss
+#include "../../core/logging.h"
 #include "../entities/level_1/nightmareboss.h"
 #include "../entities/level_2/washmachineboss.h"
 #include "../entities/level_3/teacherboss.h"
@@ -14,7 +15,7 @@ BossFactory& BossFactory::instance() {
 
 void BossFactory::registerBoss(int levelNumber, CreatorFunc creator) {
     m_creators[levelNumber] = creator;
-    qDebug() << "BossFactory: 注册关卡" << levelNumber << "的Boss";
+    qCDebug(lcBoss) << "BossFactory: 注册关卡" << levelNumber << "的Boss";
 }
 
 bool BossFactory::isRegistered(int levelNumber) const {
@@ -28,7 +29,7 @@ Boss* BossFactory::createBoss(int levelNumber, const QPixmap& pic, double scale,
     }
 
     // 未找到注册的Boss类型，返回默认Boss
-    qDebug() << "BossFactory: 关卡" << levelNumber << "未注册Boss，使用默认Boss";
+    qCDebug(lcBoss) << "BossFactory: 关卡" << levelNumber << "未注册Boss，使用默认Boss";
     return new Boss(pic, scale);
 }
 
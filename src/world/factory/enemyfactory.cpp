@@ -13,6 +13,7 @@
 #include "../entities/level_2/walker.h"
 
 // Level 3 敌人
+#include "../../core/logging.h"
 #include "../entities/level_3/digitalsystemenemy.h"
 #include "../entities/level_3/optimizationenemy.h"
 #include "../entities/level_3/probabilityenemy.h"
@@ -32,7 +33,7 @@ std::string EnemyFactory::makeKey(int levelNumber, const QString& enemyType) con
 void EnemyFactory::registerEnemy(int levelNumber, const QString& enemyType, CreatorFunc creator) {
     std::string key = makeKey(levelNumber, enemyType);
     m_creators[key] = creator;
-    qDebug() << "EnemyFactory: 注册敌人类型" << enemyType << "关卡" << levelNumber;
+    qCDebug(lcAssets) << "EnemyFactory: 注册敌人类型" << enemyType << "关卡" << levelNumber;
 }
 
 bool EnemyFactory::isRegistered(int levelNumber, const QString& enemyType) const {
@@ -49,7 +50,7 @@ Enemy* EnemyFactory::createEnemy(int levelNumber, const QString& enemyType, cons
     }
 
     // 未找到注册的类型，返回默认敌人
-    qDebug() << "EnemyFactory: 未知敌人类型，使用默认Enemy:" << enemyType << "关卡" << levelNumber;
+    qCDebug(lcAssets) << "EnemyFactory: 未知敌人类型，使用默认Enemy:" << enemyType << "关卡" << levelNumber;
     return new Enemy(pic, scale);
 }
 
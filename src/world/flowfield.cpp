@@ -0,0 +1,190 @@
+#include "flowfield.h"
+#include <QtMath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "../constants.h"
+
+namespace {
+    constexpr float kInfinity = std::numeric_limits<float>::infinity();
+    constexpr float kDiagonalCost = 1.41421356f;
+
+    // 8 个相邻方向，前 4 个为正交方向
+    constexpr int kNeighborCol[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    constexpr int kNeighborRow[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+}
+
+FlowField &FlowField::instance() {
+    static FlowField instance;
+    return instance;
+}
+
+void FlowField::ensureGrid() {
+    const int cols = qMax(1, (scene_bound_x + kCellSize - 1) / kCellSize);
+    const int rows = qMax(1, (scene_bound_y + kCellSize - 1) / kCellSize);
+    if (cols == m_cols && rows == m_rows)
+        return;
+
+    m_cols = cols;
+    m_rows = rows;
+    const int cells = cols * rows;
+    m_blocked.fill(false, cells);
+    m_distance.fill(kInfinity, cells);
+    m_dirX.fill(0.0f, cells);
+    m_dirY.fill(0.0f, cells);
+    m_targetCell = -1;
+    m_dirty = true;
+}
+
+int FlowField::cellAt(const QPointF &pos) const {
+    const int col = qBound(0, static_cast<int>(pos.x()) / kCellSize, m_cols - 1);
+    const int row = qBound(0, static_cast<int>(pos.y()) / kCellSize, m_rows - 1);
+    return row * m_cols + col;
+}
+
+bool FlowField::isOpen(int col, int row) const {
+    return col >= 0 && col < m_cols && row >= 0 && row < m_rows && !m_blocked[row * m_cols + col];
+}
+
+void FlowField::setTarget(const QPointF &pos) {
+    // 没有障碍时不建场（登记障碍会标记 m_dirty，下次设置目标时重建）
+    if (!m_hasObstacles)
+        return;
+    ensureGrid();
+    const int cell = cellAt(pos);
+    if (cell == m_targetCell && !m_dirty)
+        return;
+    m_targetCell = cell;
+    rebuild();
+}
+
+bool FlowField::direction(const QPointF &pos, double &dirX, double &dirY) const {
+    if (!m_hasObstacles || m_targetCell < 0 || m_dirty)
+        return false;
+
+    const int cell = cellAt(pos);
+    const float dist = m_distance[cell];
+    // 目标格及其相邻格直接朝目标移动，最后一段不受网格精度影响
+    if (dist <= 1.5f || dist == kInfinity)
+        return false;
+
+    dirX = m_dirX[cell];
+    dirY = m_dirY[cell];
+    return dirX != 0.0 || dirY != 0.0;
+}
+
+void FlowField::setBlocked(const QRectF &rect, bool blocked) {
+    ensureGrid();
+    const int left = qBound(0, static_cast<int>(rect.left()) / kCellSize, m_cols - 1);
+    const int right = qBound(0, static_cast<int>(rect.right()) / kCellSize, m_cols - 1);
+    const int top = qBound(0, static_cast<int>(rect.top()) / kCellSize, m_rows - 1);
+    const int bottom = qBound(0, static_cast<int>(rect.bottom()) / kCellSize, m_rows - 1);
+    for (int row = top; row <= bottom; ++row) {
+        for (int col = left; col <= right; ++col) {
+            m_blocked[row * m_cols + col] = blocked;
+        }
+    }
+    m_hasObstacles = m_blocked.contains(true);
+    m_dirty = true;
+}
+
+void FlowField::clearObstacles() {
+    ensureGrid();
+    if (!m_blocked.contains(true))
+        return;
+    m_blocked.fill(false);
+    m_hasObstacles = false;
+    m_dirty = true;
+}
+
+void FlowField::rebuild() {
+    ++m_rebuildCount;
+    m_dirty = false;
+    m_distance.fill(kInfinity);
+
+    // 从目标格出发的 Dijkstra，网格只有几百格，二叉堆足够
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+    m_distance[m_targetCell] = 0.0f;
+    open.push({0.0f, m_targetCell});
+
+    while (!open.empty()) {
+        const auto [dist, cell] = open.top();
+        open.pop();
+        if (dist > m_distance[cell])
+            continue;
+
+        const int col = cell % m_cols;
+        const int row = cell / m_cols;
+        for (int n = 0; n < 8; ++n) {
+            const int ncol = col + kNeighborCol[n];
+            const int nrow = row + kNeighborRow[n];
+            if (!isOpen(ncol, nrow))
+                continue;
+            // 斜向移动要求两侧正交格都可通行，避免贴着障碍角穿过
+            if (n >= 4 && (!isOpen(ncol, row) || !isOpen(col, nrow)))
+                continue;
+
+            const float next = dist + (n >= 4 ? kDiagonalCost : 1.0f);
+            const int ncell = nrow * m_cols + ncol;
+            if (next < m_distance[ncell]) {
+                m_distance[ncell] = next;
+                open.push({next, ncell});
+            }
+        }
+    }
+
+    computeDirections();
+}
+
+void FlowField::computeDirections() {
+    for (int row = 0; row < m_rows; ++row) {
+        for (int col = 0; col < m_cols; ++col) {
+            const int cell = row * m_cols + col;
+            m_dirX[cell] = 0.0f;
+            m_dirY[cell] = 0.0f;
+            const float here = m_distance[cell];
+            if (here == kInfinity || here == 0.0f)
+                continue;
+
+            // 中心差分求路程梯度（不可通行的一侧用本格路程代替）
+            auto at = [&](int c, int r) { return isOpen(c, r) ? m_distance[r * m_cols + c] : here; };
+            float gx = at(col - 1, row) - at(col + 1, row);
+            float gy = at(col, row - 1) - at(col, row + 1);
+
+            // 梯度指向的相邻格不可通行时，改为朝路程最小的相邻格
+            const int stepCol = gx > 0.0f ? 1 : (gx < 0.0f ? -1 : 0);
+            const int stepRow = gy > 0.0f ? 1 : (gy < 0.0f ? -1 : 0);
+            const bool blockedAhead = (stepCol || stepRow) &&
+                                      (!isOpen(col + stepCol, row + stepRow) ||
+                                       (stepCol && stepRow && (!isOpen(col + stepCol, row) || !isOpen(col, row + stepRow))));
+            if (blockedAhead || (gx == 0.0f && gy == 0.0f)) {
+                float best = here;
+                gx = 0.0f;
+                gy = 0.0f;
+                for (int n = 0; n < 8; ++n) {
+                    const int ncol = col + kNeighborCol[n];
+                    const int nrow = row + kNeighborRow[n];
+                    if (!isOpen(ncol, nrow))
+                        continue;
+                    if (n >= 4 && (!isOpen(ncol, row) || !isOpen(col, nrow)))
+                        continue;
+                    const float d = m_distance[nrow * m_cols + ncol];
+                    if (d < best) {
+                        best = d;
+                        gx = static_cast<float>(kNeighborCol[n]);
+                        gy = static_cast<float>(kNeighborRow[n]);
+                    }
+                }
+            }
+
+            const float length = qSqrt(gx * gx + gy * gy);
+            if (length > 0.0f) {
+                m_dirX[cell] = gx / length;
+                m_dirY[cell] = gy / length;
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+/**
+ * @brief 流场寻路 - 所有追击敌人共享的朝向玩家的方向场
+ *
+ * 把房间划分为 kCellSize 的网格，从玩家所在格子出发做一次 Dijkstra（8 邻接，禁止斜穿障碍角），
+ * 得到每格到玩家的路程，再按路程的梯度为每格存一个单位方向向量。
+ * 只有玩家跨入新格子（或障碍变化）时才重建，代价为 O(格子数)，与敌人数量无关；
+ * 敌人移动时只需按自身位置查表，房间加入障碍后也不需要为每个敌人做 A*。
+ * 没有通过 setBlocked() 登记障碍时不建场，direction() 返回 false，敌人直接朝玩家移动
+ * （空旷房间里网格方向只会把朝向量化到少数几个角度）。
+ *
+ * 网格坐标与敌人、玩家的 pos()（图元左上角）一致。
+ */
+class FlowField {
+public:
+    static FlowField &instance();
+
+    static constexpr int kCellSize = 40;
+
+    /**
+     * @brief 设置目标（玩家）位置，所在格子变化时重建方向场
+     */
+    void setTarget(const QPointF &pos);
+
+    /**
+     * @brief 查询某位置朝向目标的方向
+     * @param dirX,dirY 输出单位方向向量
+     * @return 没有障碍、位置在目标格附近（应直接朝目标移动）、不可达或在障碍内时返回 false
+     */
+    bool direction(const QPointF &pos, double &dirX, double &dirY) const;
+
+    /**
+     * @brief 标记/取消障碍区域（与矩形相交的格子均视为障碍）
+     */
+    void setBlocked(const QRectF &rect, bool blocked);
+
+    /**
+     * @brief 清除所有障碍（切换房间时调用）
+     */
+    void clearObstacles();
+
+    [[nodiscard]] bool hasObstacles() const { return m_hasObstacles; }
+
+    [[nodiscard]] int rebuildCount() const { return m_rebuildCount; }
+
+private:
+    FlowField() = default;
+
+    FlowField(const FlowField &) = delete;
+
+    FlowField &operator=(const FlowField &) = delete;
+
+    // 场景尺寸变化时重新分配网格
+    void ensureGrid();
+
+    [[nodiscard]] int cellAt(const QPointF &pos) const;
+
+    [[nodiscard]] bool isOpen(int col, int row) const;
+
+    void rebuild();
+
+    // 按路程梯度计算每格方向，梯度指向障碍时改用路程最小的相邻格
+    void computeDirections();
+
+    int m_cols = 0;
+    int m_rows = 0;
+    int m_targetCell = -1;
+    int m_rebuildCount = 0;
+    bool m_dirty = true;
+    bool m_hasObstacles = false;
+    QVector<bool> m_blocked;
+    QVector<float> m_distance;  // 到目标格的路程（格），不可达为无穷大
+    QVector<float> m_dirX;
+    QVector<float> m_dirY;
+};
+
+#endif // FLOWFIELD_H
@@ -10,7 +10,10 @@
 #include <QtMath>
 #include "../core/audiomanager.h"
 #include "../core/configmanager.h"
+#include "../core/objectcensus.h"
 #include "../core/resourcefactory.h"
+#include "../core/spritecache.h"
+#include "../core/timerwheel.h"
 // entities
 #include "../entities/boss.h"
 #include "../entities/enemy.h"
@@ -36,25 +39,31 @@
 #include "../entities/level_3/yanglinenemy.h"
 #include "../entities/level_3/zhuhaoenemy.h"
 // items 和 ui
+#include "../core/logging.h"
 #include "../items/chest.h"
 #include "../items/droppeditem.h"
 #include "../items/droppeditemfactory.h"
+#include "../items/statuseffect.h"
 #include "../ui/dialogsystem.h"
 #include "../ui/gameview.h"
 #include "../ui/hud.h"
+#include "entityregistry.h"
 #include "factory/bossfactory.h"
 #include "factory/enemyfactory.h"
+#include "flowfield.h"
 #include "levelconfig.h"
 #include "room.h"
+#include "triggersystem.h"
+#include "worldsnapshot.h"
 
 Level::Level(Player* player, QGraphicsScene* scene, QObject* parent)
     : QObject(parent),
       m_levelNumber(1),
       m_player(player),
-      m_scene(scene),
-      checkChange(nullptr) {
+      m_scene(scene) {
     // 创建房间管理器（完全管理房间数据）
     m_roomManager = new RoomManager(m_player, m_scene, this);
+    m_roomManager->setSpawnRandom(&m_roomRng);
 
     // 连接RoomManager的敌人创建信号（连接死亡回调）
     connect(m_roomManager, &RoomManager::enemyCreated, this, [this](Enemy* enemy) {
@@ -72,7 +81,7 @@ Level::Level(Player* player, QGraphicsScene* scene, QObject* parent)
             // 设置Boss特有的信号连接（对话、吸纳、召唤敌人等）
             setupBossConnections(boss);
 
-            qDebug() << "Boss dying信号和特有信号已连接";
+            qCDebug(lcRoom) << "Boss dying信号和特有信号已连接";
         }
     });
 
@@ -151,6 +160,11 @@ Level::~Level() {
     // 断开所有信号连接，防止析构后回调
     disconnect(this, nullptr, nullptr, nullptr);
 
+    // 游戏时间域是全局的，关卡在暂停中被销毁时要恢复，避免下一局一开始就静止
+    if (m_isPaused) {
+        GameClock::instance().setPaused(ClockDomain::Gameplay, false);
+    }
+
     // 清理背景图片项
     if (m_backgroundItem) {
         if (m_scene)
@@ -165,12 +179,7 @@ Level::~Level() {
         m_backgroundOverlay = nullptr;
     }
 
-    if (checkChange) {
-        checkChange->stop();
-        disconnect(checkChange, nullptr, nullptr, nullptr);
-        delete checkChange;
-        checkChange = nullptr;
-    }
+    TriggerSystem::instance().removeOwner(this);
 
     // 清理吸收动画定时器
     if (m_absorbAnimationTimer) {
@@ -191,17 +200,18 @@ Level::~Level() {
 }
 
 void Level::init(int levelNumber) {
-    if (checkChange) {
-        checkChange->stop();
-        delete checkChange;
-        checkChange = nullptr;
-    }
+    TriggerSystem::instance().removeOwner(this);
+    m_roomStartSnapshot.clear();
+    m_reuseRoomSeed = false;
 
     // 清理房间管理器（会清理门、房间、敌人、宝箱等）
     m_roomManager->cleanup();
 
     m_levelNumber = levelNumber;
     m_roomManager->setLevelNumber(levelNumber);
+
+    // 预热本关卡的精灵缓存（剧情对话期间完成解码和缩放）
+    SpriteCache::instance().buildForLevel(levelNumber);
     setHasEncounteredBossDoor(false);
     setBossDoorsAlreadyOpened(false);
 
@@ -233,12 +243,12 @@ void Level::init(int levelNumber) {
         return;
     }
 
-    qDebug() << "加载关卡:" << config.getLevelName();
-    qDebug() << "关卡描述条数:" << config.getDescription().size();
+    qCDebug(lcRoom) << "加载关卡:" << config.getLevelName();
+    qCDebug(lcRoom) << "关卡描述条数:" << config.getDescription().size();
 
     // 开发者模式
     if (m_skipToBoss) {
-        qDebug() << "开发者模式: 直接进入Boss对话";
+        qCDebug(lcRoom) << "开发者模式: 直接进入Boss对话";
         // 直接初始化关卡（跳过开头对话的显示，但内部状态正确初始化）
         initializeLevelAfterStory(config);
         // 延迟发出storyFinished信号，确保GameView的连接已建立
@@ -260,7 +270,7 @@ void Level::init(int levelNumber) {
 }
 
 void Level::initializeLevelAfterStory(const LevelConfig& config) {
-    qDebug() << "加载关卡:" << config.getLevelName();
+    qCDebug(lcRoom) << "加载关卡:" << config.getLevelName();
 
     bool isDevMode = m_skipToBoss;  // 保存开发者模式状态
 
@@ -271,12 +281,12 @@ void Level::initializeLevelAfterStory(const LevelConfig& config) {
         bool hasLeft = (roomCfg.doorLeft >= 0);
         bool hasRight = (roomCfg.doorRight >= 0);
 
-        Room* room = new Room(m_player, hasUp, hasDown, hasLeft, hasRight);
+        Room* room = new Room(hasUp, hasDown, hasLeft, hasRight);
 
         // 根据配置自动判断战斗房间（有敌人或有Boss的房间）
         if (roomCfg.enemyCount > 0 || roomCfg.hasBoss) {
             room->setBattleRoom(true);
-            qDebug() << "房间" << i << "标记为战斗房间（敌人数:" << roomCfg.enemyCount << "，Boss:" << roomCfg.hasBoss
+            qCDebug(lcRoom) << "房间" << i << "标记为战斗房间（敌人数:" << roomCfg.enemyCount << "，Boss:" << roomCfg.hasBoss
                      << "）";
         }
 
@@ -321,7 +331,7 @@ void Level::initializeLevelAfterStory(const LevelConfig& config) {
 
             // 直接进入boss房
             setCurrentRoomIndex(bossRoomIndex);
-            qDebug() << "开发者模式: 模拟完成，进入Boss房" << bossRoomIndex;
+            qCDebug(lcRoom) << "开发者模式: 模拟完成，进入Boss房" << bossRoomIndex;
         } else {
             // 没找到boss房，使用正常流程
             visitedRooms()[startRoomIndex] = true;
@@ -359,24 +369,16 @@ void Level::initializeLevelAfterStory(const LevelConfig& config) {
     }
 
     // 开发者模式：显示boss对话，对话结束后初始化boss房
-    bool isShowingDevModeBossDialog = false;
+    // （出口触发区域在初始化房间时注册，对话期间不会出门）
     if (isDevMode && bossRoomIndex >= 0 && !currentRoomCfg.bossDialog.isEmpty()) {
         visitedRooms()[bossRoomIndex] = true;
         visitedCount()++;
-        isShowingDevModeBossDialog = true;
         showStoryDialog(currentRoomCfg.bossDialog, true, currentRoomCfg.bossDialogBackground);
     } else {
         // 正常初始化当前房间
         initCurrentRoom(rooms()[currentRoomIndex()]);
     }
 
-    checkChange = new QTimer(this);
-    connect(checkChange, &QTimer::timeout, this, &Level::enterNextRoom);
-    // 开发者模式下显示boss对话时，不启动checkChange计时器，等对话结束后再启动
-    if (!isShowingDevModeBossDialog) {
-        checkChange->start(100);
-    }
-
     buildMinimapData();
 }
 
@@ -386,11 +388,11 @@ void Level::showStoryDialog(const QStringList& dialogs, bool isBossDialog, const
     if (m_isEliteDialog) {
         m_dialogSystem->setEliteDialog(true);
     }
-    // 暂停所有房间的定时器（防止对话期间玩家被攻击）
+    // 关闭所有房间的出门检测（防止对话期间切换房间）
     if (isBossDialog) {
         for (Room* room : rooms()) {
             if (room) {
-                room->stopChangeTimer();
+                room->setExitCheckEnabled(false);
             }
         }
     }
@@ -410,7 +412,7 @@ void Level::onDialogSystemStoryFinished() {
 void Level::onDialogSystemBossDialogFinished() {
     // 检查是否是WashMachineBoss的中途对话（变异阶段）
     if (m_currentWashMachineBoss && m_currentWashMachineBoss->getPhase() >= 2) {
-        qDebug() << "WashMachineBoss对话结束，通知Boss继续战斗";
+        qCDebug(lcRoom) << "WashMachineBoss对话结束，通知Boss继续战斗";
 
         // 释放所有被吸纳的实体（随机分布在场景中）
         for (int i = 0; i < m_absorbingItems.size(); ++i) {
@@ -426,18 +428,16 @@ void Level::onDialogSystemBossDialogFinished() {
                 m_player->setPermanentInvincible(false);
                 m_player->setScale(1.0);
                 m_player->setPos(400, 450);
-                qDebug() << "[吸纳] 玩家已恢复";
-            } else if (item != m_currentWashMachineBoss) {
-                Enemy* enemy = dynamic_cast<Enemy*>(item);
-                if (enemy) {
-                    int x = QRandomGenerator::global()->bounded(100, 700);
-                    int y = QRandomGenerator::global()->bounded(100, 500);
-                    enemy->setPos(x, y);
-                    enemy->setScale(1.0);
-                    enemy->setVisible(true);
-                    enemy->resumeTimers();
-                    qDebug() << "释放敌人到位置:" << x << "," << y;
-                }
+                qCDebug(lcRoom) << "[吸纳] 玩家已恢复";
+            } else if (item != m_currentWashMachineBoss && isEntityKind(item, EntityKind::Enemy)) {
+                Enemy* enemy = static_cast<Enemy*>(item);
+                int x = QRandomGenerator::global()->bounded(100, 700);
+                int y = QRandomGenerator::global()->bounded(100, 500);
+                enemy->setPos(x, y);
+                enemy->setScale(1.0);
+                enemy->setVisible(true);
+                enemy->resumeTimers();
+                qCDebug(lcRoom) << "释放敌人到位置:" << x << "," << y;
             }
         }
 
@@ -447,22 +447,19 @@ void Level::onDialogSystemBossDialogFinished() {
 
         m_currentWashMachineBoss->onDialogFinished();
     } else if (m_currentTeacherBoss && m_currentTeacherBoss->getPhase() >= 2) {
-        qDebug() << "TeacherBoss阶段转换对话结束，继续战斗";
+        qCDebug(lcRoom) << "TeacherBoss阶段转换对话结束，继续战斗";
         m_currentTeacherBoss->onDialogFinished();
     } else if (m_currentTeacherBoss && m_currentTeacherBoss->getPhase() == 1) {
-        qDebug() << "TeacherBoss初始对话结束，通知Boss开始第一阶段战斗";
+        qCDebug(lcRoom) << "TeacherBoss初始对话结束，通知Boss开始第一阶段战斗";
         m_currentTeacherBoss->onDialogFinished();
     } else {
         // WashMachineBoss或其他Boss的初始对话结束
         if (currentRoomIndex() >= 0 && currentRoomIndex() < rooms().size()) {
-            qDebug() << "Boss对话结束，初始化boss房间" << currentRoomIndex();
+            qCDebug(lcRoom) << "Boss对话结束，初始化boss房间" << currentRoomIndex();
             initCurrentRoom(rooms()[currentRoomIndex()]);
         }
-        if (checkChange && !checkChange->isActive()) {
-            checkChange->start(100);
-        }
         if (m_currentTeacherBoss) {
-            qDebug() << "TeacherBoss实例创建完成，通知其进入战斗";
+            qCDebug(lcRoom) << "TeacherBoss实例创建完成，通知其进入战斗";
             m_currentTeacherBoss->onDialogFinished();
         } else if (m_currentWashMachineBoss) {
             m_currentWashMachineBoss->onDialogFinished();
@@ -475,11 +472,11 @@ void Level::onDialogSystemEliteDialogFinished() {
     m_isEliteDialog = false;
 
     if (m_elitePhase2Triggered) {
-        qDebug() << "精英房间第二阶段对话结束，生成祝昊";
+        qCDebug(lcRoom) << "精英房间第二阶段对话结束，生成祝昊";
         spawnZhuhaoEnemy();
         resumeAllEnemyTimers();
     } else {
-        qDebug() << "精英房间初始对话结束，初始化房间";
+        qCDebug(lcRoom) << "精英房间初始对话结束，初始化房间";
         if (currentRoomIndex() >= 0 && currentRoomIndex() < rooms().size()) {
             initCurrentRoom(rooms()[currentRoomIndex()]);
         }
@@ -504,14 +501,16 @@ void Level::initCurrentRoom(Room* room) {
 
     for (Room* rr : rooms()) {
         if (rr)
-            rr->stopChangeTimer();
+            rr->setExitCheckEnabled(false);
     }
 
     clearSceneEntities();
+    m_roomStartSnapshot.clear();
 
     LevelConfig config;
     if (config.loadFromFile(m_levelNumber)) {
         const RoomConfig& roomCfg = config.getRoom(currentRoomIndex());
+        captureRoomSnapshot(roomCfg, true);
         try {
             QString bgPath = ConfigManager::instance().getAssetPath(roomCfg.backgroundImage);
             QPixmap bg = ResourceFactory::loadImage(bgPath);
@@ -519,22 +518,28 @@ void Level::initCurrentRoom(Room* room) {
                 m_backgroundItem->setPixmap(bg.scaled(800, 600, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
                 m_backgroundItem->setPos(0, 0);
             }
-            qDebug() << "加载房间" << currentRoomIndex() << "背景:" << roomCfg.backgroundImage;
+            qCDebug(lcRoom) << "加载房间" << currentRoomIndex() << "背景:" << roomCfg.backgroundImage;
         } catch (const QString& e) {
             qWarning() << "加载地图背景失败:" << e;
         }
         spawnDoors(roomCfg);
     }
 
-    qDebug() << "初始化房间" << currentRoomIndex() << "，开始生成实体";
+    // 对象普查：本关首个房间生成敌人之前记录基线（GameView 在每关 init 前丢弃旧基线）
+    ObjectCensus &census = ObjectCensus::instance();
+    if (census.isEnabled() && !census.hasBaseline()) {
+        census.checkpoint(QString("第%1关 进入房间%2").arg(m_levelNumber).arg(currentRoomIndex()));
+    }
+
+    qCDebug(lcRoom) << "初始化房间" << currentRoomIndex() << "，开始生成实体";
     spawnEnemiesInRoom(currentRoomIndex());
     spawnChestsInRoom(currentRoomIndex());
-    qDebug() << "初始化房间" << currentRoomIndex() << "完成，房间敌人数:" << room->currentEnemies.size() << "，全局敌人数:"
+    qCDebug(lcRoom) << "初始化房间" << currentRoomIndex() << "完成，房间敌人数:" << room->currentEnemies.size() << "，全局敌人数:"
              << currentEnemies().size();
 
     // 如果是战斗房间且尚未开始战斗，且有敌人，则标记战斗开始
     if (room && room->isBattleRoom() && !room->isBattleStarted() && !room->currentEnemies.isEmpty()) {
-        qDebug() << "战斗房间" << currentRoomIndex() << "触发战斗";
+        qCDebug(lcRoom) << "战斗房间" << currentRoomIndex() << "触发战斗";
         room->startBattle();
     }
 
@@ -544,8 +549,10 @@ void Level::initCurrentRoom(Room* room) {
 
     emit roomEntered(currentRoomIndex());
 
-    if (room)
-        room->startChangeTimer();
+    if (room) {
+        room->setExitCheckEnabled(true);
+        registerExitTriggers(room);
+    }
 }
 
 void Level::spawnEnemiesInRoom(int roomIndex) {
@@ -642,7 +649,7 @@ void Level::setupBossConnections(Boss* boss) {
 
     // 根据具体类型设置Boss特有的信号连接
     if (NightmareBoss* nightmareBoss = dynamic_cast<NightmareBoss*>(boss)) {
-        qDebug() << "[Level] 设置Nightmare Boss信号连接（第一关）";
+        qCDebug(lcRoom) << "[Level] 设置Nightmare Boss信号连接（第一关）";
         // 连接Nightmare Boss的特殊信号
         connect(nightmareBoss, &NightmareBoss::requestSpawnEnemies,
                 this, &Level::spawnEnemiesForBoss);
@@ -650,16 +657,16 @@ void Level::setupBossConnections(Boss* boss) {
         connect(nightmareBoss, &NightmareBoss::phase1DeathTriggered,
                 this, [this]() { this->fadeBackgroundTo(QString("assets/background/nightmare2_map.png"), 3000); });
     } else if (WashMachineBoss* washMachineBoss = dynamic_cast<WashMachineBoss*>(boss)) {
-        qDebug() << "[Level] 设置WashMachine Boss信号连接（第二关）";
+        qCDebug(lcRoom) << "[Level] 设置WashMachine Boss信号连接（第二关）";
         m_currentWashMachineBoss = washMachineBoss;
         washMachineBoss->setupLevelConnections(this);
     } else if (TeacherBoss* teacherBoss = dynamic_cast<TeacherBoss*>(boss)) {
-        qDebug() << "[Level] 设置Teacher Boss信号连接（第三关）";
+        qCDebug(lcRoom) << "[Level] 设置Teacher Boss信号连接（第三关）";
         m_currentTeacherBoss = teacherBoss;
         teacherBoss->setScene(m_scene);  // 设置场景引用，用于生成粉笔、监考员等实体
         teacherBoss->setupLevelConnections(this);
     } else {
-        qDebug() << "[Level] 使用默认Boss，无特殊信号连接";
+        qCDebug(lcRoom) << "[Level] 使用默认Boss，无特殊信号连接";
     }
 }
 
@@ -678,6 +685,27 @@ void Level::spawnDoors(const RoomConfig& roomCfg) {
     m_roomManager->spawnDoors(roomCfg);
 }
 
+void Level::registerExitTriggers(Room* room) {
+    TriggerSystem::instance().removeOwner(this);
+    if (!room)
+        return;
+
+    // 替代原来每100ms轮询 enterNextRoom：玩家走进出口区域时才检测门是否打开并切换房间。
+    // 注册时玩家已在区域内（刚从对面的门进来）不会触发，必须先离开再进入
+    static const int kExitDirs[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    for (const auto& dir : kExitDirs) {
+        QRectF area = room->exitArea(dir[0], dir[1]);
+        if (area.isEmpty())
+            continue;
+        TriggerSystem::instance().addZone(this, TriggerVolume::box(area, TriggerAnchor::PlayerPos),
+                                          [this](TriggerEvent event) {
+                                              if (event == TriggerEvent::Enter) {
+                                                  enterNextRoom();
+                                              }
+                                          });
+    }
+}
+
 void Level::buildMinimapData() {
     LevelConfig config;
     if (!config.loadFromFile(m_levelNumber))
@@ -769,20 +797,15 @@ void Level::clearSceneEntities() {
     }
     currentDoors().clear();
 
+    // 上一个房间的障碍不再有效
+    FlowField::instance().clearObstacles();
+
     // 清理场景中残留的子弹和毒液轨迹
     if (m_scene) {
-        QList<QGraphicsItem*> allItems = m_scene->items();
-        QVector<Projectile*> projectilesToDelete;
-        QVector<PoisonTrail*> poisonTrailsToDelete;
-
-        // 先收集所有子弹和毒液轨迹
-        for (QGraphicsItem* item : allItems) {
-            if (auto proj = dynamic_cast<Projectile*>(item)) {
-                projectilesToDelete.append(proj);
-            } else if (auto trail = dynamic_cast<PoisonTrail*>(item)) {
-                poisonTrailsToDelete.append(trail);
-            }
-        }
+        // 先收集所有子弹和毒液轨迹（注册表返回快照）
+        EntityRegistry& registry = EntityRegistry::instance();
+        QVector<Projectile*> projectilesToDelete = registry.inScene<Projectile>(EntityKind::Projectile, m_scene);
+        QVector<PoisonTrail*> poisonTrailsToDelete = registry.inScene<PoisonTrail>(EntityKind::PoisonTrail, m_scene);
 
         // 再统一删除，避免在遍历时修改容器
         for (Projectile* proj : projectilesToDelete) {
@@ -839,18 +862,7 @@ void Level::clearCurrentRoomEntities() {
     // m_doorItems已移除，门对象现在保存在RoomManager中
 
     if (m_scene) {
-        QList<QGraphicsItem*> allItems = m_scene->items();
-        QVector<Projectile*> projectilesToDelete;
-        for (QGraphicsItem* item : allItems) {
-            if (auto proj = dynamic_cast<Projectile*>(item)) {
-                projectilesToDelete.append(proj);
-            }
-        }
-        for (Projectile* proj : projectilesToDelete) {
-            if (proj) {
-                proj->destroy();
-            }
-        }
+        destroySceneProjectiles();
     }
 }
 
@@ -867,16 +879,19 @@ bool Level::enterNextRoom() {
         return false;
     }
 
+    if (m_player) {
+        currentRoom->testChange(m_player->pos());
+    }
     int x = currentRoom->getChangeX();
     int y = currentRoom->getChangeY();
 
     if (!x && !y)
         return false;
 
-    qDebug() << "enterNextRoom: 检测到切换请求 x=" << x << ", y=" << y;
+    qCDebug(lcRoom) << "enterNextRoom: 检测到切换请求 x=" << x << ", y=" << y;
 
     AudioManager::instance().playSound("enter_room");
-    qDebug() << "进入新房间音效已触发";
+    qCDebug(lcRoom) << "进入新房间音效已触发";
 
     LevelConfig config;
     if (!config.loadFromFile(m_levelNumber)) {
@@ -899,12 +914,12 @@ bool Level::enterNextRoom() {
     }
 
     if (nextRoomIndex < 0 || nextRoomIndex >= rooms().size()) {
-        qDebug() << "无效的目标房间:" << nextRoomIndex;
+        qCDebug(lcRoom) << "无效的目标房间:" << nextRoomIndex;
         currentRoom->resetChangeDir();
         return false;
     }
 
-    qDebug() << "切换房间: 从" << currentRoomIndex() << "到" << nextRoomIndex;
+    qCDebug(lcRoom) << "切换房间: 从" << currentRoomIndex() << "到" << nextRoomIndex;
 
     // 在切换房间之前，保存当前房间的掉落物品
     currentRoom->saveDroppedItemsFromScene(m_scene);
@@ -921,6 +936,9 @@ bool Level::enterNextRoom() {
         m_player->setPos(40, m_player->pos().y());
     }
 
+    // 按玩家的新位置重建出口区域（对话结束前不会初始化房间）
+    registerExitTriggers(rooms()[currentRoomIndex()]);
+
     const RoomConfig& nextRoomCfg = config.getRoom(nextRoomIndex);
     Room* nextRoom = rooms()[nextRoomIndex];
 
@@ -948,13 +966,13 @@ bool Level::enterNextRoom() {
                 (newRoomCfg.doorLeft >= 0 && config.getRoom(newRoomCfg.doorLeft).hasBoss) ||
                 (newRoomCfg.doorRight >= 0 && config.getRoom(newRoomCfg.doorRight).hasBoss)) {
                 setHasEncounteredBossDoor(true);
-                qDebug() << "首次遇到boss门，标记状态";
+                qCDebug(lcRoom) << "首次遇到boss门，标记状态";
             }
         }
 
         // 如果是首次进入精英房间且有对话配置，显示对话
         if (isFirstEnterEliteRoom && !newRoomCfg.eliteDialog.isEmpty()) {
-            qDebug() << "首次进入精英房间" << currentRoomIndex() << "，显示精英房间对话";
+            qCDebug(lcRoom) << "首次进入精英房间" << currentRoomIndex() << "，显示精英房间对话";
             m_isEliteRoom = true;
             m_elitePhase2Triggered = false;
             m_eliteYanglinDeathCount = 0;
@@ -964,7 +982,7 @@ bool Level::enterNextRoom() {
         }
         // 如果是首次进入boss房间且有对话配置，显示对话
         else if (isFirstEnterBossRoom && !newRoomCfg.bossDialog.isEmpty()) {
-            qDebug() << "首次进入boss房间" << currentRoomIndex() << "，显示boss对话";
+            qCDebug(lcRoom) << "首次进入boss房间" << currentRoomIndex() << "，显示boss对话";
             // 传递boss对话标志和自定义背景（如果有）
             showStoryDialog(newRoomCfg.bossDialog, true, newRoomCfg.bossDialogBackground);
             // 等待对话结束后再初始化房间，通过finishStory处理
@@ -973,7 +991,7 @@ bool Level::enterNextRoom() {
             initCurrentRoom(rooms()[currentRoomIndex()]);
             // 首次进入cloudDream背景的战斗房间时，显示"你已坠入梦境！"提示
             if (isFirstEnterCloudDreamRoom) {
-                qDebug() << "首次进入cloudDream背景房间，显示沉睡提示";
+                qCDebug(lcRoom) << "首次进入cloudDream背景房间，显示沉睡提示";
                 showPhaseTransitionText("你已坠入梦境！", Qt::red);
             }
         }
@@ -984,7 +1002,7 @@ bool Level::enterNextRoom() {
     // 在进入非boss房间后，检查是否满足打开boss门的条件
     if (!newRoomCfg.hasBoss && hasEncounteredBossDoor() && !bossDoorsAlreadyOpened()) {
         if (canOpenBossDoor()) {
-            qDebug() << "进入房间后检测到满足boss门开启条件，立即打开boss门";
+            qCDebug(lcRoom) << "进入房间后检测到满足boss门开启条件，立即打开boss门";
             setBossDoorsAlreadyOpened(true);
             openBossDoors();
         }
@@ -1003,13 +1021,159 @@ bool Level::enterNextRoom() {
             nextRoom->setDoorOpenLeft(true);
         }
     } else {
-        qDebug() << "首次进入战斗房间" << nextRoomIndex << "，返回门保持关闭";
+        qCDebug(lcRoom) << "首次进入战斗房间" << nextRoomIndex << "，返回门保持关闭";
     }
+    syncRoomSnapshotDoors();
 
     currentRoom->resetChangeDir();
     return true;
 }
 
+void Level::captureRoomSnapshot(const RoomConfig& roomCfg, bool firstEntry) {
+    // 本房间的随机数种子：重试时沿用快照中的种子，敌人和宝箱按原样生成。
+    // 全局生成器不能重新播种（Qt 会 qFatal），房间生成使用自己的 m_roomRng，
+    // 它在此处由种子完全确定，快照只需保存种子即可恢复其状态
+    if (!m_reuseRoomSeed) {
+        m_roomSeed = QRandomGenerator::global()->generate();
+    }
+    m_reuseRoomSeed = false;
+    m_roomRng.seed(m_roomSeed);
+
+    m_roomStartSnapshot.clear();
+    Room* room = currentRoom();
+    if (!room || !m_player)
+        return;
+
+    // Boss/精英房间的流程依赖对话和阶段状态，不支持重试
+    if (roomCfg.hasBoss || roomCfg.isEliteRoom)
+        return;
+
+    // 带着上次留下的敌人再次进入：敌人的血量和位置不在快照中，不支持重试
+    if (!firstEntry) {
+        for (const QPointer<Enemy>& enemyPtr : room->currentEnemies) {
+            if (enemyPtr)
+                return;
+        }
+    }
+
+    WorldSnapshot snapshot;
+    snapshot.levelNumber = m_levelNumber;
+    snapshot.roomIndex = currentRoomIndex();
+    snapshot.firstEntry = firstEntry;
+    snapshot.rngSeed = m_roomSeed;
+    snapshot.visitedCount = visitedCount();
+    snapshot.encounteredBossDoor = hasEncounteredBossDoor();
+    snapshot.bossDoorsOpened = bossDoorsAlreadyOpened();
+    snapshot.player = m_player->saveState();
+    snapshot.playerEffects = EffectManager::instance().capture(m_player);
+    snapshot.visited = visitedRooms();
+
+    snapshot.rooms.reserve(rooms().size());
+    for (Room* r : rooms()) {
+        snapshot.rooms.append(r ? r->saveState() : RoomState());
+    }
+
+    // 再次进入时宝箱不会重新生成，记录留在房间里的宝箱
+    if (!firstEntry) {
+        for (const QPointer<Chest>& chestPtr : room->currentChests) {
+            if (chestPtr && !chestPtr->isOpened()) {
+                snapshot.chests.append({chestPtr->getChestType() == ChestType::Locked, chestPtr->pos()});
+            }
+        }
+    }
+
+    m_roomStartSnapshot = snapshot.toBytes();
+}
+
+void Level::syncRoomSnapshotDoors() {
+    WorldSnapshot snapshot;
+    if (m_roomStartSnapshot.isEmpty() || !WorldSnapshot::fromBytes(m_roomStartSnapshot, snapshot))
+        return;
+    if (snapshot.rooms.size() != rooms().size())
+        return;
+
+    for (int i = 0; i < rooms().size(); ++i) {
+        Room* r = rooms()[i];
+        if (!r)
+            continue;
+        RoomState& state = snapshot.rooms[i];
+        state.openUp = r->isDoorOpenUp();
+        state.openDown = r->isDoorOpenDown();
+        state.openLeft = r->isDoorOpenLeft();
+        state.openRight = r->isDoorOpenRight();
+    }
+    snapshot.encounteredBossDoor = hasEncounteredBossDoor();
+    snapshot.bossDoorsOpened = bossDoorsAlreadyOpened();
+    m_roomStartSnapshot = snapshot.toBytes();
+}
+
+bool Level::retryFromRoomStart() {
+    WorldSnapshot snapshot;
+    if (m_roomStartSnapshot.isEmpty() || !WorldSnapshot::fromBytes(m_roomStartSnapshot, snapshot))
+        return false;
+    if (!m_player || !m_scene || snapshot.levelNumber != m_levelNumber || snapshot.rooms.size() != rooms().size() ||
+        snapshot.roomIndex < 0 || snapshot.roomIndex >= rooms().size() || !rooms()[snapshot.roomIndex]) {
+        qWarning() << "retryFromRoomStart: 快照与当前关卡不匹配";
+        return false;
+    }
+
+    qCDebug(lcRoom) << "从房间" << snapshot.roomIndex << "开始处重试";
+
+    // 销毁死亡时房间里的敌人、宝箱、子弹和掉落物品（车票保留原对象）
+    clearCurrentRoomEntities();
+    clearSceneEntities();
+    for (DroppedItem* item : EntityRegistry::instance().inScene<DroppedItem>(EntityKind::DroppedItem, m_scene)) {
+        if (item->getType() == DroppedItemType::TICKET)
+            continue;
+        m_scene->removeItem(item);
+        delete item;
+    }
+
+    // 恢复房间进度
+    for (int i = 0; i < rooms().size(); ++i) {
+        if (rooms()[i])
+            rooms()[i]->restoreState(snapshot.rooms[i]);
+        visitedRooms()[i] = snapshot.visited.value(i, false);
+    }
+    visitedCount() = snapshot.visitedCount;
+    setHasEncounteredBossDoor(snapshot.encounteredBossDoor);
+    setBossDoorsAlreadyOpened(snapshot.bossDoorsOpened);
+    setCurrentRoomIndex(snapshot.roomIndex);
+    Room* room = rooms()[snapshot.roomIndex];
+
+    // 玩家死亡时其他房间留存的敌人也断开了连接，重新连接
+    for (Room* r : rooms()) {
+        if (!r)
+            continue;
+        for (const QPointer<Enemy>& enemyPtr : r->currentEnemies) {
+            if (Enemy* enemy = enemyPtr.data()) {
+                connect(enemy, &Enemy::dying, this, &Level::onEnemyDying, Qt::UniqueConnection);
+                enemy->setPlayer(m_player);
+            }
+        }
+    }
+
+    if (!snapshot.firstEntry) {
+        for (const ChestState& chestState : snapshot.chests) {
+            room->currentChests.append(QPointer<Chest>(m_roomManager->createChest(chestState.locked, chestState.pos)));
+        }
+    }
+
+    // 先恢复属性（已包含效果倍率），再重建效果表，最后复活
+    m_player->restoreState(snapshot.player);
+    EffectManager::instance().restore(m_player, snapshot.playerEffects);
+    m_player->revive();
+
+    m_roomSeed = snapshot.rngSeed;
+    m_reuseRoomSeed = true;
+    if (snapshot.firstEntry) {
+        initCurrentRoom(room);
+    } else {
+        loadRoom(snapshot.roomIndex);
+    }
+    return true;
+}
+
 void Level::loadRoom(int roomIndex) {
     if (roomIndex < 0 || roomIndex >= rooms().size()) {
         qWarning() << "无效的房间索引:" << roomIndex;
@@ -1022,17 +1186,19 @@ void Level::loadRoom(int roomIndex) {
 
     for (Room* rr : rooms()) {
         if (rr)
-            rr->stopChangeTimer();
+            rr->setExitCheckEnabled(false);
     }
 
     clearSceneEntities();
 
     setCurrentRoomIndex(roomIndex);
     Room* targetRoom = rooms()[roomIndex];
+    m_roomStartSnapshot.clear();
 
     LevelConfig config;
     if (config.loadFromFile(m_levelNumber)) {
         const RoomConfig& roomCfg = config.getRoom(roomIndex);
+        captureRoomSnapshot(roomCfg, false);
         try {
             QString bgPath = ConfigManager::instance().getAssetPath(roomCfg.backgroundImage);
             QPixmap bg = ResourceFactory::loadImage(bgPath);
@@ -1040,14 +1206,14 @@ void Level::loadRoom(int roomIndex) {
                 m_backgroundItem->setPixmap(bg.scaled(800, 600, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
                 m_backgroundItem->setPos(0, 0);
             }
-            qDebug() << "重新加载房间" << roomIndex << "背景:" << roomCfg.backgroundImage;
+            qCDebug(lcRoom) << "重新加载房间" << roomIndex << "背景:" << roomCfg.backgroundImage;
         } catch (const QString& e) {
             qWarning() << "加载地图背景失败:" << e;
         }
         spawnDoors(roomCfg);
     }
 
-    qDebug() << "重新加载房间" << roomIndex << "，房间保存的敌人数:" << targetRoom->currentEnemies.size();
+    qCDebug(lcRoom) << "重新加载房间" << roomIndex << "，房间保存的敌人数:" << targetRoom->currentEnemies.size();
 
     // 重新添加房间实体到场景（使用 QPointer）
     for (QPointer<Enemy> enemyPtr : targetRoom->currentEnemies) {
@@ -1055,7 +1221,7 @@ void Level::loadRoom(int roomIndex) {
         if (enemy) {
             m_scene->addItem(enemy);
             currentEnemies().append(enemyPtr);
-            qDebug() << "  恢复敌人到场景，位置:" << enemy->pos();
+            qCDebug(lcRoom) << "  恢复敌人到场景，位置:" << enemy->pos();
         }
     }
 
@@ -1068,9 +1234,9 @@ void Level::loadRoom(int roomIndex) {
     }
 
     // 恢复掉落物品到场景
-    targetRoom->restoreDroppedItemsToScene(m_scene);
+    targetRoom->restoreDroppedItemsToScene(m_scene, m_player);
 
-    qDebug() << "重新加载房间" << roomIndex << "完成，当前场景敌人数:" << currentEnemies().size();
+    qCDebug(lcRoom) << "重新加载房间" << roomIndex << "完成，当前场景敌人数:" << currentEnemies().size();
 
     if (m_player) {
         m_player->setZValue(100);
@@ -1078,15 +1244,17 @@ void Level::loadRoom(int roomIndex) {
 
     emit roomEntered(roomIndex);
 
-    if (targetRoom)
-        targetRoom->startChangeTimer();
+    if (targetRoom) {
+        targetRoom->setExitCheckEnabled(true);
+        registerExitTriggers(targetRoom);
+    }
 
     // 在重新加载非boss房间后，检查是否满足打开boss门的条件
     if (config.loadFromFile(m_levelNumber)) {
         const RoomConfig& roomCfg = config.getRoom(roomIndex);
         if (!roomCfg.hasBoss && hasEncounteredBossDoor() && !bossDoorsAlreadyOpened()) {
             if (canOpenBossDoor()) {
-                qDebug() << "重新加载房间后检测到满足boss门开启条件，立即打开boss门";
+                qCDebug(lcRoom) << "重新加载房间后检测到满足boss门开启条件，立即打开boss门";
                 setBossDoorsAlreadyOpened(true);
                 openBossDoors();
             }
@@ -1117,13 +1285,13 @@ void Level::onEnemyDying(Enemy* enemy) {
         YanglinEnemy* yanglin = dynamic_cast<YanglinEnemy*>(enemy);
         if (yanglin) {
             m_eliteYanglinDeathCount++;
-            qDebug() << "精英房间yanglin被击败，当前被击败数:" << m_eliteYanglinDeathCount;
+            qCDebug(lcRoom) << "精英房间yanglin被击败，当前被击败数:" << m_eliteYanglinDeathCount;
 
             // 第一个yanglin被击败时触发第二阶段
             if (m_eliteYanglinDeathCount == 1) {
-                qDebug() << "触发精英房间第二阶段";
+                qCDebug(lcRoom) << "触发精英房间第二阶段";
                 // 延迟一小段时间再触发第二阶段对话
-                QTimer::singleShot(1000, this, &Level::checkEliteRoomPhase2);
+                TimerWheel::instance().schedule(this, 1000, &Level::checkEliteRoomPhase2);
             }
         }
     }
@@ -1138,7 +1306,7 @@ void Level::onEnemyDying(Enemy* enemy) {
         QPointer<Level> levelPtr(this);
         QPointer<Player> playerPtr(m_player);
         QGraphicsScene* scenePtr = m_scene;
-        QTimer::singleShot(100, this, [levelPtr, playerPtr, dropPos, scenePtr]() {
+        TimerWheel::instance().schedule(this, 100, [levelPtr, playerPtr, dropPos, scenePtr]() {
             if (levelPtr && playerPtr && scenePtr) {
                 if (DroppedItemFactory::shouldEnemyDropItem()) {
                     DroppedItemFactory::dropRandomItem(ItemDropPool::ENEMY_DROP, dropPos, playerPtr, scenePtr);
@@ -1168,7 +1336,7 @@ void Level::onEnemyDying(Enemy* enemy) {
     Room* cur = rooms()[currentRoomIndex()];
     // 如果是Boss死亡，无论房间是否清空，都标记Boss已被击败
     if (isBoss && !m_bossDefeated) {
-        qDebug() << "[Level] Boss被击败，标记m_bossDefeated = true，当前房间剩余敌人:"
+        qCDebug(lcRoom) << "[Level] Boss被击败，标记m_bossDefeated = true，当前房间剩余敌人:"
                  << (cur ? cur->currentEnemies.size() : 0);
         m_bossDefeated = true;
     }
@@ -1183,16 +1351,16 @@ void Level::onEnemyDying(Enemy* enemy) {
             if (roomCfg.hasBoss) {
                 // Boss刚死亡，记录标志并等待小怪清完
                 if (isBoss) {
-                    qDebug() << "[Level] Boss被击败，房间已清空，启动奖励流程";
+                    qCDebug(lcRoom) << "[Level] Boss被击败，房间已清空，启动奖励流程";
                     m_bossDefeated = true;
                     // 延迟启动奖励流程，等待Boss死亡动画完成
-                    QTimer::singleShot(1500, this, &Level::startBossRewardSequence);
+                    TimerWheel::instance().schedule(this, 1500, &Level::startBossRewardSequence);
                     return;  // 不执行正常的开门逻辑
                 }
                 // 小怪死亡但Boss之前已被击败，现在房间清空，启动奖励流程
                 else if (m_bossDefeated && m_rewardSystem && !m_rewardSystem->isRewardSequenceActive()) {
-                    qDebug() << "[Level] Boss房间小怪已清空，Boss之前已被击败，启动奖励流程";
-                    QTimer::singleShot(500, this, &Level::startBossRewardSequence);
+                    qCDebug(lcRoom) << "[Level] Boss房间小怪已清空，Boss之前已被击败，启动奖励流程";
+                    TimerWheel::instance().schedule(this, 500, &Level::startBossRewardSequence);
                     return;  // 不执行正常的开门逻辑
                 }
             }
@@ -1208,7 +1376,7 @@ void Level::onEnemyDying(Enemy* enemy) {
             const RoomConfig& roomCfg = config.getRoom(currentRoomIndex());
             if (!roomCfg.hasBoss && hasEncounteredBossDoor() && !bossDoorsAlreadyOpened()) {
                 if (canOpenBossDoor()) {
-                    qDebug() << "战斗房间清空后检测到满足boss门开启条件，立即打开boss门";
+                    qCDebug(lcRoom) << "战斗房间清空后检测到满足boss门开启条件，立即打开boss门";
                     setBossDoorsAlreadyOpened(true);
                     openBossDoors();
                 }
@@ -1233,7 +1401,7 @@ void Level::openDoors(Room* cur) {
 
             // 最高优先级：如果邻居是boss房间，必须所有非boss房间都已访问才能开门
             if (neighborCfg.hasBoss && !canOpenBossDoor()) {
-                qDebug() << "上门通往boss房间" << neighborRoom << "，但还有房间未探索，保持关闭";
+                qCDebug(lcRoom) << "上门通往boss房间" << neighborRoom << "，但还有房间未探索，保持关闭";
                 doorIndex++;
             } else {
                 cur->setDoorOpenUp(true);
@@ -1244,7 +1412,7 @@ void Level::openDoors(Room* cur) {
                     currentDoors()[doorIndex]->open();
                 }
                 doorIndex++;
-                qDebug() << "打开上门，通往房间" << neighborRoom;
+                qCDebug(lcRoom) << "打开上门，通往房间" << neighborRoom;
 
                 // 设置邻房间的对应门为打开状态（除非邻居是未访问的战斗房间）
                 if (neighborRoom >= 0 && neighborRoom < rooms().size()) {
@@ -1262,7 +1430,7 @@ void Level::openDoors(Room* cur) {
 
             // 最高优先级：如果邻居是boss房间，必须所有非boss房间都已访问才能开门
             if (neighborCfg.hasBoss && !canOpenBossDoor()) {
-                qDebug() << "下门通往boss房间" << neighborRoom << "，但还有房间未探索，保持关闭";
+                qCDebug(lcRoom) << "下门通往boss房间" << neighborRoom << "，但还有房间未探索，保持关闭";
                 doorIndex++;
             } else {
                 cur->setDoorOpenDown(true);
@@ -1272,7 +1440,7 @@ void Level::openDoors(Room* cur) {
                     currentDoors()[doorIndex]->open();
                 }
                 doorIndex++;
-                qDebug() << "打开下门，通往房间" << neighborRoom;
+                qCDebug(lcRoom) << "打开下门，通往房间" << neighborRoom;
 
                 if (neighborRoom >= 0 && neighborRoom < rooms().size()) {
                     Room* neighbor = rooms()[neighborRoom];
@@ -1289,7 +1457,7 @@ void Level::openDoors(Room* cur) {
 
             // 最高优先级：如果邻居是boss房间，必须所有非boss房间都已访问才能开门
             if (neighborCfg.hasBoss && !canOpenBossDoor()) {
-                qDebug() << "左门通往boss房间" << neighborRoom << "，但还有房间未探索，保持关闭";
+                qCDebug(lcRoom) << "左门通往boss房间" << neighborRoom << "，但还有房间未探索，保持关闭";
                 doorIndex++;
             } else {
                 cur->setDoorOpenLeft(true);
@@ -1299,7 +1467,7 @@ void Level::openDoors(Room* cur) {
                     currentDoors()[doorIndex]->open();
                 }
                 doorIndex++;
-                qDebug() << "打开左门，通往房间" << neighborRoom;
+                qCDebug(lcRoom) << "打开左门，通往房间" << neighborRoom;
 
                 if (neighborRoom >= 0 && neighborRoom < rooms().size()) {
                     Room* neighbor = rooms()[neighborRoom];
@@ -1316,7 +1484,7 @@ void Level::openDoors(Room* cur) {
 
             // 最高优先级：如果邻居是boss房间，必须所有非boss房间都已访问才能开门
             if (neighborCfg.hasBoss && !canOpenBossDoor()) {
-                qDebug() << "右门通往boss房间" << neighborRoom << "，但还有房间未探索，保持关闭";
+                qCDebug(lcRoom) << "右门通往boss房间" << neighborRoom << "，但还有房间未探索，保持关闭";
                 doorIndex++;
             } else {
                 cur->setDoorOpenRight(true);
@@ -1326,7 +1494,7 @@ void Level::openDoors(Room* cur) {
                     currentDoors()[doorIndex]->open();
                 }
                 doorIndex++;
-                qDebug() << "打开右门，通往房间" << neighborRoom;
+                qCDebug(lcRoom) << "打开右门，通往房间" << neighborRoom;
 
                 if (neighborRoom >= 0 && neighborRoom < rooms().size()) {
                     Room* neighbor = rooms()[neighborRoom];
@@ -1342,9 +1510,11 @@ void Level::openDoors(Room* cur) {
     // 只有在实际打开了门时才播放音效和记录日志
     if (anyDoorOpened) {
         AudioManager::instance().playSound("door_open");
-        qDebug() << "房间" << currentRoomIndex() << "敌人全部清空，门已打开";
+        qCDebug(lcRoom) << "房间" << currentRoomIndex() << "敌人全部清空，门已打开";
+        // 玩家可能早已站在出口区域内，重新武装后下一个移动节拍即可出门
+        TriggerSystem::instance().rearm(this);
     } else {
-        qDebug() << "房间" << currentRoomIndex() << "敌人已清空，但所有门都通往boss房间且条件不满足";
+        qCDebug(lcRoom) << "房间" << currentRoomIndex() << "敌人已清空，但所有门都通往boss房间且条件不满足";
     }
 
     // 只有战斗房间才发射敌人清空信号
@@ -1363,9 +1533,9 @@ void Level::openBossDoors() {
     if (!config.loadFromFile(m_levelNumber))
         return;
 
-    qDebug() << "=== 开始打开所有通往boss房间的门 ===";
+    qCDebug(lcRoom) << "=== 开始打开所有通往boss房间的门 ===";
 
-    bool shouldReloadCurrentRoom = false;
+    bool shouldSyncCurrentRoom = false;
 
     // 遍历所有房间，找到所有通往boss房间的门并打开
     for (int roomIndex = 0; roomIndex < config.getRoomCount(); ++roomIndex) {
@@ -1377,7 +1547,7 @@ void Level::openBossDoors() {
         if (roomIndex >= rooms().size() || !rooms()[roomIndex])
             continue;
         Room* room = rooms()[roomIndex];
-        qDebug() << "检查房间" << roomIndex << "的门（上:" << roomCfg.doorUp << "，下:" << roomCfg.doorDown
+        qCDebug(lcRoom) << "检查房间" << roomIndex << "的门（上:" << roomCfg.doorUp << "，下:" << roomCfg.doorDown
                  << "，左:" << roomCfg.doorLeft << "，右:" << roomCfg.doorRight << "）";
 
         // 检查当前房间的相邻房间是否有通往boss的门
@@ -1389,16 +1559,16 @@ void Level::openBossDoors() {
             isAdjacentToBoss = true;
         }
 
-        // 如果当前房间邻接boss房间，且是正在显示的房间，标记需要重新加载
+        // 如果当前房间邻接boss房间，且是正在显示的房间，标记需要同步门状态
         if (isAdjacentToBoss && roomIndex == currentRoomIndex()) {
-            shouldReloadCurrentRoom = true;
+            shouldSyncCurrentRoom = true;
         }
 
         // 检查该房间的每个门是否通往boss房间
         if (roomCfg.doorUp >= 0) {
             const RoomConfig& neighborCfg = config.getRoom(roomCfg.doorUp);
             if (neighborCfg.hasBoss && !room->isDoorOpenUp()) {
-                qDebug() << "开启房间" << roomIndex << "通往boss房间" << roomCfg.doorUp << "的上门";
+                qCDebug(lcRoom) << "开启房间" << roomIndex << "通往boss房间" << roomCfg.doorUp << "的上门";
                 room->setDoorOpenUp(true);
 
                 // 找到并播放该门的开门动画
@@ -1406,7 +1576,7 @@ void Level::openBossDoors() {
                 if (roomIndex == currentRoomIndex() && !currentDoors().isEmpty()) {
                     for (Door* door : currentDoors()) {
                         if (door && door->direction() == Door::Up) {
-                            qDebug() << "  -> 在当前房间的 currentDoors() 中找到上门并打开";
+                            qCDebug(lcRoom) << "  -> 在当前房间的 currentDoors() 中找到上门并打开";
                             door->open();
                             AudioManager::instance().playSound("door_open");
                         }
@@ -1415,7 +1585,7 @@ void Level::openBossDoors() {
                     const QVector<Door*>& doors = roomDoors()[roomIndex];
                     for (Door* door : doors) {
                         if (door && door->direction() == Door::Up) {
-                            qDebug() << "  -> 在 roomDoors() 中找到房间" << roomIndex << "的上门并打开";
+                            qCDebug(lcRoom) << "  -> 在 roomDoors() 中找到房间" << roomIndex << "的上门并打开";
                             door->open();
                             AudioManager::instance().playSound("door_open");
                         }
@@ -1427,13 +1597,13 @@ void Level::openBossDoors() {
         if (roomCfg.doorDown >= 0) {
             const RoomConfig& neighborCfg = config.getRoom(roomCfg.doorDown);
             if (neighborCfg.hasBoss && !room->isDoorOpenDown()) {
-                qDebug() << "开启房间" << roomIndex << "通往boss房间" << roomCfg.doorDown << "的下门";
+                qCDebug(lcRoom) << "开启房间" << roomIndex << "通往boss房间" << roomCfg.doorDown << "的下门";
                 room->setDoorOpenDown(true);
 
                 if (roomIndex == currentRoomIndex() && !currentDoors().isEmpty()) {
                     for (Door* door : currentDoors()) {
                         if (door && door->direction() == Door::Down) {
-                            qDebug() << "  -> 在当前房间的 currentDoors() 中找到下门并打开";
+                            qCDebug(lcRoom) << "  -> 在当前房间的 currentDoors() 中找到下门并打开";
                             door->open();
                             AudioManager::instance().playSound("door_open");
                         }
@@ -1442,7 +1612,7 @@ void Level::openBossDoors() {
                     const QVector<Door*>& doors = roomDoors()[roomIndex];
                     for (Door* door : doors) {
                         if (door && door->direction() == Door::Down) {
-                            qDebug() << "  -> 在 roomDoors() 中找到房间" << roomIndex << "的下门并打开";
+                            qCDebug(lcRoom) << "  -> 在 roomDoors() 中找到房间" << roomIndex << "的下门并打开";
                             door->open();
                             AudioManager::instance().playSound("door_open");
                         }
@@ -1454,13 +1624,13 @@ void Level::openBossDoors() {
         if (roomCfg.doorLeft >= 0) {
             const RoomConfig& neighborCfg = config.getRoom(roomCfg.doorLeft);
             if (neighborCfg.hasBoss && !room->isDoorOpenLeft()) {
-                qDebug() << "开启房间" << roomIndex << "通往boss房间" << roomCfg.doorLeft << "的左门";
+                qCDebug(lcRoom) << "开启房间" << roomIndex << "通往boss房间" << roomCfg.doorLeft << "的左门";
                 room->setDoorOpenLeft(true);
 
                 if (roomIndex == currentRoomIndex() && !currentDoors().isEmpty()) {
                     for (Door* door : currentDoors()) {
                         if (door && door->direction() == Door::Left) {
-                            qDebug() << "  -> 在当前房间的 currentDoors() 中找到左门并打开";
+                            qCDebug(lcRoom) << "  -> 在当前房间的 currentDoors() 中找到左门并打开";
                             door->open();
                             AudioManager::instance().playSound("door_open");
                         }
@@ -1469,7 +1639,7 @@ void Level::openBossDoors() {
                     const QVector<Door*>& doors = roomDoors()[roomIndex];
                     for (Door* door : doors) {
                         if (door && door->direction() == Door::Left) {
-                            qDebug() << "  -> 在 roomDoors() 中找到房间" << roomIndex << "的左门并打开";
+                            qCDebug(lcRoom) << "  -> 在 roomDoors() 中找到房间" << roomIndex << "的左门并打开";
                             door->open();
                             AudioManager::instance().playSound("door_open");
                         }
@@ -1481,13 +1651,13 @@ void Level::openBossDoors() {
         if (roomCfg.doorRight >= 0) {
             const RoomConfig& neighborCfg = config.getRoom(roomCfg.doorRight);
             if (neighborCfg.hasBoss && !room->isDoorOpenRight()) {
-                qDebug() << "开启房间" << roomIndex << "通往boss房间" << roomCfg.doorRight << "的右门";
+                qCDebug(lcRoom) << "开启房间" << roomIndex << "通往boss房间" << roomCfg.doorRight << "的右门";
                 room->setDoorOpenRight(true);
 
                 if (roomIndex == currentRoomIndex() && !currentDoors().isEmpty()) {
                     for (Door* door : currentDoors()) {
                         if (door && door->direction() == Door::Right) {
-                            qDebug() << "  -> 在当前房间的 currentDoors() 中找到右门并打开";
+                            qCDebug(lcRoom) << "  -> 在当前房间的 currentDoors() 中找到右门并打开";
                             door->open();
                             AudioManager::instance().playSound("door_open");
                         }
@@ -1496,7 +1666,7 @@ void Level::openBossDoors() {
                     const QVector<Door*>& doors = roomDoors()[roomIndex];
                     for (Door* door : doors) {
                         if (door && door->direction() == Door::Right) {
-                            qDebug() << "  -> 在 roomDoors() 中找到房间" << roomIndex << "的右门并打开";
+                            qCDebug(lcRoom) << "  -> 在 roomDoors() 中找到房间" << roomIndex << "的右门并打开";
                             door->open();
                             AudioManager::instance().playSound("door_open");
                         }
@@ -1509,32 +1679,15 @@ void Level::openBossDoors() {
     // 发射boss门开启信号
     emit bossDoorsOpened();
 
-    // 如果当前房间邻接boss房间，需要重新加载门以显示打开状态
-    if (shouldReloadCurrentRoom) {
-        qDebug() << "当前房间" << currentRoomIndex() << "邻接boss房间，重新加载门以显示打开状态";
-
-        // 清除当前所有门
-        for (Door* door : currentDoors()) {
-            if (m_scene && door) {
-                m_scene->removeItem(door);
-            }
-            delete door;
-        }
-        currentDoors().clear();
-
-        // 从缓存中移除
-        roomDoors().remove(currentRoomIndex());
-
-        // 重新生成门（会读取房间状态，boss门已经被设置为打开）
-        const RoomConfig& currentRoomCfg = config.getRoom(currentRoomIndex());
-        spawnDoors(currentRoomCfg);
-
-        qDebug() << "已重新加载当前房间的所有门";
+    // 如果当前房间邻接boss房间，直接在现有门实例上同步打开状态（不再删除重建）
+    if (shouldSyncCurrentRoom) {
+        qCDebug(lcRoom) << "当前房间" << currentRoomIndex() << "邻接boss房间，同步门的打开状态";
+        m_roomManager->syncDoorStates(currentRoomIndex());
     }
 }
 
 void Level::onPlayerDied() {
-    qDebug() << "Level::onPlayerDied - 通知所有敌人移除玩家引用";
+    qCDebug(lcRoom) << "Level::onPlayerDied - 通知所有敌人移除玩家引用";
 
     // 先收集当前全局敌人的原始指针，并断开其 dying 信号，避免在调用 setPlayer 时触发 onEnemyDying 导致容器被修改
     QVector<Enemy*> rawEnemies;
@@ -1587,28 +1740,11 @@ void Level::spawnEnemiesForBoss(const QVector<QPair<QString, int>>& enemies) {
 void Level::setPaused(bool paused) {
     m_isPaused = paused;
 
-    // 暂停/恢复所有当前敌人
-    for (QPointer<Enemy>& enemyPtr : currentEnemies()) {
-        if (Enemy* enemy = enemyPtr.data()) {
-            if (paused) {
-                enemy->pauseTimers();
-            } else {
-                enemy->resumeTimers();
-            }
-        }
-    }
-
-    // 暂停/恢复所有子弹
-    if (m_scene) {
-        QList<QGraphicsItem*> items = m_scene->items();
-        for (QGraphicsItem* item : items) {
-            if (Projectile* projectile = dynamic_cast<Projectile*>(item)) {
-                projectile->setPaused(paused);
-            }
-        }
-    }
+    // 敌人、子弹、掉落物等的定时器都运行在游戏时间域上，停止推进该域即可整体暂停，
+    // 恢复时各定时器从暂停处继续，不会改变原有间隔，也不会恢复被剧情单独冻结的敌人
+    GameClock::instance().setPaused(ClockDomain::Gameplay, paused);
 
-    qDebug() << "Level暂停状态:" << (paused ? "已暂停" : "已恢复");
+    qCDebug(lcRoom) << "Level暂停状态:" << (paused ? "已暂停" : "已恢复");
 }
 
 // ==================== 辅助方法 ====================
@@ -1629,10 +1765,18 @@ void Level::resumeAllEnemyTimers() {
     }
 }
 
+void Level::destroySceneProjectiles() {
+    if (!m_scene)
+        return;
+    for (Projectile* proj : EntityRegistry::instance().inScene<Projectile>(EntityKind::Projectile, m_scene)) {
+        proj->destroy();
+    }
+}
+
 // ==================== Boss通用槽函数 ====================
 
 void Level::onBossRequestDialog(const QStringList& dialogs, const QString& background) {
-    qDebug() << "[Level] Boss请求显示对话";
+    qCDebug(lcRoom) << "[Level] Boss请求显示对话";
 
     // 暂停所有敌人的定时器
     pauseAllEnemyTimers();
@@ -1642,7 +1786,7 @@ void Level::onBossRequestDialog(const QStringList& dialogs, const QString& backg
 }
 
 void Level::onBossRequestAbsorb() {
-    qDebug() << "[Level] Boss请求执行吸纳动画";
+    qCDebug(lcRoom) << "[Level] Boss请求执行吸纳动画";
 
     if (m_currentWashMachineBoss) {
         performAbsorbAnimation(m_currentWashMachineBoss.data());
@@ -1650,7 +1794,7 @@ void Level::onBossRequestAbsorb() {
 }
 
 void Level::onBossRequestFadeDialogBackground(const QString& backgroundPath, int duration) {
-    qDebug() << "[Level] Boss请求渐变对话背景:" << backgroundPath << "持续" << duration << "ms";
+    qCDebug(lcRoom) << "[Level] Boss请求渐变对话背景:" << backgroundPath << "持续" << duration << "ms";
     // 委托给 DialogSystem
     if (m_dialogSystem) {
         m_dialogSystem->setPendingFadeDialogBackground(backgroundPath, duration);
@@ -1658,7 +1802,7 @@ void Level::onBossRequestFadeDialogBackground(const QString& backgroundPath, int
 }
 
 void Level::onBossRequestDialogBackgroundChange(int dialogIndex, const QString& backgroundName) {
-    qDebug() << "[Level] Boss请求在对话索引" << dialogIndex << "时切换背景到:" << backgroundName;
+    qCDebug(lcRoom) << "[Level] Boss请求在对话索引" << dialogIndex << "时切换背景到:" << backgroundName;
     // 委托给 DialogSystem
     if (m_dialogSystem) {
         m_dialogSystem->setDialogBackgroundChange(dialogIndex, backgroundName);
@@ -1673,7 +1817,7 @@ void Level::onBossEnemySpawned(Enemy* enemy) {
             rooms()[currentRoomIndex()]->currentEnemies.append(eptr);
         }
         connect(enemy, &Enemy::dying, this, &Level::onEnemyDying);
-        qDebug() << "[Level] Boss召唤的敌人已追踪";
+        qCDebug(lcRoom) << "[Level] Boss召唤的敌人已追踪";
     }
 }
 
@@ -1684,7 +1828,7 @@ void Level::changeBackground(const QString& backgroundPath) {
     QPixmap bg(backgroundPath);
     if (!bg.isNull()) {
         m_backgroundItem->setPixmap(bg.scaled(800, 600, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
-        qDebug() << "背景已切换为:" << backgroundPath;
+        qCDebug(lcRoom) << "背景已切换为:" << backgroundPath;
     } else {
         qWarning() << "无法加载背景图片:" << backgroundPath;
     }
@@ -1700,14 +1844,7 @@ void Level::performAbsorbAnimation(WashMachineBoss* boss) {
     m_absorbCenter = boss->pos() + QPointF(boss->pixmap().width() / 2.0, boss->pixmap().height() / 2.0);
 
     // 清理场景中所有子弹（避免吸纳期间伤害）
-    if (m_scene) {
-        QList<QGraphicsItem*> allItems = m_scene->items();
-        for (QGraphicsItem* item : allItems) {
-            if (Projectile* proj = dynamic_cast<Projectile*>(item)) {
-                proj->destroy();
-            }
-        }
-    }
+    destroySceneProjectiles();
 
     // 收集所有需要被吸纳的实体（除了Boss本身）
     m_absorbingItems.clear();
@@ -1723,7 +1860,7 @@ void Level::performAbsorbAnimation(WashMachineBoss* boss) {
     m_player->setCanMove(false);
     m_player->setCanShoot(false);
     m_player->setPermanentInvincible(true);  // 吸纳时玩家持久无敌
-    qDebug() << "[吸纳] 玩家已设置为无敌状态";
+    qCDebug(lcRoom) << "[吸纳] 玩家已设置为无敌状态";
 
     // 添加所有敌人（除了Boss）
     for (QPointer<Enemy>& enemyPtr : currentEnemies()) {
@@ -1751,12 +1888,12 @@ void Level::performAbsorbAnimation(WashMachineBoss* boss) {
 
     // 创建吸纳动画定时器
     if (!m_absorbAnimationTimer) {
-        m_absorbAnimationTimer = new QTimer(this);
-        connect(m_absorbAnimationTimer, &QTimer::timeout, this, &Level::onAbsorbAnimationStep);
+        m_absorbAnimationTimer = new GameTimer(this);
+        connect(m_absorbAnimationTimer, &GameTimer::timeout, this, &Level::onAbsorbAnimationStep);
     }
     m_absorbAnimationTimer->start(16);  // 约60fps
 
-    qDebug() << "吸纳动画开始，共" << m_absorbingItems.size() << "个实体";
+    qCDebug(lcRoom) << "吸纳动画开始，共" << m_absorbingItems.size() << "个实体";
 }
 
 void Level::onAbsorbAnimationStep() {
@@ -1776,14 +1913,7 @@ void Level::onAbsorbAnimationStep() {
         m_isAbsorbAnimationActive = false;
 
         // 清理场景中所有子弹（避免对话期间伤害）
-        if (m_scene) {
-            QList<QGraphicsItem*> allItems = m_scene->items();
-            for (QGraphicsItem* item : allItems) {
-                if (Projectile* proj = dynamic_cast<Projectile*>(item)) {
-                    proj->destroy();
-                }
-            }
-        }
+        destroySceneProjectiles();
 
         // 隐藏所有被吸纳的实体（不删除，等待对话后释放）
         for (int i = 0; i < m_absorbingItems.size(); ++i) {
@@ -1795,18 +1925,15 @@ void Level::onAbsorbAnimationStep() {
             item->setVisible(false);
 
             // 如果是敌人，确保其定时器停止
-            if (item != m_player) {
-                Enemy* enemy = dynamic_cast<Enemy*>(item);
-                if (enemy) {
-                    enemy->pauseTimers();
-                }
+            if (item != m_player && isEntityKind(item, EntityKind::Enemy)) {
+                static_cast<Enemy*>(item)->pauseTimers();
             }
         }
 
         // 保存吸纳的实体列表供对话后释放使用
         // m_absorbingItems 保持不清空
 
-        qDebug() << "吸纳动画完成，通知Boss";
+        qCDebug(lcRoom) << "吸纳动画完成，通知Boss";
 
         // 通知Boss吸纳完成
         if (m_currentWashMachineBoss) {
@@ -1856,7 +1983,7 @@ void Level::startBossRewardSequence() {
     if (!m_rewardSystem || m_rewardSystem->isRewardSequenceActive())
         return;
 
-    qDebug() << "[Level] 委托RewardSystem开始Boss奖励流程";
+    qCDebug(lcRoom) << "[Level] 委托RewardSystem开始Boss奖励流程";
 
     // 获取当前房间的奖励配置
     QStringList usagiChestItems;
@@ -1871,7 +1998,7 @@ void Level::startBossRewardSequence() {
 }
 
 void Level::onRewardShowDialogRequested(const QStringList& dialog) {
-    qDebug() << "[Level] RewardSystem请求显示对话";
+    qCDebug(lcRoom) << "[Level] RewardSystem请求显示对话";
 
     // 显示对话（使用透明背景，保持游戏画面可见）
     showStoryDialog(dialog, false, "transparent");
@@ -1885,7 +2012,7 @@ void Level::onRewardShowDialogRequested(const QStringList& dialog) {
 }
 
 void Level::onRewardSequenceCompleted() {
-    qDebug() << "[Level] RewardSystem奖励流程完成";
+    qCDebug(lcRoom) << "[Level] RewardSystem奖励流程完成";
     // RewardSystem已经处理了G键激活逻辑
     // Level只需要在这里做额外的清理或通知（如果需要的话）
 }
@@ -1896,7 +2023,7 @@ void Level::checkEliteRoomPhase2() {
     if (!m_isEliteRoom || m_elitePhase2Triggered)
         return;
 
-    qDebug() << "准备触发精英房间第二阶段";
+    qCDebug(lcRoom) << "准备触发精英房间第二阶段";
     m_elitePhase2Triggered = true;
 
     // 暂停所有敌人的定时器
@@ -1913,7 +2040,7 @@ void Level::checkEliteRoomPhase2() {
     const RoomConfig& roomCfg = config.getRoom(currentRoomIndex());
 
     if (roomCfg.elitePhase2Dialog.isEmpty()) {
-        qDebug() << "没有第二阶段对话，直接开始第二阶段";
+        qCDebug(lcRoom) << "没有第二阶段对话，直接开始第二阶段";
         startElitePhase2();
         return;
     }
@@ -1924,7 +2051,7 @@ void Level::checkEliteRoomPhase2() {
 }
 
 void Level::startElitePhase2() {
-    qDebug() << "开始精英房间第二阶段";
+    qCDebug(lcRoom) << "开始精英房间第二阶段";
 
     // 生成祝昊
     spawnZhuhaoEnemy();
@@ -1934,7 +2061,7 @@ void Level::startElitePhase2() {
 }
 
 void Level::spawnZhuhaoEnemy() {
-    qDebug() << "生成祝昊敌人";
+    qCDebug(lcRoom) << "生成祝昊敌人";
 
     if (!m_scene || !m_player) {
         qWarning() << "无法生成祝昊：场景或玩家为空";
@@ -1976,7 +2103,7 @@ void Level::spawnZhuhaoEnemy() {
     // 保存引用
     m_zhuhaoEnemy = zhuhao;
 
-    qDebug() << "祝昊已生成，位置:" << zhuhao->pos();
+    qCDebug(lcRoom) << "祝昊已生成，位置:" << zhuhao->pos();
 }
 
 // ==================== G键进入下一关相关方法 ====================
@@ -1999,7 +2126,7 @@ void Level::showGKeyHint() {
     m_gKeyHintText->setZValue(9000);  // 确保在大部分元素之上
     m_scene->addItem(m_gKeyHintText);
 
-    qDebug() << "[Level] 显示G键提示";
+    qCDebug(lcRoom) << "[Level] 显示G键提示";
 }
 
 void Level::hideGKeyHint() {
@@ -2009,7 +2136,7 @@ void Level::hideGKeyHint() {
         }
         delete m_gKeyHintText;
         m_gKeyHintText = nullptr;
-        qDebug() << "[Level] 隐藏G键提示";
+        qCDebug(lcRoom) << "[Level] 隐藏G键提示";
     }
 }
 
@@ -2019,11 +2146,11 @@ bool Level::isGKeyEnabled() const {
 
 void Level::triggerNextLevelByGKey() {
     if (!isGKeyEnabled()) {
-        qDebug() << "[Level] G键未激活，忽略";
+        qCDebug(lcRoom) << "[Level] G键未激活，忽略";
         return;
     }
 
-    qDebug() << "[Level] G键触发进入下一关";
+    qCDebug(lcRoom) << "[Level] G键触发进入下一关";
 
     // 禁用G键
     if (m_rewardSystem) {
@@ -4,8 +4,10 @@
 #include <QObject>
 #include <QPointer>
 #include <QPropertyAnimation>
+#include <QRandomGenerator>
 #include <QTimer>
 #include <QVector>
+#include "../core/gametimer.h"
 #include "../items/droppeditem.h"
 #include "../ui/dialogsystem.h"
 #include "door.h"
@@ -40,6 +42,12 @@ class Level : public QObject {
     void loadRoom(int roomIndex);
     void onPlayerDied();
 
+    /**
+     * @brief 从进入当前房间时的快照重试（死亡后"再试一次"）
+     * @return 当前房间不可重试（Boss/精英房间、带着旧敌人再次进入）或快照无效时返回 false，由调用方冷启动
+     */
+    bool retryFromRoomStart();
+
     // 物品掉落系统
     void dropRandomItem(QPointF position);                                         // 在指定位置掉落随机物品
     void dropItemsFromPosition(QPointF position, int count, bool scatter = true);  // 从指定位置掉落多个物品（散开效果）
@@ -95,6 +103,11 @@ class Level : public QObject {
     void spawnEnemiesInRoom(int roomIndex);
     void spawnChestsInRoom(int roomIndex);
     void spawnDoors(const RoomConfig& roomCfg);
+    void registerExitTriggers(Room* room);  // 为当前房间的各个出口注册触发区域
+
+    // 房间重试快照：生成实体之前记录，同时为本房间设定随机数种子
+    void captureRoomSnapshot(const RoomConfig& roomCfg, bool firstEntry);
+    void syncRoomSnapshotDoors();  // 进入房间后门的开关有变化时同步到快照
     void buildMinimapData();  // New method
 
     // Boss工厂方法：根据关卡号创建对应的Boss实例（使用BossFactory并连接信号）
@@ -121,6 +134,9 @@ class Level : public QObject {
 
     void resumeAllEnemyTimers();
 
+    // 销毁场景中的所有子弹（遍历 EntityRegistry，无需扫描整个场景）
+    void destroySceneProjectiles();
+
     // G键提示相关
     void showGKeyHint();  // 显示G键提示
     void hideGKeyHint();  // 隐藏G键提示
@@ -151,7 +167,6 @@ class Level : public QObject {
     int m_levelNumber;
     Player* m_player;
     QGraphicsScene* m_scene;
-    QTimer* checkChange;
 
     bool m_skipToBoss = false;  // 开发者模式：直接跳过到Boss房
 
@@ -175,7 +190,7 @@ class Level : public QObject {
 
     // 吸纳动画相关
     bool m_isAbsorbAnimationActive = false;
-    QTimer* m_absorbAnimationTimer = nullptr;
+    GameTimer* m_absorbAnimationTimer = nullptr;
     QVector<QGraphicsItem*> m_absorbingItems;
     QVector<QPointF> m_absorbStartPositions;
     QVector<double> m_absorbAngles;
@@ -196,6 +211,12 @@ class Level : public QObject {
     bool m_isEliteDialog = false;         // 是否正在显示精英房间对话
     QPointer<ZhuhaoEnemy> m_zhuhaoEnemy;  // zhuhao精英怪引用
 
+    // 房间重试
+    QByteArray m_roomStartSnapshot;  // 进入当前房间时的世界快照（WorldSnapshot 二进制），空表示不可重试
+    bool m_reuseRoomSeed = false;    // 重试时沿用快照中的随机数种子
+    quint32 m_roomSeed = 0;
+    QRandomGenerator m_roomRng;      // 房间生成专用（敌人、宝箱位置），进入房间时按 m_roomSeed 播种
+
    public slots:
 
     void showPhaseTransitionText(const QString& text, const QColor& color = QColor(75, 0, 130));  // 显示阶段转换文字提示（可被信号连接或直接调用）
@@ -3,6 +3,7 @@
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonParseError>
+#include "../core/logging.h"
 
 LevelConfig::LevelConfig() : m_startRoomIndex(0) {
 }
@@ -60,7 +61,7 @@ bool LevelConfig::loadFromJson(const QJsonObject& levelObj) {
         return false;
     }
 
-    qDebug() << "加载关卡配置成功:" << m_levelName << "共" << m_rooms.size() << "个房间";
+    qCDebug(lcRoom) << "加载关卡配置成功:" << m_levelName << "共" << m_rooms.size() << "个房间";
     return true;
 }
 
@@ -0,0 +1,38 @@
+#include "projectilepool.h"
+#include "../core/objectcensus.h"
+#include "../entities/projectile.h"
+
+ProjectilePool &ProjectilePool::instance() {
+    static ProjectilePool instance;
+    return instance;
+}
+
+Projectile *ProjectilePool::acquire(int mode, double hurt, const QPointF &pos, const QPixmap &pixmap) {
+    if (!m_idle.isEmpty()) {
+        Projectile *projectile = m_idle.takeLast();
+        ObjectCensus::instance().setRetained(projectile, false);
+        projectile->reset(mode, hurt, pos, pixmap);
+        return projectile;
+    }
+    auto *projectile = new Projectile(mode, hurt, pos, pixmap, 1.0);
+    projectile->setPooled(true);
+    return projectile;
+}
+
+bool ProjectilePool::release(Projectile *projectile) {
+    if (!projectile || !projectile->isPooled())
+        return false;
+    if (m_idle.contains(projectile))
+        return true;  // 同一帧内重复销毁
+    if (m_idle.size() >= kMaxIdle)
+        return false;
+
+    m_idle.append(projectile);
+    ObjectCensus::instance().setRetained(projectile, true);  // 空闲对象不计入房间清空检查点
+    return true;
+}
+
+void ProjectilePool::clear() {
+    qDeleteAll(m_idle);
+    m_idle.clear();
+}
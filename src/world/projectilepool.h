@@ -0,0 +1,54 @@
+#ifndef PROJECTILEPOOL_H
+#define PROJECTILEPOOL_H
+
+#include <QPixmap>
+#include <QPointF>
+#include <QVector>
+
+class Projectile;
+
+/**
+ * @brief 子弹对象池 - 复用弹幕发射的敌方子弹
+ *
+ * Boss 弹幕一次发射十几到几十发、飞出屏幕后又成批销毁。池化子弹销毁时
+ * 由 Projectile::destroy() 停止定时器、移出场景后放回空闲列表；
+ * 下次发射时 reset() 复用，不再重新创建 QObject、定时器和碰撞掩码。
+ *
+ * 空闲对象不在任何场景中，由 clear() 统一销毁（重新开始游戏时调用）。
+ */
+class ProjectilePool {
+public:
+    static ProjectilePool &instance();
+
+    static constexpr int kMaxIdle = 256;  // 最多保留的空闲子弹
+
+    /**
+     * @brief 取出一发子弹（空闲列表为空时新建）
+     * @return 定时器运行中、尚未加入场景的子弹
+     */
+    Projectile *acquire(int mode, double hurt, const QPointF &pos, const QPixmap &pixmap);
+
+    /**
+     * @brief 回收一发已销毁的池化子弹
+     * @return 已放回空闲列表时返回 true；未池化或空闲列表已满时返回 false，由调用方删除
+     */
+    bool release(Projectile *projectile);
+
+    [[nodiscard]] int idleCount() const { return m_idle.size(); }
+
+    /**
+     * @brief 销毁所有空闲子弹
+     */
+    void clear();
+
+private:
+    ProjectilePool() = default;
+
+    ProjectilePool(const ProjectilePool &) = delete;
+
+    ProjectilePool &operator=(const ProjectilePool &) = delete;
+
+    QVector<Projectile *> m_idle;
+};
+
+#endif // PROJECTILEPOOL_H
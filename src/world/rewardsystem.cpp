@@ -1,6 +1,7 @@
 #include "rewardsystem.h"
 #include <QDebug>
 #include <QGraphicsScene>
+#include "../core/logging.h"
 #include "../entities/player.h"
 #include "../entities/usagi.h"
 #include "../items/droppeditem.h"
@@ -26,7 +27,7 @@ void RewardSystem::dropRandomItem(const QPointF& position) {
         return;
 
     DroppedItemFactory::dropRandomItem(ItemDropPool::ENEMY_DROP, position, m_player, m_scene);
-    qDebug() << "[RewardSystem] 在位置" << position << "掉落随机物品";
+    qCDebug(lcRoom) << "[RewardSystem] 在位置" << position << "掉落随机物品";
 }
 
 void RewardSystem::dropItemsFromPosition(const QPointF& position, int count, bool scatter) {
@@ -35,7 +36,7 @@ void RewardSystem::dropItemsFromPosition(const QPointF& position, int count, boo
 
     Q_UNUSED(scatter)  // 工厂类自动处理散开效果
     DroppedItemFactory::dropItemsScattered(ItemDropPool::ENEMY_DROP, position, count, m_player, m_scene);
-    qDebug() << "[RewardSystem] 从位置" << position << "掉落" << count << "个物品";
+    qCDebug(lcRoom) << "[RewardSystem] 从位置" << position << "掉落" << count << "个物品";
 }
 
 bool RewardSystem::shouldEnemyDropItem() {
@@ -48,7 +49,7 @@ void RewardSystem::startBossRewardSequence(int levelNumber, const QStringList& c
 
     m_rewardSequenceActive = true;
     m_currentLevel = levelNumber;
-    qDebug() << "[RewardSystem] 开始Boss奖励流程，关卡:" << levelNumber;
+    qCDebug(lcRoom) << "[RewardSystem] 开始Boss奖励流程，关卡:" << levelNumber;
 
     // 创建乌萨奇
     m_usagi = new Usagi(m_scene, m_player, levelNumber, chestItems, this);
@@ -59,13 +60,13 @@ void RewardSystem::startBossRewardSequence(int levelNumber, const QStringList& c
 
     // 连接车票创建信号（第三关）
     connect(m_usagi, &Usagi::ticketCreated, this, [this](DroppedItem* ticket) {
-        qDebug() << "[RewardSystem] 收到Usagi的ticketCreated信号";
+        qCDebug(lcRoom) << "[RewardSystem] 收到Usagi的ticketCreated信号";
         if (ticket) {
             connect(ticket, &DroppedItem::ticketPickedUp, this, [this]() {
-                qDebug() << "[RewardSystem] 车票被拾取！";
+                qCDebug(lcRoom) << "[RewardSystem] 车票被拾取！";
                 emit ticketPickedUp();
             });
-            qDebug() << "[RewardSystem] 已连接车票的ticketPickedUp信号";
+            qCDebug(lcRoom) << "[RewardSystem] 已连接车票的ticketPickedUp信号";
         }
     });
 
@@ -74,12 +75,12 @@ void RewardSystem::startBossRewardSequence(int levelNumber, const QStringList& c
 }
 
 void RewardSystem::onUsagiRequestShowDialog(const QStringList& dialog) {
-    qDebug() << "[RewardSystem] 乌萨奇请求显示对话";
+    qCDebug(lcRoom) << "[RewardSystem] 乌萨奇请求显示对话";
     emit requestShowDialog(dialog);
 }
 
 void RewardSystem::onUsagiRewardCompleted() {
-    qDebug() << "[RewardSystem] 乌萨奇奖励流程完成";
+    qCDebug(lcRoom) << "[RewardSystem] 乌萨奇奖励流程完成";
 
     // 标记Boss房间已通关
     m_bossRoomCleared = true;
@@ -87,9 +88,9 @@ void RewardSystem::onUsagiRewardCompleted() {
     // 第三关不激活G键（因为拾取车票后会触发通关动画）
     if (m_currentLevel != 3) {
         enableGKey();
-        qDebug() << "[RewardSystem] G键已激活，等待玩家按G进入下一关";
+        qCDebug(lcRoom) << "[RewardSystem] G键已激活，等待玩家按G进入下一关";
     } else {
-        qDebug() << "[RewardSystem] 第三关不激活G键，等待玩家拾取车票";
+        qCDebug(lcRoom) << "[RewardSystem] 第三关不激活G键，等待玩家拾取车票";
     }
 
     m_rewardSequenceActive = false;
@@ -110,7 +111,7 @@ void RewardSystem::disableGKey() {
 
 void RewardSystem::onDialogFinished() {
     if (m_usagi) {
-        qDebug() << "[RewardSystem] 通知Usagi对话已结束";
+        qCDebug(lcRoom) << "[RewardSystem] 通知Usagi对话已结束";
         m_usagi->onDialogFinished();
     }
 }
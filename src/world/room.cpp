@@ -1,16 +1,20 @@
 #include "room.h"
 #include <QDebug>
 #include <QGraphicsScene>
-#include "../items/droppeditem.h"
+#include "../core/logging.h"
+#include "../items/droppeditemfactory.h"
+#include "entityregistry.h"
 
-Room::Room() {}
+Room::Room(bool u, bool d, bool l, bool r) : up(u), down(d), left(l), right(r) {
+    // 门默认为关闭状态（不可通行），Level 会在合适时机打开；默认不是战斗房间
+}
 
 Room::~Room() {
     // 清理敌人（停止定时器并删除）
     for (QPointer<Enemy> enemyPtr : currentEnemies) {
         if (Enemy* enemy = enemyPtr.data()) {
             // 断开所有信号连接
-            disconnect(enemy, nullptr, nullptr, nullptr);
+            QObject::disconnect(enemy, nullptr, nullptr, nullptr);
             delete enemy;
         }
     }
@@ -19,7 +23,7 @@ Room::~Room() {
     // 清理宝箱
     for (QPointer<Chest> chestPtr : currentChests) {
         if (Chest* chest = chestPtr.data()) {
-            disconnect(chest, nullptr, nullptr, nullptr);
+            QObject::disconnect(chest, nullptr, nullptr, nullptr);
             delete chest;
         }
     }
@@ -29,63 +33,27 @@ Room::~Room() {
     clearDroppedItems();
 }
 
-Room::Room(Player* p, bool u, bool d, bool l, bool r) : up(u), down(d), left(l), right(r), door_size(100) {
-    player = p;
-    change_x = 0;
-    change_y = 0;
-
-    // 默认门为关闭状态（不可通行），Level 会在合适时机打开
-    openUp = false;
-    openDown = false;
-    openLeft = false;
-    openRight = false;
-
-    // 默认不是战斗房间
-    m_isBattleRoom = false;
-    m_battleStarted = false;
-    m_isCleared = false;
-
-    changeTimer = new QTimer(this);
-    connect(changeTimer, &QTimer::timeout, this, &Room::testChange);
-}
-
-void Room::startChangeTimer() {
-    if (changeTimer)
-        changeTimer->start(12);
-}
-
-void Room::stopChangeTimer() {
-    if (changeTimer)
-        changeTimer->stop();
+void Room::setExitCheckEnabled(bool enabled) {
+    m_exitCheckEnabled = enabled;
+    if (!enabled) {
+        resetChangeDir();
+    }
 }
 
 void Room::setDoorOpenUp(bool v) {
-    if (!openUp && v) {
-        // 门从关闭变为打开，发射开门信号（用于触发动画）
-        emit doorOpened(0);  // 0 = 上
-    }
     openUp = v;
 }
 
 void Room::setDoorOpenDown(bool v) {
-    if (!openDown && v) {
-        emit doorOpened(1);  // 1 = 下
-    }
     openDown = v;
-    qDebug() << "setDoorOpenDown 被调用，down=" << down << ", openDown=" << openDown;
+    qCDebug(lcRoom) << "setDoorOpenDown 被调用，down=" << down << ", openDown=" << openDown;
 }
 
 void Room::setDoorOpenLeft(bool v) {
-    if (!openLeft && v) {
-        emit doorOpened(2);  // 2 = 左
-    }
     openLeft = v;
 }
 
 void Room::setDoorOpenRight(bool v) {
-    if (!openRight && v) {
-        emit doorOpened(3);  // 3 = 右
-    }
     openRight = v;
 }
 
@@ -105,33 +73,51 @@ bool Room::isDoorOpenRight() const {
     return openRight;
 }
 
-void Room::testChange() {
-    int sz = door_size / 2;
-    int x = player->pos().x(), y = player->pos().y();
-
+void Room::testChange(const QPointF& playerPos) {
     // 重置切换方向
     change_x = 0;
     change_y = 0;
 
+    if (!m_exitCheckEnabled)
+        return;
+
+    int sz = door_size / 2;
+    int x = playerPos.x(), y = playerPos.y();
+
     // 只要玩家到达边缘且门是打开的，就触发切换，无需按键
     if (up && openUp && y <= 40 && qAbs(x - 400) < sz) {
         change_y = -1;
-        qDebug() << "检测到向上切换请求，玩家位置:" << x << "," << y;
+        qCDebug(lcRoom) << "检测到向上切换请求，玩家位置:" << x << "," << y;
     }
     if (down && openDown && y >= 560 && qAbs(x - 400) < sz) {
         change_y = 1;
-        qDebug() << "检测到向下切换请求，玩家位置:" << x << "," << y;
+        qCDebug(lcRoom) << "检测到向下切换请求，玩家位置:" << x << "," << y;
     }
     if (left && openLeft && x <= 40 && qAbs(y - 300) < sz) {
         change_x = -1;
-        qDebug() << "检测到向左切换请求，玩家位置:" << x << "," << y;
+        qCDebug(lcRoom) << "检测到向左切换请求，玩家位置:" << x << "," << y;
     }
     if (right && openRight && x >= 760 && qAbs(y - 300) < sz) {
         change_x = 1;
-        qDebug() << "检测到向右切换请求，玩家位置:" << x << "," << y;
+        qCDebug(lcRoom) << "检测到向右切换请求，玩家位置:" << x << "," << y;
     }
 }
 
+QRectF Room::exitArea(int dx, int dy) const {
+    // 与 testChange 的判定一致，房间外侧留足余量
+    const qreal sz = door_size / 2;
+    const qreal far = 1000;
+    if (dy < 0 && up)
+        return QRectF(400 - sz, -far, sz * 2, far + 40);
+    if (dy > 0 && down)
+        return QRectF(400 - sz, 560, sz * 2, far);
+    if (dx < 0 && left)
+        return QRectF(-far, 300 - sz, far + 40, sz * 2);
+    if (dx > 0 && right)
+        return QRectF(760, 300 - sz, far, sz * 2);
+    return {};
+}
+
 void Room::setBattleRoom(bool isBattle) {
     m_isBattleRoom = isBattle;
 }
@@ -170,44 +156,88 @@ void Room::saveDroppedItemsFromScene(QGraphicsScene* scene) {
         return;
 
     // 清空之前保存的物品（防止重复）
-    currentDroppedItems.clear();
+    clearDroppedItems();
+
+    for (DroppedItem* droppedItem : EntityRegistry::instance().inScene<DroppedItem>(EntityKind::DroppedItem, scene)) {
+        // 正在播放拾取动画的物品留给它自己完成并销毁
+        if (droppedItem->isPickingUp())
+            continue;
 
-    QList<QGraphicsItem*> allItems = scene->items();
-    for (QGraphicsItem* item : allItems) {
-        if (auto droppedItem = dynamic_cast<DroppedItem*>(item)) {
-            scene->removeItem(droppedItem);
-            currentDroppedItems.append(QPointer<DroppedItem>(droppedItem));
+        scene->removeItem(droppedItem);
+
+        // 车票的拾取信号连接在奖励流程上，无法从快照重建，保留原对象（注销拾取区域，不在场景中时不能拾取）
+        if (droppedItem->getType() == DroppedItemType::TICKET) {
+            droppedItem->suspendPickup();
+            m_liveDroppedItems.append(QPointer<DroppedItem>(droppedItem));
+            continue;
         }
+
+        m_droppedItems.append({droppedItem->getType(), droppedItem->restingPos()});
+        delete droppedItem;
     }
 
-    if (!currentDroppedItems.isEmpty()) {
-        qDebug() << "Room: 保存了" << currentDroppedItems.size() << "个掉落物品";
+    if (savedDroppedItemCount() > 0) {
+        qCDebug(lcRoom) << "Room: 保存了" << savedDroppedItemCount() << "个掉落物品";
     }
 }
 
-void Room::restoreDroppedItemsToScene(QGraphicsScene* scene) {
+void Room::restoreDroppedItemsToScene(QGraphicsScene* scene, Player* player) {
     if (!scene)
         return;
 
     int restoredCount = 0;
-    for (QPointer<DroppedItem> itemPtr : currentDroppedItems) {
+    for (const DroppedItemState& state : m_droppedItems) {
+        if (DroppedItemFactory::createDroppedItem(state.type, state.pos, player, scene)) {
+            restoredCount++;
+        }
+    }
+    m_droppedItems.clear();
+
+    for (QPointer<DroppedItem> itemPtr : m_liveDroppedItems) {
         if (DroppedItem* item = itemPtr.data()) {
             scene->addItem(item);
+            item->resumePickup();
             restoredCount++;
         }
     }
+    m_liveDroppedItems.clear();
 
     if (restoredCount > 0) {
-        qDebug() << "Room: 恢复了" << restoredCount << "个掉落物品到场景";
+        qCDebug(lcRoom) << "Room: 恢复了" << restoredCount << "个掉落物品到场景";
     }
 }
 
+RoomState Room::saveState() const {
+    RoomState state;
+    state.openUp = openUp;
+    state.openDown = openDown;
+    state.openLeft = openLeft;
+    state.openRight = openRight;
+    state.battleStarted = m_battleStarted;
+    state.cleared = m_isCleared;
+    state.droppedItems = m_droppedItems;
+    return state;
+}
+
+void Room::restoreState(const RoomState& state) {
+    openUp = state.openUp;
+    openDown = state.openDown;
+    openLeft = state.openLeft;
+    openRight = state.openRight;
+    m_battleStarted = state.battleStarted;
+    m_isCleared = state.cleared;
+    m_droppedItems = state.droppedItems;
+    resetChangeDir();
+}
+
 void Room::clearDroppedItems() {
-    for (QPointer<DroppedItem> itemPtr : currentDroppedItems) {
+    m_droppedItems.clear();
+
+    for (QPointer<DroppedItem> itemPtr : m_liveDroppedItems) {
         if (DroppedItem* item = itemPtr.data()) {
-            disconnect(item, nullptr, nullptr, nullptr);
+            QObject::disconnect(item, nullptr, nullptr, nullptr);
             delete item;
         }
     }
-    currentDroppedItems.clear();
+    m_liveDroppedItems.clear();
 }
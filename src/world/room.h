@@ -1,42 +1,72 @@
 #ifndef ROOM_H
 #define ROOM_H
 
-#include <QPixmap>
+#include <QPointF>
 #include <QPointer>
-#include <QTimer>
+#include <QRectF>
+#include <QVector>
 #include "chest.h"
+#include "droppeditem.h"
 #include "enemy.h"
 #include "player.h"
 
-class DroppedItem;
+class QGraphicsScene;
 
-class Room : public QGraphicsScene {
-    Q_OBJECT
+/**
+ * @brief 离开房间时保存的掉落物品快照（只记录类型和位置）
+ */
+struct DroppedItemState {
+    DroppedItemType type;
+    QPointF pos;
+};
+
+/**
+ * @brief 房间可变状态的值快照（门、战斗进度、保存的掉落物品），用于房间重试
+ */
+struct RoomState {
+    bool openUp = false;
+    bool openDown = false;
+    bool openLeft = false;
+    bool openRight = false;
+    bool battleStarted = false;
+    bool cleared = false;
+    QVector<DroppedItemState> droppedItems;
+};
 
-    int door_size;
-    int change_x;
-    int change_y;
-    QTimer* changeTimer;
-    Player* player;
+/**
+ * @brief 房间状态 - 纯数据对象
+ *
+ * 所有渲染都在 GameView 的同一个场景中进行，房间只记录门的开关、战斗状态、
+ * 留在房间里的敌人/宝箱，以及离开时掉落物品的值快照。
+ * 掉落物品离开房间时被销毁，重新进入时按快照重建，不再把对象移出/移回场景。
+ */
+class Room {
+    int door_size = 100;
+    int change_x = 0;
+    int change_y = 0;
     bool up, down, left, right;  // 各个方向上是否有门存在
     // 门的是否“打开”状态（是否可通行）
-    bool openUp;
-    bool openDown;
-    bool openLeft;
-    bool openRight;
-    bool m_isBattleRoom;   // 是否是战斗房间
-    bool m_battleStarted;  // 战斗是否已开始（首次进入触发）
-    bool m_isCleared;      // 房间是否已被清除（开发者模式跳关用）
+    bool openUp = false;
+    bool openDown = false;
+    bool openLeft = false;
+    bool openRight = false;
+    bool m_exitCheckEnabled = false;  // 是否检测玩家走出房门（Level 负责开启/关闭）
+    bool m_isBattleRoom = false;      // 是否是战斗房间
+    bool m_battleStarted = false;     // 战斗是否已开始（首次进入触发）
+    bool m_isCleared = false;         // 房间是否已被清除（开发者模式跳关用）
+
+    QVector<DroppedItemState> m_droppedItems;            // 离开房间时保存的掉落物品
+    QVector<QPointer<DroppedItem>> m_liveDroppedItems;   // 带信号连接的物品（车票）保留原对象
 
    public:
-    Room();
-    ~Room();  // 清理敌人和宝箱
+    Room(bool u, bool d, bool l, bool r);
+    ~Room();  // 清理敌人、宝箱和保留的掉落物品
 
-    Room(Player* p, bool u, bool d, bool l, bool r);
+    Room(const Room&) = delete;
+    Room& operator=(const Room&) = delete;
 
-    QVector<QPointer<Enemy>> currentEnemies;             // 当前房间敌人
-    QVector<QPointer<Chest>> currentChests;              // 当前房间宝箱
-    QVector<QPointer<DroppedItem>> currentDroppedItems;  // 当前房间掉落物品
+    QVector<QPointer<Enemy>> currentEnemies;  // 当前房间敌人
+    QVector<QPointer<Chest>> currentChests;   // 当前房间宝箱
     int getChangeX() { return change_x; };
 
     int getChangeY() { return change_y; };
@@ -46,10 +76,21 @@ class Room : public QGraphicsScene {
         change_y = 0;
     };
 
-    // 控制每个房间的切换检测定时器（Level 负责启动/停止）
-    void startChangeTimer();
+    // 出门检测开关（替代原来每个房间各自的切换检测定时器）
+    void setExitCheckEnabled(bool enabled);
+
+    bool isExitCheckEnabled() const { return m_exitCheckEnabled; }
+
+    /**
+     * @brief 根据玩家位置计算切换方向（玩家进入出口触发区域时由 Level 调用）
+     */
+    void testChange(const QPointF& playerPos);
 
-    void stopChangeTimer();
+    /**
+     * @brief 某个方向出口的区域（玩家位置坐标），dx/dy 与 getChangeX/Y 含义相同
+     * @return 该方向没有门时返回空矩形
+     */
+    [[nodiscard]] QRectF exitArea(int dx, int dy) const;
 
     // 门控制
     void setDoorOpenUp(bool v);
@@ -74,18 +115,14 @@ class Room : public QGraphicsScene {
 
     // 掉落物品管理
     void saveDroppedItemsFromScene(QGraphicsScene* scene);
-    void restoreDroppedItemsToScene(QGraphicsScene* scene);
+    void restoreDroppedItemsToScene(QGraphicsScene* scene, Player* player);
     void clearDroppedItems();
 
-    void testChange();
+    [[nodiscard]] int savedDroppedItemCount() const { return m_droppedItems.size() + m_liveDroppedItems.size(); }
 
-   signals:
-
-    /**
-     * @brief 门打开信号（用于触发开门动画）
-     * @param direction 门的方向：0=上，1=下，2=左，3=右
-     */
-    void doorOpened(int direction);
+    // 房间重试：保存/恢复可变状态（保留的车票等原对象不在快照中，恢复时保持不变）
+    [[nodiscard]] RoomState saveState() const;
+    void restoreState(const RoomState& state);
 };
 
 #endif  // ROOM_H
@@ -4,13 +4,16 @@
 #include <QRandomGenerator>
 #include <QtMath>
 #include "../core/configmanager.h"
+#include "../core/logging.h"
 #include "../core/resourcefactory.h"
+#include "../core/timerwheel.h"
 #include "../entities/boss.h"
 #include "../entities/enemy.h"
 #include "../entities/level_1/clockboom.h"
 #include "../entities/player.h"
 #include "../items/chest.h"
 #include "../items/droppeditemfactory.h"
+#include "enemypool.h"
 #include "factory/bossfactory.h"
 #include "factory/enemyfactory.h"
 
@@ -23,13 +26,6 @@ RoomManager::~RoomManager() {
 }
 
 void RoomManager::cleanup() {
-    // 清理定时器
-    if (m_checkChangeTimer) {
-        m_checkChangeTimer->stop();
-        delete m_checkChangeTimer;
-        m_checkChangeTimer = nullptr;
-    }
-
     // 断开所有敌人信号
     for (QPointer<Enemy> ePtr : m_currentEnemies) {
         if (Enemy* e = ePtr.data()) {
@@ -76,7 +72,7 @@ bool RoomManager::createRooms(const LevelConfig& config) {
 
     for (int i = 0; i < roomCount; ++i) {
         const RoomConfig& roomCfg = config.getRoom(i);
-        Room* room = new Room();
+        Room* room = new Room(roomCfg.doorUp >= 0, roomCfg.doorDown >= 0, roomCfg.doorLeft >= 0, roomCfg.doorRight >= 0);
         // Room类使用setBattleRoom，并通过检查hasBoss来判断是否战斗房间
         room->setBattleRoom(roomCfg.hasBoss || roomCfg.enemyCount > 0);
         m_rooms[i] = room;
@@ -118,10 +114,10 @@ bool RoomManager::loadRoom(int roomIndex) {
         return false;
     }
 
-    // 停止所有房间的定时器
+    // 关闭所有房间的出门检测
     for (Room* r : m_rooms) {
         if (r)
-            r->stopChangeTimer();
+            r->setExitCheckEnabled(false);
     }
 
     clearSceneEntities();
@@ -153,7 +149,7 @@ bool RoomManager::loadRoom(int roomIndex) {
     }
 
     // 恢复掉落物品
-    targetRoom->restoreDroppedItemsToScene(m_scene);
+    targetRoom->restoreDroppedItemsToScene(m_scene, m_player);
 
     if (m_player) {
         m_player->setZValue(100);
@@ -162,7 +158,7 @@ bool RoomManager::loadRoom(int roomIndex) {
     emit roomEntered(roomIndex);
 
     if (targetRoom) {
-        targetRoom->startChangeTimer();
+        targetRoom->setExitCheckEnabled(true);
     }
 
     return true;
@@ -268,30 +264,15 @@ void RoomManager::spawnDoors(const RoomConfig& roomCfg) {
     // 检查是否已有该房间的门
     if (m_roomDoors.contains(m_currentRoomIndex)) {
         m_currentDoors = m_roomDoors[m_currentRoomIndex];
-        Room* room = m_rooms[m_currentRoomIndex];
 
         for (Door* door : m_currentDoors) {
             if (door) {
                 m_scene->addItem(door);
-
-                // 更新门状态
-                if (door->state() != Door::Open && room) {
-                    bool shouldBeOpen = false;
-                    if (door->direction() == Door::Up && room->isDoorOpenUp())
-                        shouldBeOpen = true;
-                    else if (door->direction() == Door::Down && room->isDoorOpenDown())
-                        shouldBeOpen = true;
-                    else if (door->direction() == Door::Left && room->isDoorOpenLeft())
-                        shouldBeOpen = true;
-                    else if (door->direction() == Door::Right && room->isDoorOpenRight())
-                        shouldBeOpen = true;
-
-                    if (shouldBeOpen) {
-                        door->setOpenState();
-                    }
-                }
             }
         }
+
+        // 更新门状态
+        syncDoorStates(m_currentRoomIndex);
         return;
     }
 
@@ -340,6 +321,39 @@ void RoomManager::spawnDoors(const RoomConfig& roomCfg) {
     m_roomDoors[m_currentRoomIndex] = m_currentDoors;
 }
 
+void RoomManager::syncDoorStates(int roomIndex) {
+    if (!m_roomDoors.contains(roomIndex) || roomIndex < 0 || roomIndex >= m_rooms.size())
+        return;
+
+    Room* room = m_rooms[roomIndex];
+    if (!room)
+        return;
+
+    for (Door* door : m_roomDoors[roomIndex]) {
+        if (!door)
+            continue;
+
+        bool shouldBeOpen = false;
+        if (door->direction() == Door::Up && room->isDoorOpenUp())
+            shouldBeOpen = true;
+        else if (door->direction() == Door::Down && room->isDoorOpenDown())
+            shouldBeOpen = true;
+        else if (door->direction() == Door::Left && room->isDoorOpenLeft())
+            shouldBeOpen = true;
+        else if (door->direction() == Door::Right && room->isDoorOpenRight())
+            shouldBeOpen = true;
+
+        // 两个方向都同步：重试恢复快照后，快照之后打开的门要重新关上；
+        // 应当打开且正在播放开门动画的门保持动画
+        if (shouldBeOpen) {
+            if (door->state() == Door::Closed)
+                door->setOpenState();
+        } else {
+            door->setClosedState();
+        }
+    }
+}
+
 void RoomManager::openDoors() {
     LevelConfig config;
     if (!config.loadFromFile(m_levelNumber)) {
@@ -360,7 +374,7 @@ void RoomManager::openDoors() {
 
         // Boss门特殊处理
         if (neighborCfg.hasBoss && !canOpenBossDoor()) {
-            qDebug() << "RoomManager: 门通往Boss房间" << neighborRoom << "，但条件不满足";
+            qCDebug(lcRoom) << "RoomManager: 门通往Boss房间" << neighborRoom << "，但条件不满足";
             doorIndex++;
             return;
         }
@@ -411,7 +425,7 @@ void RoomManager::openBossDoors() {
     }
 
     m_bossDoorsAlreadyOpened = true;
-    qDebug() << "RoomManager: 打开Boss门";
+    qCDebug(lcRoom) << "RoomManager: 打开Boss门";
 
     // 遍历所有门，找到Boss门并打开
     for (Door* door : m_currentDoors) {
@@ -459,7 +473,7 @@ void RoomManager::spawnEnemiesInRoom() {
 
     // 如果房间已清除，跳过
     if (cur && cur->isCleared()) {
-        qDebug() << "房间" << m_currentRoomIndex << "已被清除，跳过敌人生成";
+        qCDebug(lcRoom) << "房间" << m_currentRoomIndex << "已被清除，跳过敌人生成";
         openDoors();
         return;
     }
@@ -490,8 +504,8 @@ void RoomManager::spawnEnemiesInRoom() {
                 QPixmap boomNormalPic = ResourceFactory::createEnemyImage(enemySize, m_levelNumber, "clock_boom");
 
                 for (int i = 0; i < count; ++i) {
-                    int x = QRandomGenerator::global()->bounded(100, 700);
-                    int y = QRandomGenerator::global()->bounded(100, 500);
+                    int x = spawnRandom()->bounded(100, 700);
+                    int y = spawnRandom()->bounded(100, 500);
 
                     if (qAbs(x - 400) < 100 && qAbs(y - 300) < 100) {
                         x += 150;
@@ -510,7 +524,7 @@ void RoomManager::spawnEnemiesInRoom() {
                     m_rooms[m_currentRoomIndex]->currentEnemies.append(eptr);
 
                     emit enemyCreated(boom);
-                    qDebug() << "创建ClockBoom，房间" << m_currentRoomIndex << "，编号" << i << "，位置:" << x << "," << y;
+                    qCDebug(lcRoom) << "创建ClockBoom，房间" << m_currentRoomIndex << "，编号" << i << "，位置:" << x << "," << y;
                 }
             } else {
                 // 普通敌人生成
@@ -525,7 +539,7 @@ void RoomManager::spawnEnemiesInRoom() {
                 if (m_levelNumber == 3 && (enemyType == "optimization" || enemyType == "digital_system" || enemyType == "yanglin" || enemyType == "probability_theory")) {
                     enemyPix = ResourceFactory::createEnemyImageHighRes(m_levelNumber, enemyType, 200);
                     enemyScale = static_cast<double>(enemySize) / static_cast<double>(enemyPix.width());
-                    qDebug() << "使用高分辨率图片创建ScalingEnemy:" << enemyType
+                    qCDebug(lcRoom) << "使用高分辨率图片创建ScalingEnemy:" << enemyType
                              << "图片尺寸:" << enemyPix.width() << "x" << enemyPix.height()
                              << "基础scale:" << enemyScale;
                 } else {
@@ -540,8 +554,8 @@ void RoomManager::spawnEnemiesInRoom() {
                         x = 400;
                         y = 300;
                     } else {
-                        x = QRandomGenerator::global()->bounded(100, 700);
-                        y = QRandomGenerator::global()->bounded(100, 500);
+                        x = spawnRandom()->bounded(100, 700);
+                        y = spawnRandom()->bounded(100, 500);
 
                         if (qAbs(x - 400) < 100 && qAbs(y - 300) < 100) {
                             x += 150;
@@ -557,7 +571,7 @@ void RoomManager::spawnEnemiesInRoom() {
                     if (enemyType == "yanglin" && count > 1) {
                         double initialAngle = (2.0 * M_PI / count) * i;
                         enemy->setCircleAngle(initialAngle);
-                        qDebug() << "设置yanglin" << i << "初始角度:" << (initialAngle * 180.0 / M_PI) << "度";
+                        qCDebug(lcRoom) << "设置yanglin" << i << "初始角度:" << (initialAngle * 180.0 / M_PI) << "度";
                     }
 
                     enemy->preloadCollisionMask();
@@ -568,7 +582,7 @@ void RoomManager::spawnEnemiesInRoom() {
                     m_rooms[m_currentRoomIndex]->currentEnemies.append(eptr);
 
                     emit enemyCreated(enemy);
-                    qDebug() << "创建敌人" << enemyType << "位置:" << x << "," << y;
+                    qCDebug(lcRoom) << "创建敌人" << enemyType << "位置:" << x << "," << y;
                 }
             }
         }
@@ -587,8 +601,8 @@ void RoomManager::spawnEnemiesInRoom() {
             int bossSize = ConfigManager::instance().getEntitySize("bosses", bossType);
             QPixmap bossPix = ResourceFactory::createBossImage(bossSize, m_levelNumber, bossType);
 
-            int x = QRandomGenerator::global()->bounded(100, 700);
-            int y = QRandomGenerator::global()->bounded(100, 500);
+            int x = spawnRandom()->bounded(100, 700);
+            int y = spawnRandom()->bounded(100, 500);
 
             if (qAbs(x - 400) < 100 && qAbs(y - 300) < 100) {
                 x += 150;
@@ -608,7 +622,7 @@ void RoomManager::spawnEnemiesInRoom() {
                 m_rooms[m_currentRoomIndex]->currentEnemies.append(eptr);
 
                 emit bossCreated(boss);
-                qDebug() << "创建boss类型:" << bossType << "位置:" << x << "," << y;
+                qCDebug(lcRoom) << "创建boss类型:" << bossType << "位置:" << x << "," << y;
             }
         }
     } catch (const QString& error) {
@@ -629,36 +643,41 @@ void RoomManager::spawnChestsInRoom() {
     }
 
     try {
-        int x = QRandomGenerator::global()->bounded(150, 650);
-        int y = QRandomGenerator::global()->bounded(150, 450);
-
-        Chest* chest = nullptr;
+        int x = spawnRandom()->bounded(150, 650);
+        int y = spawnRandom()->bounded(150, 450);
 
-        if (roomCfg.isChestLocked) {
-            // 高级宝箱 - 需要钥匙，使用 chest_up.png
-            QPixmap chestPix = ResourceFactory::createLockedChestImage(50);
-            chest = new LockedChest(m_player, chestPix, 1.0);
-            qDebug() << "RoomManager: 生成高级宝箱（需要钥匙）";
-        } else {
-            // 普通宝箱 - 无需钥匙，使用 chest.png
-            QPixmap chestPix = ResourceFactory::createNormalChestImage(50);
-            chest = new NormalChest(m_player, chestPix, 1.0);
-            qDebug() << "RoomManager: 生成普通宝箱";
-        }
-
-        chest->setPos(x, y);
+        Chest* chest = createChest(roomCfg.isChestLocked, QPointF(x, y));
         m_scene->addItem(chest);
 
         QPointer<Chest> chestPtr(chest);
         m_currentChests.append(chestPtr);
         m_rooms[m_currentRoomIndex]->currentChests.append(chestPtr);
 
-        qDebug() << "RoomManager: 创建宝箱，位置:" << x << "," << y;
+        qCDebug(lcRoom) << "RoomManager: 创建宝箱，位置:" << x << "," << y;
     } catch (const QString& error) {
         qWarning() << "RoomManager: 生成宝箱失败:" << error;
     }
 }
 
+Chest* RoomManager::createChest(bool locked, const QPointF& pos) {
+    Chest* chest = nullptr;
+
+    if (locked) {
+        // 高级宝箱 - 需要钥匙，使用 chest_up.png
+        QPixmap chestPix = ResourceFactory::createLockedChestImage(50);
+        chest = new LockedChest(m_player, chestPix, 1.0);
+        qCDebug(lcRoom) << "RoomManager: 生成高级宝箱（需要钥匙）";
+    } else {
+        // 普通宝箱 - 无需钥匙，使用 chest.png
+        QPixmap chestPix = ResourceFactory::createNormalChestImage(50);
+        chest = new NormalChest(m_player, chestPix, 1.0);
+        qCDebug(lcRoom) << "RoomManager: 生成普通宝箱";
+    }
+
+    chest->setPos(pos);
+    return chest;
+}
+
 void RoomManager::removeEnemy(Enemy* enemy) {
     if (!enemy)
         return;
@@ -721,14 +740,14 @@ void RoomManager::initCurrentRoom(Room* room) {
     if (!room)
         return;
 
-    room->startChangeTimer();
+    room->setExitCheckEnabled(true);
 }
 
 void RoomManager::spawnEnemiesForBoss(const QVector<QPair<QString, int>>& enemies) {
     if (!m_scene)
         return;
 
-    qDebug() << "RoomManager: Boss召唤敌人...";
+    qCDebug(lcRoom) << "RoomManager: Boss召唤敌人...";
 
     // 收集所有需要召唤的敌人，用于1秒后的操作
     QVector<QPointer<Enemy>> spawnedEnemies;
@@ -742,32 +761,40 @@ void RoomManager::spawnEnemiesForBoss(const QVector<QPair<QString, int>>& enemie
         if (enemySize <= 0)
             enemySize = 40;  // 默认值
 
-        qDebug() << "RoomManager: 召唤" << count << "个" << enemyType << "尺寸:" << enemySize;
+        qCDebug(lcRoom) << "RoomManager: 召唤" << count << "个" << enemyType << "尺寸:" << enemySize;
 
         if (enemyType == "clock_boom") {
-            // 召唤clock_boom - 使用正确的图片路径
-            QPixmap boomPic = ResourceFactory::createEnemyImage(enemySize, m_levelNumber, "clock_boom");
-
-            // 如果加载失败，尝试直接加载
-            if (boomPic.isNull()) {
-                boomPic = QPixmap("assets/enemy/level_1/clock_boom.png");
-                if (!boomPic.isNull()) {
-                    boomPic = boomPic.scaled(enemySize, enemySize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            // 召唤clock_boom - 图片只在对象池中没有空闲对象、需要新建时加载
+            QPixmap boomPic;
+            auto createBoom = [&]() {
+                if (boomPic.isNull()) {
+                    boomPic = ResourceFactory::createEnemyImage(enemySize, m_levelNumber, "clock_boom");
+
+                    // 如果加载失败，尝试直接加载
+                    if (boomPic.isNull()) {
+                        boomPic = QPixmap("assets/enemy/level_1/clock_boom.png");
+                        if (!boomPic.isNull()) {
+                            boomPic = boomPic.scaled(enemySize, enemySize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                        }
+                    }
                 }
-            }
+                return new ClockBoom(boomPic, boomPic, 1.0);
+            };
 
             for (int i = 0; i < count; ++i) {
                 // 立即随机生成在场景中
                 int x = QRandomGenerator::global()->bounded(100, 700);
                 int y = QRandomGenerator::global()->bounded(100, 500);
 
-                ClockBoom* boom = new ClockBoom(boomPic, boomPic, 1.0);
+                ClockBoom* boom = EnemyPool::instance().acquire<ClockBoom>("clock_boom", createBoom);
                 boom->setPos(x, y);
                 boom->setPlayer(m_player);
                 boom->setIsSummoned(true);  // 标记为召唤的敌人，不触发bonus
 
-                // 预加载碰撞掩码
-                boom->preloadCollisionMask();
+                // 预加载碰撞掩码（复用的对象已有掩码）
+                if (!boom->hasCollisionMask()) {
+                    boom->preloadCollisionMask();
+                }
 
                 // 暂停敌人的AI和移动（等待1秒）
                 boom->pauseTimers();
@@ -785,21 +812,29 @@ void RoomManager::spawnEnemiesForBoss(const QVector<QPair<QString, int>>& enemie
                 emit enemySummoned(boom);
             }
         } else if (enemyType == "clock_normal") {
-            // 召唤clock_normal
-            QPixmap normalPic = ResourceFactory::createEnemyImage(enemySize, m_levelNumber, "clock_normal");
+            // 召唤clock_normal - 图片只在需要新建时加载
+            QPixmap normalPic;
+            auto createEnemy = [&]() {
+                if (normalPic.isNull()) {
+                    normalPic = ResourceFactory::createEnemyImage(enemySize, m_levelNumber, "clock_normal");
+                }
+                return EnemyFactory::instance().createEnemy(m_levelNumber, "clock_normal", normalPic, 1.0);
+            };
 
             for (int i = 0; i < count; ++i) {
                 // 立即随机生成在场景中
                 int x = QRandomGenerator::global()->bounded(100, 700);
                 int y = QRandomGenerator::global()->bounded(100, 500);
 
-                Enemy* enemy = EnemyFactory::instance().createEnemy(m_levelNumber, "clock_normal", normalPic, 1.0);
+                Enemy* enemy = EnemyPool::instance().acquire<Enemy>("clock_normal", createEnemy);
                 enemy->setPos(x, y);
                 enemy->setPlayer(m_player);
                 enemy->setIsSummoned(true);  // 标记为召唤的敌人，不触发bonus
 
-                // 预加载碰撞掩码
-                enemy->preloadCollisionMask();
+                // 预加载碰撞掩码（复用的对象已有掩码）
+                if (!enemy->hasCollisionMask()) {
+                    enemy->preloadCollisionMask();
+                }
 
                 // 暂停敌人的AI和移动（等待1秒）
                 enemy->pauseTimers();
@@ -817,21 +852,29 @@ void RoomManager::spawnEnemiesForBoss(const QVector<QPair<QString, int>>& enemie
                 emit enemySummoned(enemy);
             }
         } else if (enemyType == "pillow") {
-            // 召唤pillow
-            QPixmap pillowPic = ResourceFactory::createEnemyImage(enemySize, m_levelNumber, "pillow");
+            // 召唤pillow - 图片只在需要新建时加载
+            QPixmap pillowPic;
+            auto createEnemy = [&]() {
+                if (pillowPic.isNull()) {
+                    pillowPic = ResourceFactory::createEnemyImage(enemySize, m_levelNumber, "pillow");
+                }
+                return EnemyFactory::instance().createEnemy(m_levelNumber, "pillow", pillowPic, 1.0);
+            };
 
             for (int i = 0; i < count; ++i) {
                 // 立即随机生成在场景中
                 int x = QRandomGenerator::global()->bounded(100, 700);
                 int y = QRandomGenerator::global()->bounded(100, 500);
 
-                Enemy* enemy = EnemyFactory::instance().createEnemy(m_levelNumber, "pillow", pillowPic, 1.0);
+                Enemy* enemy = EnemyPool::instance().acquire<Enemy>("pillow", createEnemy);
                 enemy->setPos(x, y);
                 enemy->setPlayer(m_player);
                 enemy->setIsSummoned(true);  // 标记为召唤的敌人，不触发bonus
 
-                // 预加载碰撞掩码
-                enemy->preloadCollisionMask();
+                // 预加载碰撞掩码（复用的对象已有掩码）
+                if (!enemy->hasCollisionMask()) {
+                    enemy->preloadCollisionMask();
+                }
 
                 // 暂停敌人的AI和移动（等待1秒）
                 enemy->pauseTimers();
@@ -852,9 +895,11 @@ void RoomManager::spawnEnemiesForBoss(const QVector<QPair<QString, int>>& enemie
     }
 
     // 1秒后：恢复所有敌人的移动，并让ClockBoom进入引爆动画
-    QTimer::singleShot(1000, this, [spawnedEnemies]() {
+    TimerWheel::instance().schedule(this, 1000, [spawnedEnemies]() {
         for (QPointer<Enemy> ePtr : spawnedEnemies) {
-            if (Enemy* e = ePtr.data()) {
+            Enemy* e = ePtr.data();
+            // 1秒内死亡的敌人可能已回到对象池（不在场景中），跳过
+            if (e && e->scene()) {
                 // 恢复敌人的AI和移动
                 e->resumeTimers();
 
@@ -865,10 +910,10 @@ void RoomManager::spawnEnemiesForBoss(const QVector<QPair<QString, int>>& enemie
                 }
             }
         }
-        qDebug() << "RoomManager: 召唤完成，所有敌人开始移动，ClockBoom进入引爆动画";
+        qCDebug(lcRoom) << "RoomManager: 召唤完成，所有敌人开始移动，ClockBoom进入引爆动画";
     });
 
-    qDebug() << "RoomManager: Boss召唤敌人完成，当前场上敌人数:" << m_currentEnemies.size();
+    qCDebug(lcRoom) << "RoomManager: Boss召唤敌人完成，当前场上敌人数:" << m_currentEnemies.size();
 }
 
 void RoomManager::dropRandomItem(QPointF position) {
@@ -876,7 +921,7 @@ void RoomManager::dropRandomItem(QPointF position) {
         return;
 
     DroppedItemFactory::dropRandomItem(ItemDropPool::ENEMY_DROP, position, m_player, m_scene);
-    qDebug() << "RoomManager: 在位置" << position << "掉落随机物品";
+    qCDebug(lcRoom) << "RoomManager: 在位置" << position << "掉落随机物品";
 }
 
 void RoomManager::dropItemsFromPosition(QPointF position, int count, bool scatter) {
@@ -885,13 +930,13 @@ void RoomManager::dropItemsFromPosition(QPointF position, int count, bool scatte
 
     Q_UNUSED(scatter)  // 工厂类自动处理散开效果
     DroppedItemFactory::dropItemsScattered(ItemDropPool::ENEMY_DROP, position, count, m_player, m_scene);
-    qDebug() << "RoomManager: 从位置" << position << "掉落" << count << "个物品";
+    qCDebug(lcRoom) << "RoomManager: 从位置" << position << "掉落" << count << "个物品";
 }
 
 void RoomManager::restoreDroppedItemsToScene() {
     Room* room = currentRoom();
     if (room && m_scene) {
-        room->restoreDroppedItemsToScene(m_scene);
-        qDebug() << "RoomManager: 恢复掉落物品到场景";
+        room->restoreDroppedItemsToScene(m_scene, m_player);
+        qCDebug(lcRoom) << "RoomManager: 恢复掉落物品到场景";
     }
 }
@@ -5,8 +5,10 @@
 #include <QObject>
 #include <QPair>
 #include <QPointer>
+#include <QRandomGenerator>
 #include <QTimer>
 #include <QVector>
+#include "../core/gametimer.h"
 #include "door.h"
 #include "levelconfig.h"
 #include "room.h"
@@ -92,6 +94,9 @@ class RoomManager : public QObject {
     void openDoors();
     void openBossDoors();
 
+    // 按房间的开门标志同步已有门实例的状态（打开或关闭，不重建门）
+    void syncDoorStates(int roomIndex);
+
     // 检查是否可以打开Boss门
     bool canOpenBossDoor() const;
 
@@ -106,6 +111,10 @@ class RoomManager : public QObject {
 
     void spawnEnemiesInRoom();
     void spawnChestsInRoom();
+
+    // 房间敌人和宝箱位置使用的随机数生成器（由 Level 按房间种子播种，重试时重放同样的房间）
+    void setSpawnRandom(QRandomGenerator* rng) { m_spawnRng = rng; }
+    Chest* createChest(bool locked, const QPointF& pos);  // 创建宝箱（未加入场景和房间）
     void spawnEnemiesForBoss(const QVector<QPair<QString, int>>& enemies);
 
     // ==================== 物品掉落管理 ====================
@@ -154,6 +163,7 @@ class RoomManager : public QObject {
    private:
     void initCurrentRoom(Room* room);
     bool createRooms(const LevelConfig& config);
+    QRandomGenerator* spawnRandom() const { return m_spawnRng ? m_spawnRng : QRandomGenerator::global(); }
 
     int m_levelNumber = 0;
     int m_currentRoomIndex = 0;
@@ -170,13 +180,11 @@ class RoomManager : public QObject {
     QMap<int, QVector<Door*>> m_roomDoors;
 
     QGraphicsPixmapItem* m_backgroundItem = nullptr;
+    QRandomGenerator* m_spawnRng = nullptr;
 
     // Boss门相关状态
     bool m_hasEncounteredBossDoor = false;
     bool m_bossDoorsAlreadyOpened = false;
-
-    // 房间切换检测定时器
-    QTimer* m_checkChangeTimer = nullptr;
 };
 
 #endif  // ROOMMANAGER_H
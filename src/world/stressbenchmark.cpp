@@ -0,0 +1,411 @@
+#include "stressbenchmark.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGraphicsPixmapItem>
+#include <QGraphicsScene>
+#include <QGraphicsView>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QtMath>
+#include <algorithm>
+#include "../constants.h"
+#include "../core/allocationcounter.h"
+#include "../core/configmanager.h"
+#include "../core/gameclock.h"
+#include "../core/objectcensus.h"
+#include "../core/resourcefactory.h"
+#include "../entities/enemy.h"
+#include "../entities/level_2/toxicgas.h"
+#include "../entities/level_3/chalkbeam.h"
+#include "../entities/player.h"
+#include "../entities/projectile.h"
+#include "factory/enemyfactory.h"
+#include "levelconfig.h"
+#include "projectilepool.h"
+
+#if defined(Q_OS_WIN)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+namespace {
+    constexpr int kEnemyHealth = 1000000;  // 测试期间敌人不会被玩家子弹打死
+    const char *const kEnemyTypes[] = {"clock_normal", "pillow"};  // 第一关的普通敌人
+
+    double percentileMs(const QVector<qint64> &sortedNs, double p) {
+        if (sortedNs.isEmpty())
+            return 0.0;
+        const int index = qBound(0, static_cast<int>(qCeil(p * sortedNs.size())) - 1, sortedNs.size() - 1);
+        return sortedNs[index] / 1.0e6;
+    }
+}
+
+// ==================== StressBenchmarkConfig ====================
+
+StressBenchmarkConfig StressBenchmarkConfig::forBulletCount(int bullets) {
+    StressBenchmarkConfig config;
+    bullets = qMax(0, bullets);
+    config.enemyBullets = bullets * 70 / 100;
+    config.playerBullets = bullets * 20 / 100;
+    config.toxicGas = bullets * 5 / 100;
+    config.chalkBeams = bullets - config.enemyBullets - config.playerBullets - config.toxicGas;
+    config.enemies = bullets >= 10000 ? 48 : 36;
+    return config;
+}
+
+bool StressBenchmarkConfig::applyMix(const QString &mix) {
+    for (const QString &part : mix.split(',')) {
+        if (part.trimmed().isEmpty())
+            continue;
+        const QStringList pair = part.split('=');
+        bool ok = false;
+        const int value = pair.size() == 2 ? pair[1].trimmed().toInt(&ok) : 0;
+        if (!ok || value < 0) {
+            qWarning() << "StressBenchmark: 无效的 --benchmark-mix 项" << part;
+            return false;
+        }
+
+        const QString key = pair[0].trimmed();
+        if (key == "enemy") {
+            enemyBullets = value;
+        } else if (key == "player") {
+            playerBullets = value;
+        } else if (key == "gas") {
+            toxicGas = value;
+        } else if (key == "beam") {
+            chalkBeams = value;
+        } else if (key == "enemies") {
+            enemies = value;
+        } else {
+            qWarning() << "StressBenchmark: 未知的 --benchmark-mix 项" << key;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ==================== StressBenchmark ====================
+
+StressBenchmark::StressBenchmark(const StressBenchmarkConfig &config)
+    : m_config(config), m_random(kSeed) {
+}
+
+StressBenchmark::~StressBenchmark() {
+    delete m_view;
+    // 场景删除时一并删除其中的子弹、敌人和玩家
+    delete m_scene;
+    ProjectilePool::instance().clear();
+}
+
+bool StressBenchmark::setupScene() {
+    m_scene = new QGraphicsScene();
+    m_scene->setSceneRect(0, 0, scene_bound_x, scene_bound_y);
+
+    try {
+        // 第一关起始房间的背景
+        LevelConfig level;
+        if (level.loadFromFile(1) && level.getRoomCount() > 0) {
+            const RoomConfig &room = level.getRoom(level.getStartRoomIndex());
+            auto *background = new QGraphicsPixmapItem(ResourceFactory::loadBackgroundImage(room.backgroundImage));
+            background->setZValue(-1000);
+            m_scene->addItem(background);
+        }
+
+        int playerSize = ConfigManager::instance().getSize("player");
+        if (playerSize <= 0)
+            playerSize = 60;
+        m_player = new Player(ResourceFactory::createPlayerImage(playerSize), 1.0);
+        m_player->setPermanentInvincible(true);
+        m_player->setPos(scene_bound_x / 2.0 - playerSize / 2.0, scene_bound_y / 2.0 - playerSize / 2.0);
+        m_player->preloadCollisionMask();
+        m_scene->addItem(m_player);
+
+        int bulletSize = ConfigManager::instance().getBulletSize("player");
+        if (bulletSize <= 0)
+            bulletSize = 20;
+        m_playerBulletPixmap = ResourceFactory::createBulletImage(bulletSize);
+    } catch (const QString &e) {
+        qCritical() << "StressBenchmark: 加载资源失败:" << e;
+        return false;
+    }
+
+    m_enemyBulletPixmap = ResourceFactory::tryLoadSprite("assets/boss/Teacher/formula_bullet.png", 30, 30);
+    if (m_enemyBulletPixmap.isNull()) {
+        m_enemyBulletPixmap = QPixmap(30, 30);
+        m_enemyBulletPixmap.fill(Qt::yellow);
+    }
+    m_toxicGasPixmap = ResourceFactory::tryLoadSprite("assets/boss/WashMachine/toxic_gas.png", 30, 30);
+    if (m_toxicGasPixmap.isNull()) {
+        m_toxicGasPixmap = QPixmap(30, 30);
+        m_toxicGasPixmap.fill(QColor(100, 200, 50, 180));
+    }
+    m_chalkBeamPixmap = ResourceFactory::tryLoadSprite("assets/boss/Teacher/chalk_beam.png");
+    if (m_chalkBeamPixmap.isNull()) {
+        m_chalkBeamPixmap = QPixmap(30, 60);
+        m_chalkBeamPixmap.fill(Qt::white);
+    }
+
+    if (m_config.headless) {
+        m_frame = QImage(scene_bound_x, scene_bound_y, QImage::Format_ARGB32_Premultiplied);
+    } else {
+        m_view = new QGraphicsView(m_scene);
+        m_view->setFixedSize(scene_bound_x + 2, scene_bound_y + 2);
+        m_view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        m_view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        m_view->setWindowTitle("Stress Benchmark");
+        m_view->show();
+    }
+    return true;
+}
+
+void StressBenchmark::spawnEnemies() {
+    const int typeCount = static_cast<int>(sizeof(kEnemyTypes) / sizeof(kEnemyTypes[0]));
+    for (int i = 0; i < m_config.enemies; ++i) {
+        const QString type = kEnemyTypes[i % typeCount];
+        int size = ConfigManager::instance().getEntitySize("enemies", type);
+        if (size <= 0)
+            size = 40;
+
+        Enemy *enemy = nullptr;
+        try {
+            enemy = EnemyFactory::instance().createEnemy(1, type, ResourceFactory::createEnemyImage(size, 1, type), 1.0);
+        } catch (const QString &e) {
+            qWarning() << "StressBenchmark: 创建敌人失败:" << e;
+        }
+        if (!enemy)
+            continue;
+
+        enemy->setHealth(kEnemyHealth);
+        enemy->setPos(randomPoint(60.0));
+        enemy->setPlayer(m_player);
+        enemy->preloadCollisionMask();
+        m_scene->addItem(enemy);
+        m_enemies.append(enemy);
+    }
+}
+
+QPointF StressBenchmark::randomPoint(double margin) {
+    return QPointF(margin + m_random.generateDouble() * (scene_bound_x - 2 * margin),
+                   margin + m_random.generateDouble() * (scene_bound_y - 2 * margin));
+}
+
+void StressBenchmark::spawnProjectile(int mode, QVector<TrackedProjectile> &list) {
+    const QPixmap &pixmap = mode ? m_enemyBulletPixmap : m_playerBulletPixmap;
+    Projectile *bullet = ProjectilePool::instance().acquire(mode, 1, randomPoint(10.0), pixmap);
+
+    // 速度 1~4 像素/帧，方向随机（不为零）
+    int dx = 0;
+    int dy = 0;
+    while (dx == 0 && dy == 0) {
+        dx = m_random.bounded(-4, 5);
+        dy = m_random.bounded(-4, 5);
+    }
+    bullet->setDir(dx, dy);
+    m_scene->addItem(bullet);
+
+    TrackedProjectile tracked;
+    tracked.bullet = bullet;
+    tracked.generation = bullet->generation();
+    list.append(tracked);
+}
+
+void StressBenchmark::replenish() {
+    auto gone = [this](const TrackedProjectile &t) {
+        return !t.bullet || t.bullet->isDestroyed() || t.bullet->generation() != t.generation ||
+               t.bullet->scene() != m_scene;
+    };
+    m_enemyBullets.erase(std::remove_if(m_enemyBullets.begin(), m_enemyBullets.end(), gone), m_enemyBullets.end());
+    m_playerBullets.erase(std::remove_if(m_playerBullets.begin(), m_playerBullets.end(), gone), m_playerBullets.end());
+    m_gases.erase(std::remove_if(m_gases.begin(), m_gases.end(),
+                                 [this](const QPointer<ToxicGas> &gas) { return !gas || gas->scene() != m_scene; }),
+                  m_gases.end());
+    m_beams.erase(std::remove_if(m_beams.begin(), m_beams.end(),
+                                 [this](const QPointer<ChalkBeam> &beam) { return !beam || beam->scene() != m_scene; }),
+                  m_beams.end());
+
+    while (m_enemyBullets.size() < m_config.enemyBullets) {
+        spawnProjectile(1, m_enemyBullets);
+    }
+    while (m_playerBullets.size() < m_config.playerBullets) {
+        spawnProjectile(0, m_playerBullets);
+    }
+    while (m_gases.size() < m_config.toxicGas) {
+        const double angle = m_random.generateDouble() * 2.0 * M_PI;
+        auto *gas = new ToxicGas(randomPoint(30.0), QPointF(qCos(angle), qSin(angle)), m_toxicGasPixmap, m_player);
+        gas->setSpeed(2.5);
+        m_scene->addItem(gas);
+        m_gases.append(gas);
+    }
+    while (m_beams.size() < m_config.chalkBeams) {
+        auto *beam = new ChalkBeam(randomPoint(50.0), m_chalkBeamPixmap, m_scene);
+        m_scene->addItem(beam);
+        beam->startWarning();
+        m_beams.append(beam);
+    }
+}
+
+void StressBenchmark::renderFrame() {
+    if (m_view) {
+        m_view->viewport()->repaint();
+        QCoreApplication::processEvents();
+    } else {
+        QPainter painter(&m_frame);
+        m_scene->render(&painter);
+    }
+}
+
+int StressBenchmark::run() {
+    if (!setupScene())
+        return 1;
+    spawnEnemies();
+    replenish();
+
+    qInfo().noquote() << QString("StressBenchmark: 敌弹 %1，玩家子弹 %2，毒气 %3，粉笔 %4，敌人 %5，运行 %6 秒（%7）")
+                                 .arg(m_config.enemyBullets)
+                                 .arg(m_config.playerBullets)
+                                 .arg(m_config.toxicGas)
+                                 .arg(m_config.chalkBeams)
+                                 .arg(m_enemies.size())
+                                 .arg(m_config.seconds)
+                                 .arg(m_config.headless ? "无窗口" : "窗口");
+
+    // 由测试循环逐帧推进，不再由时钟定时器驱动
+    GameClock::instance().stop();
+
+    QVector<qint64> frameNs;
+    frameNs.reserve(m_config.seconds * 1000 / kFrameMs);
+    quint64 allocations = 0;
+
+    // 对象普查只在 --census 时启用；启用时唤醒速率从测试循环开始计算
+    ObjectCensus::instance().sample();
+
+    QElapsedTimer wall;
+    wall.start();
+    QElapsedTimer frame;
+    while (wall.elapsed() < m_config.seconds * 1000LL) {
+        const quint64 allocBefore = AllocationCounter::count();
+        frame.start();
+
+        replenish();
+        GameClock::instance().advanceGameplay(kFrameMs);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        renderFrame();
+
+        frameNs.append(frame.nsecsElapsed());
+        allocations += AllocationCounter::count() - allocBefore;
+
+        if (m_view && !m_view->isVisible())
+            break;  // 窗口被关闭
+    }
+
+    const qint64 wallMs = wall.elapsed();
+    report(wallMs, frameNs, allocations, ObjectCensus::instance().sample());
+    return 0;
+}
+
+void StressBenchmark::report(qint64 wallMs, const QVector<qint64> &frameNs, quint64 allocations,
+                             const CensusSnapshot &census) const {
+    QVector<qint64> sorted = frameNs;
+    std::sort(sorted.begin(), sorted.end());
+
+    const int frames = frameNs.size();
+    const double ticksPerSec = wallMs > 0 ? frames * 1000.0 / wallMs : 0.0;
+    const double p50 = percentileMs(sorted, 0.50);
+    const double p99 = percentileMs(sorted, 0.99);
+    const qint64 rssKb = peakRssKb();
+    // 未统计分配次数的构建记为 -1（与峰值内存不可用时一致）
+    const double allocsPerFrame = !AllocationCounter::isEnabled() ? -1.0
+                                  : frames > 0                    ? static_cast<double>(allocations) / frames
+                                                                  : 0.0;
+
+    qInfo().noquote() << QString("StressBenchmark 结果（子弹 %1）：\n"
+                                 "  帧数          %2\n"
+                                 "  tick/s        %3\n"
+                                 "  帧时间 p50    %4 ms\n"
+                                 "  帧时间 p99    %5 ms\n"
+                                 "  峰值内存      %6\n"
+                                 "  每帧分配次数  %7")
+                                 .arg(m_config.totalBullets())
+                                 .arg(frames)
+                                 .arg(ticksPerSec, 0, 'f', 1)
+                                 .arg(p50, 0, 'f', 3)
+                                 .arg(p99, 0, 'f', 3)
+                                 .arg(rssKb >= 0 ? QString("%1 MB").arg(rssKb / 1024.0, 0, 'f', 1) : QString("不可用"))
+                                 .arg(allocsPerFrame >= 0 ? QString::number(allocsPerFrame, 'f', 1) : QString("不可用"));
+    if (ObjectCensus::instance().isEnabled()) {
+        qInfo().noquote() << QString("  存活 QObject  %1\n  定时器唤醒    %2 次/s")
+                                     .arg(census.liveObjects)
+                                     .arg(census.timerWakeupsPerSec, 0, 'f', 1);
+    }
+
+    if (m_config.outputPath.isEmpty())
+        return;
+
+    QJsonObject result;
+    result["scenario"] = "bullet_hell";
+    result["bullets"] = m_config.totalBullets();
+    result["enemy_bullets"] = m_config.enemyBullets;
+    result["player_bullets"] = m_config.playerBullets;
+    result["toxic_gas"] = m_config.toxicGas;
+    result["chalk_beams"] = m_config.chalkBeams;
+    result["enemies"] = m_config.enemies;
+    result["headless"] = m_config.headless;
+    result["seconds"] = wallMs / 1000.0;
+    result["frames"] = frames;
+    result["ticks_per_sec"] = ticksPerSec;
+    result["frame_ms_p50"] = p50;
+    result["frame_ms_p99"] = p99;
+    result["peak_rss_mb"] = rssKb >= 0 ? rssKb / 1024.0 : -1.0;
+    result["allocs_per_frame"] = allocsPerFrame;
+    if (ObjectCensus::instance().isEnabled()) {
+        result["census"] = census.toJson();
+    }
+
+    QFile file(m_config.outputPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "StressBenchmark: 无法写入结果文件" << m_config.outputPath;
+        return;
+    }
+    file.write(QJsonDocument(result).toJson());
+    qInfo() << "StressBenchmark: 结果已写入" << m_config.outputPath;
+}
+
+qint64 StressBenchmark::peakRssKb() {
+#if defined(Q_OS_LINUX)
+    // VmHWM：进程常驻内存的峰值
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        const QList<QByteArray> lines = status.readAll().split('\n');
+        for (const QByteArray &line : lines) {
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').first().toLongLong();
+            }
+        }
+    }
+    return -1;
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<qint64>(counters.PeakWorkingSetSize / 1024);
+    }
+    return -1;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(Q_OS_MACOS)
+        return usage.ru_maxrss / 1024;  // macOS 以字节为单位
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+    return -1;
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,120 @@
+#ifndef STRESSBENCHMARK_H
+#define STRESSBENCHMARK_H
+
+#include <QImage>
+#include <QPixmap>
+#include <QPointer>
+#include <QRandomGenerator>
+#include <QString>
+#include <QVector>
+
+struct CensusSnapshot;
+class ChalkBeam;
+class Enemy;
+class Player;
+class Projectile;
+class QGraphicsScene;
+class QGraphicsView;
+class ToxicGas;
+
+/**
+ * @brief 弹幕压力测试配置
+ *
+ * 标准规模为 500、2000、10000 发子弹，按 forBulletCount() 的比例分配到各类子弹；
+ * 各项数量也可用 --benchmark-mix 单独指定。
+ */
+struct StressBenchmarkConfig {
+    int enemyBullets = 350;   // 敌方 Projectile（mode 1）
+    int playerBullets = 100;  // 玩家 Projectile（mode 0）
+    int toxicGas = 25;
+    int chalkBeams = 25;
+    int enemies = 36;
+    int seconds = 10;
+    bool headless = false;
+    QString outputPath;  // 结果 JSON 的输出路径，为空时只打印
+
+    /**
+     * @brief 按子弹总数生成标准配置（敌弹 70%、玩家子弹 20%、毒气和粉笔各 5%）
+     */
+    static StressBenchmarkConfig forBulletCount(int bullets);
+
+    /**
+     * @brief 解析 "enemy=1400,player=400,gas=100,beam=100,enemies=48"，未出现的项保持不变
+     * @return 格式错误时返回 false
+     */
+    bool applyMix(const QString &mix);
+
+    [[nodiscard]] int totalBullets() const { return enemyBullets + playerBullets + toxicGas + chalkBeams; }
+};
+
+/**
+ * @brief 弹幕压力测试 - 在一个房间里维持指定数量的子弹和敌人，逐帧测量
+ *
+ * 停止 GameClock 的定时器，由测试循环逐帧推进游戏域（每帧 kFrameMs）、处理延迟删除并渲染：
+ * 有窗口时重绘 QGraphicsView，无窗口（offscreen）时把场景渲染到离屏图像，
+ * 碰撞和渲染两条路径都计入帧时间。飞出场景或自行消失的子弹在下一帧开始前补足。
+ * 结束后报告 tick/s、帧时间 p50/p99、峰值常驻内存和每帧 operator new 次数。
+ */
+class StressBenchmark {
+public:
+    static constexpr int kFrameMs = 16;
+    static constexpr quint32 kSeed = 20240601;  // 固定种子，同一配置的场景可复现
+
+    explicit StressBenchmark(const StressBenchmarkConfig &config);
+
+    ~StressBenchmark();
+
+    /**
+     * @brief 运行测试并输出结果
+     * @return 进程退出码（0 成功）
+     */
+    int run();
+
+private:
+    StressBenchmark(const StressBenchmark &) = delete;
+
+    StressBenchmark &operator=(const StressBenchmark &) = delete;
+
+    struct TrackedProjectile {
+        QPointer<Projectile> bullet;
+        quint32 generation = 0;  // 子弹被对象池回收复用后视为已消失
+    };
+
+    bool setupScene();
+
+    void spawnEnemies();
+
+    // 补足各类子弹到配置数量
+    void replenish();
+
+    void spawnProjectile(int mode, QVector<TrackedProjectile> &list);
+
+    void renderFrame();
+
+    [[nodiscard]] QPointF randomPoint(double margin);
+
+    // 输出结果（控制台表格 + 可选 JSON 文件）
+    void report(qint64 wallMs, const QVector<qint64> &frameNs, quint64 allocations, const CensusSnapshot &census) const;
+
+    [[nodiscard]] static qint64 peakRssKb();
+
+    StressBenchmarkConfig m_config;
+    QRandomGenerator m_random;
+    QGraphicsScene *m_scene = nullptr;
+    QGraphicsView *m_view = nullptr;
+    Player *m_player = nullptr;
+    QImage m_frame;  // 无窗口时的渲染目标
+
+    QPixmap m_enemyBulletPixmap;
+    QPixmap m_playerBulletPixmap;
+    QPixmap m_toxicGasPixmap;
+    QPixmap m_chalkBeamPixmap;
+
+    QVector<TrackedProjectile> m_enemyBullets;
+    QVector<TrackedProjectile> m_playerBullets;
+    QVector<QPointer<ToxicGas>> m_gases;
+    QVector<QPointer<ChalkBeam>> m_beams;
+    QVector<QPointer<Enemy>> m_enemies;
+};
+
+#endif // STRESSBENCHMARK_H
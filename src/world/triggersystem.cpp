@@ -0,0 +1,169 @@
+#include "triggersystem.h"
+#include <QDebug>
+#include <algorithm>
+#include "../entities/player.h"
+
+TriggerVolume TriggerVolume::box(const QRectF &rect, TriggerAnchor anchor) {
+    TriggerVolume volume;
+    volume.rect = rect;
+    volume.anchor = anchor;
+    return volume;
+}
+
+TriggerVolume TriggerVolume::circle(const QPointF &center, double radius, TriggerAnchor anchor) {
+    TriggerVolume volume;
+    volume.center = center;
+    volume.radius = radius;
+    volume.anchor = anchor;
+    return volume;
+}
+
+bool TriggerVolume::contains(const QPointF &pos, const QPointF &center) const {
+    const QPointF &probe = anchor == TriggerAnchor::PlayerPos ? pos : center;
+    if (radius > 0.0) {
+        const double dx = probe.x() - this->center.x();
+        const double dy = probe.y() - this->center.y();
+        return dx * dx + dy * dy < radius * radius;
+    }
+    return rect.contains(probe);
+}
+
+TriggerSystem &TriggerSystem::instance() {
+    static TriggerSystem instance;
+    return instance;
+}
+
+int TriggerSystem::addZone(QObject *owner, const TriggerVolume &volume, TriggerCallback callback, bool fireIfInside) {
+    if (!owner || !callback) {
+        qWarning() << "TriggerSystem::addZone: 所有者或回调为空";
+        return 0;
+    }
+
+    Zone zone;
+    zone.id = m_nextId++;
+    zone.owner = owner;
+    zone.volume = volume;
+    zone.callback = std::move(callback);
+
+    // 已在区域内：fireIfInside 时保持"区域外"状态，下一个移动节拍补发 Enter
+    if (!fireIfInside && m_player) {
+        const QPointF pos = m_player->pos();
+        zone.inside = volume.contains(pos, pos + m_player->boundingRect().center());
+    }
+
+    m_zones.append(zone);
+    return zone.id;
+}
+
+void TriggerSystem::removeZone(int id) {
+    if (id <= 0)
+        return;
+    for (Zone &zone : m_zones) {
+        if (zone.id == id) {
+            markRemoved(zone);
+            break;
+        }
+    }
+    if (m_dispatchDepth == 0)
+        compact();
+}
+
+void TriggerSystem::removeOwner(const QObject *owner) {
+    if (!owner)
+        return;
+    for (Zone &zone : m_zones) {
+        if (zone.id != 0 && zone.owner == owner) {
+            markRemoved(zone);
+        }
+    }
+    if (m_dispatchDepth == 0)
+        compact();
+}
+
+void TriggerSystem::rearm(const QObject *owner) {
+    for (Zone &zone : m_zones) {
+        if (zone.id != 0 && zone.owner == owner) {
+            zone.inside = false;
+        }
+    }
+}
+
+void TriggerSystem::playerMoved(Player *player) {
+    if (!player)
+        return;
+    m_player = player;
+
+    const QPointF pos = player->pos();
+    const QPointF center = pos + player->boundingRect().center();
+
+    ++m_dispatchDepth;
+    // 回调中新增的区域追加在末尾，本次不参与检测
+    const int count = m_zones.size();
+    for (int i = 0; i < count; ++i) {
+        Zone &zone = m_zones[i];
+        if (!isLive(zone)) {
+            if (zone.id != 0)
+                markRemoved(zone);  // 所有者已销毁
+            continue;
+        }
+
+        const bool inside = zone.volume.contains(pos, center);
+        if (inside == zone.inside)
+            continue;
+        zone.inside = inside;
+        fire(i, inside ? TriggerEvent::Enter : TriggerEvent::Exit);
+    }
+    --m_dispatchDepth;
+
+    if (m_dispatchDepth == 0)
+        compact();
+}
+
+void TriggerSystem::playerInteract(Player *player) {
+    if (!player)
+        return;
+    m_player = player;
+
+    ++m_dispatchDepth;
+    const int count = m_zones.size();
+    for (int i = 0; i < count; ++i) {
+        if (isLive(m_zones[i]) && m_zones[i].inside) {
+            fire(i, TriggerEvent::Interact);
+        }
+    }
+    --m_dispatchDepth;
+
+    if (m_dispatchDepth == 0)
+        compact();
+}
+
+void TriggerSystem::clear() {
+    if (m_dispatchDepth > 0) {
+        for (Zone &zone : m_zones) {
+            markRemoved(zone);
+        }
+        return;
+    }
+    m_zones.clear();
+    m_holes = 0;
+}
+
+void TriggerSystem::markRemoved(Zone &zone) {
+    if (zone.id == 0)
+        return;
+    zone.id = 0;
+    ++m_holes;
+}
+
+void TriggerSystem::fire(int index, TriggerEvent event) {
+    TriggerCallback callback = m_zones[index].callback;
+    callback(event);
+}
+
+void TriggerSystem::compact() {
+    if (m_holes == 0)
+        return;
+    m_zones.erase(std::remove_if(m_zones.begin(), m_zones.end(), [](const Zone &zone) { return zone.id == 0; }),
+                  m_zones.end());
+    m_holes = 0;
+}
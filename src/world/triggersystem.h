@@ -0,0 +1,131 @@
+#ifndef TRIGGERSYSTEM_H
+#define TRIGGERSYSTEM_H
+
+#include <QObject>
+#include <QPointF>
+#include <QPointer>
+#include <QRectF>
+#include <QVector>
+#include <functional>
+
+class Player;
+
+/**
+ * @brief 触发区域检测点：玩家图元的左上角（pos）或中心
+ */
+enum class TriggerAnchor {
+    PlayerPos,
+    PlayerCenter
+};
+
+/**
+ * @brief 触发区域形状 - 矩形或圆形
+ */
+struct TriggerVolume {
+    QRectF rect;             // 矩形区域（radius <= 0 时使用）
+    QPointF center;          // 圆心
+    double radius = 0.0;     // 圆半径
+    TriggerAnchor anchor = TriggerAnchor::PlayerCenter;
+
+    static TriggerVolume box(const QRectF &rect, TriggerAnchor anchor);
+
+    static TriggerVolume circle(const QPointF &center, double radius, TriggerAnchor anchor);
+
+    [[nodiscard]] bool contains(const QPointF &pos, const QPointF &center) const;
+};
+
+/**
+ * @brief 触发事件
+ */
+enum class TriggerEvent {
+    Enter,    // 玩家进入区域
+    Exit,     // 玩家离开区域
+    Interact  // 玩家在区域内按下交互键（空格）
+};
+
+using TriggerCallback = std::function<void(TriggerEvent)>;
+
+/**
+ * @brief 触发区域系统 - 事件驱动的玩家接近检测
+ *
+ * 替代出门检测、宝箱、陷阱、掉落物各自用定时器轮询玩家位置：
+ * 各对象注册触发区域，玩家每个移动节拍结束后调用 playerMoved()，
+ * 只有越过区域边界时才回调 Enter/Exit，延迟为一个节拍（16ms）。
+ * 区域绑定所有者对象，所有者销毁后区域自动失效；回调中可以安全地增删区域。
+ */
+class TriggerSystem {
+public:
+    static TriggerSystem &instance();
+
+    /**
+     * @brief 注册触发区域
+     * @param owner 所有者对象，销毁后区域失效
+     * @param fireIfInside 玩家注册时已在区域内，是否在下一个移动节拍补发 Enter
+     *                     （陷阱、掉落物为 true；房门为 false，避免刚穿门就被传回去）
+     * @return 区域 id，用于 removeZone()
+     */
+    int addZone(QObject *owner, const TriggerVolume &volume, TriggerCallback callback, bool fireIfInside = false);
+
+    void removeZone(int id);
+
+    /**
+     * @brief 移除某个所有者的全部区域
+     */
+    void removeOwner(const QObject *owner);
+
+    /**
+     * @brief 重新武装某个所有者的区域：玩家若仍在区域内，下一个移动节拍重新触发 Enter
+     *
+     * 用于条件变化后（如房门打开）让已站在区域内的玩家无需走出再进入。
+     */
+    void rearm(const QObject *owner);
+
+    /**
+     * @brief 玩家移动节拍结束后调用，检测越界并派发 Enter/Exit
+     */
+    void playerMoved(Player *player);
+
+    /**
+     * @brief 玩家按下交互键，派发给玩家当前所在的全部区域
+     */
+    void playerInteract(Player *player);
+
+    [[nodiscard]] int zoneCount() const { return m_zones.size() - m_holes; }
+
+    /**
+     * @brief 移除所有区域（重新开始游戏时调用）
+     */
+    void clear();
+
+private:
+    TriggerSystem() = default;
+
+    TriggerSystem(const TriggerSystem &) = delete;
+
+    TriggerSystem &operator=(const TriggerSystem &) = delete;
+
+    struct Zone {
+        int id = 0;  // 0 表示已移除，派发结束后压缩
+        QPointer<QObject> owner;
+        TriggerVolume volume;
+        TriggerCallback callback;
+        bool inside = false;
+    };
+
+    [[nodiscard]] bool isLive(const Zone &zone) const { return zone.id != 0 && zone.owner; }
+
+    void markRemoved(Zone &zone);
+
+    // 复制回调后再调用，回调中增删区域导致数组重新分配也不影响执行
+    void fire(int index, TriggerEvent event);
+
+    void compact();
+
+    QVector<Zone> m_zones;
+    QPointer<Player> m_player;  // 最近一次移动的玩家，用于注册时判断初始状态
+    int m_nextId = 1;
+    int m_holes = 0;
+    int m_dispatchDepth = 0;
+};
+
+#endif // TRIGGERSYSTEM_H
@@ -0,0 +1,158 @@
+#include "worldsnapshot.h"
+#include <QDataStream>
+#include <QDebug>
+
+namespace {
+    void writePlayer(QDataStream &out, const PlayerState &player) {
+        out << player.pos << qint32(player.redContainers) << player.redHearts << qint32(player.blackHearts)
+            << qint32(player.keys) << qint32(player.bulletHurt) << qint32(player.shootCooldown) << player.speed
+            << player.shootSpeed << player.hurt << player.damageScale << qint32(player.frostChance)
+            << qint32(player.shieldCount);
+    }
+
+    void readPlayer(QDataStream &in, PlayerState &player) {
+        qint32 redContainers, blackHearts, keys, bulletHurt, shootCooldown, frostChance, shieldCount;
+        in >> player.pos >> redContainers >> player.redHearts >> blackHearts >> keys >> bulletHurt >> shootCooldown >>
+            player.speed >> player.shootSpeed >> player.hurt >> player.damageScale >> frostChance >> shieldCount;
+        player.redContainers = redContainers;
+        player.blackHearts = blackHearts;
+        player.keys = keys;
+        player.bulletHurt = bulletHurt;
+        player.shootCooldown = shootCooldown;
+        player.frostChance = frostChance;
+        player.shieldCount = shieldCount;
+    }
+
+    void writeRoom(QDataStream &out, const RoomState &room) {
+        // 四个门和两个进度标志打包为一个字节
+        quint8 flags = (room.openUp ? 0x01 : 0) | (room.openDown ? 0x02 : 0) | (room.openLeft ? 0x04 : 0) |
+                       (room.openRight ? 0x08 : 0) | (room.battleStarted ? 0x10 : 0) | (room.cleared ? 0x20 : 0);
+        out << flags << quint16(room.droppedItems.size());
+        for (const DroppedItemState &item : room.droppedItems) {
+            out << quint8(item.type) << item.pos;
+        }
+    }
+
+    void readRoom(QDataStream &in, RoomState &room) {
+        quint8 flags;
+        quint16 itemCount;
+        in >> flags >> itemCount;
+        room.openUp = flags & 0x01;
+        room.openDown = flags & 0x02;
+        room.openLeft = flags & 0x04;
+        room.openRight = flags & 0x08;
+        room.battleStarted = flags & 0x10;
+        room.cleared = flags & 0x20;
+
+        room.droppedItems.clear();
+        room.droppedItems.reserve(itemCount);
+        for (int i = 0; i < itemCount && in.status() == QDataStream::Ok; ++i) {
+            quint8 type;
+            QPointF pos;
+            in >> type >> pos;
+            if (type > static_cast<quint8>(DroppedItemType::TICKET)) {
+                in.setStatus(QDataStream::ReadCorruptData);
+                return;
+            }
+            room.droppedItems.append({static_cast<DroppedItemType>(type), pos});
+        }
+    }
+}
+
+QByteArray WorldSnapshot::toBytes() const {
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_12);
+
+    out << kMagic << kVersion;
+    out << qint32(levelNumber) << qint32(roomIndex) << firstEntry << rngSeed << qint32(visitedCount)
+        << encounteredBossDoor << bossDoorsOpened;
+
+    writePlayer(out, player);
+
+    out << quint16(playerEffects.size());
+    for (const StatusEffectRecord &effect : playerEffects) {
+        out << quint8(effect.type) << effect.magnitude << qint32(effect.remainingMs) << qint32(effect.stacks)
+            << qint32(effect.pulseInMs);
+    }
+
+    out << quint16(rooms.size());
+    for (int i = 0; i < rooms.size(); ++i) {
+        out << bool(visited.value(i, false));
+        writeRoom(out, rooms[i]);
+    }
+
+    out << quint16(chests.size());
+    for (const ChestState &chest : chests) {
+        out << chest.locked << chest.pos;
+    }
+    return bytes;
+}
+
+bool WorldSnapshot::fromBytes(const QByteArray &bytes, WorldSnapshot &out) {
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic;
+    quint16 version;
+    in >> magic >> version;
+    if (magic != kMagic || version != kVersion) {
+        qWarning() << "WorldSnapshot: 快照格式不匹配" << magic << version;
+        return false;
+    }
+
+    WorldSnapshot snapshot;
+    qint32 levelNumber, roomIndex, visitedCount;
+    in >> levelNumber >> roomIndex >> snapshot.firstEntry >> snapshot.rngSeed >> visitedCount >>
+        snapshot.encounteredBossDoor >> snapshot.bossDoorsOpened;
+    snapshot.levelNumber = levelNumber;
+    snapshot.roomIndex = roomIndex;
+    snapshot.visitedCount = visitedCount;
+
+    readPlayer(in, snapshot.player);
+
+    quint16 effectCount;
+    in >> effectCount;
+    for (int i = 0; i < effectCount && in.status() == QDataStream::Ok; ++i) {
+        quint8 type;
+        StatusEffectRecord effect{};
+        qint32 remainingMs, stacks, pulseInMs;
+        in >> type >> effect.magnitude >> remainingMs >> stacks >> pulseInMs;
+        if (type > static_cast<quint8>(StatusEffectType::Poison)) {
+            in.setStatus(QDataStream::ReadCorruptData);
+            break;
+        }
+        effect.type = static_cast<StatusEffectType>(type);
+        effect.remainingMs = remainingMs;
+        effect.stacks = stacks;
+        effect.pulseInMs = pulseInMs;
+        snapshot.playerEffects.append(effect);
+    }
+
+    quint16 roomCount;
+    in >> roomCount;
+    snapshot.visited.resize(roomCount);
+    snapshot.rooms.resize(roomCount);
+    for (int i = 0; i < roomCount && in.status() == QDataStream::Ok; ++i) {
+        bool visited;
+        in >> visited;
+        snapshot.visited[i] = visited;
+        readRoom(in, snapshot.rooms[i]);
+    }
+
+    quint16 chestCount;
+    in >> chestCount;
+    for (int i = 0; i < chestCount && in.status() == QDataStream::Ok; ++i) {
+        ChestState chest;
+        in >> chest.locked >> chest.pos;
+        snapshot.chests.append(chest);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qWarning() << "WorldSnapshot: 快照数据损坏";
+        return false;
+    }
+
+    out = std::move(snapshot);
+    return true;
+}
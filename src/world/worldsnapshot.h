@@ -0,0 +1,55 @@
+#ifndef WORLDSNAPSHOT_H
+#define WORLDSNAPSHOT_H
+
+#include <QByteArray>
+#include <QPointF>
+#include <QVector>
+#include "../entities/player.h"
+#include "../items/statuseffect.h"
+#include "room.h"
+
+/**
+ * @brief 宝箱的值快照（再次进入房间时已存在的宝箱）
+ */
+struct ChestState {
+    bool locked = false;
+    QPointF pos;
+};
+
+/**
+ * @brief 世界快照 - 进入房间时记录的可恢复状态
+ *
+ * 死亡后"再试一次"不再走 initGame 冷启动（清空场景、重建玩家/HUD/关卡、
+ * 重新加载资源并重播剧情），而是把快照写回现有对象，再按进入房间的方式重新初始化当前房间。
+ * 只包含值：玩家属性与道具、状态效果、各房间的门/战斗进度/掉落物品、
+ * 当前房间的宝箱，以及游戏随机数种子（重试时生成的敌人与宝箱位置和第一次完全一致）。
+ * 以紧凑的二进制形式保存在 Level 中。
+ */
+struct WorldSnapshot {
+    static constexpr quint32 kMagic = 0x57534E50;  // "WSNP"
+    static constexpr quint16 kVersion = 1;
+
+    int levelNumber = 0;
+    int roomIndex = -1;
+    bool firstEntry = false;  // 首次进入：重试时按配置重新生成敌人和宝箱
+    quint32 rngSeed = 0;      // Level::m_roomRng 的种子（进入房间时播种，即生成器在快照时的状态）
+    int visitedCount = 0;
+    bool encounteredBossDoor = false;
+    bool bossDoorsOpened = false;
+
+    PlayerState player;
+    QVector<StatusEffectRecord> playerEffects;
+    QVector<bool> visited;
+    QVector<RoomState> rooms;
+    QVector<ChestState> chests;
+
+    [[nodiscard]] QByteArray toBytes() const;
+
+    /**
+     * @brief 从二进制数据解析快照
+     * @return 数据损坏或版本不匹配时返回 false
+     */
+    static bool fromBytes(const QByteArray &bytes, WorldSnapshot &out);
+};
+
+#endif // WORLDSNAPSHOT_H
@@ -0,0 +1,116 @@
+/**
+ * @brief 房间重试回归测试（tst_roomretry，cmake -DBUILD_TESTS=ON 后由 ctest 运行）
+ *
+ * 重试恢复进入房间时的快照：快照之后打开的门必须重新关上，门的图元状态与房间的开门标志一致。
+ */
+#include <QDir>
+#include <QFile>
+#include <QGraphicsScene>
+#include <QtTest>
+#include "constants.h"
+#include "core/configmanager.h"
+#include "core/gameclock.h"
+#include "core/resourcefactory.h"
+#include "entities/player.h"
+#include "items/itemeffectconfig.h"
+#include "world/door.h"
+#include "world/level.h"
+#include "world/levelconfig.h"
+#include "world/room.h"
+
+class RoomRetryTest : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    void initTestCase() {
+        // 资源路径相对于项目根目录
+        if (!QFile::exists("assets/config.json")) {
+            QDir::setCurrent(GAME_SOURCE_DIR);
+        }
+        QVERIFY(ConfigManager::instance().loadConfig("assets/config.json"));
+        ItemEffectConfig::instance().loadConfig("assets/item_effects.json");
+    }
+
+    void retryClosesDoorsOpenedAfterSnapshot() {
+        constexpr int kLevel = 1;
+        LevelConfig config;
+        QVERIFY(config.loadFromFile(kLevel));
+
+        // 可重试的房间：非 Boss、非精英、至少有一扇门
+        int roomIndex = -1;
+        for (int i = 0; i < config.getRoomCount() && roomIndex < 0; ++i) {
+            const RoomConfig &roomCfg = config.getRoom(i);
+            const bool hasDoor = roomCfg.doorUp >= 0 || roomCfg.doorDown >= 0 || roomCfg.doorLeft >= 0 || roomCfg.doorRight >= 0;
+            if (!roomCfg.hasBoss && !roomCfg.isEliteRoom && hasDoor)
+                roomIndex = i;
+        }
+        QVERIFY(roomIndex >= 0);
+
+        QGraphicsScene scene;
+        scene.setSceneRect(0, 0, scene_bound_x, scene_bound_y);
+        const int playerSize = ConfigManager::instance().getSize("player");
+        auto *player = new Player(ResourceFactory::createPlayerImage(playerSize), 1.0);
+        player->setPos(scene_bound_x / 2.0, scene_bound_y / 2.0);
+        scene.addItem(player);
+        GameClock::instance().setPaused(ClockDomain::Gameplay, false);
+
+        // 开发者模式把非 Boss 房间标记为已访问、已清空，可以直接 loadRoom
+        Level level(player, &scene);
+        level.setSkipToBoss(true);
+        level.init(kLevel);
+
+        // 关上所有门后重新进入房间，快照记录关闭状态
+        level.loadRoom(roomIndex);
+        Room *target = level.currentRoom();
+        QVERIFY(target);
+        target->setDoorOpenUp(false);
+        target->setDoorOpenDown(false);
+        target->setDoorOpenLeft(false);
+        target->setDoorOpenRight(false);
+        level.loadRoom(roomIndex);
+        QCOMPARE(openDoorCount(scene), 0);
+
+        // 快照之后开门
+        level.openDoors(level.currentRoom());
+        QVERIFY(openDoorCount(scene) > 0);
+
+        // 重试：门与恢复的开门标志一致，重新关上
+        QVERIFY(level.retryFromRoomStart());
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        Room *restored = level.currentRoom();
+        QVERIFY(restored);
+        QVERIFY(!restored->isDoorOpenUp());
+        QVERIFY(!restored->isDoorOpenDown());
+        QVERIFY(!restored->isDoorOpenLeft());
+        QVERIFY(!restored->isDoorOpenRight());
+        QVERIFY(doorCount(scene) > 0);
+        QCOMPARE(openDoorCount(scene), 0);
+    }
+
+private:
+    static QList<Door *> doors(const QGraphicsScene &scene) {
+        QList<Door *> result;
+        for (QGraphicsItem *item : scene.items()) {
+            if (auto *door = dynamic_cast<Door *>(item))
+                result.append(door);
+        }
+        return result;
+    }
+
+    static int doorCount(const QGraphicsScene &scene) { return doors(scene).size(); }
+
+    // 打开或正在播放开门动画的门
+    static int openDoorCount(const QGraphicsScene &scene) {
+        int count = 0;
+        for (Door *door : doors(scene)) {
+            if (door->state() != Door::Closed)
+                ++count;
+        }
+        return count;
+    }
+};
+
+QTEST_MAIN(RoomRetryTest)
+
+#include "tst_roomretry.moc"
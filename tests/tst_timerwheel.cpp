@@ -0,0 +1,59 @@
+/**
+ * @brief 时间轮回归测试（tst_timerwheel，cmake -DBUILD_TESTS=ON 后由 ctest 运行）
+ *
+ * 同一节拍到期的回调必须按调度顺序执行：游戏逻辑中原本依次调用的 singleShot（如掉落物品先于精英检查）依赖这一顺序。
+ */
+#include <QtTest>
+#include "core/gameclock.h"
+#include "core/timerwheel.h"
+
+class TimerWheelTest : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    void init() {
+        TimerWheel::instance().clear();
+        GameClock::instance().setPaused(ClockDomain::Gameplay, false);
+        GameClock::instance().setTimeScale(ClockDomain::Gameplay, 1.0);
+    }
+
+    void sameTickCallbacksRunInScheduleOrder() {
+        QVector<int> order;
+        for (int i = 0; i < 5; ++i) {
+            TimerWheel::instance().schedule(this, 2 * GameClock::kTickIntervalMs, [&order, i]() { order.append(i); });
+        }
+
+        advanceTicks(1);
+        QVERIFY(order.isEmpty());
+        advanceTicks(1);
+        QCOMPARE(order, QVector<int>({0, 1, 2, 3, 4}));
+    }
+
+    void cascadedCallbackRunsBeforeLaterScheduledOne() {
+        // 先调度的长延迟回调放在上层，到期前才分配到第0层；后调度的回调直接进入第0层，同一节拍到期
+        constexpr int kDueTicks = 313;
+        constexpr int kLaterTicks = 63;
+        QVector<int> order;
+        TimerWheel::instance().schedule(this, kDueTicks * GameClock::kTickIntervalMs, [&order]() { order.append(0); });
+        advanceTicks(kLaterTicks);
+        TimerWheel::instance().schedule(this, (kDueTicks - kLaterTicks) * GameClock::kTickIntervalMs,
+                                        [&order]() { order.append(1); });
+
+        advanceTicks(kDueTicks - kLaterTicks - 1);
+        QVERIFY(order.isEmpty());
+        advanceTicks(1);
+        QCOMPARE(order, QVector<int>({0, 1}));
+    }
+
+private:
+    static void advanceTicks(int ticks) {
+        for (int i = 0; i < ticks; ++i) {
+            GameClock::instance().advanceGameplay(GameClock::kTickIntervalMs);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(TimerWheelTest)
+
+#include "tst_timerwheel.moc"